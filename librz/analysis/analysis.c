@@ -76,6 +76,7 @@ RZ_API RzAnalysis *rz_analysis_new(void) {
 		return NULL;
 	}
 	analysis->bb_tree = NULL;
+	analysis->read_ahead_addr = UT64_MAX;
 	analysis->ht_addr_fun = ht_up_new0();
 	analysis->ht_name_fun = ht_pp_new0();
 	analysis->os = strdup(RZ_SYS_OS);
@@ -144,6 +145,7 @@ RZ_API RzAnalysis *rz_analysis_free(RzAnalysis *a) {
 	plugin_fini(a);
 
 	rz_hash_free(a->hash);
+	rz_analysis_op_cache_free(a->opcache);
 	rz_analysis_il_vm_cleanup(a);
 	rz_list_free(a->fcns);
 	ht_up_free(a->ht_addr_fun);
@@ -232,6 +234,9 @@ RZ_API char *rz_analysis_get_reg_profile(RzAnalysis *analysis) {
 
 RZ_API bool rz_analysis_set_reg_profile(RzAnalysis *analysis) {
 	bool ret = false;
+	// cached ops hold references to the register items and depend on
+	// the arch, cpu and bits which all lead to a new register profile.
+	rz_analysis_op_cache_flush(analysis->opcache);
 	char *p = rz_analysis_get_reg_profile(analysis);
 	if (p) {
 		rz_reg_set_profile_string(analysis->reg, p);
@@ -338,6 +343,9 @@ RZ_API void rz_analysis_set_cpu(RzAnalysis *analysis, const char *cpu) {
 }
 
 RZ_API int rz_analysis_set_big_endian(RzAnalysis *analysis, int bigend) {
+	if (analysis->big_endian != bigend) {
+		rz_analysis_op_cache_flush(analysis->opcache);
+	}
 	analysis->big_endian = bigend;
 	if (analysis->reg) {
 		analysis->reg->big_endian = bigend;
@@ -8,14 +8,24 @@
 #include <rz_bin_dwarf.h>
 #include <string.h>
 
+typedef enum {
+	DWARF_PASS_TYPES = 1 << 0,
+	DWARF_PASS_FUNCTIONS = 1 << 1,
+	DWARF_PASS_ALL = DWARF_PASS_TYPES | DWARF_PASS_FUNCTIONS
+} DwarfPass;
+
 typedef struct dwarf_parse_context_t {
 	const RzAnalysis *analysis;
 	const RzBinDwarfDie *all_dies;
 	const ut64 count;
 	Sdb *sdb;
-	HtUP /*<ut64 offset, DwarfDie *die>*/ *die_map;
+	RzBinDwarfDebugInfo *info;
 	HtUP /*<offset, RzBinDwarfLocList*>*/ *locations;
 	char *lang; // for demangling
+	ut32 passes; // DwarfPass mask of the entries to parse
+	RzPVector /*<RzBaseType *>*/ *types; // if set, parsed types are collected here instead of being saved
+	RzPVector /*<PendingFunction *>*/ *functions; // if set, parsed functions are collected here instead of being saved
+	RzVector /*<size_t>*/ *pinned; // if set, units pinned while parsing, as other threads may release them
 } Context;
 
 typedef struct dwarf_function_t {
@@ -60,6 +70,39 @@ static void variable_free(Variable *var) {
 	free(var);
 }
 
+/* function parsed by a worker thread, saved to the sdb when merging the units */
+typedef struct dwarf_pending_function_t {
+	Function fcn; // owns name and signature
+	RzList /*<Variable *>*/ *variables;
+} PendingFunction;
+
+static void pending_function_free(PendingFunction *pf) {
+	if (!pf) {
+		return;
+	}
+	free((char *)pf->fcn.name);
+	free((char *)pf->fcn.signature);
+	RzListIter *iter;
+	Variable *var;
+	rz_list_foreach (pf->variables, iter, var) {
+		variable_free(var);
+	}
+	rz_list_free(pf->variables);
+	free(pf);
+}
+
+/**
+ * \brief Saves \p base_type into the type database, or collects it
+ *        for the merge when parsing in parallel
+ */
+static void save_base_type(Context *ctx, RZ_OWN RzBaseType *base_type) {
+	if (!ctx->types) {
+		rz_type_db_save_base_type(ctx->analysis->typedb, base_type);
+	} else if (!rz_pvector_push(ctx->types, base_type)) {
+		rz_type_base_type_free(base_type);
+	}
+}
+
 /* return -1 if attr isn't found */
 static inline st32 find_attr_idx(const RzBinDwarfDie *die, st32 attr_name) {
 	st32 i;
@@ -183,6 +226,35 @@ static RzType *parse_type_in_die(Context *ctx, RzBinDwarfDie *die, bool allow_vo
 	return parse_type(ctx, die->attr_values[type_idx].reference, size, visited);
 }
 
+/**
+ * Finds the DIE at \p offset, pinning its unit first when the units are
+ * shared with other threads, so that the DIE stays valid while it is used.
+ */
+static RzBinDwarfDie *find_die(Context *ctx, ut64 offset) {
+	if (ctx->pinned) {
+		size_t idx = rz_bin_dwarf_debug_info_unit_index(ctx->info, offset);
+		bool pinned = false;
+		size_t *it;
+		rz_vector_foreach(ctx->pinned, it) {
+			if (*it == idx) {
+				pinned = true;
+				break;
+			}
+		}
+		if (!pinned) {
+			if (!rz_bin_dwarf_debug_info_pin_unit(ctx->info, idx)) {
+				return NULL;
+			}
+			if (!rz_vector_push(ctx->pinned, &idx)) {
+				// nothing would drop the pin later
+				rz_bin_dwarf_debug_info_unpin_unit(ctx->info, idx);
+				return NULL;
+			}
+		}
+	}
+	return rz_bin_dwarf_debug_info_find_die(ctx->info, offset);
+}
+
 /**
  * \brief Recursively parses type entry of a certain offset and saves type size into *size
  *
@@ -197,7 +269,7 @@ static RzType *parse_type(Context *ctx, const ut64 offset, RZ_NULLABLE ut64 *siz
 	if (set_u_contains(visited, offset)) {
 		return NULL;
 	}
-	RzBinDwarfDie *die = ht_up_find(ctx->die_map, offset, NULL);
+	RzBinDwarfDie *die = find_die(ctx, offset);
 	if (!die) {
 		return NULL;
 	}
@@ -484,7 +556,7 @@ static void parse_structure_type(Context *ctx, ut64 idx) {
 	// if it is definition of previous declaration (TODO Fix, big ugly hotfix addition)
 	st32 spec_attr_idx = find_attr_idx(die, DW_AT_specification);
 	if (spec_attr_idx != -1) {
-		RzBinDwarfDie *decl_die = ht_up_find(ctx->die_map, die->attr_values[spec_attr_idx].reference, NULL);
+		RzBinDwarfDie *decl_die = find_die(ctx, die->attr_values[spec_attr_idx].reference);
 		if (!decl_die) {
 			rz_type_base_type_free(base_type);
 			return;
@@ -529,7 +601,7 @@ static void parse_structure_type(Context *ctx, ut64 idx) {
 			}
 		}
 	}
-	rz_type_db_save_base_type(ctx->analysis->typedb, base_type);
+	save_base_type(ctx, base_type);
 }
 
 /**
@@ -594,7 +666,7 @@ static void parse_enum_type(Context *ctx, ut64 idx) {
 			}
 		}
 	}
-	rz_type_db_save_base_type(ctx->analysis->typedb, base_type);
+	save_base_type(ctx, base_type);
 }
 
 /**
@@ -643,7 +715,7 @@ static void parse_typedef(Context *ctx, ut64 idx) {
 	}
 	base_type->name = name;
 	base_type->type = type;
-	rz_type_db_save_base_type(ctx->analysis->typedb, base_type);
+	save_base_type(ctx, base_type);
 	return;
 
 cleanup:
@@ -694,7 +766,7 @@ static void parse_atomic_type(Context *ctx, ut64 idx) {
 	}
 	base_type->name = name;
 	base_type->size = size;
-	rz_type_db_save_base_type(ctx->analysis->typedb, base_type);
+	save_base_type(ctx, base_type);
 }
 
 static const char *get_specification_die_name(const RzBinDwarfDie *die) {
@@ -739,7 +811,7 @@ static bool prefer_linkage_name(char *lang) {
 }
 
 static RzType *parse_abstract_origin(Context *ctx, ut64 offset, const char **name) {
-	RzBinDwarfDie *die = ht_up_find(ctx->die_map, offset, NULL);
+	RzBinDwarfDie *die = find_die(ctx, offset);
 	if (die) {
 		size_t i;
 		ut64 size = 0;
@@ -1383,7 +1455,7 @@ static void parse_function(Context *ctx, ut64 idx) {
 			break;
 		case DW_AT_specification: /* reference to declaration DIE with more info */
 		{
-			RzBinDwarfDie *spec_die = ht_up_find(ctx->die_map, val->reference, NULL);
+			RzBinDwarfDie *spec_die = find_die(ctx, val->reference);
 			if (spec_die) {
 				fcn.name = get_specification_die_name(spec_die); /* I assume that if specification has a name, this DIE hasn't */
 				rz_type_free(ret_type);
@@ -1443,7 +1515,20 @@ static void parse_function(Context *ctx, ut64 idx) {
 	char *ret_type_str = type_as_string(ctx->analysis->typedb, ret_type);
 	fcn.signature = rz_str_newf("%s %s(%s);", rz_str_get(ret_type_str), fcn.name, rz_strbuf_get(&args));
 	free(ret_type_str);
-	sdb_save_dwarf_function(&fcn, variables, ctx->sdb);
+	if (ctx->functions) {
+		PendingFunction *pf = RZ_NEW0(PendingFunction);
+		if (pf) {
+			pf->fcn = fcn;
+			pf->variables = variables;
+			if (!rz_pvector_push(ctx->functions, pf)) {
+				pending_function_free(pf);
+			}
+			rz_strbuf_fini(&args);
+			goto cleanup;
+		}
+	} else {
+		sdb_save_dwarf_function(&fcn, variables, ctx->sdb);
+	}
 
 	free((char *)fcn.signature);
 	free((char *)fcn.name);
@@ -1528,23 +1613,34 @@ static void parse_type_entry(Context *ctx, ut64 idx) {
 	rz_return_if_fail(ctx);
 
 	const RzBinDwarfDie *die = &ctx->all_dies[idx];
+	bool types = ctx->passes & DWARF_PASS_TYPES;
 	switch (die->tag) {
 	case DW_TAG_structure_type:
 	case DW_TAG_union_type:
 	case DW_TAG_class_type:
-		parse_structure_type(ctx, idx);
+		if (types) {
+			parse_structure_type(ctx, idx);
+		}
 		break;
 	case DW_TAG_enumeration_type:
-		parse_enum_type(ctx, idx);
+		if (types) {
+			parse_enum_type(ctx, idx);
+		}
 		break;
 	case DW_TAG_typedef:
-		parse_typedef(ctx, idx);
+		if (types) {
+			parse_typedef(ctx, idx);
+		}
 		break;
 	case DW_TAG_base_type:
-		parse_atomic_type(ctx, idx);
+		if (types) {
+			parse_atomic_type(ctx, idx);
+		}
 		break;
 	case DW_TAG_subprogram:
-		parse_function(ctx, idx);
+		if (ctx->passes & DWARF_PASS_FUNCTIONS) {
+			parse_function(ctx, idx);
+		}
 		break;
 	case DW_TAG_compile_unit:
 		/* used for name demangling */
@@ -1554,33 +1650,259 @@ static void parse_type_entry(Context *ctx, ut64 idx) {
 	}
 }
 
+/* below this number of units, the import is not worth the threads */
+#define DWARF_PROCESS_PARALLEL_MIN 16
+
+typedef struct {
+	RzPVector /*<RzBaseType *>*/ types;
+	RzPVector /*<PendingFunction *>*/ functions;
+} UnitResult;
+
+typedef struct {
+	const RzAnalysis *analysis;
+	RzAnalysisDwarfContext *ctx;
+	UnitResult *results;
+	ut32 passes;
+	RzThreadLock *lock;
+	size_t next; ///< index of the next unit to parse, guarded by lock
+} ProcessJob;
+
+static bool struct_members_equal(const RzVector /*<RzTypeStructMember>*/ *a, const RzVector /*<RzTypeStructMember>*/ *b) {
+	if (rz_vector_len(a) != rz_vector_len(b)) {
+		return false;
+	}
+	for (size_t i = 0; i < rz_vector_len(a); i++) {
+		const RzTypeStructMember *ma = rz_vector_index_ptr((RzVector *)a, i);
+		const RzTypeStructMember *mb = rz_vector_index_ptr((RzVector *)b, i);
+		if (ma->offset != mb->offset || ma->size != mb->size || rz_str_cmp(ma->name, mb->name, -1) ||
+			!ma->type != !mb->type || (ma->type && !rz_types_equal(ma->type, mb->type))) {
+			return false;
+		}
+	}
+	return true;
+}
+
+static bool base_types_equal(const RzBaseType *a, const RzBaseType *b) {
+	if (a->kind != b->kind || a->size != b->size || a->attrs != b->attrs ||
+		!a->type != !b->type || (a->type && !rz_types_equal(a->type, b->type))) {
+		return false;
+	}
+	switch (a->kind) {
+	case RZ_BASE_TYPE_KIND_STRUCT:
+		return struct_members_equal(&a->struct_data.members, &b->struct_data.members);
+	case RZ_BASE_TYPE_KIND_UNION:
+		// RzTypeUnionMember has the same layout as RzTypeStructMember
+		return struct_members_equal(&a->union_data.members, &b->union_data.members);
+	case RZ_BASE_TYPE_KIND_ENUM: {
+		if (rz_vector_len(&a->enum_data.cases) != rz_vector_len(&b->enum_data.cases)) {
+			return false;
+		}
+		for (size_t i = 0; i < rz_vector_len(&a->enum_data.cases); i++) {
+			const RzTypeEnumCase *ca = rz_vector_index_ptr((RzVector *)&a->enum_data.cases, i);
+			const RzTypeEnumCase *cb = rz_vector_index_ptr((RzVector *)&b->enum_data.cases, i);
+			if (ca->val != cb->val || rz_str_cmp(ca->name, cb->name, -1)) {
+				return false;
+			}
+		}
+		return true;
+	}
+	default:
+		return true;
+	}
+}
+
 /**
- * \brief Parses type and function information out of DWARF entries
- *        and stores them to the sdb for further use
+ * \brief Saves the types parsed from one unit into the type database
  *
- * \param analysis
- * \param ctx
+ * The first definition of a name wins, as when saving them one by one.
+ * The same type is usually defined by every unit including its header,
+ * these copies are just dropped.
  */
-RZ_API void rz_analysis_dwarf_process_info(const RzAnalysis *analysis, RzAnalysisDwarfContext *ctx) {
-	rz_return_if_fail(ctx && analysis);
-	Sdb *dwarf_sdb = sdb_ns(analysis->sdb, "dwarf", 1);
-	size_t i, j;
-	const RzBinDwarfDebugInfo *info = ctx->info;
-	for (i = 0; i < info->count; i++) {
-		RzBinDwarfCompUnit *unit = &info->comp_units[i];
+static void merge_unit_types(const RzTypeDB *typedb, RzPVector /*<RzBaseType *>*/ *types) {
+	void **it;
+	rz_pvector_foreach (types, it) {
+		RzBaseType *btype = *it;
+		RzBaseType *known = rz_type_db_get_base_type(typedb, btype->name);
+		if (!known) {
+			rz_type_db_save_base_type(typedb, btype);
+			continue;
+		}
+		if (!base_types_equal(known, btype)) {
+			RZ_LOG_DEBUG("dwarf: conflicting definitions of type %s, keeping the first one\n", btype->name);
+		}
+		rz_type_base_type_free(btype);
+	}
+	rz_pvector_clear(types);
+}
+
+static void merge_unit_functions(Sdb *sdb, RzPVector /*<PendingFunction *>*/ *functions) {
+	void **it;
+	rz_pvector_foreach (functions, it) {
+		PendingFunction *pf = *it;
+		sdb_save_dwarf_function(&pf->fcn, pf->variables, sdb);
+		pending_function_free(pf);
+	}
+	rz_pvector_clear(functions);
+}
+
+static void unpin_units(RzBinDwarfDebugInfo *info, RzVector /*<size_t>*/ *pinned) {
+	size_t *it;
+	rz_vector_foreach(pinned, it) {
+		rz_bin_dwarf_debug_info_unpin_unit(info, *it);
+	}
+	rz_vector_clear(pinned);
+}
+
+/**
+ * \brief Parses the units handed out by \p job until there are none left
+ *
+ * Each unit, and any other unit its entries refer to, is pinned while being
+ * parsed and released right after, as the results do not point into the DIEs.
+ */
+static void *process_units_runner(ProcessJob *job) {
+	RzBinDwarfDebugInfo *info = job->ctx->info;
+	RzVector pinned;
+	rz_vector_init(&pinned, sizeof(size_t), NULL, NULL);
+	while (true) {
+		rz_th_lock_enter(job->lock);
+		size_t i = job->next++;
+		rz_th_lock_leave(job->lock);
+		if (i >= info->count) {
+			break;
+		}
+		RzBinDwarfCompUnit *unit = rz_bin_dwarf_debug_info_pin_unit(info, i);
+		if (!unit) {
+			continue;
+		}
+		rz_vector_push(&pinned, &i);
+		Context dw_context = {
+			.analysis = job->analysis,
+			.all_dies = unit->dies,
+			.count = unit->count,
+			.info = info,
+			.sdb = NULL,
+			.locations = job->ctx->loc,
+			.lang = NULL,
+			.passes = job->passes,
+			.types = &job->results[i].types,
+			.functions = &job->results[i].functions,
+			.pinned = &pinned
+		};
+		for (size_t j = 0; j < unit->count; j++) {
+			parse_type_entry(&dw_context, j);
+		}
+		unpin_units(info, &pinned);
+	}
+	rz_vector_fini(&pinned);
+	return NULL;
+}
+
+/**
+ * \brief Runs \p job over all the units on the thread pool
+ *
+ * The units left over by a thread which could not be started are
+ * parsed by the calling thread.
+ */
+static void process_units_parallel(ProcessJob *job) {
+	job->next = 0;
+	RzThreadPool *pool = rz_th_pool_new(job->analysis->opt.threads);
+	if (pool) {
+		size_t pool_size = rz_th_pool_size(pool);
+		for (size_t i = 0; i < pool_size; i++) {
+			RzThread *th = rz_th_new((RzThreadFunction)process_units_runner, job);
+			if (!th) {
+				break;
+			} else if (!rz_th_pool_add_thread(pool, th)) {
+				rz_th_wait(th);
+				rz_th_free(th);
+				break;
+			}
+		}
+		rz_th_pool_wait(pool);
+		rz_th_pool_free(pool);
+	}
+	process_units_runner(job);
+}
+
+static void process_info_serial(const RzAnalysis *analysis, RzAnalysisDwarfContext *ctx, Sdb *dwarf_sdb) {
+	RzBinDwarfDebugInfo *info = ctx->info;
+	for (size_t i = 0; i < info->count; i++) {
+		RzBinDwarfCompUnit *unit = rz_bin_dwarf_debug_info_get_unit(info, i);
+		if (!unit) {
+			continue;
+		}
 		Context dw_context = { // context per unit?
 			.analysis = analysis,
 			.all_dies = unit->dies,
 			.count = unit->count,
-			.die_map = info->lookup_table,
+			.info = info,
 			.sdb = dwarf_sdb,
 			.locations = ctx->loc,
-			.lang = NULL
+			.lang = NULL,
+			.passes = DWARF_PASS_ALL
 		};
-		for (j = 0; j < unit->count; j++) {
+		for (size_t j = 0; j < unit->count; j++) {
 			parse_type_entry(&dw_context, j);
 		}
+		// when the info was only indexed, this keeps the decoded DIEs bounded to the referenced units
+		rz_bin_dwarf_debug_info_release_unit(info, i);
+	}
+}
+
+/**
+ * \brief Parses type and function information out of DWARF entries
+ *        and stores them to the sdb for further use
+ *
+ * With enough units, these are parsed in parallel, in two passes: the types
+ * of all the units first, then the functions, whose signatures refer to the
+ * types. After each pass, the results are merged into the type database and
+ * the sdb in unit order, so that the outcome does not depend on the scheduling.
+ *
+ * \param analysis
+ * \param ctx
+ */
+RZ_API void rz_analysis_dwarf_process_info(const RzAnalysis *analysis, RzAnalysisDwarfContext *ctx) {
+	rz_return_if_fail(ctx && analysis);
+	Sdb *dwarf_sdb = sdb_ns(analysis->sdb, "dwarf", 1);
+	RzBinDwarfDebugInfo *info = ctx->info;
+	size_t i;
+	bool parallel = info->count >= DWARF_PROCESS_PARALLEL_MIN && analysis->opt.threads != 1;
+	UnitResult *results = parallel ? RZ_NEWS0(UnitResult, info->count) : NULL;
+	RzThreadLock *lock = results ? rz_th_lock_new(false) : NULL;
+	if (!lock) {
+		free(results);
+		process_info_serial(analysis, ctx, dwarf_sdb);
+		return;
+	}
+	for (i = 0; i < info->count; i++) {
+		rz_pvector_init(&results[i].types, NULL);
+		rz_pvector_init(&results[i].functions, NULL);
+	}
+
+	ProcessJob job = {
+		.analysis = analysis,
+		.ctx = ctx,
+		.results = results,
+		.passes = DWARF_PASS_TYPES,
+		.lock = lock
+	};
+	process_units_parallel(&job);
+	for (i = 0; i < info->count; i++) {
+		merge_unit_types(analysis->typedb, &results[i].types);
+	}
+
+	job.passes = DWARF_PASS_FUNCTIONS;
+	process_units_parallel(&job);
+	for (i = 0; i < info->count; i++) {
+		merge_unit_functions(dwarf_sdb, &results[i].functions);
+	}
+
+	for (i = 0; i < info->count; i++) {
+		rz_pvector_fini(&results[i].types);
+		rz_pvector_fini(&results[i].functions);
 	}
+	rz_th_lock_free(lock);
+	free(results);
 }
 
 bool filter_sdb_function_names(void *user, const char *k, const char *v) {
@@ -46,33 +46,26 @@ RZ_API const char *rz_analysis_fcntype_tostring(int type) {
 }
 
 #if READ_AHEAD
-static ut64 cache_addr = UT64_MAX;
-
-// TODO: move into io :?
+// Reads through analysis->read_ahead, the reads of the plugins are cached below by io.rcache if enabled
 static int read_ahead(RzAnalysis *analysis, ut64 addr, ut8 *buf, int len) {
-	static ut8 cache[1024];
-	const int cache_len = sizeof(cache);
+	const int cache_len = sizeof(analysis->read_ahead);
 
 	if (len < 1) {
 		return 0;
 	}
 	if (len > cache_len) {
-		int a = analysis->iob.read_at(analysis->iob.io, addr, buf, len); // double read
-		memcpy(cache, buf, cache_len);
-		cache_addr = addr;
-		return a;
+		return analysis->iob.read_at(analysis->iob.io, addr, buf, len);
 	}
 
+	ut64 cache_addr = analysis->read_ahead_addr;
 	ut64 addr_end = UT64_ADD_OVFCHK(addr, len) ? UT64_MAX : addr + len;
 	ut64 cache_addr_end = UT64_ADD_OVFCHK(cache_addr, cache_len) ? UT64_MAX : cache_addr + cache_len;
 	bool isCached = ((addr != UT64_MAX) && (addr >= cache_addr) && (addr_end < cache_addr_end));
-	if (isCached) {
-		memcpy(buf, cache + (addr - cache_addr), len);
-	} else {
-		analysis->iob.read_at(analysis->iob.io, addr, cache, sizeof(cache));
-		memcpy(buf, cache, len);
-		cache_addr = addr;
+	if (!isCached) {
+		analysis->iob.read_at(analysis->iob.io, addr, analysis->read_ahead, cache_len);
+		analysis->read_ahead_addr = cache_addr = addr;
 	}
+	memcpy(buf, analysis->read_ahead + (addr - cache_addr), len);
 	return len;
 }
 #else
@@ -81,10 +74,14 @@ static int read_ahead(RzAnalysis *analysis, ut64 addr, ut8 *buf, int len) {
 }
 #endif
 
-RZ_API void rz_analysis_fcn_invalidate_read_ahead_cache(void) {
-#if READ_AHEAD
-	cache_addr = UT64_MAX;
-#endif
+/**
+ * \brief Drops the bytes read ahead by the function analysis of \p analysis
+ *
+ * Must be called when the memory may have changed since the last analysis.
+ */
+RZ_API void rz_analysis_fcn_invalidate_read_ahead_cache(RZ_NONNULL RzAnalysis *analysis) {
+	rz_return_if_fail(analysis);
+	analysis->read_ahead_addr = UT64_MAX;
 }
 
 RZ_API int rz_analysis_function_resize(RzAnalysisFunction *fcn, int newsize) {
@@ -529,6 +526,35 @@ static int analyze_function_locally(RzAnalysis *analysis, RzAnalysisFunction *fc
 	return ret;
 }
 
+/**
+ * \brief Adds a task item to \p tasks unless one starting at \p address is pending.
+ *
+ * \p pending holds the start addresses of the items in \p tasks and is updated
+ * with the new item. If it is NULL, \p tasks is scanned for duplicates instead.
+ */
+RZ_IPI bool rz_analysis_task_item_add(RzAnalysis *analysis, RzVector /*<RzAnalysisTaskItem>*/ *tasks, RZ_NULLABLE SetU *pending, RzAnalysisFunction *fcn, RzAnalysisBlock *block, ut64 address, RzStackAddr sp) {
+	RzAnalysisTaskItem item = { fcn, block, sp, address };
+	if (pending) {
+		if (set_u_contains(pending, address)) {
+			return true;
+		}
+	} else {
+		RzAnalysisTaskItem *it;
+		rz_vector_foreach(tasks, it) {
+			if (item.start_address == it->start_address) {
+				return true;
+			}
+		}
+	}
+	if (!rz_vector_push(tasks, &item)) {
+		return false;
+	}
+	if (pending) {
+		set_u_add(pending, address);
+	}
+	return true;
+}
+
 static inline void set_bb_branches(RZ_OUT RzAnalysisBlock *bb, const ut64 jump, const ut64 fail) {
 	bb->jump = jump;
 	bb->fail = fail;
@@ -544,9 +570,10 @@ static inline void set_bb_branches(RZ_OUT RzAnalysisBlock *bb, const ut64 jump,
  *
  * \param item The task item with the parent function and start address to start analysing from.
  * \param tasks The task list to append the new task items to.
+ * \param pending The start addresses of the items in \p tasks, or NULL.
  * \return RzAnalysisBBEndCause Cause a basic block ended.
  */
-static RzAnalysisBBEndCause run_basic_block_analysis(RzAnalysisTaskItem *item, RzVector /*<RzAnalysisTaskItem>*/ *tasks) {
+static RzAnalysisBBEndCause run_basic_block_analysis(RzAnalysisTaskItem *item, RzVector /*<RzAnalysisTaskItem>*/ *tasks, SetU *pending) {
 	rz_return_val_if_fail(item && tasks, RZ_ANALYSIS_RET_ERROR);
 	RzAnalysis *analysis = item->fcn->analysis;
 	RzAnalysisFunction *fcn = item->fcn;
@@ -595,7 +622,7 @@ static RzAnalysisBBEndCause run_basic_block_analysis(RzAnalysisTaskItem *item, R
 	bool has_variadic_reg = !!variadic_reg;
 
 	if (rz_cons_is_breaked()) {
-		rz_analysis_task_item_new(analysis, tasks, fcn, bb, addr, sp);
+		rz_analysis_task_item_add(analysis, tasks, pending, fcn, bb, addr, sp);
 		return RZ_ANALYSIS_RET_END;
 	}
 	if (analysis->sleep) {
@@ -704,7 +731,7 @@ static RzAnalysisBBEndCause run_basic_block_analysis(RzAnalysisTaskItem *item, R
 		at_delta = addrbytes * idx;
 		at = addr + at_delta;
 		if (rz_cons_is_breaked()) {
-			rz_analysis_task_item_new(analysis, tasks, fcn, bb, at, sp);
+			rz_analysis_task_item_add(analysis, tasks, pending, fcn, bb, at, sp);
 			break;
 		}
 		ut64 bytes_read = RZ_MIN(len - at_delta, sizeof(buf));
@@ -988,7 +1015,8 @@ static RzAnalysisBBEndCause run_basic_block_analysis(RzAnalysisTaskItem *item, R
 						.entry_size = 4,
 						.jmptbl_off = op.ptr,
 						.sp = sp,
-						.tasks = tasks
+						.tasks = tasks,
+						.pending = pending
 					};
 					if (rz_analysis_get_jmptbl_info(analysis, fcn, bb, jmp_aop.addr, &params) || rz_analysis_get_delta_jmptbl_info(analysis, fcn, jmp_aop.addr, op.addr, &params)) {
 						ret = casetbl_addr == op.ptr
@@ -1057,8 +1085,8 @@ static RzAnalysisBBEndCause run_basic_block_analysis(RzAnalysisTaskItem *item, R
 			}
 			if (rz_analysis_noreturn_at(analysis, op.jump)) {
 				if (continue_after_jump && is_hexagon) {
-					rz_analysis_task_item_new(analysis, tasks, fcn, NULL, op.jump, sp);
-					rz_analysis_task_item_new(analysis, tasks, fcn, NULL, op.addr + op.size, sp);
+					rz_analysis_task_item_add(analysis, tasks, pending, fcn, NULL, op.jump, sp);
+					rz_analysis_task_item_add(analysis, tasks, pending, fcn, NULL, op.addr + op.size, sp);
 					if (!overlapped) {
 						set_bb_branches(bb, op.jump, op.addr + op.size);
 					}
@@ -1074,8 +1102,8 @@ static RzAnalysisBBEndCause run_basic_block_analysis(RzAnalysisTaskItem *item, R
 				}
 				if (must_eob) {
 					if (continue_after_jump && is_hexagon) {
-						rz_analysis_task_item_new(analysis, tasks, fcn, NULL, op.jump, sp);
-						rz_analysis_task_item_new(analysis, tasks, fcn, NULL, op.addr + op.size, sp);
+						rz_analysis_task_item_add(analysis, tasks, pending, fcn, NULL, op.jump, sp);
+						rz_analysis_task_item_add(analysis, tasks, pending, fcn, NULL, op.addr + op.size, sp);
 						if (!overlapped) {
 							set_bb_branches(bb, op.jump, op.addr + op.size);
 						}
@@ -1088,9 +1116,9 @@ static RzAnalysisBBEndCause run_basic_block_analysis(RzAnalysisTaskItem *item, R
 			if (!overlapped) {
 				set_bb_branches(bb, op.jump, UT64_MAX);
 			}
-			rz_analysis_task_item_new(analysis, tasks, fcn, NULL, op.jump, sp);
+			rz_analysis_task_item_add(analysis, tasks, pending, fcn, NULL, op.jump, sp);
 			if (continue_after_jump && (is_hexagon || (is_dalvik && op.cond == RZ_TYPE_COND_EXCEPTION))) {
-				rz_analysis_task_item_new(analysis, tasks, fcn, NULL, op.addr + op.size, sp);
+				rz_analysis_task_item_add(analysis, tasks, pending, fcn, NULL, op.addr + op.size, sp);
 				gotoBeach(RZ_ANALYSIS_RET_BRANCH);
 			}
 			int tc = analysis->opt.tailcall;
@@ -1100,11 +1128,11 @@ static RzAnalysisBBEndCause run_basic_block_analysis(RzAnalysisTaskItem *item, R
 					ut8 buf[32];
 					(void)analysis->iob.read_at(analysis->iob.io, op.jump, (ut8 *)buf, sizeof(buf));
 					if (rz_analysis_is_prelude(analysis, buf, sizeof(buf))) {
-						rz_analysis_task_item_new(analysis, tasks, fcn, NULL, op.jump, sp);
+						rz_analysis_task_item_add(analysis, tasks, pending, fcn, NULL, op.jump, sp);
 					}
 				} else if (RZ_ABS(diff) > tc) {
 					(void)rz_analysis_xrefs_set(analysis, op.addr, op.jump, RZ_ANALYSIS_XREF_TYPE_CALL);
-					rz_analysis_task_item_new(analysis, tasks, fcn, NULL, op.jump, sp);
+					rz_analysis_task_item_add(analysis, tasks, pending, fcn, NULL, op.jump, sp);
 					gotoBeach(RZ_ANALYSIS_RET_END);
 				}
 			}
@@ -1140,7 +1168,7 @@ static RzAnalysisBBEndCause run_basic_block_analysis(RzAnalysisTaskItem *item, R
 					rz_analysis_xrefs_set(analysis, op.addr, op.fail, RZ_ANALYSIS_XREF_TYPE_CODE);
 				}
 				if (continue_after_jump) {
-					rz_analysis_task_item_new(analysis, tasks, fcn, NULL, op.addr + op.size, sp);
+					rz_analysis_task_item_add(analysis, tasks, pending, fcn, NULL, op.addr + op.size, sp);
 				}
 				if (!overlapped) {
 					// If it is an endloop01 instruction the jump to the inner loop is not added yet.
@@ -1173,7 +1201,8 @@ static RzAnalysisBBEndCause run_basic_block_analysis(RzAnalysisTaskItem *item, R
 							.jmptbl_off = op.ptr,
 							.default_case = op.fail,
 							.sp = sp,
-							.tasks = tasks
+							.tasks = tasks,
+							.pending = pending
 						};
 						if (op.ireg) {
 							rz_analysis_walkthrough_jmptbl(analysis, fcn, bb, &params);
@@ -1191,13 +1220,13 @@ static RzAnalysisBBEndCause run_basic_block_analysis(RzAnalysisTaskItem *item, R
 					}
 				}
 			}
-			rz_analysis_task_item_new(analysis, tasks, fcn, NULL, op.fail, sp);
-			rz_analysis_task_item_new(analysis, tasks, fcn, NULL, op.jump, sp);
+			rz_analysis_task_item_add(analysis, tasks, pending, fcn, NULL, op.fail, sp);
+			rz_analysis_task_item_add(analysis, tasks, pending, fcn, NULL, op.jump, sp);
 			if (continue_after_jump && is_hexagon) {
 				if (op.type == RZ_ANALYSIS_OP_TYPE_RCJMP) {
 					break;
 				}
-				rz_analysis_task_item_new(analysis, tasks, fcn, NULL, op.addr + op.size, sp);
+				rz_analysis_task_item_add(analysis, tasks, pending, fcn, NULL, op.addr + op.size, sp);
 				gotoBeach(RZ_ANALYSIS_RET_BRANCH);
 			}
 			if (!continue_after_jump) {
@@ -1283,7 +1312,8 @@ static RzAnalysisBBEndCause run_basic_block_analysis(RzAnalysisTaskItem *item, R
 					.jmptbl_loc = op.ptr,
 					.jmptbl_off = op.ptr,
 					.sp = sp,
-					.tasks = tasks
+					.tasks = tasks,
+					.pending = pending
 				};
 				// op.ireg since rip relative addressing produces way too many false positives otherwise
 				// op.ireg is 0 for rip relative, "rax", etc otherwise
@@ -1375,8 +1405,8 @@ static RzAnalysisBBEndCause run_basic_block_analysis(RzAnalysisTaskItem *item, R
 			}
 			if (analysis->opt.ijmp) {
 				if (continue_after_jump) {
-					rz_analysis_task_item_new(analysis, tasks, fcn, NULL, op.fail, sp);
-					rz_analysis_task_item_new(analysis, tasks, fcn, NULL, op.jump, sp);
+					rz_analysis_task_item_add(analysis, tasks, pending, fcn, NULL, op.fail, sp);
+					rz_analysis_task_item_add(analysis, tasks, pending, fcn, NULL, op.jump, sp);
 					if (overlapped) {
 						goto analopfinish;
 					}
@@ -1417,7 +1447,7 @@ static RzAnalysisBBEndCause run_basic_block_analysis(RzAnalysisTaskItem *item, R
 				op.type = RZ_ANALYSIS_OP_TYPE_JMP;
 				op.jump = last_push_addr;
 				bb->jump = op.jump;
-				rz_analysis_task_item_new(analysis, tasks, fcn, NULL, op.jump, sp);
+				rz_analysis_task_item_add(analysis, tasks, pending, fcn, NULL, op.jump, sp);
 				goto beach;
 			}
 			if (!op.cond) {
@@ -1429,7 +1459,7 @@ static RzAnalysisBBEndCause run_basic_block_analysis(RzAnalysisTaskItem *item, R
 			break;
 		case RZ_ANALYSIS_OP_TYPE_CRET:
 			if (continue_after_jump && is_hexagon) {
-				rz_analysis_task_item_new(analysis, tasks, fcn, NULL, op.addr + op.size, sp);
+				rz_analysis_task_item_add(analysis, tasks, pending, fcn, NULL, op.addr + op.size, sp);
 				set_bb_branches(bb, op.addr + op.size, UT64_MAX);
 				gotoBeach(RZ_ANALYSIS_RET_COND);
 			}
@@ -1476,6 +1506,7 @@ beach:
  *
  * Used to create a new item to the `tasks` parameter
  * that can be worked on later by the `rz_analysis_run_tasks` function.
+ * Nothing is added when a task starting at \p address is already pending.
  *
  * \param analysis Pointer to RzAnalysis instance.
  * \param tasks Pointer to RzVector to add a new RzAnalysisTaskItem to.
@@ -1486,14 +1517,7 @@ beach:
  */
 RZ_API bool rz_analysis_task_item_new(RZ_NONNULL RzAnalysis *analysis, RZ_NONNULL RzVector /*<RzAnalysisTaskItem>*/ *tasks, RZ_NONNULL RzAnalysisFunction *fcn, RZ_NULLABLE RzAnalysisBlock *block, ut64 address, RzStackAddr sp) {
 	rz_return_val_if_fail(analysis && tasks && fcn, false);
-	RzAnalysisTaskItem item = { fcn, block, sp, address };
-	RzAnalysisTaskItem *it;
-	rz_vector_foreach(tasks, it) {
-		if (item.start_address == it->start_address) {
-			return true;
-		}
-	}
-	return rz_vector_push(tasks, &item);
+	return rz_analysis_task_item_add(analysis, tasks, NULL, fcn, block, address, sp);
 }
 
 /**
@@ -1508,10 +1532,24 @@ RZ_API bool rz_analysis_task_item_new(RZ_NONNULL RzAnalysis *analysis, RZ_NONNUL
 RZ_API int rz_analysis_run_tasks(RZ_NONNULL RzVector /*<RzAnalysisTaskItem>*/ *tasks) {
 	rz_return_val_if_fail(tasks, RZ_ANALYSIS_RET_ERROR);
 	int ret = RZ_ANALYSIS_RET_ERROR;
+	if (rz_vector_empty(tasks)) {
+		return ret;
+	}
+	// start addresses of the pending items, so new items are deduplicated without scanning tasks
+	SetU *pending = set_u_new();
+	if (pending) {
+		RzAnalysisTaskItem *it;
+		rz_vector_foreach(tasks, it) {
+			set_u_add(pending, it->start_address);
+		}
+	}
 	while (!rz_vector_empty(tasks)) {
 		RzAnalysisTaskItem item;
 		rz_vector_pop(tasks, &item);
-		int r = run_basic_block_analysis(&item, tasks);
+		if (pending) {
+			set_u_delete(pending, item.start_address);
+		}
+		int r = run_basic_block_analysis(&item, tasks, pending);
 		switch (r) {
 		case RZ_ANALYSIS_RET_BRANCH:
 		case RZ_ANALYSIS_RET_COND:
@@ -1531,6 +1569,7 @@ RZ_API int rz_analysis_run_tasks(RZ_NONNULL RzVector /*<RzAnalysisTaskItem>*/ *t
 			break;
 		}
 	}
+	set_u_free(pending);
 	return ret;
 }
 
@@ -2293,7 +2332,7 @@ static void update_analysis(RzAnalysis *analysis, RzList /*<RzAnalysisFunction *
 	RzAnalysisFunction *fcn;
 	bool old_jmpmid = analysis->opt.jmpmid;
 	analysis->opt.jmpmid = true;
-	rz_analysis_fcn_invalidate_read_ahead_cache();
+	rz_analysis_fcn_invalidate_read_ahead_cache(analysis);
 	rz_list_foreach (fcns, it, fcn) {
 		// Recurse through blocks of function, mark reachable,
 		// analyze edges that don't have a block
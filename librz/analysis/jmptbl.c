@@ -12,6 +12,8 @@
 #define aprintf(format, ...) \
 	RZ_LOG_DEBUG(format, __VA_ARGS__)
 
+RZ_IPI bool rz_analysis_task_item_add(RzAnalysis *analysis, RzVector /*<RzAnalysisTaskItem>*/ *tasks, RZ_NULLABLE SetU *pending, RzAnalysisFunction *fcn, RzAnalysisBlock *block, ut64 address, RzStackAddr sp);
+
 static void apply_case(RzAnalysis *analysis, RzAnalysisBlock *block, ut64 switch_addr, ut64 offset_sz, ut64 case_addr, ut64 id, ut64 case_addr_loc) {
 	// eprintf ("** apply_case: 0x%"PFMT64x " from 0x%"PFMT64x "\n", case_addr, case_addr_loc);
 	rz_meta_set_data_at(analysis, case_addr_loc, offset_sz);
@@ -148,7 +150,7 @@ RZ_API bool rz_analysis_walkthrough_casetbl(RZ_NONNULL RzAnalysis *analysis, RZ_
 		rz_analysis_hint_set_immbase(analysis, jmpptr_idx_off, 10);
 
 		apply_case(analysis, block, params->jmp_address, params->entry_size, jmpptr, case_idx + params->case_shift, params->jmptbl_loc + jmpptr_idx * params->entry_size);
-		rz_analysis_task_item_new(analysis, params->tasks, fcn, NULL, jmpptr, params->sp);
+		rz_analysis_task_item_add(analysis, params->tasks, params->pending, fcn, NULL, jmpptr, params->sp);
 	}
 
 	if (case_idx > 0) {
@@ -239,7 +241,7 @@ RZ_API bool rz_analysis_walkthrough_jmptbl(RZ_NONNULL RzAnalysis *analysis, RZ_N
 			}
 		}
 		apply_case(analysis, block, params->jmp_address, params->entry_size, jmpptr, (offs / params->entry_size) + params->case_shift, params->jmptbl_loc + offs);
-		rz_analysis_task_item_new(analysis, params->tasks, fcn, NULL, jmpptr, params->sp);
+		rz_analysis_task_item_add(analysis, params->tasks, params->pending, fcn, NULL, jmpptr, params->sp);
 	}
 
 	if (offs > 0) {
@@ -418,7 +420,7 @@ RZ_API bool rz_analysis_walkthrough_arm_jmptbl_style(RZ_NONNULL RzAnalysis *anal
 	for (offs = 0; offs + params->entry_size - 1 < params->table_count * params->entry_size; offs += params->entry_size) {
 		jmpptr = params->jmptbl_loc + offs;
 		apply_case(analysis, block, params->jmp_address, params->entry_size, jmpptr, offs / params->entry_size, params->jmptbl_loc + offs);
-		rz_analysis_task_item_new(analysis, params->tasks, fcn, NULL, jmpptr, params->sp);
+		rz_analysis_task_item_add(analysis, params->tasks, params->pending, fcn, NULL, jmpptr, params->sp);
 	}
 
 	if (offs > 0) {
@@ -111,7 +111,15 @@ RZ_API int rz_analysis_op(RzAnalysis *analysis, RzAnalysisOp *op, ut64 addr, con
 			op->size = 1;
 			return -1;
 		}
-		ret = analysis->cur->op(analysis, op, addr, data, len, mask);
+		if (analysis->opcache && analysis->reg) {
+			rz_analysis_op_cache_sync_reg(analysis->opcache, analysis->reg);
+		}
+		if (!analysis->opcache || !rz_analysis_op_cache_get(analysis->opcache, op, addr, data, len, analysis->bits, mask, &ret)) {
+			ret = analysis->cur->op(analysis, op, addr, data, len, mask);
+			if (analysis->opcache) {
+				rz_analysis_op_cache_set(analysis->opcache, op, addr, data, len, analysis->bits, mask, ret);
+			}
+		}
 		if (ret < 1) {
 			op->type = RZ_ANALYSIS_OP_TYPE_ILL;
 		}
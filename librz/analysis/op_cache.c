@@ -0,0 +1,233 @@
+// SPDX-FileCopyrightText: 2023 RizinOrg <info@rizin.re>
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#include <rz_analysis.h>
+
+/*
+ * Decoded instructions cache.
+ *
+ * Each entry holds the RzAnalysisOp produced by the arch plugin for an
+ * address, together with the bytes, the bits and the mask it has been
+ * decoded with. An entry is used only when all of them match, thus writes
+ * to the decoded bytes never return stale results. Any change that can
+ * alter the decoding of the same bytes (plugin, cpu, bits, endianness or
+ * register profile) flushes the whole cache. Cached values borrow the
+ * RzRegItem of analysis->reg, so the cache is also flushed when
+ * rz_analysis_op_cache_sync_reg() sees that these items have been freed,
+ * whatever function changed the register profile.
+ *
+ * The cache is direct-mapped by address, so it never grows beyond
+ * RZ_ANALYSIS_OP_CACHE_SIZE entries.
+ */
+
+#define OP_CACHE_BYTES 32
+
+typedef struct {
+	ut64 addr;
+	RzAnalysisOpMask mask;
+	int bits;
+	int len; ///< number of valid bytes in `bytes`
+	int ret; ///< value returned by the plugin
+	ut8 bytes[OP_CACHE_BYTES];
+	RzAnalysisOp op;
+	bool used;
+} OpCacheEntry;
+
+struct rz_analysis_op_cache_t {
+	OpCacheEntry entries[RZ_ANALYSIS_OP_CACHE_SIZE];
+	ut64 hits;
+	ut64 misses;
+	ut32 reg_generation; ///< RzReg.generation of the register items borrowed by the cached ops
+};
+
+static inline OpCacheEntry *cache_entry(RzAnalysisOpCache *cache, ut64 addr) {
+	return &cache->entries[(addr ^ (addr >> 12)) % RZ_ANALYSIS_OP_CACHE_SIZE];
+}
+
+static void entry_fini(OpCacheEntry *e) {
+	if (e->used) {
+		rz_analysis_op_fini(&e->op);
+		e->used = false;
+	}
+}
+
+/**
+ * Copies all the data of \p src that is owned by the op into \p dst.
+ * \p dst must be initialized with rz_analysis_op_init().
+ */
+static bool op_copy(RzAnalysisOp *dst, const RzAnalysisOp *src) {
+	*dst = *src;
+	dst->mnemonic = NULL;
+	dst->src[0] = dst->src[1] = dst->src[2] = NULL;
+	dst->dst = NULL;
+	dst->access = NULL;
+	rz_strbuf_init(&dst->esil);
+	rz_strbuf_init(&dst->opex);
+	if (src->mnemonic && !(dst->mnemonic = strdup(src->mnemonic))) {
+		goto fail;
+	}
+	for (size_t i = 0; i < RZ_ARRAY_SIZE(src->src); i++) {
+		if (src->src[i] && !(dst->src[i] = rz_analysis_value_copy(src->src[i]))) {
+			goto fail;
+		}
+	}
+	if (src->dst && !(dst->dst = rz_analysis_value_copy(src->dst))) {
+		goto fail;
+	}
+	if (src->access) {
+		dst->access = rz_list_newf((RzListFree)rz_analysis_value_free);
+		if (!dst->access) {
+			goto fail;
+		}
+		RzListIter *it;
+		RzAnalysisValue *val;
+		rz_list_foreach (src->access, it, val) {
+			RzAnalysisValue *nval = rz_analysis_value_copy(val);
+			if (!nval || !rz_list_append(dst->access, nval)) {
+				rz_analysis_value_free(nval);
+				goto fail;
+			}
+		}
+	}
+	if (!rz_strbuf_copy(&dst->esil, (RzStrBuf *)&src->esil) ||
+		!rz_strbuf_copy(&dst->opex, (RzStrBuf *)&src->opex)) {
+		goto fail;
+	}
+	return true;
+
+fail:
+	rz_analysis_op_fini(dst);
+	return false;
+}
+
+static bool op_is_cacheable(const RzAnalysisOp *op, int ret) {
+	// the IL and the switch ops cannot be copied, so these ops are never cached
+	return ret > 0 && ret <= OP_CACHE_BYTES && !op->il_op && !op->switch_op;
+}
+
+/**
+ * \brief Creates a new empty decoded instructions cache
+ */
+RZ_API RZ_OWN RzAnalysisOpCache *rz_analysis_op_cache_new(void) {
+	return RZ_NEW0(RzAnalysisOpCache);
+}
+
+/**
+ * \brief Frees the decoded instructions cache and all the cached ops
+ */
+RZ_API void rz_analysis_op_cache_free(RZ_NULLABLE RzAnalysisOpCache *cache) {
+	if (!cache) {
+		return;
+	}
+	rz_analysis_op_cache_flush(cache);
+	free(cache);
+}
+
+/**
+ * \brief Removes all the cached ops
+ */
+RZ_API void rz_analysis_op_cache_flush(RZ_NULLABLE RzAnalysisOpCache *cache) {
+	if (!cache) {
+		return;
+	}
+	for (size_t i = 0; i < RZ_ANALYSIS_OP_CACHE_SIZE; i++) {
+		entry_fini(&cache->entries[i]);
+	}
+}
+
+/**
+ * \brief Flushes the cache if the register items referenced by the cached
+ * ops have been freed since they were cached.
+ *
+ * Must be called before rz_analysis_op_cache_get() with the RzReg the ops
+ * are decoded with.
+ */
+RZ_API void rz_analysis_op_cache_sync_reg(RZ_NONNULL RzAnalysisOpCache *cache, RZ_NONNULL RzReg *reg) {
+	rz_return_if_fail(cache && reg);
+	if (cache->reg_generation != reg->generation) {
+		rz_analysis_op_cache_flush(cache);
+		cache->reg_generation = reg->generation;
+	}
+}
+
+/**
+ * \brief Looks for an op previously decoded at \p addr from the same bytes.
+ *
+ * \param cache The decoded instructions cache
+ * \param op Initialized op that is filled with a copy of the cached one on hit
+ * \param addr Address of the instruction
+ * \param data Bytes of the instruction
+ * \param len Size of \p data
+ * \param bits Bits the instruction is decoded with
+ * \param mask Mask passed to the plugin
+ * \param ret Set to the value returned by the plugin on hit
+ * \return true on cache hit
+ */
+RZ_API bool rz_analysis_op_cache_get(RZ_NONNULL RzAnalysisOpCache *cache, RZ_NONNULL RZ_OUT RzAnalysisOp *op, ut64 addr, RZ_NONNULL const ut8 *data, int len, int bits, RzAnalysisOpMask mask, RZ_NONNULL RZ_OUT int *ret) {
+	rz_return_val_if_fail(cache && op && data && ret, false);
+	OpCacheEntry *e = cache_entry(cache, addr);
+	int blen = RZ_MIN(len, OP_CACHE_BYTES);
+	if (!e->used || e->addr != addr || e->bits != bits || e->mask != mask ||
+		e->len != blen || memcmp(e->bytes, data, blen) ||
+		!op_copy(op, &e->op)) {
+		cache->misses++;
+		return false;
+	}
+	cache->hits++;
+	*ret = e->ret;
+	return true;
+}
+
+/**
+ * \brief Stores a copy of the op just decoded by the plugin.
+ *
+ * Ops whose size exceeds the number of bytes kept per entry, ops holding
+ * an IL effect or a switch op and invalid ops are not cached.
+ */
+RZ_API void rz_analysis_op_cache_set(RZ_NONNULL RzAnalysisOpCache *cache, RZ_NONNULL const RzAnalysisOp *op, ut64 addr, RZ_NONNULL const ut8 *data, int len, int bits, RzAnalysisOpMask mask, int ret) {
+	rz_return_if_fail(cache && op && data);
+	if (!op_is_cacheable(op, ret)) {
+		return;
+	}
+	OpCacheEntry *e = cache_entry(cache, addr);
+	entry_fini(e);
+	if (!op_copy(&e->op, op)) {
+		return;
+	}
+	e->addr = addr;
+	e->bits = bits;
+	e->mask = mask;
+	e->len = RZ_MIN(len, OP_CACHE_BYTES);
+	e->ret = ret;
+	memcpy(e->bytes, data, e->len);
+	e->used = true;
+}
+
+/**
+ * \brief Returns the number of hits and misses of the cache since its creation
+ */
+RZ_API void rz_analysis_op_cache_stats(RZ_NONNULL RzAnalysisOpCache *cache, RZ_NULLABLE RZ_OUT ut64 *hits, RZ_NULLABLE RZ_OUT ut64 *misses) {
+	rz_return_if_fail(cache);
+	if (hits) {
+		*hits = cache->hits;
+	}
+	if (misses) {
+		*misses = cache->misses;
+	}
+}
+
+/**
+ * \brief Enables or disables the decoded instructions cache of \p analysis
+ */
+RZ_API bool rz_analysis_op_cache_enable(RZ_NONNULL RzAnalysis *analysis, bool enable) {
+	rz_return_val_if_fail(analysis, false);
+	if (!enable) {
+		rz_analysis_op_cache_free(analysis->opcache);
+		analysis->opcache = NULL;
+		return true;
+	}
+	if (!analysis->opcache) {
+		analysis->opcache = rz_analysis_op_cache_new();
+	}
+	return analysis->opcache != NULL;
+}
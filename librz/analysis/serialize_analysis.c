@@ -1202,11 +1202,12 @@ RZ_API bool rz_serialize_analysis_function_noreturn_load(RZ_NONNULL Sdb *db, RZ_
 }
 
 static bool store_xref_cb(void *j, const ut64 k, const void *v) {
-	const RzAnalysisXRef *xref = v;
+	// the values of the inner xrefs tables are the xref types
+	RzAnalysisXRefType xref_type = (RzAnalysisXRefType)(size_t)v;
 	pj_o(j);
 	pj_kn(j, "to", k);
-	if (xref->type != RZ_ANALYSIS_XREF_TYPE_NULL) {
-		char type[2] = { xref->type, '\0' };
+	if (xref_type != RZ_ANALYSIS_XREF_TYPE_NULL) {
+		char type[2] = { xref_type, '\0' };
 		pj_ks(j, "type", type);
 	}
 	pj_end(j);
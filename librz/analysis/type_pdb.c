@@ -805,6 +805,10 @@ RZ_API void rz_parse_pdb_types(const RzTypeDB *typedb, const RzPdb *pdb) {
 	if (!stream) { // no TPI stream found
 		return;
 	}
+	if (!rz_bin_pdb_load_all_types(pdb)) {
+		RZ_LOG_ERROR("%s : Error parsing the TPI stream\n", __FUNCTION__);
+		return;
+	}
 
 	stream->print_type = rz_list_new();
 	if (!stream->print_type) {
@@ -21,6 +21,15 @@ refs 10->20 C 16->10 J 20->10 C
 // XXX: is it possible to have multiple type for the same (from, to) pair?
 //      if it is, things need to be adjusted
 
+/*
+ * Both RzAnalysis::ht_xrefs_from and RzAnalysis::ht_xrefs_to map an address
+ * to an inner HtUP which maps the other end of the reference to its type.
+ * The type is stored directly as the value of the inner table, so no
+ * RzAnalysisXRef is allocated per reference.
+ */
+#define XREF_TYPE_TO_VALUE(t) ((void *)(size_t)(t))
+#define XREF_VALUE_TO_TYPE(v) ((RzAnalysisXRefType)(size_t)(v))
+
 static RzAnalysisXRef *rz_analysis_xref_new(ut64 from, ut64 to, ut64 type) {
 	RzAnalysisXRef *xref = RZ_NEW(RzAnalysisXRef);
 	if (xref) {
@@ -31,10 +40,6 @@ static RzAnalysisXRef *rz_analysis_xref_new(ut64 from, ut64 to, ut64 type) {
 	return xref;
 }
 
-static void rz_analysis_xref_free(RzAnalysisXRef *xref) {
-	free(xref);
-}
-
 RZ_API RZ_OWN RzList /*<RzAnalysisXRef *>*/ *rz_analysis_xref_list_new() {
 	return rz_list_newf((RzListFree)free);
 }
@@ -43,24 +48,28 @@ static void xrefs_ht_free(HtUPKv *kv) {
 	ht_up_free(kv->value);
 }
 
-static void xrefs_ref_free(HtUPKv *kv) {
-	rz_analysis_xref_free(kv->value);
-}
+typedef struct {
+	ut64 addr;
+	bool from2to;
+	RzList /*<RzAnalysisXRef *>*/ *list;
+} ListXRefsCtx;
 
 static bool appendRef(void *u, const ut64 k, const void *v) {
-	RzList *list = (RzList *)u;
-	RzAnalysisXRef *xref = (RzAnalysisXRef *)v;
-	RzAnalysisXRef *cloned = rz_analysis_xref_new(xref->from, xref->to, xref->type);
-	if (cloned) {
-		rz_list_append(list, cloned);
+	ListXRefsCtx *ctx = u;
+	ut64 from = ctx->from2to ? ctx->addr : k;
+	ut64 to = ctx->from2to ? k : ctx->addr;
+	RzAnalysisXRef *xref = rz_analysis_xref_new(from, to, XREF_VALUE_TO_TYPE(v));
+	if (xref) {
+		rz_list_append(ctx->list, xref);
 		return true;
 	}
 	return false;
 }
 
-static bool mylistrefs_cb(void *list, const ut64 k, const void *v) {
-	HtUP *ht = (HtUP *)v;
-	ht_up_foreach(ht, appendRef, list);
+static bool mylistrefs_cb(void *u, const ut64 k, const void *v) {
+	ListXRefsCtx *ctx = u;
+	ctx->addr = k;
+	ht_up_foreach((HtUP *)v, appendRef, ctx);
 	return true;
 }
 
@@ -84,33 +93,31 @@ static void sortxrefs(RzList /*<RzAnalysisXRef *>*/ *list) {
 	rz_list_sort(list, (RzListComparator)ref_cmp);
 }
 
-static void listxrefs(HtUP *m, ut64 addr, RzList /*<RzAnalysisXRef *>*/ *list) {
+static void listxrefs(HtUP *m, bool from2to, ut64 addr, RzList /*<RzAnalysisXRef *>*/ *list) {
+	ListXRefsCtx ctx = { addr, from2to, list };
 	if (addr == UT64_MAX) {
-		ht_up_foreach(m, mylistrefs_cb, list);
+		ht_up_foreach(m, mylistrefs_cb, &ctx);
 	} else {
 		HtUP *d = ht_up_find(m, addr, NULL);
 		if (d) {
-			ht_up_foreach(d, appendRef, list);
+			ht_up_foreach(d, appendRef, &ctx);
 		}
 	}
 }
 
-static bool set_xref(HtUP *m, RzAnalysisXRef *xref, bool from2to) {
-	ut64 key1 = from2to ? xref->from : xref->to;
+static bool set_xref(HtUP *m, ut64 key1, ut64 key2, RzAnalysisXRefType type) {
 	HtUP *ht = ht_up_find(m, key1, NULL);
 	if (!ht) {
-		// RzAnalysis::ht_xrefs_to is responsible for releasing of pointers.
-		HtUPKvFreeFunc cb = from2to ? NULL : xrefs_ref_free;
-		ht = ht_up_new(NULL, cb, NULL);
+		ht = ht_up_new(NULL, NULL, NULL);
 		if (!ht) {
 			return false;
 		}
 		if (!ht_up_insert(m, key1, ht)) {
+			ht_up_free(ht);
 			return false;
 		}
 	}
-	ut64 key2 = from2to ? xref->to : xref->from;
-	return ht_up_update(ht, key2, xref);
+	return ht_up_update(ht, key2, XREF_TYPE_TO_VALUE(type));
 }
 
 // Set a cross reference from FROM to TO.
@@ -126,20 +133,15 @@ RZ_API bool rz_analysis_xrefs_set(RzAnalysis *analysis, ut64 from, ut64 to, RzAn
 			return false;
 		}
 	}
-	RzAnalysisXRef *xref = rz_analysis_xref_new(from, to, type);
-	if (!xref) {
-		return false;
+	if (type == -1) {
+		type = RZ_ANALYSIS_XREF_TYPE_CODE;
 	}
-	if (!set_xref(analysis->ht_xrefs_from, xref, true)) {
-		// Pointer isn't added to <ht_xrefs_from> so we have to release it
-		rz_analysis_xref_free(xref);
+	if (!set_xref(analysis->ht_xrefs_from, from, to, type)) {
 		return false;
 	}
-	if (!set_xref(analysis->ht_xrefs_to, xref, false)) {
+	if (!set_xref(analysis->ht_xrefs_to, to, from, type)) {
 		// Delete the entry in <ht_xrefs_from>
 		rz_analysis_xrefs_deln(analysis, from, to, type);
-		// Pointer isn't added to <ht_xrefs_to> so we have to release it
-		rz_analysis_xref_free(xref);
 		return false;
 	}
 	return true;
@@ -175,7 +177,7 @@ RZ_API RZ_OWN RzList /*<RzAnalysisXRef *>*/ *rz_analysis_xrefs_get_to(RzAnalysis
 	if (!list) {
 		return NULL;
 	}
-	listxrefs(analysis->ht_xrefs_to, addr, list);
+	listxrefs(analysis->ht_xrefs_to, false, addr, list);
 	sortxrefs(list);
 	if (rz_list_empty(list)) {
 		rz_list_free(list);
@@ -189,7 +191,7 @@ RZ_API RZ_OWN RzList /*<RzAnalysisXRef *>*/ *rz_analysis_xrefs_get_from(RzAnalys
 	if (!list) {
 		return NULL;
 	}
-	listxrefs(analysis->ht_xrefs_from, addr, list);
+	listxrefs(analysis->ht_xrefs_from, true, addr, list);
 	sortxrefs(list);
 	if (rz_list_empty(list)) {
 		rz_list_free(list);
@@ -207,7 +209,7 @@ RZ_API RZ_OWN RzList /*<RzAnalysisXRef *>*/ *rz_analysis_xrefs_list(RzAnalysis *
 	rz_return_val_if_fail(analysis, NULL);
 	RzList *list = rz_analysis_xref_list_new();
 	if (list) {
-		listxrefs(analysis->ht_xrefs_from, UT64_MAX, list);
+		listxrefs(analysis->ht_xrefs_from, true, UT64_MAX, list);
 		sortxrefs(list);
 	}
 	return list;
@@ -275,7 +277,93 @@ RZ_API ut64 rz_analysis_xrefs_count(RzAnalysis *analysis) {
 	return ret;
 }
 
-static RZ_OWN RzList /*<RzAnalysisXRef *>*/ *fcn_get_refs(RzAnalysisFunction *fcn, HtUP *ht) {
+typedef struct {
+	RzAnalysisXRefCb cb;
+	void *user;
+	RzAnalysisXRef xref;
+	bool stop;
+} ForeachXRefsCtx;
+
+static bool foreach_xref_cb(void *u, const ut64 k, const void *v) {
+	ForeachXRefsCtx *ctx = u;
+	ctx->xref.from = k;
+	ctx->xref.type = XREF_VALUE_TO_TYPE(v);
+	if (!ctx->cb(&ctx->xref, ctx->user)) {
+		ctx->stop = true;
+		return false;
+	}
+	return true;
+}
+
+static bool foreach_xrefs_to_cb(void *u, const ut64 k, const void *v) {
+	ForeachXRefsCtx *ctx = u;
+	ctx->xref.to = k;
+	ht_up_foreach((HtUP *)v, foreach_xref_cb, ctx);
+	return !ctx->stop;
+}
+
+/**
+ * \brief Calls \p cb for each xref without allocating them.
+ *
+ * The xrefs are visited grouped by their destination address.
+ * The RzAnalysisXRef passed to \p cb is only valid during the call.
+ *
+ * \param analysis RzAnalysis instance
+ * \param cb Callback to call, return false to stop the iteration
+ * \param user User data passed to \p cb
+ */
+RZ_API void rz_analysis_xrefs_foreach(RZ_NONNULL RzAnalysis *analysis, RZ_NONNULL RzAnalysisXRefCb cb, RZ_NULLABLE void *user) {
+	rz_return_if_fail(analysis && cb);
+	ForeachXRefsCtx ctx = { cb, user, { 0 }, false };
+	ht_up_foreach(analysis->ht_xrefs_to, foreach_xrefs_to_cb, &ctx);
+}
+
+typedef struct {
+	RzAnalysis *analysis;
+	ut64 diff;
+	ut64 from;
+} RebaseXRefsCtx;
+
+static bool rebase_xref_cb(void *user, const ut64 k, const void *v) {
+	RebaseXRefsCtx *ctx = user;
+	rz_analysis_xrefs_set(ctx->analysis, ctx->from + ctx->diff, k + ctx->diff, XREF_VALUE_TO_TYPE(v));
+	return true;
+}
+
+static bool rebase_xrefs_from_cb(void *user, const ut64 k, const void *v) {
+	RebaseXRefsCtx *ctx = user;
+	ctx->from = k;
+	ht_up_foreach((HtUP *)v, rebase_xref_cb, ctx);
+	return true;
+}
+
+/**
+ * \brief Move both ends of all the xrefs by \p diff
+ *
+ * The xrefs are moved from the old tables to new ones without building
+ * any RzAnalysisXRef.
+ */
+RZ_API void rz_analysis_xrefs_rebase(RZ_NONNULL RzAnalysis *analysis, ut64 diff) {
+	rz_return_if_fail(analysis);
+	if (!diff) {
+		return;
+	}
+	HtUP *xrefs_from = analysis->ht_xrefs_from;
+	HtUP *xrefs_to = analysis->ht_xrefs_to;
+	analysis->ht_xrefs_from = NULL;
+	analysis->ht_xrefs_to = NULL;
+	if (!rz_analysis_xrefs_init(analysis)) {
+		analysis->ht_xrefs_from = xrefs_from;
+		analysis->ht_xrefs_to = xrefs_to;
+		return;
+	}
+	RebaseXRefsCtx ctx = { analysis, diff, 0 };
+	ht_up_foreach(xrefs_from, rebase_xrefs_from_cb, &ctx);
+	ht_up_free(xrefs_from);
+	ht_up_free(xrefs_to);
+}
+
+static RZ_OWN RzList /*<RzAnalysisXRef *>*/ *fcn_get_refs(RzAnalysisFunction *fcn, HtUP *ht, bool from2to) {
 	RzListIter *iter;
 	RzAnalysisBlock *bb;
 	RzList *list = rz_analysis_xref_list_new();
@@ -287,7 +375,7 @@ static RZ_OWN RzList /*<RzAnalysisXRef *>*/ *fcn_get_refs(RzAnalysisFunction *fc
 
 		for (i = 0; i < bb->ninstr; i++) {
 			ut64 at = bb->addr + rz_analysis_block_get_op_offset(bb, i);
-			listxrefs(ht, at, list);
+			listxrefs(ht, from2to, at, list);
 		}
 	}
 	sortxrefs(list);
@@ -296,12 +384,12 @@ static RZ_OWN RzList /*<RzAnalysisXRef *>*/ *fcn_get_refs(RzAnalysisFunction *fc
 
 RZ_API RZ_OWN RzList /*<RzAnalysisXRef *>*/ *rz_analysis_function_get_xrefs_from(RzAnalysisFunction *fcn) {
 	rz_return_val_if_fail(fcn, NULL);
-	return fcn_get_refs(fcn, fcn->analysis->ht_xrefs_from);
+	return fcn_get_refs(fcn, fcn->analysis->ht_xrefs_from, true);
 }
 
 RZ_API RZ_OWN RzList /*<RzAnalysisXRef *>*/ *rz_analysis_function_get_xrefs_to(RzAnalysisFunction *fcn) {
 	rz_return_val_if_fail(fcn, NULL);
-	return fcn_get_refs(fcn, fcn->analysis->ht_xrefs_to);
+	return fcn_get_refs(fcn, fcn->analysis->ht_xrefs_to, false);
 }
 
 RZ_API const char *rz_analysis_ref_type_tostring(RzAnalysisXRefType t) {
@@ -237,9 +237,6 @@ RZ_API RzBinFile *rz_bin_reload(RzBin *bin, RzBinFile *bf, ut64 baseaddr) {
 RZ_API RzBinFile *rz_bin_open_buf(RzBin *bin, RzBuffer *buf, RzBinOptions *opt) {
 	rz_return_val_if_fail(bin && opt, NULL);
 
-	RzListIter *it;
-	RzBinXtrPlugin *xtr;
-
 	bin->file = opt->filename;
 	if (opt->obj_opts.loadaddr == UT64_MAX) {
 		opt->obj_opts.loadaddr = 0;
@@ -250,7 +247,15 @@ RZ_API RzBinFile *rz_bin_open_buf(RzBin *bin, RzBuffer *buf, RzBinOptions *opt)
 		// XXX - for the time being this is fine, but we may want to
 		// change the name to something like
 		// <xtr_name>:<bin_type_name>
-		rz_list_foreach (bin->binxtrs, it, xtr) {
+		ut8 header[RZ_BIN_MAGIC_SIZE];
+		size_t header_size = rz_bin_probe_read_header(buf, header);
+		void **it;
+		rz_pvector_foreach (rz_bin_probe_candidates(bin->xtr_probe, header, header_size), it) {
+			RzBinProbeEntry *entry = *it;
+			if (!rz_bin_probe_entry_match(entry, header, header_size)) {
+				continue;
+			}
+			RzBinXtrPlugin *xtr = entry->plugin;
 			if (!xtr->check_buffer) {
 				RZ_LOG_ERROR("Missing check_buffer callback for '%s'\n", xtr->name);
 				continue;
@@ -346,13 +351,16 @@ RZ_IPI RzBinPlugin *rz_bin_get_binplugin_by_name(RzBin *bin, const char *name) {
 }
 
 RZ_API RzBinPlugin *rz_bin_get_binplugin_by_buffer(RzBin *bin, RzBuffer *buf) {
-	RzBinPlugin *plugin;
-	RzListIter *it;
-
 	rz_return_val_if_fail(bin && buf, NULL);
 
-	rz_list_foreach (bin->plugins, it, plugin) {
-		if (plugin->check_buffer) {
+	// only the plugins whose magics match the header are checked
+	ut8 header[RZ_BIN_MAGIC_SIZE];
+	size_t header_size = rz_bin_probe_read_header(buf, header);
+	void **it;
+	rz_pvector_foreach (rz_bin_probe_candidates(bin->probe, header, header_size), it) {
+		RzBinProbeEntry *entry = *it;
+		RzBinPlugin *plugin = entry->plugin;
+		if (plugin->check_buffer && rz_bin_probe_entry_match(entry, header, header_size)) {
 			if (plugin->check_buffer(buf)) {
 				return plugin;
 			}
@@ -399,6 +407,10 @@ RZ_IPI RzBinXtrPlugin *rz_bin_get_xtrplugin_by_name(RzBin *bin, const char *name
 RZ_API bool rz_bin_plugin_add(RzBin *bin, RZ_NONNULL RzBinPlugin *plugin) {
 	rz_return_val_if_fail(bin && plugin, false);
 	RZ_PLUGIN_CHECK_AND_ADD(bin->plugins, plugin, RzBinPlugin);
+	if (!rz_bin_probe_add(bin->probe, plugin, plugin->magics)) {
+		rz_list_delete_data(bin->plugins, plugin);
+		return false;
+	}
 	return true;
 }
 
@@ -413,6 +425,7 @@ RZ_API bool rz_bin_plugin_del(RzBin *bin, RZ_NONNULL RzBinPlugin *plugin) {
 			rz_bin_file_delete(bin, bf);
 		}
 	}
+	rz_bin_probe_del(bin->probe, plugin);
 	return rz_list_delete_data(bin->plugins, plugin);
 }
 
@@ -420,6 +433,10 @@ RZ_API bool rz_bin_xtr_plugin_add(RzBin *bin, RZ_NONNULL RzBinXtrPlugin *plugin)
 	rz_return_val_if_fail(bin && plugin, false);
 
 	RZ_PLUGIN_CHECK_AND_ADD(bin->binxtrs, plugin, RzBinXtrPlugin);
+	if (!rz_bin_probe_add(bin->xtr_probe, plugin, plugin->magics)) {
+		rz_list_delete_data(bin->binxtrs, plugin);
+		return false;
+	}
 	if (plugin->init) {
 		plugin->init(bin->user);
 	}
@@ -444,9 +461,13 @@ RZ_API bool rz_bin_xtr_plugin_del(RzBin *bin, RZ_NONNULL RzBinXtrPlugin *plugin)
 	if (!plugin_fini(bin, plugin)) {
 		return false;
 	}
+	rz_bin_probe_del(bin->xtr_probe, plugin);
 	return rz_list_delete_data(bin->binxtrs, plugin);
 }
 
+static RzBinDemangleCache *bin_demangle_cache_new(void);
+static void bin_demangle_cache_free(RzBinDemangleCache *cache);
+
 RZ_API void rz_bin_free(RzBin *bin) {
 	if (!bin) {
 		return;
@@ -455,6 +476,7 @@ RZ_API void rz_bin_free(RzBin *bin) {
 	free(bin->force);
 	free(bin->srcdir);
 	free(bin->strenc);
+	free(bin->cache_dir);
 	// rz_bin_free_bin_files (bin);
 	rz_list_free(bin->binfiles);
 
@@ -471,6 +493,9 @@ RZ_API void rz_bin_free(RzBin *bin) {
 	rz_event_free(bin->event);
 	rz_str_constpool_fini(&bin->constpool);
 	rz_demangler_free(bin->demangler);
+	bin_demangle_cache_free(bin->demangle_cache);
+	rz_bin_probe_free(bin->probe);
+	rz_bin_probe_free(bin->xtr_probe);
 	free(bin);
 }
 
@@ -754,6 +779,7 @@ RZ_API RzBin *rz_bin_new(void) {
 	bin->cb_printf = (PrintfCallback)printf;
 	bin->plugins = rz_list_new();
 	bin->minstrlen = 0;
+	bin->cache_max_size = RZ_BIN_CACHE_MAX_SIZE;
 	bin->strpurge = NULL;
 	bin->strenc = NULL;
 	bin->want_dbginfo = true;
@@ -762,6 +788,15 @@ RZ_API RzBin *rz_bin_new(void) {
 	if (!bin->hash) {
 		goto trashbin_event;
 	}
+	bin->demangle_cache = bin_demangle_cache_new();
+	if (!bin->demangle_cache) {
+		goto trashbin_hash;
+	}
+	bin->probe = rz_bin_probe_new();
+	bin->xtr_probe = rz_bin_probe_new();
+	if (!bin->probe || !bin->xtr_probe) {
+		goto trashbin_probe;
+	}
 
 	bin->ids = rz_id_storage_new(0, ST32_MAX);
 
@@ -788,6 +823,12 @@ trashbin_binxtrs:
 	rz_list_free(bin->binxtrs);
 	rz_list_free(bin->binfiles);
 	rz_id_storage_free(bin->ids);
+trashbin_probe:
+	rz_bin_probe_free(bin->probe);
+	rz_bin_probe_free(bin->xtr_probe);
+	bin_demangle_cache_free(bin->demangle_cache);
+trashbin_hash:
+	rz_hash_free(bin->hash);
 trashbin_event:
 	rz_event_free(bin->event);
 trashbin_constpool:
@@ -924,6 +965,19 @@ RZ_API void rz_bin_force_plugin(RzBin *bin, const char *name) {
 	bin->force = (name && *name) ? strdup(name) : NULL;
 }
 
+/**
+ * \brief Set the directory where the snapshots of the loaded objects are kept
+ *
+ * Objects whose content has already been loaded with the same settings
+ * are read back from their snapshot instead of being parsed again.
+ * A NULL or empty \p dir disables the cache.
+ */
+RZ_API void rz_bin_set_cache_dir(RzBin *bin, const char *dir) {
+	rz_return_if_fail(bin);
+	free(bin->cache_dir);
+	bin->cache_dir = RZ_STR_ISNOTEMPTY(dir) ? strdup(dir) : NULL;
+}
+
 RZ_API const char *rz_bin_entry_type_string(int etype) {
 	switch (etype) {
 	case RZ_BIN_ENTRY_TYPE_PROGRAM:
@@ -1287,9 +1341,108 @@ RZ_API const RzBinXtrPlugin *rz_bin_xtrplugin_get(RZ_NONNULL RzBin *bin, RZ_NONN
 	return NULL;
 }
 
+#define BIN_DEMANGLE_BATCH_MIN 1024
+
+typedef enum {
+	BIN_DEMANGLE_NONE = -1,
+	BIN_DEMANGLE_JAVA = 0,
+	BIN_DEMANGLE_OBJC,
+	BIN_DEMANGLE_MSVC,
+	BIN_DEMANGLE_PASCAL,
+	BIN_DEMANGLE_RUST,
+	BIN_DEMANGLE_CXX,
+	BIN_DEMANGLE_KINDS,
+} BinDemangleKind;
+
+typedef char *(*BinDemangleFn)(const char *symbol);
+
+static const BinDemangleFn bin_demangle_fns[BIN_DEMANGLE_KINDS] = {
+	[BIN_DEMANGLE_JAVA] = rz_demangler_java,
+	[BIN_DEMANGLE_OBJC] = rz_demangler_objc,
+	[BIN_DEMANGLE_MSVC] = rz_demangler_msvc,
+	[BIN_DEMANGLE_PASCAL] = rz_demangler_pascal,
+	[BIN_DEMANGLE_RUST] = rz_demangler_rust,
+	[BIN_DEMANGLE_CXX] = rz_demangler_cxx,
+};
+
+/**
+ * Memoizes the output of the builtin demanglers, the same mangled names
+ * are found over and over in the symbols, imports and relocs of all the
+ * files opened in the same RzBin.
+ */
+struct rz_bin_demangle_cache_t {
+	RzThreadLock *lock;
+	HtPP /*<const char *, char *>*/ *names[BIN_DEMANGLE_KINDS]; ///< mangled name -> demangled name, NULL when it cannot be demangled
+};
+
+static void bin_demangle_cache_kv_free(HtPPKv *kv) {
+	free(kv->key);
+	free(kv->value);
+}
+
+static void bin_demangle_cache_free(RzBinDemangleCache *cache) {
+	if (!cache) {
+		return;
+	}
+	for (ut32 i = 0; i < BIN_DEMANGLE_KINDS; i++) {
+		ht_pp_free(cache->names[i]);
+	}
+	rz_th_lock_free(cache->lock);
+	free(cache);
+}
+
+static RzBinDemangleCache *bin_demangle_cache_new(void) {
+	RzBinDemangleCache *cache = RZ_NEW0(RzBinDemangleCache);
+	if (!cache) {
+		return NULL;
+	}
+	cache->lock = rz_th_lock_new(false);
+	if (!cache->lock) {
+		goto fail;
+	}
+	for (ut32 i = 0; i < BIN_DEMANGLE_KINDS; i++) {
+		cache->names[i] = ht_pp_new(NULL, bin_demangle_cache_kv_free, NULL);
+		if (!cache->names[i]) {
+			goto fail;
+		}
+	}
+	return cache;
+
+fail:
+	bin_demangle_cache_free(cache);
+	return NULL;
+}
+
+static char *bin_demangle_cached(RzBin *bin, BinDemangleKind kind, const char *symbol) {
+	RzBinDemangleCache *cache = bin ? bin->demangle_cache : NULL;
+	if (!cache) {
+		return bin_demangle_fns[kind](symbol);
+	}
+	HtPP *names = cache->names[kind];
+	bool found = false;
+	rz_th_lock_enter(cache->lock);
+	const char *cached = ht_pp_find(names, symbol, &found);
+	char *out = found && cached ? strdup(cached) : NULL;
+	rz_th_lock_leave(cache->lock);
+	if (found) {
+		return out;
+	}
+
+	// demangle outside of the lock, so the batch threads do not serialize on it.
+	out = bin_demangle_fns[kind](symbol);
+	rz_th_lock_enter(cache->lock);
+	bool inserted = ht_pp_insert(names, symbol, out);
+	rz_th_lock_leave(cache->lock);
+	if (!inserted) {
+		// another thread was faster, the value is the same.
+		return out;
+	}
+	return out ? strdup(out) : NULL;
+}
+
 #if WITH_GPL
 static char *bin_demangle_cxx(RzBinFile *bf, const char *symbol, ut64 vaddr) {
-	char *out = rz_demangler_cxx(symbol);
+	char *out = bin_demangle_cached(bf ? bf->rbin : NULL, BIN_DEMANGLE_CXX, symbol);
 	if (!out || !bf) {
 		return out;
 	}
@@ -1334,61 +1487,47 @@ static char *bin_demangle_rust(RzBinFile *binfile, const char *symbol, ut64 vadd
 		return str;
 	}
 	free(str);
-	return rz_demangler_rust(symbol);
+	return bin_demangle_cached(binfile ? binfile->rbin : NULL, BIN_DEMANGLE_RUST, symbol);
 }
 #endif
 
 /**
- * \brief Demangles a symbol based on the language or the RzBinFile data
- *
- * This function demangles a symbol based on the language or the RzBinFile data
- * When C++ or rust is selected as the language, it will add methods into the
- * RzBinFile structure based on the demangled symbol.
- * When libs is set to true, the demangled symbol will be appended to the
- * library name <libname>_<demangled symbol>.
- *
- * \param bf RzBinFile data to be used for demangling
- * \param language Language to be used for demanglind
- * \param symbol Symbol to be demangled
- * \param vaddr vaddr of the \p symbol to be demangled
- * \param libs Append the library name to the demangled symbol, if set to true
- * \return char* Demangled name of the \p symbol
+ * Strips the known prefixes and library names from \p symbol and detects
+ * the language to use for demangling it.
  */
-RZ_API RZ_OWN char *rz_bin_demangle(RZ_NULLABLE RzBinFile *bf, RZ_NULLABLE const char *language, RZ_NULLABLE const char *symbol, ut64 vaddr, bool libs) {
-	if (RZ_STR_ISEMPTY(symbol)) {
-		return NULL;
-	}
-
+static RzBinLanguage bin_demangle_prepare(RzBinFile *bf, const char **language, const char **symbol, const char **library) {
 	RzBinLanguage type = RZ_BIN_LANGUAGE_UNKNOWN;
 	RzBin *bin = bf ? bf->rbin : NULL;
 	RzBinObject *o = bf ? bf->o : NULL;
+	const char *name = *symbol;
+	const char *lang = *language;
 
-	if (!language && o && o->info && o->info->lang) {
-		language = o->info->lang;
+	if (!lang && o && o->info && o->info->lang) {
+		lang = o->info->lang;
 	}
 
 	RzListIter *iter;
 	const char *lib = NULL;
-	if (!strncmp(symbol, "reloc.", 6)) {
-		symbol += 6;
+	if (!strncmp(name, "reloc.", 6)) {
+		name += 6;
 	}
-	if (!strncmp(symbol, "sym.", 4)) {
-		symbol += 4;
+	if (!strncmp(name, "sym.", 4)) {
+		name += 4;
 	}
-	if (!strncmp(symbol, "imp.", 4)) {
-		symbol += 4;
+	if (!strncmp(name, "imp.", 4)) {
+		name += 4;
 	}
-	if (!strncmp(symbol, "target.", 7)) {
-		symbol += 7;
+	if (!strncmp(name, "target.", 7)) {
+		name += 7;
 	}
 	if (o) {
 		bool found = false;
 		rz_list_foreach (o->libs, iter, lib) {
 			size_t len = strlen(lib);
-			if (!rz_str_ncasecmp(symbol, lib, len)) {
-				symbol += len;
-				if (*symbol == '_') {
-					symbol++;
+			if (!rz_str_ncasecmp(name, lib, len)) {
+				name += len;
+				if (*name == '_') {
+					name++;
 				}
 				found = true;
 				break;
@@ -1398,21 +1537,24 @@ RZ_API RZ_OWN char *rz_bin_demangle(RZ_NULLABLE RzBinFile *bf, RZ_NULLABLE const
 			lib = NULL;
 		}
 		size_t len = bin ? strlen(bin->file) : 0;
-		if (bin && len > 0 && !rz_str_ncasecmp(symbol, bin->file, len)) {
+		if (bin && len > 0 && !rz_str_ncasecmp(name, bin->file, len)) {
 			lib = bin->file;
-			symbol += len;
-			if (*symbol == '_') {
-				symbol++;
+			name += len;
+			if (*name == '_') {
+				name++;
 			}
 		}
 	}
 
-	if (RZ_STR_ISEMPTY(symbol)) {
-		return NULL;
+	*symbol = name;
+	*library = lib;
+	*language = lang;
+	if (RZ_STR_ISEMPTY(name)) {
+		return RZ_BIN_LANGUAGE_UNKNOWN;
 	}
 
-	if (!strncmp(symbol, "__", 2)) {
-		if (symbol[2] == 'T') {
+	if (!strncmp(name, "__", 2)) {
+		if (name[2] == 'T') {
 			type = RZ_BIN_LANGUAGE_SWIFT;
 		} else {
 			type = RZ_BIN_LANGUAGE_CXX;
@@ -1420,14 +1562,39 @@ RZ_API RZ_OWN char *rz_bin_demangle(RZ_NULLABLE RzBinFile *bf, RZ_NULLABLE const
 	}
 
 	if (type == RZ_BIN_LANGUAGE_UNKNOWN) {
-		type = rz_bin_language_to_id(language);
+		type = rz_bin_language_to_id(lang);
 		// ignore "with blocks"
 		type = RZ_BIN_LANGUAGE_MASK(type);
-		language = rz_bin_language_to_string(type);
+		*language = rz_bin_language_to_string(type);
 	}
-	if (!language) {
+	return *language ? type : RZ_BIN_LANGUAGE_UNKNOWN;
+}
+
+/**
+ * \brief Demangles a symbol based on the language or the RzBinFile data
+ *
+ * This function demangles a symbol based on the language or the RzBinFile data
+ * When C++ or rust is selected as the language, it will add methods into the
+ * RzBinFile structure based on the demangled symbol.
+ * When libs is set to true, the demangled symbol will be appended to the
+ * library name <libname>_<demangled symbol>.
+ * The output of the builtin demanglers is cached in the RzBin of \p bf.
+ *
+ * \param bf RzBinFile data to be used for demangling
+ * \param language Language to be used for demanglind
+ * \param symbol Symbol to be demangled
+ * \param vaddr vaddr of the \p symbol to be demangled
+ * \param libs Append the library name to the demangled symbol, if set to true
+ * \return char* Demangled name of the \p symbol
+ */
+RZ_API RZ_OWN char *rz_bin_demangle(RZ_NULLABLE RzBinFile *bf, RZ_NULLABLE const char *language, RZ_NULLABLE const char *symbol, ut64 vaddr, bool libs) {
+	if (RZ_STR_ISEMPTY(symbol)) {
 		return NULL;
 	}
+
+	RzBin *bin = bf ? bf->rbin : NULL;
+	const char *lib = NULL;
+	RzBinLanguage type = bin_demangle_prepare(bf, &language, &symbol, &lib);
 	char *demangled = NULL;
 	switch (type) {
 	case RZ_BIN_LANGUAGE_UNKNOWN: return NULL;
@@ -1437,10 +1604,10 @@ RZ_API RZ_OWN char *rz_bin_demangle(RZ_NULLABLE RzBinFile *bf, RZ_NULLABLE const
 		/* fall-thru */
 	case RZ_BIN_LANGUAGE_DART:
 		/* fall-thru */
-	case RZ_BIN_LANGUAGE_JAVA: demangled = rz_demangler_java(symbol); break;
-	case RZ_BIN_LANGUAGE_OBJC: demangled = rz_demangler_objc(symbol); break;
-	case RZ_BIN_LANGUAGE_MSVC: demangled = rz_demangler_msvc(symbol); break;
-	case RZ_BIN_LANGUAGE_PASCAL: demangled = rz_demangler_pascal(symbol); break;
+	case RZ_BIN_LANGUAGE_JAVA: demangled = bin_demangle_cached(bin, BIN_DEMANGLE_JAVA, symbol); break;
+	case RZ_BIN_LANGUAGE_OBJC: demangled = bin_demangle_cached(bin, BIN_DEMANGLE_OBJC, symbol); break;
+	case RZ_BIN_LANGUAGE_MSVC: demangled = bin_demangle_cached(bin, BIN_DEMANGLE_MSVC, symbol); break;
+	case RZ_BIN_LANGUAGE_PASCAL: demangled = bin_demangle_cached(bin, BIN_DEMANGLE_PASCAL, symbol); break;
 #if WITH_GPL
 	case RZ_BIN_LANGUAGE_RUST: demangled = bin_demangle_rust(bf, symbol, vaddr); break;
 	case RZ_BIN_LANGUAGE_CXX: demangled = bin_demangle_cxx(bf, symbol, vaddr); break;
@@ -1461,3 +1628,129 @@ RZ_API RZ_OWN char *rz_bin_demangle(RZ_NULLABLE RzBinFile *bf, RZ_NULLABLE const
 	}
 	return demangled;
 }
+
+typedef struct {
+	BinDemangleKind kind;
+	const char *symbol;
+} BinDemangleJob;
+
+typedef struct {
+	RzBin *bin;
+	RzVector /*<BinDemangleJob>*/ *jobs;
+	size_t from;
+	size_t to;
+} BinDemangleSlice;
+
+static BinDemangleKind bin_demangle_kind(RzBinLanguage type) {
+	switch (type) {
+	case RZ_BIN_LANGUAGE_KOTLIN:
+	case RZ_BIN_LANGUAGE_GROOVY:
+	case RZ_BIN_LANGUAGE_DART:
+	case RZ_BIN_LANGUAGE_JAVA: return BIN_DEMANGLE_JAVA;
+	case RZ_BIN_LANGUAGE_OBJC: return BIN_DEMANGLE_OBJC;
+	case RZ_BIN_LANGUAGE_MSVC: return BIN_DEMANGLE_MSVC;
+	case RZ_BIN_LANGUAGE_PASCAL: return BIN_DEMANGLE_PASCAL;
+#if WITH_GPL
+	case RZ_BIN_LANGUAGE_RUST: return BIN_DEMANGLE_RUST;
+	case RZ_BIN_LANGUAGE_CXX: return BIN_DEMANGLE_CXX;
+#endif
+	default: return BIN_DEMANGLE_NONE;
+	}
+}
+
+static void *bin_demangle_slice_runner(BinDemangleSlice *slice) {
+	for (size_t i = slice->from; i < slice->to; i++) {
+		BinDemangleJob *job = rz_vector_index_ptr(slice->jobs, i);
+		if (job->kind == BIN_DEMANGLE_RUST) {
+			// rust symbols are first tried as C++ ones, see bin_demangle_rust()
+			free(bin_demangle_cached(slice->bin, BIN_DEMANGLE_CXX, job->symbol));
+		}
+		free(bin_demangle_cached(slice->bin, job->kind, job->symbol));
+	}
+	return NULL;
+}
+
+/**
+ * \brief Demangles the names of \p symbols in parallel and caches the results
+ *
+ * Fills the demangling cache of the RzBin of \p bf, so that the following
+ * calls to rz_bin_demangle() on the same names do not demangle them again.
+ * The symbols which already have a demangled name and the languages without
+ * a builtin demangler are skipped. Nothing is done for small lists, where
+ * starting the threads costs more than it saves.
+ *
+ * \param bf RzBinFile the symbols belong to
+ * \param language Language to be used for demangling, or NULL to use the one of \p bf
+ * \param symbols List of RzBinSymbol to demangle
+ */
+RZ_API void rz_bin_demangle_batch(RZ_NONNULL RzBinFile *bf, RZ_NULLABLE const char *language, RZ_NONNULL const RzList /*<RzBinSymbol *>*/ *symbols) {
+	rz_return_if_fail(bf && symbols);
+	RzBin *bin = bf->rbin;
+	if (!bin || !bin->demangle_cache || rz_list_length(symbols) < BIN_DEMANGLE_BATCH_MIN) {
+		return;
+	}
+
+	RzVector jobs;
+	rz_vector_init(&jobs, sizeof(BinDemangleJob), NULL, NULL);
+	RzListIter *iter;
+	RzBinSymbol *sym;
+	rz_list_foreach (symbols, iter, sym) {
+		if (RZ_STR_ISEMPTY(sym->name) || sym->dname) {
+			continue;
+		}
+		const char *lang = language;
+		const char *name = sym->name;
+		const char *lib = NULL;
+		BinDemangleJob job = { 0 };
+		job.kind = bin_demangle_kind(bin_demangle_prepare(bf, &lang, &name, &lib));
+		if (job.kind == BIN_DEMANGLE_NONE) {
+			continue;
+		}
+		job.symbol = name;
+		if (!rz_vector_push(&jobs, &job)) {
+			goto end;
+		}
+	}
+	if (rz_vector_len(&jobs) < BIN_DEMANGLE_BATCH_MIN) {
+		goto end;
+	}
+
+	RzThreadPool *pool = rz_th_pool_new(RZ_THREAD_POOL_ALL_CORES);
+	if (!pool) {
+		RZ_LOG_ERROR("bin: cannot allocate the demangling thread pool.\n");
+		goto end;
+	}
+	size_t pool_size = rz_th_pool_size(pool);
+	size_t n_jobs = rz_vector_len(&jobs);
+	size_t per_thread = (n_jobs + pool_size - 1) / pool_size;
+	BinDemangleSlice *slices = RZ_NEWS0(BinDemangleSlice, pool_size);
+	if (!slices) {
+		rz_th_pool_free(pool);
+		goto end;
+	}
+
+	size_t done = 0;
+	for (size_t i = 0; i < pool_size && done < n_jobs; i++) {
+		BinDemangleSlice *slice = &slices[i];
+		slice->bin = bin;
+		slice->jobs = &jobs;
+		slice->from = done;
+		slice->to = RZ_MIN(done + per_thread, n_jobs);
+		RzThread *th = rz_th_new((RzThreadFunction)bin_demangle_slice_runner, slice);
+		if (!th) {
+			break;
+		} else if (!rz_th_pool_add_thread(pool, th)) {
+			rz_th_wait(th);
+			rz_th_free(th);
+			break;
+		}
+		done = slice->to;
+	}
+	rz_th_pool_wait(pool);
+	rz_th_pool_free(pool);
+	free(slices);
+	// the names left out by a failure are demangled on first use.
+
+end:
+	rz_vector_fini(&jobs);
+}
@@ -185,6 +185,135 @@ RZ_API RzBinReloc *rz_bin_reloc_storage_get_reloc_to(RzBinRelocStorage *storage,
 	return r->target_vaddr == vaddr ? r : NULL;
 }
 
+typedef struct {
+	ut64 addr;
+	size_t pos;
+	RzBinSymbol *symbol;
+} SymbolIndexEntry;
+
+static int symbol_index_entry_cmp(const void *a, const void *b) {
+	const SymbolIndexEntry *ea = a;
+	const SymbolIndexEntry *eb = b;
+	if (ea->addr != eb->addr) {
+		return RZ_NUM_CMP(ea->addr, eb->addr);
+	}
+	return RZ_NUM_CMP(ea->pos, eb->pos);
+}
+
+static bool symbol_index_fill(SymbolIndexEntry *entries, size_t count, ut64 **addrs, RzBinSymbol ***symbols) {
+	if (!count) {
+		return true;
+	}
+	qsort(entries, count, sizeof(SymbolIndexEntry), symbol_index_entry_cmp);
+	*addrs = RZ_NEWS(ut64, count);
+	*symbols = RZ_NEWS(RzBinSymbol *, count);
+	if (!*addrs || !*symbols) {
+		return false;
+	}
+	for (size_t i = 0; i < count; i++) {
+		(*addrs)[i] = entries[i].addr;
+		(*symbols)[i] = entries[i].symbol;
+	}
+	return true;
+}
+
+static void symbol_name_kv_free(HtPPKv *kv) {
+	free(kv->key);
+}
+
+/**
+ * \brief Builds the address and name index of \p symbols
+ *
+ * The index borrows the symbols, so it must be rebuilt whenever the list changes.
+ */
+RZ_API RZ_OWN RzBinSymbolIndex *rz_bin_symbol_index_new(RZ_NONNULL const RzList /*<RzBinSymbol *>*/ *symbols) {
+	rz_return_val_if_fail(symbols, NULL);
+	RzBinSymbolIndex *index = RZ_NEW0(RzBinSymbolIndex);
+	if (!index) {
+		return NULL;
+	}
+	index->list = symbols;
+	index->count = rz_list_length(symbols);
+	index->by_name = ht_pp_new_size(index->count, NULL, symbol_name_kv_free, NULL);
+	SymbolIndexEntry *entries = index->count ? RZ_NEWS(SymbolIndexEntry, index->count) : NULL;
+	if (!index->by_name || (index->count && !entries)) {
+		goto fail;
+	}
+
+	size_t pos = 0;
+	RzListIter *it;
+	RzBinSymbol *sym;
+	rz_list_foreach (symbols, it, sym) {
+		entries[pos].addr = sym->vaddr;
+		entries[pos].pos = pos;
+		entries[pos].symbol = sym;
+		pos++;
+		if (RZ_STR_ISNOTEMPTY(sym->name)) {
+			// keeps the first symbol of each name
+			ht_pp_insert(index->by_name, sym->name, sym);
+		}
+	}
+	if (!symbol_index_fill(entries, index->count, &index->vaddrs, &index->by_vaddr)) {
+		goto fail;
+	}
+	for (size_t i = 0; i < index->count; i++) {
+		entries[i].addr = entries[i].symbol->paddr;
+	}
+	if (!symbol_index_fill(entries, index->count, &index->paddrs, &index->by_paddr)) {
+		goto fail;
+	}
+	free(entries);
+	return index;
+
+fail:
+	free(entries);
+	rz_bin_symbol_index_free(index);
+	return NULL;
+}
+
+RZ_API void rz_bin_symbol_index_free(RZ_NULLABLE RzBinSymbolIndex *index) {
+	if (!index) {
+		return;
+	}
+	free(index->vaddrs);
+	free(index->by_vaddr);
+	free(index->paddrs);
+	free(index->by_paddr);
+	ht_pp_free(index->by_name);
+	free(index);
+}
+
+static size_t addr_lower_bound(const ut64 *addrs, size_t count, ut64 addr) {
+	size_t lo = 0, hi = count;
+	while (lo < hi) {
+		size_t mid = lo + (hi - lo) / 2;
+		if (addrs[mid] < addr) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+	return lo;
+}
+
+/**
+ * \brief Returns the position in \p index->by_vaddr of the first symbol at or after \p vaddr,
+ * or \p index->count if there is none
+ */
+RZ_API size_t rz_bin_symbol_index_lower_vaddr(RZ_NONNULL const RzBinSymbolIndex *index, ut64 vaddr) {
+	rz_return_val_if_fail(index, 0);
+	return addr_lower_bound(index->vaddrs, index->count, vaddr);
+}
+
+/**
+ * \brief Returns the position in \p index->by_paddr of the first symbol at or after \p paddr,
+ * or \p index->count if there is none
+ */
+RZ_API size_t rz_bin_symbol_index_lower_paddr(RZ_NONNULL const RzBinSymbolIndex *index, ut64 paddr) {
+	rz_return_val_if_fail(index, 0);
+	return addr_lower_bound(index->paddrs, index->count, paddr);
+}
+
 RZ_IPI void rz_bin_object_free(RzBinObject *o) {
 	if (!o) {
 		return;
@@ -199,9 +328,12 @@ RZ_IPI void rz_bin_object_free(RzBinObject *o) {
 	rz_list_free(o->imports);
 	rz_list_free(o->libs);
 	rz_bin_reloc_storage_free(o->relocs);
+	rz_bin_object_cache_free(o->cache);
 	rz_list_free(o->sections);
 	rz_bin_string_database_free(o->strings);
+	rz_list_free(o->resources);
 	ht_pp_free(o->import_name_symbols);
+	rz_bin_symbol_index_free(o->symbols_index);
 	rz_list_free(o->symbols);
 	rz_list_free(o->classes);
 	ht_pp_free(o->classes_ht);
@@ -211,6 +343,7 @@ RZ_IPI void rz_bin_object_free(RzBinObject *o) {
 	for (ut32 i = 0; i < RZ_BIN_SPECIAL_SYMBOL_LAST; i++) {
 		free(o->binsym[i]);
 	}
+	rz_th_lock_free(o->lazy_lock);
 	free(o);
 }
 
@@ -295,6 +428,12 @@ RZ_IPI RzBinObject *rz_bin_object_new(RzBinFile *bf, RzBinPlugin *plugin, RzBinO
 	o->methods_ht = ht_pp_new0();
 	o->baddr_shift = 0;
 	o->plugin = plugin;
+	o->bf = bf;
+	o->lazy_lock = rz_th_lock_new(true);
+	if (!o->lazy_lock) {
+		rz_bin_object_free(o);
+		return NULL;
+	}
 
 	if (plugin && plugin->load_buffer) {
 		if (!plugin->load_buffer(bf, o, bf->buf, bf->sdb)) {
@@ -389,13 +528,65 @@ static void rz_bin_object_rebuild_classes_ht(RzBinObject *o) {
 	}
 }
 
+static RzBinStrDb *bin_object_scan_strings(RzBinFile *bf, RzBinObject *o, int minlen) {
+	RzBin *bin = bf->rbin;
+	RzBinPlugin *plugin = o->plugin;
+	RzList *strings = NULL;
+	if (plugin && plugin->strings) {
+		strings = plugin->strings(bf);
+	} else {
+		// when a bin plugin does not provide it's own strings
+		// we always take all the strings found in the binary
+		// the method also converts the paddrs to vaddrs
+		strings = rz_bin_file_strings(bf, minlen, true);
+	}
+
+	if (bin->debase64) {
+		bin_object_decode_all_base64_strings(strings);
+	}
+	REBASE_PADDR(o, strings, RzBinString);
+
+	// RzBinStrDb becomes the owner of the RzList strings
+	return rz_bin_string_database_new(strings);
+}
+
+/*
+ * Strings and resources are the most expensive items to get out of a binary
+ * and often are never looked at, so rz_bin_object_set_items() only marks them
+ * as pending and they are loaded by the first getter that needs them.
+ * The lock is recursive because the plugins may call the getters back.
+ */
+static void bin_object_load_strings(RzBinObject *o) {
+	rz_th_lock_enter(o->lazy_lock);
+	if (o->strings_pending) {
+		o->strings_pending = false;
+		RzBinFile *bf = o->bf;
+		o->strings = rz_bin_object_cache_load_strings(bf, o);
+		if (!o->strings) {
+			int minlen = (bf->rbin->minstrlen > 0) ? bf->rbin->minstrlen : o->plugin->minstrlen;
+			o->strings = bin_object_scan_strings(bf, o, minlen);
+			rz_bin_object_cache_save_strings(bf, o);
+		}
+	}
+	rz_th_lock_leave(o->lazy_lock);
+}
+
+static void bin_object_load_resources(RzBinObject *o) {
+	rz_th_lock_enter(o->lazy_lock);
+	if (o->resources_pending) {
+		o->resources_pending = false;
+		o->resources = o->plugin->resources(o->bf);
+	}
+	rz_th_lock_leave(o->lazy_lock);
+}
+
 RZ_API int rz_bin_object_set_items(RzBinFile *bf, RzBinObject *o) {
 	rz_return_val_if_fail(bf && o && o->plugin, false);
 
 	RzBin *bin = bf->rbin;
 	RzBinPlugin *p = o->plugin;
-	int minlen = (bf->rbin->minstrlen > 0) ? bf->rbin->minstrlen : p->minstrlen;
 	bf->o = o;
+	o->bf = bf;
 
 	if (p->file_type) {
 		int type = p->file_type(bf);
@@ -444,34 +635,38 @@ RZ_API int rz_bin_object_set_items(RzBinFile *bf, RzBinObject *o) {
 			REBASE_PADDR(o, o->fields, RzBinField);
 		}
 	}
-	if (p->imports) {
+	// symbols, imports, libs, relocs and lines may come from the bin.cache snapshot
+	bool cached = rz_bin_object_cache_load(bf, o);
+	if (p->imports && !cached) {
 		rz_list_free(o->imports);
 		o->imports = p->imports(bf);
 		if (o->imports) {
 			rz_warn_if_fail(o->imports->free);
 		}
 	}
-	if (p->symbols) {
+	if (p->symbols && !cached) {
 		o->symbols = p->symbols(bf);
 		if (o->symbols) {
 			REBASE_PADDR(o, o->symbols, RzBinSymbol);
 			if (bin->filter) {
 				rz_bin_filter_symbols(bf, o->symbols);
 			}
-			o->import_name_symbols = ht_pp_new0();
-			if (o->import_name_symbols) {
-				RzBinSymbol *sym;
-				RzListIter *it;
-				rz_list_foreach (o->symbols, it, sym) {
-					if (!sym->is_imported || !sym->name || !*sym->name) {
-						continue;
-					}
-					ht_pp_insert(o->import_name_symbols, sym->name, sym);
+		}
+	}
+	if (o->symbols) {
+		o->import_name_symbols = ht_pp_new0();
+		if (o->import_name_symbols) {
+			RzBinSymbol *sym;
+			RzListIter *it;
+			rz_list_foreach (o->symbols, it, sym) {
+				if (!sym->is_imported || !sym->name || !*sym->name) {
+					continue;
 				}
+				ht_pp_insert(o->import_name_symbols, sym->name, sym);
 			}
 		}
 	}
-	if (p->libs) {
+	if (p->libs && !cached) {
 		o->libs = p->libs(bf);
 	}
 	if (p->sections) {
@@ -487,7 +682,7 @@ RZ_API int rz_bin_object_set_items(RzBinFile *bf, RzBinObject *o) {
 
 	o->info = p->info ? p->info(bf) : NULL;
 
-	if (bin->filter_rules & (RZ_BIN_REQ_RELOCS | RZ_BIN_REQ_IMPORTS)) {
+	if (bin->filter_rules & (RZ_BIN_REQ_RELOCS | RZ_BIN_REQ_IMPORTS) && !cached) {
 		if (p->relocs) {
 			RzList *l = p->relocs(bf);
 			if (l) {
@@ -496,25 +691,17 @@ RZ_API int rz_bin_object_set_items(RzBinFile *bf, RzBinObject *o) {
 			}
 		}
 	}
-	if (bin->filter_rules & RZ_BIN_REQ_STRINGS) {
-		RzList *strings;
-		if (p->strings) {
-			strings = p->strings(bf);
-		} else {
-			// when a bin plugin does not provide it's own strings
-			// we always take all the strings found in the binary
-			// the method also converts the paddrs to vaddrs
-			strings = rz_bin_file_strings(bf, minlen, true);
-		}
-
-		if (bin->debase64) {
-			bin_object_decode_all_base64_strings(strings);
-		}
-		REBASE_PADDR(o, strings, RzBinString);
-
-		// RzBinStrDb becomes the owner of the RzList strings
-		o->strings = rz_bin_string_database_new(strings);
+	if (p->lines && !cached) {
+		o->lines = p->lines(bf);
 	}
+	if (!cached) {
+		rz_bin_object_cache_save(bf, o);
+	}
+	// strings are scanned on first access, see rz_bin_object_get_strings()
+	rz_th_lock_enter(o->lazy_lock);
+	RZ_FREE_CUSTOM(o->strings, rz_bin_string_database_free);
+	o->strings_pending = bin->filter_rules & RZ_BIN_REQ_STRINGS;
+	rz_th_lock_leave(o->lazy_lock);
 
 	if (o->info && RZ_STR_ISEMPTY(o->info->compiler)) {
 		free(o->info->compiler);
@@ -567,9 +754,6 @@ RZ_API int rz_bin_object_set_items(RzBinFile *bf, RzBinObject *o) {
 			}
 		}
 	}
-	if (p->lines) {
-		o->lines = p->lines(bf);
-	}
 	if (p->get_sdb) {
 		Sdb *new_kv = p->get_sdb(bf);
 		if (new_kv != o->kv) {
@@ -580,9 +764,11 @@ RZ_API int rz_bin_object_set_items(RzBinFile *bf, RzBinObject *o) {
 	if (p->mem) {
 		o->mem = p->mem(bf);
 	}
-	if (p->resources) {
-		o->resources = p->resources(bf);
-	}
+	// resources are parsed on first access, see rz_bin_object_get_resources()
+	rz_th_lock_enter(o->lazy_lock);
+	RZ_FREE_CUSTOM(o->resources, rz_list_free);
+	o->resources_pending = p->resources != NULL;
+	rz_th_lock_leave(o->lazy_lock);
 	return true;
 }
 
@@ -620,6 +806,103 @@ RZ_API RzBinSymbol *rz_bin_object_get_symbol_of_import(RzBinObject *o, RzBinImpo
 	return ht_pp_find(o->import_name_symbols, imp->name, NULL);
 }
 
+/**
+ * \brief Returns the address and name index of the symbols of \p o
+ *
+ * The index is built on the first call and rebuilt when the symbol list
+ * has been replaced or resized since. It is owned by \p o.
+ */
+RZ_API RZ_BORROW RzBinSymbolIndex *rz_bin_object_get_symbol_index(RZ_NONNULL RzBinObject *o) {
+	rz_return_val_if_fail(o, NULL);
+	rz_th_lock_enter(o->lazy_lock);
+	RzBinSymbolIndex *index = o->symbols_index;
+	if (index && (index->list != o->symbols || index->count != rz_list_length(o->symbols))) {
+		RZ_FREE_CUSTOM(o->symbols_index, rz_bin_symbol_index_free);
+	}
+	if (!o->symbols_index && o->symbols) {
+		o->symbols_index = rz_bin_symbol_index_new(o->symbols);
+	}
+	index = o->symbols_index;
+	rz_th_lock_leave(o->lazy_lock);
+	return index;
+}
+
+/**
+ * \brief Returns the first symbol of \p o starting at \p vaddr
+ */
+RZ_API RZ_BORROW RzBinSymbol *rz_bin_object_get_symbol_at(RZ_NONNULL RzBinObject *o, ut64 vaddr) {
+	rz_return_val_if_fail(o, NULL);
+	RzBinSymbolIndex *index = rz_bin_object_get_symbol_index(o);
+	if (!index) {
+		return NULL;
+	}
+	size_t i = rz_bin_symbol_index_lower_vaddr(index, vaddr);
+	return i < index->count && index->vaddrs[i] == vaddr ? index->by_vaddr[i] : NULL;
+}
+
+/**
+ * \brief Returns the first symbol of \p o starting at the file offset \p paddr
+ */
+RZ_API RZ_BORROW RzBinSymbol *rz_bin_object_get_symbol_at_paddr(RZ_NONNULL RzBinObject *o, ut64 paddr) {
+	rz_return_val_if_fail(o, NULL);
+	RzBinSymbolIndex *index = rz_bin_object_get_symbol_index(o);
+	if (!index) {
+		return NULL;
+	}
+	size_t i = rz_bin_symbol_index_lower_paddr(index, paddr);
+	return i < index->count && index->paddrs[i] == paddr ? index->by_paddr[i] : NULL;
+}
+
+/**
+ * \brief Returns the first symbol of \p o named \p name
+ */
+RZ_API RZ_BORROW RzBinSymbol *rz_bin_object_get_symbol_by_name(RZ_NONNULL RzBinObject *o, RZ_NONNULL const char *name) {
+	rz_return_val_if_fail(o && name, NULL);
+	RzBinSymbolIndex *index = rz_bin_object_get_symbol_index(o);
+	return index ? ht_pp_find(index->by_name, name, NULL) : NULL;
+}
+
+/**
+ * \brief Returns the symbol of \p o whose vaddr is the closest to \p vaddr,
+ * preferring the one before \p vaddr on ties
+ */
+RZ_API RZ_BORROW RzBinSymbol *rz_bin_object_get_symbol_nearest(RZ_NONNULL RzBinObject *o, ut64 vaddr) {
+	rz_return_val_if_fail(o, NULL);
+	RzBinSymbolIndex *index = rz_bin_object_get_symbol_index(o);
+	if (!index || !index->count) {
+		return NULL;
+	}
+	size_t i = rz_bin_symbol_index_lower_vaddr(index, vaddr);
+	if (i < index->count && index->vaddrs[i] == vaddr) {
+		return index->by_vaddr[i];
+	}
+	if (!i) {
+		return index->by_vaddr[0];
+	}
+	// first symbol of the closest address before vaddr
+	size_t before = rz_bin_symbol_index_lower_vaddr(index, index->vaddrs[i - 1]);
+	if (i == index->count || vaddr - index->vaddrs[before] <= index->vaddrs[i] - vaddr) {
+		return index->by_vaddr[before];
+	}
+	return index->by_vaddr[i];
+}
+
+/**
+ * \brief Returns the symbols of \p o starting in [vaddr, vaddr + size), ordered by vaddr
+ */
+RZ_API RZ_OWN RzPVector /*<RzBinSymbol *>*/ *rz_bin_object_get_symbols_in(RZ_NONNULL RzBinObject *o, ut64 vaddr, ut64 size) {
+	rz_return_val_if_fail(o, NULL);
+	RzPVector *ret = rz_pvector_new(NULL);
+	RzBinSymbolIndex *index = rz_bin_object_get_symbol_index(o);
+	if (!ret || !index) {
+		return ret;
+	}
+	for (size_t i = rz_bin_symbol_index_lower_vaddr(index, vaddr); i < index->count && index->vaddrs[i] - vaddr < size; i++) {
+		rz_pvector_push(ret, index->by_vaddr[i]);
+	}
+	return ret;
+}
+
 RZ_API RzBinVirtualFile *rz_bin_object_get_virtual_file(RzBinObject *o, const char *name) {
 	rz_return_val_if_fail(o && name, NULL);
 	if (!o->vfiles) {
@@ -804,6 +1087,7 @@ RZ_API const RzList /*<RzBinClass *>*/ *rz_bin_object_get_classes(RZ_NONNULL RzB
  */
 RZ_API const RzList /*<RzBinString *>*/ *rz_bin_object_get_strings(RZ_NONNULL RzBinObject *obj) {
 	rz_return_val_if_fail(obj, NULL);
+	bin_object_load_strings(obj);
 	if (!obj->strings) {
 		return NULL;
 	}
@@ -831,6 +1115,7 @@ RZ_API const RzList /*<RzBinSymbol *>*/ *rz_bin_object_get_symbols(RZ_NONNULL Rz
  */
 RZ_API const RzList /*<RzBinResource *>*/ *rz_bin_object_get_resources(RZ_NONNULL RzBinObject *obj) {
 	rz_return_val_if_fail(obj, NULL);
+	bin_object_load_resources(obj);
 	return obj->resources;
 }
 
@@ -839,27 +1124,13 @@ RZ_API const RzList /*<RzBinResource *>*/ *rz_bin_object_get_resources(RZ_NONNUL
  */
 RZ_API bool rz_bin_object_reset_strings(RZ_NONNULL RzBin *bin, RZ_NONNULL RzBinFile *bf, RZ_NONNULL RzBinObject *obj) {
 	rz_return_val_if_fail(bin && bf && obj, false);
+	rz_th_lock_enter(obj->lazy_lock);
 	RZ_FREE_CUSTOM(obj->strings, rz_bin_string_database_free);
-
-	RzList *strings = NULL;
-	RzBinPlugin *plugin = obj->plugin;
-	if (plugin && plugin->strings) {
-		strings = plugin->strings(bf);
-	} else {
-		// when a bin plugin does not provide it's own strings
-		// we always take all the strings found in the binary
-		// the method also converts the paddrs to vaddrs
-		strings = rz_bin_file_strings(bf, bin->minstrlen, true);
-	}
-
-	if (bin->debase64) {
-		bin_object_decode_all_base64_strings(strings);
-	}
-	REBASE_PADDR(obj, strings, RzBinString);
-
-	// RzBinStrDb becomes the owner of the RzList strings
-	obj->strings = rz_bin_string_database_new(strings);
-	return obj->strings != NULL;
+	obj->strings_pending = false;
+	obj->strings = bin_object_scan_strings(bf, obj, bin->minstrlen);
+	bool res = obj->strings != NULL;
+	rz_th_lock_leave(obj->lazy_lock);
+	return res;
 }
 
 /**
@@ -867,6 +1138,7 @@ RZ_API bool rz_bin_object_reset_strings(RZ_NONNULL RzBin *bin, RZ_NONNULL RzBinF
  */
 RZ_API RZ_BORROW RzBinString *rz_bin_object_get_string_at(RZ_NONNULL RzBinObject *obj, ut64 address, bool is_va) {
 	rz_return_val_if_fail(obj, false);
+	bin_object_load_strings(obj);
 	if (!obj->strings) {
 		return NULL;
 	}
@@ -0,0 +1,955 @@
+// SPDX-FileCopyrightText: 2024 RizinOrg <info@rizin.re>
+// SPDX-License-Identifier: LGPL-3.0-only
+
+/**
+ * \file bobj_cache.c
+ * Persistent snapshots of the items of an RzBinObject.
+ *
+ * When `bin.cache` points to a directory, the symbols, imports, libs, relocs
+ * and source lines of every loaded object are serialized into
+ * `<dir>/<size>-<mtime>.<plugin>.obj` and the strings into `<dir>/<size>-<mtime>.<plugin>.str`,
+ * where size and mtime are the ones of the loaded file. Later loads of the same
+ * file map the snapshot instead of asking the plugin to parse these items again.
+ *
+ * Every snapshot starts with a fingerprint of the format version, the rizin and
+ * plugin versions and all the options that change the loaded items, followed by
+ * the sha256 of the content. The content is only hashed once a snapshot with the
+ * same key and fingerprint is found, or when writing one. A snapshot taken with
+ * different settings or of another content is simply ignored and overwritten.
+ * Once the directory grows beyond `bin.cache.maxsize`, the least recently written
+ * snapshots are removed.
+ * Integers are encoded as ULEB128, strings as ULEB128(length + 1) followed by
+ * the bytes, with 0 meaning NULL.
+ */
+
+#include <rz_bin.h>
+#include <rz_hash.h>
+#include <rz_util.h>
+#include <ht_uu.h>
+#include "i/private.h"
+#if __WINDOWS__
+#include <rz_windows.h>
+#endif
+
+#define BIN_CACHE_MAGIC   "RZBC"
+#define BIN_CACHE_VERSION 2
+
+#define BIN_CACHE_KIND_OBJECT  'o'
+#define BIN_CACHE_KIND_STRINGS 's'
+
+#define BIN_CACHE_REF_NONE   0
+#define BIN_CACHE_REF_INDEX  1
+#define BIN_CACHE_REF_INLINE 2
+
+struct rz_bin_object_cache_t {
+	char *path; ///< snapshot path without the extension
+	char *digest; ///< sha256 of the content, computed on the first candidate hit or write
+	RzList /*<RzBinSymbol *>*/ *symbols; ///< reloc symbols that are not part of RzBinObject.symbols
+	RzList /*<RzBinImport *>*/ *imports; ///< reloc imports that are not part of RzBinObject.imports
+};
+
+typedef struct {
+	RzVector /*<ut8>*/ data;
+	bool error;
+} CacheWriter;
+
+typedef struct {
+	const ut8 *cur;
+	const ut8 *end;
+	bool error;
+} CacheReader;
+
+RZ_IPI void rz_bin_object_cache_free(RZ_NULLABLE RzBinObjectCache *cache) {
+	if (!cache) {
+		return;
+	}
+	rz_list_free(cache->symbols);
+	rz_list_free(cache->imports);
+	free(cache->path);
+	free(cache->digest);
+	free(cache);
+}
+
+static ut64 cache_hash_chunk(const ut8 *buf, ut64 size, void *user) {
+	if (!rz_hash_cfg_update((RzHashCfg *)user, buf, size)) {
+		return 0;
+	}
+	return size;
+}
+
+static char *cache_content_hash(RzBin *bin, RzBuffer *buf) {
+	ut64 size = rz_buf_size(buf);
+	if (!size || !bin->hash) {
+		return NULL;
+	}
+	RzHashCfg *md = rz_hash_cfg_new_with_algo(bin->hash, "sha256", NULL, 0);
+	if (!md) {
+		return NULL;
+	}
+	char *digest = NULL;
+	if (rz_buf_fwd_scan(buf, 0, size, cache_hash_chunk, md) == size && rz_hash_cfg_final(md)) {
+		digest = rz_hash_cfg_get_result_string(md, "sha256", NULL, false);
+	}
+	rz_hash_cfg_free(md);
+	return digest;
+}
+
+static RzBinObjectCache *cache_get(RzBinFile *bf, RzBinObject *o) {
+	if (o->cache) {
+		return o->cache;
+	}
+	RzBin *bin = bf->rbin;
+	if (RZ_STR_ISEMPTY(bin->cache_dir) || !bf->buf || !o->plugin->name) {
+		return NULL;
+	}
+	ut64 size = rz_buf_size(bf->buf);
+	if (!size) {
+		return NULL;
+	}
+	RzBinObjectCache *cache = RZ_NEW0(RzBinObjectCache);
+	if (!cache) {
+		return NULL;
+	}
+	// buffers not backed by a file get a 0 mtime, the digest in the header still tells them apart
+	ut64 mtime = RZ_STR_ISNOTEMPTY(bf->file) ? rz_file_mtime(bf->file) : 0;
+	char *name = rz_str_newf("%" PFMT64x "-%" PFMT64x ".%s", size, mtime, o->plugin->name);
+	if (name) {
+		cache->path = rz_file_path_join(bin->cache_dir, name);
+		free(name);
+	}
+	if (!cache->path) {
+		rz_bin_object_cache_free(cache);
+		return NULL;
+	}
+	o->cache = cache;
+	return cache;
+}
+
+static const char *cache_digest(RzBinFile *bf, RzBinObjectCache *cache) {
+	if (!cache->digest) {
+		cache->digest = cache_content_hash(bf->rbin, bf->buf);
+	}
+	return cache->digest;
+}
+
+/**
+ * Everything that changes the items loaded from the same content.
+ */
+static char *cache_fingerprint(RzBinFile *bf, RzBinObject *o) {
+	RzBin *bin = bf->rbin;
+	RzBinPlugin *p = o->plugin;
+	return rz_str_newf("%s;%s;%s;0x%" PFMT64x ";0x%" PFMT64x ";0x%" PFMT64x ";%d%d%d%d%d;"
+			   "%d;0x%" PFMT64x ";%d;%d;0x%" PFMT64x ";%d;%d;%d;%s;%s;%s",
+		RZ_VERSION, p->name, rz_str_get(p->version),
+		o->boffset, o->opts.baseaddr, o->opts.loadaddr,
+		o->opts.patch_relocs, o->opts.big_endian, o->opts.elf_load_sections,
+		o->opts.elf_checks_sections, o->opts.elf_checks_segments,
+		bin->filter, bin->filter_rules, bin->minstrlen, bin->maxstrlen, bin->maxstrbuf,
+		bin->rawstr, bin->debase64, bin->strfilter,
+		rz_str_get(bin->prefix), rz_str_get(bin->strenc), rz_str_get(bin->strpurge));
+}
+
+static void write_bytes(CacheWriter *w, const void *data, size_t size) {
+	if (size && !rz_vector_insert_range(&w->data, rz_vector_len(&w->data), (void *)data, size)) {
+		w->error = true;
+	}
+}
+
+static void write_uleb(CacheWriter *w, ut64 value) {
+	ut8 tmp[10];
+	size_t n = 0;
+	do {
+		tmp[n] = value & 0x7f;
+		value >>= 7;
+		if (value) {
+			tmp[n] |= 0x80;
+		}
+		n++;
+	} while (value);
+	write_bytes(w, tmp, n);
+}
+
+static void write_str(CacheWriter *w, const char *s) {
+	if (!s) {
+		write_uleb(w, 0);
+		return;
+	}
+	size_t len = strlen(s);
+	write_uleb(w, len + 1);
+	write_bytes(w, s, len);
+}
+
+static ut64 read_uleb(CacheReader *r) {
+	ut64 value = 0;
+	for (ut32 shift = 0; !r->error && r->cur < r->end && shift < 64; shift += 7) {
+		ut8 b = *r->cur++;
+		value |= (ut64)(b & 0x7f) << shift;
+		if (!(b & 0x80)) {
+			return value;
+		}
+	}
+	r->error = true;
+	return 0;
+}
+
+/**
+ * Reads an element count, which can never exceed the remaining bytes
+ * since every element takes at least one.
+ */
+static size_t read_count(CacheReader *r) {
+	ut64 count = read_uleb(r);
+	if (count > (ut64)(r->end - r->cur)) {
+		r->error = true;
+		return 0;
+	}
+	return (size_t)count;
+}
+
+static char *read_str(CacheReader *r) {
+	ut64 len = read_uleb(r);
+	if (!len || r->error) {
+		return NULL;
+	}
+	len--;
+	if (len > (ut64)(r->end - r->cur)) {
+		r->error = true;
+		return NULL;
+	}
+	char *s = rz_str_ndup((const char *)r->cur, (int)len);
+	if (!s) {
+		r->error = true;
+		return NULL;
+	}
+	r->cur += len;
+	return s;
+}
+
+static const char *read_const_str(CacheReader *r, RzBin *bin) {
+	char *s = read_str(r);
+	if (!s) {
+		return NULL;
+	}
+	const char *interned = rz_str_constpool_get(&bin->constpool, s);
+	free(s);
+	return interned;
+}
+
+static void write_header(CacheWriter *w, char kind, const char *fingerprint, const char *digest) {
+	write_bytes(w, BIN_CACHE_MAGIC, strlen(BIN_CACHE_MAGIC));
+	write_uleb(w, BIN_CACHE_VERSION);
+	write_uleb(w, kind);
+	write_str(w, fingerprint);
+	write_str(w, digest);
+}
+
+/**
+ * Checks the header of a candidate snapshot, the content of \p bf
+ * is hashed only if everything else matches.
+ */
+static bool read_header(CacheReader *r, char kind, const char *fingerprint, RzBinFile *bf, RzBinObjectCache *cache) {
+	size_t magic_len = strlen(BIN_CACHE_MAGIC);
+	if ((size_t)(r->end - r->cur) < magic_len || memcmp(r->cur, BIN_CACHE_MAGIC, magic_len)) {
+		return false;
+	}
+	r->cur += magic_len;
+	if (read_uleb(r) != BIN_CACHE_VERSION || read_uleb(r) != kind) {
+		return false;
+	}
+	char *stored = read_str(r);
+	bool match = !r->error && stored && !strcmp(stored, fingerprint);
+	free(stored);
+	if (!match) {
+		return false;
+	}
+	stored = read_str(r);
+	const char *digest = !r->error && stored ? cache_digest(bf, cache) : NULL;
+	match = digest && !strcmp(stored, digest);
+	free(stored);
+	return match;
+}
+
+static void write_symbol(CacheWriter *w, RzBinSymbol *sym) {
+	write_str(w, sym->name);
+	write_str(w, sym->dname);
+	write_str(w, sym->libname);
+	write_str(w, sym->classname);
+	write_str(w, sym->visibility_str);
+	write_str(w, sym->forwarder);
+	write_str(w, sym->bind);
+	write_str(w, sym->type);
+	write_str(w, sym->rtype);
+	write_uleb(w, sym->is_imported);
+	write_uleb(w, sym->vaddr);
+	write_uleb(w, sym->paddr);
+	write_uleb(w, sym->size);
+	write_uleb(w, sym->ordinal);
+	write_uleb(w, sym->visibility);
+	write_uleb(w, (ut32)sym->bits);
+	write_uleb(w, sym->method_flags);
+	write_uleb(w, (ut32)sym->dup_count);
+}
+
+static RzBinSymbol *read_symbol(CacheReader *r, RzBin *bin) {
+	RzBinSymbol *sym = RZ_NEW0(RzBinSymbol);
+	if (!sym) {
+		r->error = true;
+		return NULL;
+	}
+	sym->name = read_str(r);
+	sym->dname = read_str(r);
+	sym->libname = read_str(r);
+	sym->classname = read_str(r);
+	sym->visibility_str = read_str(r);
+	sym->forwarder = read_const_str(r, bin);
+	sym->bind = read_const_str(r, bin);
+	sym->type = read_const_str(r, bin);
+	sym->rtype = read_const_str(r, bin);
+	sym->is_imported = read_uleb(r);
+	sym->vaddr = read_uleb(r);
+	sym->paddr = read_uleb(r);
+	sym->size = read_uleb(r);
+	sym->ordinal = read_uleb(r);
+	sym->visibility = read_uleb(r);
+	sym->bits = (int)(ut32)read_uleb(r);
+	sym->method_flags = read_uleb(r);
+	sym->dup_count = (int)(ut32)read_uleb(r);
+	if (r->error) {
+		rz_bin_symbol_free(sym);
+		return NULL;
+	}
+	return sym;
+}
+
+static void write_import(CacheWriter *w, RzBinImport *imp) {
+	write_str(w, imp->name);
+	write_str(w, imp->libname);
+	write_str(w, imp->bind);
+	write_str(w, imp->type);
+	write_str(w, imp->classname);
+	write_str(w, imp->descriptor);
+	write_uleb(w, imp->ordinal);
+	write_uleb(w, imp->visibility);
+}
+
+static RzBinImport *read_import(CacheReader *r, RzBin *bin) {
+	RzBinImport *imp = RZ_NEW0(RzBinImport);
+	if (!imp) {
+		r->error = true;
+		return NULL;
+	}
+	imp->name = read_str(r);
+	imp->libname = read_str(r);
+	imp->bind = read_const_str(r, bin);
+	imp->type = read_const_str(r, bin);
+	imp->classname = read_str(r);
+	imp->descriptor = read_str(r);
+	imp->ordinal = read_uleb(r);
+	imp->visibility = read_uleb(r);
+	if (r->error) {
+		rz_bin_import_free(imp);
+		return NULL;
+	}
+	return imp;
+}
+
+/**
+ * Lists are stored as count + 1, so that 0 can tell a NULL list apart from an empty one.
+ */
+static bool read_list_count(CacheReader *r, size_t *count) {
+	ut64 n = read_uleb(r);
+	if (!n || r->error) {
+		return false;
+	}
+	if (n - 1 > (ut64)(r->end - r->cur)) {
+		r->error = true;
+		return false;
+	}
+	*count = (size_t)(n - 1);
+	return true;
+}
+
+static void write_list_count(CacheWriter *w, RzList *list) {
+	write_uleb(w, list ? (ut64)rz_list_length(list) + 1 : 0);
+}
+
+/**
+ * Relocs usually point to the symbols and imports of the object itself,
+ * in that case only their index is stored.
+ */
+static void write_ref(CacheWriter *w, HtUU *indices, void *item, void (*write_item)(CacheWriter *, void *)) {
+	if (!item) {
+		write_uleb(w, BIN_CACHE_REF_NONE);
+		return;
+	}
+	bool found = false;
+	ut64 index = ht_uu_find(indices, (ut64)(size_t)item, &found);
+	if (found) {
+		write_uleb(w, BIN_CACHE_REF_INDEX);
+		write_uleb(w, index);
+		return;
+	}
+	write_uleb(w, BIN_CACHE_REF_INLINE);
+	write_item(w, item);
+}
+
+static HtUU *index_list(RzList *list) {
+	HtUU *ht = ht_uu_new0();
+	if (!ht) {
+		return NULL;
+	}
+	ut64 i = 0;
+	RzListIter *it;
+	void *item;
+	rz_list_foreach (list, it, item) {
+		ht_uu_insert(ht, (ut64)(size_t)item, i++);
+	}
+	return ht;
+}
+
+static void write_relocs(CacheWriter *w, RzBinObject *o) {
+	RzBinRelocStorage *relocs = o->relocs;
+	if (!relocs) {
+		write_uleb(w, 0);
+		return;
+	}
+	HtUU *symbols = index_list(o->symbols);
+	HtUU *imports = index_list(o->imports);
+	if (!symbols || !imports) {
+		w->error = true;
+		goto beach;
+	}
+	write_uleb(w, (ut64)relocs->relocs_count + 1);
+	for (size_t i = 0; i < relocs->relocs_count; i++) {
+		RzBinReloc *reloc = relocs->relocs[i];
+		write_uleb(w, reloc->type);
+		write_ref(w, symbols, reloc->symbol, (void (*)(CacheWriter *, void *))write_symbol);
+		write_ref(w, imports, reloc->import, (void (*)(CacheWriter *, void *))write_import);
+		write_uleb(w, (ut64)reloc->addend);
+		write_uleb(w, reloc->vaddr);
+		write_uleb(w, reloc->paddr);
+		write_uleb(w, reloc->target_vaddr);
+		write_uleb(w, reloc->visibility);
+		write_uleb(w, reloc->additive);
+		write_uleb(w, reloc->is_ifunc);
+	}
+beach:
+	ht_uu_free(symbols);
+	ht_uu_free(imports);
+}
+
+static void *read_ref(CacheReader *r, RzBin *bin, RzPVector *items, RzList *owned, void *(*read_item)(CacheReader *, RzBin *)) {
+	switch (read_uleb(r)) {
+	case BIN_CACHE_REF_NONE:
+		return NULL;
+	case BIN_CACHE_REF_INDEX: {
+		ut64 index = read_uleb(r);
+		if (index >= rz_pvector_len(items)) {
+			r->error = true;
+			return NULL;
+		}
+		return rz_pvector_at(items, index);
+	}
+	case BIN_CACHE_REF_INLINE: {
+		void *item = read_item(r, bin);
+		if (item && !rz_list_append(owned, item)) {
+			owned->free(item);
+			r->error = true;
+			return NULL;
+		}
+		return item;
+	}
+	default:
+		r->error = true;
+		return NULL;
+	}
+}
+
+static void pvector_from_list(RzPVector *vec, RzList *list) {
+	rz_pvector_init(vec, NULL);
+	rz_pvector_reserve(vec, rz_list_length(list));
+	RzListIter *it;
+	void *item;
+	rz_list_foreach (list, it, item) {
+		rz_pvector_push(vec, item);
+	}
+}
+
+static RzBinRelocStorage *read_relocs(CacheReader *r, RzBin *bin, RzList *symbols, RzList *imports, RzBinObjectCache *cache) {
+	size_t count;
+	if (!read_list_count(r, &count)) {
+		return NULL;
+	}
+	RzList *relocs = rz_list_newf((RzListFree)rz_bin_reloc_free);
+	if (!relocs) {
+		r->error = true;
+		return NULL;
+	}
+	RzPVector symbol_vec, import_vec;
+	pvector_from_list(&symbol_vec, symbols);
+	pvector_from_list(&import_vec, imports);
+	for (size_t i = 0; i < count && !r->error; i++) {
+		RzBinReloc *reloc = RZ_NEW0(RzBinReloc);
+		if (!reloc || !rz_list_append(relocs, reloc)) {
+			free(reloc);
+			r->error = true;
+			break;
+		}
+		reloc->type = read_uleb(r);
+		reloc->symbol = read_ref(r, bin, &symbol_vec, cache->symbols, (void *(*)(CacheReader *, RzBin *))read_symbol);
+		reloc->import = read_ref(r, bin, &import_vec, cache->imports, (void *(*)(CacheReader *, RzBin *))read_import);
+		reloc->addend = (st64)read_uleb(r);
+		reloc->vaddr = read_uleb(r);
+		reloc->paddr = read_uleb(r);
+		reloc->target_vaddr = read_uleb(r);
+		reloc->visibility = read_uleb(r);
+		reloc->additive = read_uleb(r);
+		reloc->is_ifunc = read_uleb(r);
+	}
+	rz_pvector_fini(&symbol_vec);
+	rz_pvector_fini(&import_vec);
+	if (r->error) {
+		rz_list_free(relocs);
+		return NULL;
+	}
+	RzBinRelocStorage *storage = rz_bin_reloc_storage_new(relocs);
+	if (!storage) {
+		r->error = true;
+	}
+	return storage;
+}
+
+static void write_lines(CacheWriter *w, RzBinSourceLineInfo *lines) {
+	if (!lines) {
+		write_uleb(w, 0);
+		return;
+	}
+	HtPU *files = ht_pu_new0();
+	RzPVector file_table;
+	rz_pvector_init(&file_table, NULL);
+	if (!files) {
+		w->error = true;
+		return;
+	}
+	for (size_t i = 0; i < lines->samples_count; i++) {
+		const char *file = lines->samples[i].file;
+		if (file && !ht_pu_find(files, file, NULL)) {
+			rz_pvector_push(&file_table, (void *)file);
+			ht_pu_insert(files, file, rz_pvector_len(&file_table));
+		}
+	}
+	write_uleb(w, (ut64)lines->samples_count + 1);
+	write_uleb(w, rz_pvector_len(&file_table));
+	void **it;
+	rz_pvector_foreach (&file_table, it) {
+		write_str(w, *it);
+	}
+	for (size_t i = 0; i < lines->samples_count; i++) {
+		RzBinSourceLineSample *sample = &lines->samples[i];
+		write_uleb(w, sample->address);
+		write_uleb(w, sample->line);
+		write_uleb(w, sample->column);
+		write_uleb(w, sample->file ? ht_pu_find(files, sample->file, NULL) : 0);
+	}
+	rz_pvector_fini(&file_table);
+	ht_pu_free(files);
+}
+
+static RzBinSourceLineInfo *read_lines(CacheReader *r) {
+	size_t count;
+	if (!read_list_count(r, &count)) {
+		return NULL;
+	}
+	RzBinSourceLineInfoBuilder builder;
+	rz_bin_source_line_info_builder_init(&builder);
+	RzPVector file_table;
+	rz_pvector_init(&file_table, free);
+	size_t files_count = read_count(r);
+	for (size_t i = 0; i < files_count && !r->error; i++) {
+		char *file = read_str(r);
+		if (!file || !rz_pvector_push(&file_table, file)) {
+			free(file);
+			r->error = true;
+		}
+	}
+	for (size_t i = 0; i < count && !r->error; i++) {
+		ut64 address = read_uleb(r);
+		ut32 line = read_uleb(r);
+		ut32 column = read_uleb(r);
+		ut64 file = read_uleb(r);
+		if (file > rz_pvector_len(&file_table)) {
+			r->error = true;
+			break;
+		}
+		rz_bin_source_line_info_builder_push_sample(&builder, address, line, column,
+			file ? rz_pvector_at(&file_table, file - 1) : NULL);
+	}
+	rz_pvector_fini(&file_table);
+	if (r->error) {
+		rz_bin_source_line_info_builder_fini(&builder);
+		return NULL;
+	}
+	RzBinSourceLineInfo *lines = rz_bin_source_line_info_builder_build_and_fini(&builder);
+	if (!lines) {
+		r->error = true;
+	}
+	return lines;
+}
+
+typedef struct {
+	char *path;
+	ut64 size;
+	ut64 mtime;
+} CacheFile;
+
+static int cache_file_cmp(const void *a, const void *b) {
+	const CacheFile *fa = a, *fb = b;
+	return fa->mtime < fb->mtime ? -1 : fa->mtime > fb->mtime;
+}
+
+/**
+ * Removes the least recently written snapshots, other than \p keep,
+ * until the directory fits in bin.cache.maxsize.
+ */
+static void cache_evict(RzBin *bin, const char *keep) {
+	if (!bin->cache_max_size) {
+		return;
+	}
+	RzList *names = rz_sys_dir(bin->cache_dir);
+	if (!names) {
+		return;
+	}
+	RzVector files;
+	rz_vector_init(&files, sizeof(CacheFile), NULL, NULL);
+	ut64 total = 0;
+	RzListIter *it;
+	const char *name;
+	rz_list_foreach (names, it, name) {
+		if (!rz_str_endswith(name, ".obj") && !rz_str_endswith(name, ".str")) {
+			continue;
+		}
+		CacheFile f = { .path = rz_file_path_join(bin->cache_dir, name) };
+		if (!f.path) {
+			continue;
+		}
+		f.size = rz_file_size(f.path);
+		f.mtime = rz_file_mtime(f.path);
+		total += f.size;
+		if (!strcmp(f.path, keep) || !rz_vector_push(&files, &f)) {
+			free(f.path);
+		}
+	}
+	rz_list_free(names);
+	rz_vector_sort(&files, cache_file_cmp, false);
+	CacheFile *f;
+	rz_vector_foreach(&files, f) {
+		if (total > bin->cache_max_size && rz_file_rm(f->path)) {
+			total -= f->size;
+		}
+		free(f->path);
+	}
+	rz_vector_fini(&files);
+}
+
+/**
+ * Moves \p src over \p dst, replacing it if it exists.
+ */
+static bool cache_replace_file(const char *src, const char *dst) {
+#if __WINDOWS__
+	// rename() fails on Windows when the destination exists
+	wchar_t *src_ = rz_utf8_to_utf16(src);
+	wchar_t *dst_ = rz_utf8_to_utf16(dst);
+	bool ok = src_ && dst_ && MoveFileExW(src_, dst_, MOVEFILE_REPLACE_EXISTING);
+	free(src_);
+	free(dst_);
+	return ok;
+#else
+	return !rename(src, dst);
+#endif
+}
+
+static bool cache_write_file(RzBin *bin, CacheWriter *w, const char *path) {
+	size_t size = rz_vector_len(&w->data);
+	if (w->error || size > INT_MAX) {
+		return false;
+	}
+	char *dir = rz_file_dirname(path);
+	if (!dir || !rz_sys_mkdirp(dir)) {
+		RZ_LOG_WARN("bin.cache: cannot create directory %s\n", rz_str_get(dir));
+		free(dir);
+		return false;
+	}
+	free(dir);
+	// write a temporary file and rename it, so that no reader sees a partial snapshot
+	char *tmp = rz_str_newf("%s.%d.tmp", path, rz_sys_getpid());
+	if (!tmp) {
+		return false;
+	}
+	bool ok = rz_file_dump(tmp, rz_vector_head(&w->data), (int)size, false) && cache_replace_file(tmp, path);
+	if (!ok) {
+		RZ_LOG_WARN("bin.cache: cannot write %s\n", path);
+		rz_file_rm(tmp);
+	}
+	free(tmp);
+	if (ok) {
+		cache_evict(bin, path);
+	}
+	return ok;
+}
+
+static RzMmap *cache_map_file(const char *path) {
+	if (!rz_file_exists(path)) {
+		return NULL;
+	}
+	RzMmap *m = rz_file_mmap(path, RZ_PERM_R, 0, 0);
+	if (m && (!m->buf || !m->len)) {
+		rz_file_mmap_free(m);
+		return NULL;
+	}
+	return m;
+}
+
+static char *cache_file_path(RzBinObjectCache *cache, char kind) {
+	return rz_str_newf("%s.%s", cache->path, kind == BIN_CACHE_KIND_STRINGS ? "str" : "obj");
+}
+
+/**
+ * \brief Loads symbols, imports, libs, relocs and source lines of \p o from its bin.cache snapshot
+ *
+ * \return true if the items were loaded and must not be requested from the plugin again
+ */
+RZ_IPI bool rz_bin_object_cache_load(RZ_NONNULL RzBinFile *bf, RZ_NONNULL RzBinObject *o) {
+	rz_return_val_if_fail(bf && o, false);
+	RzBinObjectCache *cache = cache_get(bf, o);
+	if (!cache) {
+		return false;
+	}
+	char *path = cache_file_path(cache, BIN_CACHE_KIND_OBJECT);
+	RzMmap *m = path ? cache_map_file(path) : NULL;
+	char *fingerprint = m ? cache_fingerprint(bf, o) : NULL;
+	if (!fingerprint) {
+		rz_file_mmap_free(m);
+		free(path);
+		return false;
+	}
+
+	RzBin *bin = bf->rbin;
+	CacheReader r = { .cur = m->buf, .end = m->buf + m->len };
+	RzList *symbols = NULL, *imports = NULL, *libs = NULL;
+	RzBinRelocStorage *relocs = NULL;
+	RzBinSourceLineInfo *lines = NULL;
+	size_t reloc_symbols = 0, reloc_imports = 0;
+	if (!cache->symbols) {
+		cache->symbols = rz_list_newf((RzListFree)rz_bin_symbol_free);
+	}
+	if (!cache->imports) {
+		cache->imports = rz_list_newf((RzListFree)rz_bin_import_free);
+	}
+	if (!cache->symbols || !cache->imports || !read_header(&r, BIN_CACHE_KIND_OBJECT, fingerprint, bf, cache)) {
+		goto miss;
+	}
+	reloc_symbols = rz_list_length(cache->symbols);
+	reloc_imports = rz_list_length(cache->imports);
+
+	size_t count;
+	if (read_list_count(&r, &count)) {
+		symbols = rz_list_newf((RzListFree)rz_bin_symbol_free);
+		for (size_t i = 0; symbols && i < count && !r.error; i++) {
+			RzBinSymbol *sym = read_symbol(&r, bin);
+			if (sym && !rz_list_append(symbols, sym)) {
+				rz_bin_symbol_free(sym);
+				r.error = true;
+			}
+		}
+		r.error |= !symbols;
+	}
+	if (!r.error && read_list_count(&r, &count)) {
+		imports = rz_list_newf((RzListFree)rz_bin_import_free);
+		for (size_t i = 0; imports && i < count && !r.error; i++) {
+			RzBinImport *imp = read_import(&r, bin);
+			if (imp && !rz_list_append(imports, imp)) {
+				rz_bin_import_free(imp);
+				r.error = true;
+			}
+		}
+		r.error |= !imports;
+	}
+	if (!r.error && read_list_count(&r, &count)) {
+		libs = rz_list_newf(free);
+		for (size_t i = 0; libs && i < count && !r.error; i++) {
+			char *lib = read_str(&r);
+			if (!rz_list_append(libs, lib)) {
+				free(lib);
+				r.error = true;
+			}
+		}
+		r.error |= !libs;
+	}
+	if (!r.error) {
+		relocs = read_relocs(&r, bin, symbols, imports, cache);
+	}
+	if (!r.error) {
+		lines = read_lines(&r);
+	}
+	if (r.error || r.cur != r.end) {
+		goto miss;
+	}
+
+	rz_file_mmap_free(m);
+	free(fingerprint);
+	free(path);
+	rz_list_free(o->imports);
+	o->symbols = symbols;
+	o->imports = imports;
+	o->libs = libs;
+	o->relocs = relocs;
+	o->lines = lines;
+	return true;
+
+miss:
+	if (bin->verbose) {
+		RZ_LOG_WARN("bin.cache: ignoring stale snapshot %s\n", path);
+	}
+	// drop the reloc items read before the failure
+	while (cache->symbols && rz_list_length(cache->symbols) > reloc_symbols) {
+		rz_bin_symbol_free(rz_list_pop(cache->symbols));
+	}
+	while (cache->imports && rz_list_length(cache->imports) > reloc_imports) {
+		rz_bin_import_free(rz_list_pop(cache->imports));
+	}
+	rz_bin_reloc_storage_free(relocs);
+	rz_bin_source_line_info_free(lines);
+	rz_list_free(symbols);
+	rz_list_free(imports);
+	rz_list_free(libs);
+	rz_file_mmap_free(m);
+	free(fingerprint);
+	free(path);
+	return false;
+}
+
+/**
+ * \brief Writes symbols, imports, libs, relocs and source lines of \p o into its bin.cache snapshot
+ */
+RZ_IPI void rz_bin_object_cache_save(RZ_NONNULL RzBinFile *bf, RZ_NONNULL RzBinObject *o) {
+	rz_return_if_fail(bf && o);
+	RzBinObjectCache *cache = cache_get(bf, o);
+	const char *digest = cache ? cache_digest(bf, cache) : NULL;
+	char *fingerprint = digest ? cache_fingerprint(bf, o) : NULL;
+	char *path = fingerprint ? cache_file_path(cache, BIN_CACHE_KIND_OBJECT) : NULL;
+	if (!path) {
+		free(fingerprint);
+		return;
+	}
+	CacheWriter w = { 0 };
+	rz_vector_init(&w.data, sizeof(ut8), NULL, NULL);
+	write_header(&w, BIN_CACHE_KIND_OBJECT, fingerprint, digest);
+
+	RzListIter *it;
+	RzBinSymbol *sym;
+	write_list_count(&w, o->symbols);
+	rz_list_foreach (o->symbols, it, sym) {
+		write_symbol(&w, sym);
+	}
+	RzBinImport *imp;
+	write_list_count(&w, o->imports);
+	rz_list_foreach (o->imports, it, imp) {
+		write_import(&w, imp);
+	}
+	char *lib;
+	write_list_count(&w, o->libs);
+	rz_list_foreach (o->libs, it, lib) {
+		write_str(&w, lib);
+	}
+	write_relocs(&w, o);
+	write_lines(&w, o->lines);
+
+	cache_write_file(bf->rbin, &w, path);
+	rz_vector_fini(&w.data);
+	free(fingerprint);
+	free(path);
+}
+
+/**
+ * \brief Loads the strings of \p o from its bin.cache snapshot
+ *
+ * \return the string database or NULL if there is no valid snapshot
+ */
+RZ_IPI RZ_OWN RzBinStrDb *rz_bin_object_cache_load_strings(RZ_NONNULL RzBinFile *bf, RZ_NONNULL RzBinObject *o) {
+	rz_return_val_if_fail(bf && o, NULL);
+	RzBinObjectCache *cache = cache_get(bf, o);
+	if (!cache) {
+		return NULL;
+	}
+	char *path = cache_file_path(cache, BIN_CACHE_KIND_STRINGS);
+	RzMmap *m = path ? cache_map_file(path) : NULL;
+	char *fingerprint = m ? cache_fingerprint(bf, o) : NULL;
+	RzList *strings = NULL;
+	if (!fingerprint) {
+		goto beach;
+	}
+	CacheReader r = { .cur = m->buf, .end = m->buf + m->len };
+	size_t count;
+	if (!read_header(&r, BIN_CACHE_KIND_STRINGS, fingerprint, bf, cache) || !read_list_count(&r, &count)) {
+		goto beach;
+	}
+	strings = rz_list_newf(rz_bin_string_free);
+	for (size_t i = 0; strings && i < count && !r.error; i++) {
+		RzBinString *bstr = RZ_NEW0(RzBinString);
+		if (!bstr || !rz_list_append(strings, bstr)) {
+			free(bstr);
+			r.error = true;
+			break;
+		}
+		bstr->string = read_str(&r);
+		bstr->vaddr = read_uleb(&r);
+		bstr->paddr = read_uleb(&r);
+		bstr->ordinal = read_uleb(&r);
+		bstr->size = read_uleb(&r);
+		bstr->length = read_uleb(&r);
+		bstr->type = read_uleb(&r);
+	}
+	if (!strings || r.error || r.cur != r.end) {
+		RZ_FREE_CUSTOM(strings, rz_list_free);
+	}
+
+beach:
+	rz_file_mmap_free(m);
+	free(fingerprint);
+	free(path);
+	// RzBinStrDb becomes the owner of the RzList strings
+	return strings ? rz_bin_string_database_new(strings) : NULL;
+}
+
+/**
+ * \brief Writes the strings of \p o into its bin.cache snapshot
+ */
+RZ_IPI void rz_bin_object_cache_save_strings(RZ_NONNULL RzBinFile *bf, RZ_NONNULL RzBinObject *o) {
+	rz_return_if_fail(bf && o);
+	RzBinObjectCache *cache = o->strings ? cache_get(bf, o) : NULL;
+	const char *digest = cache ? cache_digest(bf, cache) : NULL;
+	char *fingerprint = digest ? cache_fingerprint(bf, o) : NULL;
+	char *path = fingerprint ? cache_file_path(cache, BIN_CACHE_KIND_STRINGS) : NULL;
+	if (!path) {
+		free(fingerprint);
+		return;
+	}
+	CacheWriter w = { 0 };
+	rz_vector_init(&w.data, sizeof(ut8), NULL, NULL);
+	write_header(&w, BIN_CACHE_KIND_STRINGS, fingerprint, digest);
+	write_list_count(&w, o->strings->list);
+	RzListIter *it;
+	RzBinString *bstr;
+	rz_list_foreach (o->strings->list, it, bstr) {
+		write_str(&w, bstr->string);
+		write_uleb(&w, bstr->vaddr);
+		write_uleb(&w, bstr->paddr);
+		write_uleb(&w, bstr->ordinal);
+		write_uleb(&w, bstr->size);
+		write_uleb(&w, bstr->length);
+		write_uleb(&w, bstr->type);
+	}
+	cache_write_file(bf->rbin, &w, path);
+	rz_vector_fini(&w.data);
+	free(fingerprint);
+	free(path);
+}
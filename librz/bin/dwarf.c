@@ -1202,9 +1202,17 @@ static bool init_debug_info(RzBinDwarfDebugInfo *inf) {
 	if (!inf->line_info_offset_comp_dir) {
 		goto wurzelbert_comp_units;
 	}
+	// also needed when parsed whole, the units are pinned by several threads
+	inf->lazy.lock = rz_th_lock_new(false);
+	if (!inf->lazy.lock) {
+		goto wurzelbert_comp_dir;
+	}
 	inf->capacity = DEBUG_INFO_CAPACITY;
 	inf->count = 0;
 	return true;
+wurzelbert_comp_dir:
+	ht_up_free(inf->line_info_offset_comp_dir);
+	inf->line_info_offset_comp_dir = NULL;
 wurzelbert_comp_units:
 	RZ_FREE(inf->comp_units);
 	return false;
@@ -1414,6 +1422,9 @@ RZ_API void rz_bin_dwarf_debug_info_free(RzBinDwarfDebugInfo *inf) {
 	ht_up_free(inf->line_info_offset_comp_dir);
 	ht_up_free(inf->lookup_table);
 	free(inf->comp_units);
+	free(inf->lazy.debug_info);
+	free(inf->lazy.debug_str);
+	rz_th_lock_free(inf->lazy.lock);
 	free(inf);
 }
 
@@ -1711,7 +1722,7 @@ static const ut8 *parse_attr_value(const ut8 *obuf, int obuf_len,
 /**
  * \param buf Start of the DIE data
  * \param buf_end
- * \param info debug info where the line_info_offset_comp_dir will be populated if such an entry is found
+ * \param info debug info where the line_info_offset_comp_dir will be populated if such an entry is found, can be NULL
  * \param abbrev Abbreviation of the DIE
  * \param hdr Unit header
  * \param die DIE to store the parsed info into
@@ -1749,7 +1760,7 @@ static const ut8 *parse_die(const ut8 *buf, const ut8 *buf_end, RzBinDwarfDebugI
 
 	// If this is a compilation unit dir attribute, we want to cache it so the line info parsing
 	// which will need this info can quickly look it up.
-	if (comp_dir && line_info_offset != UT64_MAX) {
+	if (info && comp_dir && line_info_offset != UT64_MAX) {
 		char *name = strdup(comp_dir);
 		if (name) {
 			if (!ht_up_insert(info->line_info_offset_comp_dir, line_info_offset, name)) {
@@ -1951,6 +1962,7 @@ static RzBinDwarfDebugInfo *parse_info_raw(RzBinDwarfDebugAbbrev *da,
 		}
 		// They point to the same array object, so should be def. behaviour
 		size_t first_abbr_idx = abbrev_start - da->decls;
+		unit->first_abbr_idx = first_abbr_idx;
 
 		buf = parse_comp_unit(info, buf, buf_end - buf, unit, da, first_abbr_idx, debug_str, debug_str_len, big_endian);
 
@@ -1970,6 +1982,96 @@ cleanup:
 	return NULL;
 }
 
+static inline ut64 comp_unit_hdr_total_size(const RzBinDwarfCompUnitHdr *hdr) {
+	return (hdr->is_64bit ? 12 : 4) + hdr->header_size;
+}
+
+/**
+ * \brief Parses only the first DIE of the unit, which holds the DW_AT_comp_dir
+ *        needed later by the line information.
+ */
+static void index_comp_unit(RzBinDwarfDebugInfo *info, const ut8 *buf, const ut8 *buf_end, RzBinDwarfCompUnit *unit,
+	const RzBinDwarfDebugAbbrev *da, const ut8 *debug_str, size_t debug_str_len, bool big_endian) {
+	ut64 abbr_code;
+	buf = rz_uleb128(buf, buf_end - buf, &abbr_code, NULL);
+	if (!buf || !abbr_code || buf >= buf_end) {
+		return;
+	}
+	ut64 abbr_idx = unit->first_abbr_idx + abbr_code;
+	if (da->count < abbr_idx) {
+		return;
+	}
+	RzBinDwarfAbbrevDecl *abbrev = &da->decls[abbr_idx - 1];
+	RzBinDwarfDie die = { 0 };
+	if (!init_die(&die, abbr_code, abbrev->count)) {
+		parse_die(buf, buf_end, info, abbrev, &unit->hdr, &die, debug_str, debug_str_len, big_endian);
+	}
+	free_die(&die);
+}
+
+/**
+ * \brief Reads the unit headers of the whole .debug_info section without decoding their DIEs
+ *
+ * \param da Parsed Abbreviations
+ * \param obuf .debug_info section buffer start
+ * \param len length of the section buffer
+ * \param debug_str start of the .debug_str section
+ * \param debug_str_len length of the debug_str section
+ * \param big_endian
+ * \return Indexed information, the units have to be expanded with rz_bin_dwarf_debug_info_get_unit()
+ */
+static RzBinDwarfDebugInfo *index_info_raw(const RzBinDwarfDebugAbbrev *da,
+	const ut8 *obuf, size_t len,
+	const ut8 *debug_str, size_t debug_str_len, bool big_endian) {
+	rz_return_val_if_fail(da && obuf, NULL);
+
+	const ut8 *buf = obuf;
+	const ut8 *buf_end = obuf + len;
+
+	RzBinDwarfDebugInfo *info = RZ_NEW0(RzBinDwarfDebugInfo);
+	if (!info) {
+		return NULL;
+	}
+	if (!init_debug_info(info)) {
+		goto cleanup;
+	}
+
+	while (buf < buf_end) {
+		if (info->count >= info->capacity && expand_info(info)) {
+			break;
+		}
+		RzBinDwarfCompUnit *unit = &info->comp_units[info->count];
+		const ut8 *unit_start = buf;
+		unit->offset = buf - obuf;
+		unit->hdr.unit_offset = buf - obuf;
+
+		buf = info_comp_unit_read_hdr(buf, buf_end, &unit->hdr, big_endian);
+		if (unit->hdr.length > len) {
+			goto cleanup;
+		}
+
+		RzBinDwarfAbbrevDecl key = { .offset = unit->hdr.abbrev_offset };
+		RzBinDwarfAbbrevDecl *abbrev_start = bsearch(&key, da->decls, da->count, sizeof(key), abbrev_cmp);
+		if (!abbrev_start) {
+			goto cleanup;
+		}
+		unit->first_abbr_idx = abbrev_start - da->decls;
+		info->count++;
+
+		const ut8 *unit_end = unit_start + (unit->hdr.is_64bit ? 12 : 4) + unit->hdr.length;
+		if (unit_end <= buf || unit_end > buf_end) {
+			unit_end = buf_end;
+		}
+		index_comp_unit(info, buf, unit_end, unit, da, debug_str, debug_str_len, big_endian);
+		buf = unit_end;
+	}
+	return info;
+
+cleanup:
+	rz_bin_dwarf_debug_info_free(info);
+	return NULL;
+}
+
 static RzBinDwarfDebugAbbrev *parse_abbrev_raw(const ut8 *obuf, size_t len) {
 	const ut8 *buf = obuf, *buf_end = obuf + len;
 	ut64 tmp, attr_code, attr_form, offset;
@@ -2113,6 +2215,207 @@ cave_debug_str_buf:
 	return info;
 }
 
+/**
+ * \brief Indexes the .debug_info section, the DIEs are decoded only when their unit is requested
+ *
+ * Compared to rz_bin_dwarf_parse_info(), only the unit headers and the first DIE of every unit
+ * are read here. The units are decoded from the kept section data by
+ * rz_bin_dwarf_debug_info_get_unit() and can be dropped again with
+ * rz_bin_dwarf_debug_info_release_unit(), so that the memory needed does not grow
+ * with the size of the whole section. The lookup_table of the result is NULL,
+ * use rz_bin_dwarf_debug_info_find_die() instead.
+ *
+ * \param binfile RzBinFile to read the sections from
+ * \param da Parsed abbreviations, they must outlive the returned info
+ * \return RzBinDwarfDebugInfo* Indexed information, NULL if error
+ */
+RZ_API RzBinDwarfDebugInfo *rz_bin_dwarf_index_info(RzBinFile *binfile, RzBinDwarfDebugAbbrev *da) {
+	rz_return_val_if_fail(binfile && da, NULL);
+	size_t debug_str_len = 0;
+	ut8 *debug_str_buf = get_section_bytes(binfile, "debug_str", &debug_str_len);
+
+	size_t len;
+	ut8 *buf = get_section_bytes(binfile, "debug_info", &len);
+	if (!buf) {
+		free(debug_str_buf);
+		return NULL;
+	}
+	bool big_endian = binfile->o && binfile->o->info && binfile->o->info->big_endian;
+	RzBinDwarfDebugInfo *info = index_info_raw(da, buf, len, debug_str_buf, debug_str_len, big_endian);
+	if (!info) {
+		free(buf);
+		free(debug_str_buf);
+		return NULL;
+	}
+	info->lazy.abbrevs = da;
+	info->lazy.debug_info = buf;
+	info->lazy.debug_info_len = len;
+	info->lazy.debug_str = debug_str_buf;
+	info->lazy.debug_str_len = debug_str_len;
+	info->lazy.big_endian = big_endian;
+	return info;
+}
+
+/**
+ * \brief Returns the unit at \p idx, decoding its DIEs first when \p info was indexed
+ *
+ * It is safe to call this from multiple threads at the same time.
+ *
+ * \return the unit or NULL when \p idx is out of bounds or the unit cannot be decoded
+ */
+RZ_API RZ_BORROW RzBinDwarfCompUnit *rz_bin_dwarf_debug_info_get_unit(RZ_NONNULL RzBinDwarfDebugInfo *info, size_t idx) {
+	rz_return_val_if_fail(info, NULL);
+	if (idx >= info->count) {
+		return NULL;
+	}
+	RzBinDwarfCompUnit *unit = &info->comp_units[idx];
+	if (!info->lazy.debug_info) {
+		return unit;
+	}
+
+	rz_th_lock_enter(info->lazy.lock);
+	RzBinDwarfCompUnit tmp = *unit;
+	rz_th_lock_leave(info->lazy.lock);
+	if (tmp.dies) {
+		return unit;
+	}
+
+	// decode outside of the lock, so that different units can be expanded in parallel
+	const ut8 *buf = info->lazy.debug_info + unit->offset + comp_unit_hdr_total_size(&unit->hdr);
+	const ut8 *buf_end = info->lazy.debug_info + info->lazy.debug_info_len;
+	if (buf >= buf_end || init_comp_unit(&tmp) < 0) {
+		return NULL;
+	}
+	if (!parse_comp_unit(NULL, buf, buf_end - buf, &tmp, info->lazy.abbrevs, tmp.first_abbr_idx,
+		    info->lazy.debug_str, info->lazy.debug_str_len, info->lazy.big_endian)) {
+		free_comp_unit(&tmp);
+		return NULL;
+	}
+
+	rz_th_lock_enter(info->lazy.lock);
+	if (!unit->dies) {
+		unit->dies = tmp.dies;
+		unit->count = tmp.count;
+		unit->capacity = tmp.capacity;
+		tmp.dies = NULL;
+		tmp.count = 0;
+	}
+	rz_th_lock_leave(info->lazy.lock);
+	// another thread expanded the same unit in the meantime
+	free_comp_unit(&tmp);
+	return unit;
+}
+
+static void unit_release(RzBinDwarfCompUnit *unit) {
+	free_comp_unit(unit);
+	unit->count = 0;
+	unit->capacity = 0;
+}
+
+/**
+ * \brief Frees the DIEs of the unit at \p idx, if \p info was indexed
+ *
+ * The unit is decoded again the next time it is requested, any pointer
+ * to its DIEs is invalid after this call. Pinned units are kept.
+ */
+RZ_API void rz_bin_dwarf_debug_info_release_unit(RZ_NONNULL RzBinDwarfDebugInfo *info, size_t idx) {
+	rz_return_if_fail(info);
+	if (idx >= info->count || !info->lazy.debug_info) {
+		return;
+	}
+	RzBinDwarfCompUnit *unit = &info->comp_units[idx];
+	rz_th_lock_enter(info->lazy.lock);
+	if (!unit->pins) {
+		unit_release(unit);
+	}
+	rz_th_lock_leave(info->lazy.lock);
+}
+
+/**
+ * \brief Returns the unit at \p idx like rz_bin_dwarf_debug_info_get_unit(),
+ * and keeps its DIEs decoded until the matching rz_bin_dwarf_debug_info_unpin_unit()
+ *
+ * Threads sharing an indexed info pin every unit whose DIEs they point to,
+ * so that no other thread releases them in the meantime.
+ *
+ * \return the unit or NULL, in which case it is not pinned
+ */
+RZ_API RZ_BORROW RzBinDwarfCompUnit *rz_bin_dwarf_debug_info_pin_unit(RZ_NONNULL RzBinDwarfDebugInfo *info, size_t idx) {
+	rz_return_val_if_fail(info, NULL);
+	if (idx >= info->count) {
+		return NULL;
+	}
+	rz_th_lock_enter(info->lazy.lock);
+	info->comp_units[idx].pins++;
+	rz_th_lock_leave(info->lazy.lock);
+	RzBinDwarfCompUnit *unit = rz_bin_dwarf_debug_info_get_unit(info, idx);
+	if (!unit) {
+		rz_bin_dwarf_debug_info_unpin_unit(info, idx);
+	}
+	return unit;
+}
+
+/**
+ * \brief Drops a pin taken by rz_bin_dwarf_debug_info_pin_unit(), the DIEs of
+ * an indexed info are freed together with the last pin.
+ */
+RZ_API void rz_bin_dwarf_debug_info_unpin_unit(RZ_NONNULL RzBinDwarfDebugInfo *info, size_t idx) {
+	rz_return_if_fail(info);
+	if (idx >= info->count) {
+		return;
+	}
+	RzBinDwarfCompUnit *unit = &info->comp_units[idx];
+	rz_th_lock_enter(info->lazy.lock);
+	if (unit->pins && !--unit->pins && info->lazy.debug_info) {
+		unit_release(unit);
+	}
+	rz_th_lock_leave(info->lazy.lock);
+}
+
+/**
+ * \brief Returns the index of the unit containing \p offset in .debug_info,
+ * or the count of units when there is none.
+ */
+RZ_API size_t rz_bin_dwarf_debug_info_unit_index(RZ_NONNULL RzBinDwarfDebugInfo *info, ut64 offset) {
+	rz_return_val_if_fail(info, 0);
+	// units are sorted by offset, find the last one starting before the offset
+	size_t lo = 0, hi = info->count;
+	while (lo < hi) {
+		size_t mid = lo + (hi - lo) / 2;
+		if (info->comp_units[mid].offset <= offset) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+	return lo ? lo - 1 : info->count;
+}
+
+/**
+ * \brief Finds the DIE at \p offset in .debug_info, decoding its unit when needed
+ */
+RZ_API RZ_BORROW RzBinDwarfDie *rz_bin_dwarf_debug_info_find_die(RZ_NONNULL RzBinDwarfDebugInfo *info, ut64 offset) {
+	rz_return_val_if_fail(info, NULL);
+	if (info->lookup_table) {
+		return ht_up_find(info->lookup_table, offset, NULL);
+	}
+	RzBinDwarfCompUnit *unit = rz_bin_dwarf_debug_info_get_unit(info, rz_bin_dwarf_debug_info_unit_index(info, offset));
+	if (!unit) {
+		return NULL;
+	}
+	// DIEs of a unit are sorted by offset
+	size_t lo = 0, hi = unit->count;
+	while (lo < hi) {
+		size_t mid = lo + (hi - lo) / 2;
+		if (unit->dies[mid].offset < offset) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+	return lo < unit->count && unit->dies[lo].offset == offset ? &unit->dies[lo] : NULL;
+}
+
 /**
  * \param info if not NULL, filenames can get resolved to absolute paths using the compilation unit dirs from it
  */
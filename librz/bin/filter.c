@@ -131,6 +131,10 @@ RZ_API void rz_bin_filter_symbols(RzBinFile *bf, RzList /*<RzBinSymbol *>*/ *lis
 		return;
 	}
 
+	if (bf && bf->o && bf->o->lang) {
+		rz_bin_demangle_batch(bf, NULL, list);
+	}
+
 	RzListIter *iter;
 	RzBinSymbol *sym;
 	rz_list_foreach (list, iter, sym) {
@@ -768,7 +768,6 @@ beach:
 static RzDyldRebaseInfo *get_rebase_info(RzDyldCache *cache, ut64 slideInfoOffset, ut64 slideInfoSize, ut64 start_of_data, ut64 slide) {
 	ut8 *tmp_buf_1 = NULL;
 	ut8 *tmp_buf_2 = NULL;
-	ut8 *one_page_buf = NULL;
 	RzBuffer *cache_buf = cache->buf;
 
 	ut64 offset = slideInfoOffset;
@@ -805,13 +804,6 @@ static RzDyldRebaseInfo *get_rebase_info(RzDyldCache *cache, ut64 slideInfoOffse
 			}
 		}
 
-		if (slide_info.page_size > 0) {
-			one_page_buf = malloc(slide_info.page_size);
-			if (!one_page_buf) {
-				goto beach;
-			}
-		}
-
 		RzDyldRebaseInfo3 *rebase_info = RZ_NEW0(RzDyldRebaseInfo3);
 		if (!rebase_info) {
 			goto beach;
@@ -825,7 +817,6 @@ static RzDyldRebaseInfo *get_rebase_info(RzDyldCache *cache, ut64 slideInfoOffse
 		rebase_info->page_starts_count = slide_info.page_starts_count;
 		rebase_info->auth_value_add = slide_info.auth_value_add;
 		rebase_info->page_size = slide_info.page_size;
-		rebase_info->one_page_buf = one_page_buf;
 		if (slide == UT64_MAX) {
 			rebase_info->slide = estimate_slide(cache, 0x7ffffffffffffULL, 0);
 			if (rebase_info->slide) {
@@ -879,13 +870,6 @@ static RzDyldRebaseInfo *get_rebase_info(RzDyldCache *cache, ut64 slideInfoOffse
 			}
 		}
 
-		if (slide_info.page_size > 0) {
-			one_page_buf = malloc(slide_info.page_size);
-			if (!one_page_buf) {
-				goto beach;
-			}
-		}
-
 		RzDyldRebaseInfo2 *rebase_info = RZ_NEW0(RzDyldRebaseInfo2);
 		if (!rebase_info) {
 			goto beach;
@@ -902,7 +886,6 @@ static RzDyldRebaseInfo *get_rebase_info(RzDyldCache *cache, ut64 slideInfoOffse
 		rebase_info->value_mask = ~rebase_info->delta_mask;
 		rebase_info->delta_shift = dumb_ctzll(rebase_info->delta_mask) - 2;
 		rebase_info->page_size = slide_info.page_size;
-		rebase_info->one_page_buf = one_page_buf;
 		if (slide == UT64_MAX) {
 			rebase_info->slide = estimate_slide(cache, rebase_info->value_mask, rebase_info->value_add);
 			if (rebase_info->slide) {
@@ -956,11 +939,6 @@ static RzDyldRebaseInfo *get_rebase_info(RzDyldCache *cache, ut64 slideInfoOffse
 			}
 		}
 
-		one_page_buf = malloc(4096);
-		if (!one_page_buf) {
-			goto beach;
-		}
-
 		RzDyldRebaseInfo1 *rebase_info = RZ_NEW0(RzDyldRebaseInfo1);
 		if (!rebase_info) {
 			goto beach;
@@ -968,7 +946,6 @@ static RzDyldRebaseInfo *get_rebase_info(RzDyldCache *cache, ut64 slideInfoOffse
 
 		rebase_info->version = 1;
 		rebase_info->start_of_data = start_of_data;
-		rebase_info->one_page_buf = one_page_buf;
 		rebase_info->page_size = 4096;
 		rebase_info->toc = (ut16 *)tmp_buf_1;
 		rebase_info->toc_count = slide_info.toc_count;
@@ -992,7 +969,6 @@ static RzDyldRebaseInfo *get_rebase_info(RzDyldCache *cache, ut64 slideInfoOffse
 beach:
 	free(tmp_buf_1);
 	free(tmp_buf_2);
-	free(one_page_buf);
 	return NULL;
 }
 
@@ -1170,8 +1146,9 @@ RZ_API void rz_dyldcache_symbols_from_locsym(RzDyldCache *cache, RzDyldBinImage
 		if (symstr) {
 			sym->name = symstr;
 		} else {
-			static ut32 k = 0;
-			sym->name = rz_str_newf("unk_local%d", k++);
+			// named after the index of the entry in the cache rather than a global counter,
+			// unique across the images and safe when caches are loaded by several threads
+			sym->name = rz_str_newf("unk_local%u", bin->nlist_start_index + j);
 		}
 
 		rz_list_append(symbols, sym);
@@ -1202,6 +1179,7 @@ RZ_API RzDyldCache *rz_dyldcache_new_buf(RzBuffer *buf) {
 	}
 	cache->locsym = rz_dyld_locsym_new(cache);
 	cache->rebase_infos = get_rebase_infos(cache);
+	cache->rebased_pages = rz_dyldcache_rebased_pages_new(cache);
 	return cache;
 cupertino:
 	rz_dyldcache_free(cache);
@@ -1239,8 +1217,6 @@ static void rebase_info_free(RzDyldRebaseInfo *rebase_info) {
 		return;
 	}
 
-	RZ_FREE(rebase_info->one_page_buf);
-
 	ut8 version = rebase_info->version;
 
 	if (version == 1) {
@@ -1344,6 +1320,8 @@ RZ_API void rz_dyldcache_free(RzDyldCache *cache) {
 	cache->bins = NULL;
 	rz_buf_free(cache->buf);
 	cache->buf = NULL;
+	rz_dyldcache_rebased_pages_free(cache->rebased_pages, cache->rebase_infos ? cache->rebase_infos->length : 0);
+	cache->rebased_pages = NULL;
 	if (cache->rebase_infos) {
 		int i;
 		for (i = 0; i < cache->rebase_infos->length; i++) {
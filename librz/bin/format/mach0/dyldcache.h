@@ -15,7 +15,6 @@
 typedef struct rz_dyld_rebase_info_t {
 	ut8 version;
 	ut64 slide;
-	ut8 *one_page_buf;
 	ut32 page_size;
 	ut64 start_of_data;
 } RzDyldRebaseInfo;
@@ -34,7 +33,6 @@ typedef struct rz_dyld_rebase_infos_t {
 typedef struct rz_dyld_rebase_info_3_t {
 	ut8 version;
 	ut64 slide;
-	ut8 *one_page_buf;
 	ut32 page_size;
 	ut64 start_of_data;
 	ut16 *page_starts;
@@ -47,7 +45,6 @@ typedef struct rz_dyld_rebase_info_3_t {
 typedef struct rz_dyld_rebase_info_2_t {
 	ut8 version;
 	ut64 slide;
-	ut8 *one_page_buf;
 	ut32 page_size;
 	ut64 start_of_data;
 	ut16 *page_starts;
@@ -63,7 +60,6 @@ typedef struct rz_dyld_rebase_info_2_t {
 typedef struct rz_dyld_rebase_info_1_t {
 	ut8 version;
 	ut64 slide;
-	ut8 *one_page_buf;
 	ut32 page_size;
 	ut64 start_of_data;
 	ut16 *toc;
@@ -72,6 +68,8 @@ typedef struct rz_dyld_rebase_info_1_t {
 	ut32 entries_size;
 } RzDyldRebaseInfo1;
 
+typedef struct rz_dyld_rebased_pages_t RzDyldRebasedPages;
+
 typedef struct rz_dyld_loc_sym_t {
 	ut64 local_symbols_offset;
 	ut64 nlists_offset;
@@ -104,6 +102,7 @@ typedef struct rz_dyldcache_t {
 	RzList /*<RzDyldBinImage *>*/ *bins;
 	RzBuffer *buf;
 	RzDyldRebaseInfos *rebase_infos;
+	RzDyldRebasedPages *rebased_pages; ///< LRU of rebased pages shared by all rebasing buffers
 	cache_accel_t *accel;
 	RzDyldLocSym *locsym;
 	objc_cache_opt_info *oi;
@@ -121,5 +120,8 @@ RZ_API void rz_dyldcache_symbols_from_locsym(RzDyldCache *cache, RzDyldBinImage
 RZ_API RzBuffer *rz_dyldcache_new_rebasing_buf(RzDyldCache *cache);
 RZ_API bool rz_dyldcache_needs_rebasing(RzDyldCache *cache);
 RZ_API bool rz_dyldcache_range_needs_rebasing(RzDyldCache *cache, ut64 paddr, ut64 size);
+RZ_API void rz_dyldcache_prefetch_rebased(RZ_NONNULL RzDyldCache *cache, ut64 paddr, ut64 size);
+RZ_IPI RzDyldRebasedPages *rz_dyldcache_rebased_pages_new(RzDyldCache *cache);
+RZ_IPI void rz_dyldcache_rebased_pages_free(RZ_NULLABLE RzDyldRebasedPages *pages, size_t infos_count);
 
 #endif
@@ -173,6 +173,420 @@ static void rebase_bytes(RzDyldRebaseInfo *rebase_info, ut8 *buf, ut64 offset, i
 	}
 }
 
+/// maximum amount of rebased data kept in memory per cache
+#define REBASED_PAGES_MAX_SIZE (64 * 1024 * 1024)
+/// prefetching fewer pages than this is not worth starting threads
+#define PREFETCH_MIN_PAGES 16
+
+typedef struct rebased_page_t {
+	ut64 offset; ///< file offset of the page
+	ut64 size; ///< bytes in data, less than the page size at the end of the file
+	ut8 *data;
+	struct rebased_page_t *prev; ///< more recently used page
+	struct rebased_page_t *next; ///< less recently used page
+} RebasedPage;
+
+struct rz_dyld_rebased_pages_t {
+	RzThreadLock *lock; ///< guards everything below
+	RzThreadLock *io_lock; ///< serializes the reads of the cache buffer from the prefetch workers
+	HtUP /*<ut64, RebasedPage *>*/ *pages; ///< cached pages by offset
+	RebasedPage *head; ///< most recently used page
+	RebasedPage *tail; ///< least recently used page
+	ut64 size; ///< bytes of all the cached pages
+	RzBitVector **fixups; ///< for every rebase info entry, which of its pages have any pointer to rebase
+};
+
+static void rebased_page_free(RebasedPage *page) {
+	if (!page) {
+		return;
+	}
+	free(page->data);
+	free(page);
+}
+
+static RzBitVector *fixup_pages_new(RzDyldRebaseInfo *info) {
+	ut32 count = 0;
+	if (info->version == 3) {
+		count = ((RzDyldRebaseInfo3 *)info)->page_starts_count;
+	} else if (info->version == 2 || info->version == 4) {
+		count = ((RzDyldRebaseInfo2 *)info)->page_starts_count;
+	} else if (info->version == 1) {
+		count = ((RzDyldRebaseInfo1 *)info)->toc_count;
+	}
+	if (!count) {
+		return NULL;
+	}
+	RzBitVector *bv = rz_bv_new(count);
+	if (!bv) {
+		return NULL;
+	}
+	for (ut32 i = 0; i < count; i++) {
+		bool has_fixups = true;
+		if (info->version == 3) {
+			has_fixups = ((RzDyldRebaseInfo3 *)info)->page_starts[i] != DYLD_CACHE_SLIDE_V3_PAGE_ATTR_NO_REBASE;
+		} else if (info->version == 2 || info->version == 4) {
+			// pages with extras are not rebased, see rebase_bytes_v2()
+			ut16 page_flag = ((RzDyldRebaseInfo2 *)info)->page_starts[i];
+			has_fixups = page_flag != DYLD_CACHE_SLIDE_PAGE_ATTR_NO_REBASE && !(page_flag & DYLD_CACHE_SLIDE_PAGE_ATTR_EXTRA);
+		}
+		rz_bv_set(bv, i, has_fixups);
+	}
+	return bv;
+}
+
+RZ_IPI RzDyldRebasedPages *rz_dyldcache_rebased_pages_new(RzDyldCache *cache) {
+	rz_return_val_if_fail(cache, NULL);
+	RzDyldRebaseInfos *infos = cache->rebase_infos;
+	if (!infos || !infos->length) {
+		return NULL;
+	}
+	RzDyldRebasedPages *pages = RZ_NEW0(RzDyldRebasedPages);
+	if (!pages) {
+		return NULL;
+	}
+	pages->lock = rz_th_lock_new(false);
+	pages->io_lock = rz_th_lock_new(false);
+	pages->pages = ht_up_new(NULL, NULL, NULL);
+	pages->fixups = RZ_NEWS0(RzBitVector *, infos->length);
+	if (!pages->lock || !pages->io_lock || !pages->pages || !pages->fixups) {
+		rz_dyldcache_rebased_pages_free(pages, infos->length);
+		return NULL;
+	}
+	for (size_t i = 0; i < infos->length; i++) {
+		RzDyldRebaseInfo *info = infos->entries[i].info;
+		pages->fixups[i] = info && info->page_size ? fixup_pages_new(info) : NULL;
+	}
+	return pages;
+}
+
+RZ_IPI void rz_dyldcache_rebased_pages_free(RZ_NULLABLE RzDyldRebasedPages *pages, size_t infos_count) {
+	if (!pages) {
+		return;
+	}
+	RebasedPage *page = pages->head;
+	while (page) {
+		RebasedPage *next = page->next;
+		rebased_page_free(page);
+		page = next;
+	}
+	if (pages->fixups) {
+		for (size_t i = 0; i < infos_count; i++) {
+			rz_bv_free(pages->fixups[i]);
+		}
+		free(pages->fixups);
+	}
+	ht_up_free(pages->pages);
+	rz_th_lock_free(pages->lock);
+	rz_th_lock_free(pages->io_lock);
+	free(pages);
+}
+
+/// index of the rebase info entry containing \p offset or -1
+static st64 rebase_entry_at(RzDyldRebaseInfos *infos, ut64 offset) {
+	size_t lo = 0, hi = infos->length;
+	while (lo < hi) {
+		size_t mid = lo + (hi - lo) / 2;
+		if (infos->entries[mid].end <= offset) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+	if (lo < infos->length && infos->entries[lo].start <= offset) {
+		return lo;
+	}
+	return -1;
+}
+
+static void lru_unlink(RzDyldRebasedPages *pages, RebasedPage *page) {
+	if (page->prev) {
+		page->prev->next = page->next;
+	} else {
+		pages->head = page->next;
+	}
+	if (page->next) {
+		page->next->prev = page->prev;
+	} else {
+		pages->tail = page->prev;
+	}
+	page->prev = page->next = NULL;
+}
+
+static void lru_push_head(RzDyldRebasedPages *pages, RebasedPage *page) {
+	page->next = pages->head;
+	if (pages->head) {
+		pages->head->prev = page;
+	}
+	pages->head = page;
+	if (!pages->tail) {
+		pages->tail = page;
+	}
+}
+
+/// inserts \p page in the cache, or frees it and returns the cached copy if another thread was first
+static RebasedPage *lru_insert(RzDyldRebasedPages *pages, RebasedPage *page) {
+	RebasedPage *cached = ht_up_find(pages->pages, page->offset, NULL);
+	if (cached) {
+		rebased_page_free(page);
+		return cached;
+	}
+	ht_up_insert(pages->pages, page->offset, page);
+	lru_push_head(pages, page);
+	pages->size += page->size;
+	while (pages->size > REBASED_PAGES_MAX_SIZE && pages->tail && pages->tail != page) {
+		RebasedPage *victim = pages->tail;
+		lru_unlink(pages, victim);
+		ht_up_delete(pages->pages, victim->offset);
+		pages->size -= victim->size;
+		rebased_page_free(victim);
+	}
+	return page;
+}
+
+/// reads the page at \p offset and rebases all of it
+static RebasedPage *rebased_page_new(RzDyldCache *cache, RzDyldRebaseInfo *info, ut64 offset) {
+	RebasedPage *page = RZ_NEW0(RebasedPage);
+	if (!page) {
+		return NULL;
+	}
+	page->offset = offset;
+	page->data = malloc(info->page_size);
+	if (!page->data) {
+		free(page);
+		return NULL;
+	}
+	rz_th_lock_enter(cache->rebased_pages->io_lock);
+	st64 r = rz_buf_read_at(cache->buf, offset, page->data, info->page_size);
+	rz_th_lock_leave(cache->rebased_pages->io_lock);
+	if (r <= 0) {
+		rebased_page_free(page);
+		return NULL;
+	}
+	page->size = r;
+	rebase_bytes(info, page->data, offset, r, 0);
+	return page;
+}
+
+/**
+ * Copies up to \p len bytes of the rebased page at \p page_offset, starting at
+ * \p offset, into \p dst and returns how many were copied (-1 on error).
+ */
+static st64 rebased_page_read(RzDyldCache *cache, RzDyldRebaseInfo *info, ut64 page_offset, ut64 offset, ut8 *dst, ut64 len) {
+	RzDyldRebasedPages *pages = cache->rebased_pages;
+	rz_th_lock_enter(pages->lock);
+	RebasedPage *page = ht_up_find(pages->pages, page_offset, NULL);
+	if (page) {
+		lru_unlink(pages, page);
+		lru_push_head(pages, page);
+	} else {
+		rz_th_lock_leave(pages->lock);
+		RebasedPage *fresh = rebased_page_new(cache, info, page_offset);
+		if (!fresh) {
+			return -1;
+		}
+		rz_th_lock_enter(pages->lock);
+		page = lru_insert(pages, fresh);
+	}
+	ut64 in_page = offset - page_offset;
+	st64 r = in_page < page->size ? RZ_MIN(len, page->size - in_page) : 0;
+	memcpy(dst, page->data + in_page, r);
+	rz_th_lock_leave(pages->lock);
+	return r;
+}
+
+/**
+ * Finds where the page containing \p offset starts, if that page has pointers to rebase.
+ * \return the rebase info of the page or NULL if the data at \p offset can be read as is
+ */
+static RzDyldRebaseInfo *page_to_rebase(RzDyldCache *cache, ut64 offset, ut64 *page_offset, ut64 *end) {
+	RzDyldRebaseInfos *infos = cache->rebase_infos;
+	st64 idx = rebase_entry_at(infos, offset);
+	if (idx < 0) {
+		// nothing to rebase until the next entry
+		size_t next = 0;
+		while (next < infos->length && infos->entries[next].start <= offset) {
+			next++;
+		}
+		*end = next < infos->length ? infos->entries[next].start : UT64_MAX;
+		return NULL;
+	}
+	RzDyldRebaseInfosEntry *entry = &infos->entries[idx];
+	RzDyldRebaseInfo *info = entry->info;
+	*end = entry->end;
+	if (!info || !info->page_size) {
+		return NULL;
+	}
+	if (offset < info->start_of_data) {
+		*end = RZ_MIN(*end, info->start_of_data);
+		return NULL;
+	}
+	ut64 page_index = (offset - info->start_of_data) / info->page_size;
+	*page_offset = info->start_of_data + page_index * info->page_size;
+	*end = RZ_MIN(*end, *page_offset + info->page_size);
+	RzBitVector *fixups = cache->rebased_pages->fixups[idx];
+	if (!fixups || page_index >= rz_bv_len(fixups) || !rz_bv_get(fixups, page_index)) {
+		return NULL;
+	}
+	return info;
+}
+
+static st64 rebased_read_at(RzDyldCache *cache, ut64 offset, ut8 *buf, ut64 len) {
+	ut64 done = 0;
+	while (done < len) {
+		ut64 at = offset + done;
+		ut64 page_offset = 0, end = UT64_MAX;
+		RzDyldRebaseInfo *info = page_to_rebase(cache, at, &page_offset, &end);
+		ut64 chunk = RZ_MIN(len - done, end - at);
+		st64 r = info
+			? rebased_page_read(cache, info, page_offset, at, buf + done, chunk)
+			: rz_buf_read_at(cache->buf, at, buf + done, chunk);
+		if (r <= 0) {
+			return done ? (st64)done : r;
+		}
+		done += r;
+		if (r < chunk) {
+			break;
+		}
+	}
+	return done;
+}
+
+/// rebases the pages of the range on every read, when the page cache is not available
+static st64 rebased_read_uncached(RzDyldCache *cache, RzDyldRebaseInfo *rebase_info, ut64 offset, ut8 *buf, ut64 len) {
+	if (rebase_info->page_size < 1) {
+		return -1;
+	}
+	ut64 offset_in_data = offset - rebase_info->start_of_data;
+	ut64 page_offset = offset_in_data % rebase_info->page_size;
+
+	ut64 internal_offset = offset & ~(rebase_info->page_size - 1);
+	ut64 internal_end = offset + len;
+	int rounded_count = internal_end - internal_offset;
+
+	ut8 *internal_buf = malloc(rounded_count);
+	if (!internal_buf) {
+		RZ_LOG_ERROR("dyldcache: Cannot allocate memory for 'internal_buf'\n");
+		return -1;
+	}
+
+	st64 result = 0;
+	st64 internal_result = rz_buf_read_at(cache->buf, internal_offset, internal_buf, rounded_count);
+	if (internal_result >= page_offset + len) {
+		rebase_bytes(rebase_info, internal_buf, internal_offset, internal_result, page_offset);
+		result = RZ_MIN(len, internal_result);
+		memcpy(buf, internal_buf + page_offset, result);
+	} else {
+		RZ_LOG_ERROR("dyldcache: Cannot rebase address\n");
+		result = rz_buf_read_at(cache->buf, offset, buf, len);
+	}
+	free(internal_buf);
+	return result;
+}
+
+/// drops the cached pages overlapping [offset, offset + len), whose data changed
+static void rebased_pages_invalidate(RzDyldRebasedPages *pages, ut64 offset, ut64 len) {
+	ut64 end = len > UT64_MAX - offset ? UT64_MAX : offset + len;
+	rz_th_lock_enter(pages->lock);
+	RebasedPage *page = pages->head;
+	while (page) {
+		RebasedPage *next = page->next;
+		if (page->offset < end && offset < page->offset + page->size) {
+			lru_unlink(pages, page);
+			ht_up_delete(pages->pages, page->offset);
+			pages->size -= page->size;
+			rebased_page_free(page);
+		}
+		page = next;
+	}
+	rz_th_lock_leave(pages->lock);
+}
+
+typedef struct {
+	RzDyldCache *cache;
+	RzVector /*<ut64>*/ offsets; ///< pages to prefetch
+	size_t next; ///< index of the next page to prefetch, guarded by lock
+	RzThreadLock *lock;
+} PrefetchCtx;
+
+static void *prefetch_worker(PrefetchCtx *ctx) {
+	RzDyldRebasedPages *pages = ctx->cache->rebased_pages;
+	while (true) {
+		rz_th_lock_enter(ctx->lock);
+		ut64 *offset = ctx->next < rz_vector_len(&ctx->offsets) ? rz_vector_index_ptr(&ctx->offsets, ctx->next++) : NULL;
+		rz_th_lock_leave(ctx->lock);
+		if (!offset) {
+			break;
+		}
+		ut64 page_offset = 0, end = 0;
+		RzDyldRebaseInfo *info = page_to_rebase(ctx->cache, *offset, &page_offset, &end);
+		RebasedPage *page = info ? rebased_page_new(ctx->cache, info, page_offset) : NULL;
+		if (!page) {
+			continue;
+		}
+		rz_th_lock_enter(pages->lock);
+		lru_insert(pages, page);
+		rz_th_lock_leave(pages->lock);
+	}
+	return NULL;
+}
+
+/**
+ * \brief Rebases the pages of [paddr, paddr + size) ahead of their reads, on all the cores
+ *
+ * Meant to be called before parsing the data of an image, so later reads of
+ * the rebasing buffers in that range are served from the page cache.
+ * Only as many pages as the cache can hold are prefetched.
+ */
+RZ_API void rz_dyldcache_prefetch_rebased(RZ_NONNULL RzDyldCache *cache, ut64 paddr, ut64 size) {
+	rz_return_if_fail(cache);
+	RzDyldRebasedPages *pages = cache->rebased_pages;
+	if (!pages || !size || !rz_dyldcache_needs_rebasing(cache)) {
+		return;
+	}
+	PrefetchCtx ctx = { .cache = cache };
+	rz_vector_init(&ctx.offsets, sizeof(ut64), NULL, NULL);
+	ut64 planned = 0;
+	ut64 at = paddr;
+	while (at - paddr < size && planned < REBASED_PAGES_MAX_SIZE) {
+		ut64 page_offset = 0, end = UT64_MAX;
+		RzDyldRebaseInfo *info = page_to_rebase(cache, at, &page_offset, &end);
+		if (info) {
+			rz_th_lock_enter(pages->lock);
+			bool cached = ht_up_find(pages->pages, page_offset, NULL);
+			rz_th_lock_leave(pages->lock);
+			if (!cached && rz_vector_push(&ctx.offsets, &page_offset)) {
+				planned += info->page_size;
+			}
+		}
+		if (end <= at) {
+			break;
+		}
+		at = end;
+	}
+
+	size_t count = rz_vector_len(&ctx.offsets);
+	RzThreadPool *pool = count >= PREFETCH_MIN_PAGES ? rz_th_pool_new(RZ_THREAD_POOL_ALL_CORES) : NULL;
+	ctx.lock = rz_th_lock_new(false);
+	if (pool && ctx.lock) {
+		size_t pool_size = rz_th_pool_size(pool);
+		for (size_t i = 0; i < pool_size; ++i) {
+			RzThread *th = rz_th_new((RzThreadFunction)prefetch_worker, &ctx);
+			if (!th || !rz_th_pool_add_thread(pool, th)) {
+				rz_th_free(th);
+				break;
+			}
+		}
+		rz_th_pool_wait(pool);
+	}
+	if (ctx.lock) {
+		// any page left (small range or no thread could be started) is handled here.
+		prefetch_worker(&ctx);
+	}
+	rz_th_pool_free(pool);
+	rz_th_lock_free(ctx.lock);
+	rz_vector_fini(&ctx.offsets);
+}
+
 typedef struct {
 	RzDyldCache *cache;
 	ut64 off;
@@ -196,61 +610,39 @@ static bool buf_fini(RzBuffer *b) {
 
 static bool buf_resize(RzBuffer *b, ut64 newsize) {
 	BufCtx *ctx = b->priv;
-	return rz_buf_resize(ctx->cache->buf, newsize);
+	RzDyldCache *cache = ctx->cache;
+	ut64 oldsize = rz_buf_size(cache->buf);
+	if (!rz_buf_resize(cache->buf, newsize)) {
+		return false;
+	}
+	if (cache->rebased_pages) {
+		// the last page may have been truncated or grown
+		rebased_pages_invalidate(cache->rebased_pages, RZ_MIN(oldsize, newsize), UT64_MAX);
+	}
+	return true;
 }
 
 static st64 buf_read(RzBuffer *b, ut8 *buf, ut64 len) {
 	BufCtx *ctx = b->priv;
-	st64 r = rz_buf_read_at(ctx->cache->buf, ctx->off, buf, len);
-	if (r <= 0 || !len) {
-		return r;
-	}
-
 	RzDyldCache *cache = ctx->cache;
-	RzDyldRebaseInfo *rebase_info = rebase_info_by_range(cache->rebase_infos, ctx->off, len);
-
+	RzDyldRebaseInfo *rebase_info = len ? rebase_info_by_range(cache->rebase_infos, ctx->off, len) : NULL;
 	if (!rebase_info) {
 		return rz_buf_read_at(cache->buf, ctx->off, buf, len);
-	} else if (rebase_info->page_size < 1) {
-		return -1;
 	}
-
-	st64 result = 0;
-	ut64 offset_in_data = ctx->off - rebase_info->start_of_data;
-	ut64 page_offset = offset_in_data % rebase_info->page_size;
-
-	ut64 internal_offset = ctx->off & ~(rebase_info->page_size - 1);
-	ut64 internal_end = ctx->off + len;
-	int rounded_count = internal_end - internal_offset;
-
-	ut8 *internal_buf = rebase_info->one_page_buf;
-	if (rounded_count > rebase_info->page_size) {
-		internal_buf = malloc(rounded_count);
-		if (!internal_buf) {
-			RZ_LOG_ERROR("dyldcache: Cannot allocate memory for 'internal_buf'\n");
-			return -1;
-		}
-	}
-
-	st64 internal_result = rz_buf_read_at(cache->buf, internal_offset, internal_buf, rounded_count);
-	if (internal_result >= page_offset + len) {
-		rebase_bytes(rebase_info, internal_buf, internal_offset, internal_result, page_offset);
-		result = RZ_MIN(len, internal_result);
-		memcpy(buf, internal_buf + page_offset, result);
-	} else {
-		RZ_LOG_ERROR("dyldcache: Cannot rebase address\n");
-		result = rz_buf_read_at(cache->buf, ctx->off, buf, len);
+	if (!cache->rebased_pages) {
+		return rebased_read_uncached(cache, rebase_info, ctx->off, buf, len);
 	}
-
-	if (internal_buf != rebase_info->one_page_buf) {
-		RZ_FREE(internal_buf);
-	}
-	return result;
+	return rebased_read_at(cache, ctx->off, buf, len);
 }
 
 static st64 buf_write(RzBuffer *b, const ut8 *buf, ut64 len) {
 	BufCtx *ctx = b->priv;
-	return rz_buf_write_at(ctx->cache->buf, ctx->off, buf, len);
+	RzDyldCache *cache = ctx->cache;
+	st64 r = rz_buf_write_at(cache->buf, ctx->off, buf, len);
+	if (r > 0 && cache->rebased_pages) {
+		rebased_pages_invalidate(cache->rebased_pages, ctx->off, r);
+	}
+	return r;
 }
 
 static ut64 buf_get_size(RzBuffer *b) {
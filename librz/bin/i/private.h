@@ -27,6 +27,25 @@ RZ_IPI RzBinObject *rz_bin_object_new(RzBinFile *binfile, RzBinPlugin *plugin, R
 RZ_IPI RzBinObject *rz_bin_object_get_cur(RzBin *bin);
 RZ_IPI RzBinObject *rz_bin_object_find_by_arch_bits(RzBinFile *binfile, const char *arch, int bits, const char *name);
 
+RZ_IPI bool rz_bin_object_cache_load(RZ_NONNULL RzBinFile *bf, RZ_NONNULL RzBinObject *o);
+RZ_IPI void rz_bin_object_cache_save(RZ_NONNULL RzBinFile *bf, RZ_NONNULL RzBinObject *o);
+RZ_IPI RZ_OWN RzBinStrDb *rz_bin_object_cache_load_strings(RZ_NONNULL RzBinFile *bf, RZ_NONNULL RzBinObject *o);
+RZ_IPI void rz_bin_object_cache_save_strings(RZ_NONNULL RzBinFile *bf, RZ_NONNULL RzBinObject *o);
+RZ_IPI void rz_bin_object_cache_free(RZ_NULLABLE RzBinObjectCache *cache);
+
+typedef struct rz_bin_probe_entry_t {
+	void *plugin; ///< RzBinPlugin or RzBinXtrPlugin
+	const RzBinMagic *magics; ///< NULL when the plugin must always be checked
+} RzBinProbeEntry;
+
+RZ_IPI RzBinProbe *rz_bin_probe_new(void);
+RZ_IPI void rz_bin_probe_free(RZ_NULLABLE RzBinProbe *probe);
+RZ_IPI bool rz_bin_probe_add(RZ_NONNULL RzBinProbe *probe, RZ_NONNULL void *plugin, RZ_NULLABLE const RzBinMagic *magics);
+RZ_IPI void rz_bin_probe_del(RZ_NONNULL RzBinProbe *probe, RZ_NONNULL void *plugin);
+RZ_IPI size_t rz_bin_probe_read_header(RZ_NONNULL RzBuffer *buf, ut8 header[RZ_BIN_MAGIC_SIZE]);
+RZ_IPI const RzPVector /*<RzBinProbeEntry *>*/ *rz_bin_probe_candidates(RZ_NONNULL RzBinProbe *probe, RZ_NONNULL const ut8 *header, size_t header_size);
+RZ_IPI bool rz_bin_probe_entry_match(RZ_NONNULL const RzBinProbeEntry *entry, RZ_NONNULL const ut8 *header, size_t header_size);
+
 RZ_IPI void rz_bin_class_free(RzBinClass *c);
 RZ_IPI RzBinSymbol *rz_bin_class_add_method(RzBinFile *binfile, const char *classname, const char *name, int nargs);
 RZ_IPI void rz_bin_class_add_field(RzBinFile *binfile, const char *classname, const char *name);
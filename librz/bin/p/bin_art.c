@@ -132,6 +132,11 @@ static bool check_buffer(RzBuffer *buf) {
 	return r == 4 && !strncmp(tmp, "art\n", 4);
 }
 
+static const RzBinMagic magics[] = {
+	RZ_BIN_MAGIC("art\n"),
+	{ 0 }
+};
+
 static RzList /*<RzBinAddr *>*/ *entries(RzBinFile *bf) {
 	RzList *ret = rz_list_newf(free);
 	if (ret) {
@@ -213,6 +218,7 @@ RzBinPlugin rz_bin_plugin_art = {
 	.load_buffer = &load_buffer,
 	.destroy = &destroy,
 	.check_buffer = &check_buffer,
+	.magics = magics,
 	.baddr = &baddr,
 	.maps = &rz_bin_maps_of_file_sections,
 	.sections = &sections,
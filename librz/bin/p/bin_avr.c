@@ -19,8 +19,6 @@
 		return false; \
 	}
 
-static ut64 tmp_entry = UT64_MAX;
-
 static bool rjmp(RzBuffer *b, ut64 addr) {
 	ut8 tmp;
 	if (!rz_buf_read8_at(b, addr + 1, &tmp)) {
@@ -78,7 +76,7 @@ static bool jmp_dest(RzBuffer *b, ut64 addr, ut64 *result) {
 	return true;
 }
 
-static bool check_buffer_rjmp(RzBuffer *b) {
+static bool find_entry_rjmp(RzBuffer *b, ut64 *entry) {
 	CHECK3INSTR(b, rjmp, 4);
 	ut64 dst;
 	if (!rjmp_dest(b, 0, &dst)) {
@@ -88,11 +86,11 @@ static bool check_buffer_rjmp(RzBuffer *b) {
 	if (dst < 1 || dst > rz_buf_size(b)) {
 		return false;
 	}
-	tmp_entry = dst;
+	*entry = dst;
 	return true;
 }
 
-static bool check_buffer_jmp(RzBuffer *b) {
+static bool find_entry_jmp(RzBuffer *b, ut64 *entry) {
 	CHECK4INSTR(b, jmp, 4);
 	ut64 dst;
 	if (!jmp_dest(b, 0, &dst)) {
@@ -102,18 +100,27 @@ static bool check_buffer_jmp(RzBuffer *b) {
 	if (dst < 1 || dst > rz_buf_size(b)) {
 		return false;
 	}
-	tmp_entry = dst;
+	*entry = dst;
 	return true;
 }
 
-static bool check_buffer(RzBuffer *buf) {
+/**
+ * Finds the entrypoint from the reset vector, the plugin keeps no state
+ * so that several files can be loaded by different threads.
+ */
+static bool find_entry(RzBuffer *buf, ut64 *entry) {
 	if (rz_buf_size(buf) < 32) {
 		return false;
 	}
 	if (!rjmp(buf, 0)) {
-		return check_buffer_jmp(buf);
+		return find_entry_jmp(buf, entry);
 	}
-	return check_buffer_rjmp(buf);
+	return find_entry_rjmp(buf, entry);
+}
+
+static bool check_buffer(RzBuffer *buf) {
+	ut64 entry;
+	return find_entry(buf, &entry);
 }
 
 static bool load_buffer(RzBinFile *bf, RzBinObject *obj, RzBuffer *buf, Sdb *sdb) {
@@ -142,15 +149,15 @@ static RzBinInfo *info(RzBinFile *bf) {
 static RzList /*<RzBinAddr *>*/ *entries(RzBinFile *bf) {
 	RzList *ret;
 	RzBinAddr *ptr = NULL;
-	if (tmp_entry == UT64_MAX) {
-		return false;
+	ut64 addr;
+	if (!find_entry(bf->buf, &addr)) {
+		return NULL;
 	}
 	if (!(ret = rz_list_new())) {
 		return NULL;
 	}
 	ret->free = free;
 	if ((ptr = RZ_NEW0(RzBinAddr))) {
-		ut64 addr = tmp_entry;
 		ptr->vaddr = ptr->paddr = addr;
 		rz_list_append(ret, ptr);
 	}
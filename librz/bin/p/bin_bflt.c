@@ -244,6 +244,11 @@ static bool check_buffer(RzBuffer *buf) {
 	return r == sizeof(tmp) && !memcmp(tmp, "bFLT", 4);
 }
 
+static const RzBinMagic magics[] = {
+	RZ_BIN_MAGIC("bFLT"),
+	{ 0 }
+};
+
 static void destroy(RzBinFile *bf) {
 	rz_bflt_free(bf->o->bin_obj);
 }
@@ -259,6 +264,7 @@ RzBinPlugin rz_bin_plugin_bflt = {
 	.load_buffer = &load_buffer,
 	.destroy = &destroy,
 	.check_buffer = &check_buffer,
+	.magics = magics,
 	.virtual_files = &virtual_files,
 	.maps = &maps,
 	.entries = &entries,
@@ -152,6 +152,11 @@ static bool check_buffer(RzBuffer *buf) {
 	return r > 12 && !strncmp((const char *)tmp, "ANDROID!", 8);
 }
 
+static const RzBinMagic magics[] = {
+	RZ_BIN_MAGIC("ANDROID!"),
+	{ 0 }
+};
+
 static RzList /*<RzBinAddr *>*/ *entries(RzBinFile *bf) {
 	BootImageObj *bio = bf->o->bin_obj;
 	RzBinAddr *ptr = NULL;
@@ -248,6 +253,7 @@ RzBinPlugin rz_bin_plugin_bootimg = {
 	.load_buffer = &load_buffer,
 	.destroy = &destroy,
 	.check_buffer = &check_buffer,
+	.magics = magics,
 	.baddr = &baddr,
 	.maps = rz_bin_maps_of_file_sections,
 	.sections = &sections,
@@ -13,6 +13,11 @@ static bool check_buffer(RzBuffer *buf) {
 	return r > SCGCMAG && !memcmp(tmp, CGCMAG, SCGCMAG) && tmp[4] != 2;
 }
 
+static const RzBinMagic magics[] = {
+	RZ_BIN_MAGIC(CGCMAG),
+	{ 0 }
+};
+
 static RzBuffer *create(RzBin *bin, const ut8 *code, int codelen, const ut8 *data, int datalen, RzBinArchOptions *opt) {
 	ut32 filesize, code_va, code_pa, phoff;
 	ut32 p_start, p_phoff, p_phdr;
@@ -107,6 +112,7 @@ RzBinPlugin rz_bin_plugin_cgc = {
 	.get_sdb = &get_sdb,
 	.load_buffer = load_buffer,
 	.check_buffer = &check_buffer,
+	.magics = magics,
 	.baddr = &baddr,
 	.boffset = &boffset,
 	.binsym = &binsym,
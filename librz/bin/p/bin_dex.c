@@ -60,6 +60,11 @@ static bool check_buffer(RzBuffer *b) {
 	return false;
 }
 
+static const RzBinMagic magics[] = {
+	RZ_BIN_MAGIC("dex\n"),
+	{ 0 }
+};
+
 static ut64 baddr(RzBinFile *bf) {
 	return 0;
 }
@@ -245,6 +250,7 @@ RzBinPlugin rz_bin_plugin_dex = {
 	.load_buffer = &load_buffer,
 	.destroy = &destroy,
 	.check_buffer = &check_buffer,
+	.magics = magics,
 	.baddr = &baddr,
 	.binsym = &binsym,
 	.entries = &entrypoints,
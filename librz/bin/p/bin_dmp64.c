@@ -273,6 +273,11 @@ static bool check_buffer(RzBuffer *b) {
 	return false;
 }
 
+static const RzBinMagic magics[] = {
+	RZ_BIN_MAGIC(DMP64_MAGIC),
+	{ 0 }
+};
+
 RzBinPlugin rz_bin_plugin_dmp64 = {
 	.name = "dmp64",
 	.desc = "Windows Crash Dump x64 rz_bin plugin",
@@ -284,6 +289,7 @@ RzBinPlugin rz_bin_plugin_dmp64 = {
 	.info = &info,
 	.load_buffer = &load_buffer,
 	.check_buffer = &check_buffer,
+	.magics = magics,
 	.maps = &maps,
 	.libs = &libs,
 	.regstate = &regstate,
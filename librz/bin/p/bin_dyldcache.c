@@ -72,6 +72,11 @@ static bool check_buffer(RzBuffer *buf) {
 	return rz_dyldcache_check_magic(hdr);
 }
 
+static const RzBinMagic magics[] = {
+	RZ_BIN_MAGIC("dyld_v1 "),
+	{ 0 }
+};
+
 static bool load_buffer(RzBinFile *bf, RzBinObject *obj, RzBuffer *buf, Sdb *sdb) {
 	RzDyldCache *cache = rz_dyldcache_new_buf(buf);
 	if (!cache) {
@@ -408,6 +413,15 @@ static RzList /*<RzBinClass *>*/ *classes(RzBinFile *bf) {
 		}
 
 		int i;
+		if (owned_buf) {
+			// the class data is scattered over the objc sections, rebase them up front
+			for (i = 0; !sections[i].last; i++) {
+				if (sections[i].size && strstr(sections[i].name, "__objc_")) {
+					ut64 paddr = rz_dyldcache_va2pa(cache, sections[i].addr, NULL, NULL);
+					rz_dyldcache_prefetch_rebased(cache, paddr, sections[i].size);
+				}
+			}
+		}
 		for (i = 0; !sections[i].last; i++) {
 			if (sections[i].size == 0) {
 				continue;
@@ -659,6 +673,7 @@ RzBinPlugin rz_bin_plugin_dyldcache = {
 	.maps = &maps,
 	.sections = &sections,
 	.check_buffer = &check_buffer,
+	.magics = magics,
 	.destroy = &destroy,
 	.classes = &classes,
 	.header = &header,
@@ -9,6 +9,11 @@ static bool check_buffer(RzBuffer *buf) {
 	return check_buffer_aux(buf) == ELFCLASS32;
 }
 
+static const RzBinMagic magics[] = {
+	RZ_BIN_MAGIC(ELFMAG),
+	{ 0 }
+};
+
 RzBinPlugin rz_bin_plugin_elf = {
 	.name = "elf",
 	.desc = "ELF format plugin",
@@ -16,6 +21,7 @@ RzBinPlugin rz_bin_plugin_elf = {
 	.get_sdb = &get_sdb,
 	.load_buffer = &load_buffer,
 	.check_buffer = &check_buffer,
+	.magics = magics,
 	.baddr = &baddr,
 	.boffset = &boffset,
 	.binsym = &binsym,
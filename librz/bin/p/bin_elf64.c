@@ -9,6 +9,11 @@ static bool check_buffer(RzBuffer *buf) {
 	return check_buffer_aux(buf) == ELFCLASS64;
 }
 
+static const RzBinMagic magics[] = {
+	RZ_BIN_MAGIC(ELFMAG),
+	{ 0 }
+};
+
 static ut64 get_elf_vaddr64(RzBinFile *bf, ut64 baddr, ut64 paddr, ut64 vaddr) {
 	// NOTE(aaSSfxxx): since RVA is vaddr - "official" image base, we just need to add imagebase to vaddr
 	ELFOBJ *bin = bf->o->bin_obj;
@@ -21,6 +26,7 @@ RzBinPlugin rz_bin_plugin_elf64 = {
 	.license = "LGPL3",
 	.get_sdb = &get_sdb,
 	.check_buffer = &check_buffer,
+	.magics = magics,
 	.load_buffer = &load_buffer,
 	.baddr = &baddr,
 	.boffset = &boffset,
@@ -58,6 +58,11 @@ static bool check_buffer(RzBuffer *b) {
 	return false;
 }
 
+static const RzBinMagic magics[] = {
+	RZ_BIN_MAGIC("\xca\xfe\xba\xbe"),
+	{ 0 }
+};
+
 static ut64 baddr(RzBinFile *bf) {
 	return 0;
 }
@@ -236,6 +241,7 @@ RzBinPlugin rz_bin_plugin_java = {
 	.load_buffer = &load_buffer,
 	.destroy = &destroy,
 	.check_buffer = &check_buffer,
+	.magics = magics,
 	.baddr = &baddr,
 	.binsym = &binsym,
 	.entries = &entrypoints,
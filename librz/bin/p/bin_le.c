@@ -31,6 +31,13 @@ static bool check_buffer(RzBuffer *b) {
 	return false;
 }
 
+static const RzBinMagic magics[] = {
+	RZ_BIN_MAGIC("MZ"),
+	RZ_BIN_MAGIC("LX"),
+	RZ_BIN_MAGIC("LE"),
+	{ 0 }
+};
+
 static bool load_buffer(RzBinFile *bf, RzBinObject *obj, RzBuffer *buf, Sdb *sdb) {
 	rz_return_val_if_fail(bf && obj && buf, false);
 	rz_bin_le_obj_t *res = rz_bin_le_new_buf(buf);
@@ -159,6 +166,7 @@ RzBinPlugin rz_bin_plugin_le = {
 	.author = "GustavoLCR",
 	.license = "LGPL3",
 	.check_buffer = &check_buffer,
+	.magics = magics,
 	.load_buffer = &load_buffer,
 	.destroy = &destroy,
 	.info = &info,
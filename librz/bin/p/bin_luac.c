@@ -16,6 +16,11 @@ static bool check_buffer(RzBuffer *buff) {
 	return false;
 }
 
+static const RzBinMagic magics[] = {
+	RZ_BIN_MAGIC(LUAC_MAGIC),
+	{ 0 }
+};
+
 static bool load_buffer(RzBinFile *bf, RzBinObject *obj, RzBuffer *buf, Sdb *sdb) {
 	ut8 major_minor_version;
 	LuacBinInfo *bin_info_obj = NULL;
@@ -144,6 +149,7 @@ RzBinPlugin rz_bin_plugin_luac = {
 	.load_buffer = &load_buffer,
 	.destroy = &destroy,
 	.check_buffer = &check_buffer,
+	.magics = magics,
 	.baddr = NULL,
 	.entries = &entries,
 	.maps = &rz_bin_maps_of_file_sections,
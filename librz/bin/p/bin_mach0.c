@@ -514,6 +514,12 @@ static bool check_buffer(RzBuffer *b) {
 	return false;
 }
 
+static const RzBinMagic magics[] = {
+	RZ_BIN_MAGIC("\xce\xfa\xed\xfe"),
+	RZ_BIN_MAGIC("\xfe\xed\xfa\xce"),
+	{ 0 }
+};
+
 static RzBuffer *create(RzBin *bin, const ut8 *code, int clen, const ut8 *data, int dlen, RzBinArchOptions *opt) {
 	const bool use_pagezero = true;
 	const bool use_main = true;
@@ -833,6 +839,7 @@ RzBinPlugin rz_bin_plugin_mach0 = {
 	.load_buffer = &load_buffer,
 	.destroy = &destroy,
 	.check_buffer = &check_buffer,
+	.magics = magics,
 	.baddr = &baddr,
 	.binsym = &binsym,
 	.entries = &entries,
@@ -23,6 +23,12 @@ static bool check_buffer(RzBuffer *b) {
 	return false;
 }
 
+static const RzBinMagic magics[] = {
+	RZ_BIN_MAGIC("\xfe\xed\xfa\xcf"),
+	RZ_BIN_MAGIC("\xcf\xfa\xed\xfe"),
+	{ 0 }
+};
+
 static RzBuffer *create(RzBin *bin, const ut8 *code, int codelen, const ut8 *data, int datalen, RzBinArchOptions *opt) {
 	const bool use_pagezero = true;
 	const bool use_main = true;
@@ -299,6 +305,7 @@ RzBinPlugin rz_bin_plugin_mach064 = {
 	.load_buffer = &load_buffer,
 	.destroy = &destroy,
 	.check_buffer = &check_buffer,
+	.magics = magics,
 	.baddr = &baddr,
 	.binsym = binsym,
 	.entries = &entries,
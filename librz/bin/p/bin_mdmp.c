@@ -465,6 +465,11 @@ static bool mdmp_check_buffer(RzBuffer *b) {
 	return false;
 }
 
+static const RzBinMagic magics[] = {
+	RZ_BIN_MAGIC(MDMP_MAGIC),
+	{ 0 }
+};
+
 static RzList /*<RzBinString *>*/ *mdmp_strings(RzBinFile *bf) {
 	return rz_bin_file_strings(bf, bf->minstrlen, false);
 }
@@ -481,6 +486,7 @@ RzBinPlugin rz_bin_plugin_mdmp = {
 	.libs = &mdmp_libs,
 	.load_buffer = &mdmp_load_buffer,
 	.check_buffer = &mdmp_check_buffer,
+	.magics = magics,
 	.mem = &mdmp_mem,
 	.relocs = &mdmp_relocs,
 	.maps = &mdmp_maps,
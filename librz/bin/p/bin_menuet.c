@@ -67,6 +67,11 @@ static bool check_buffer(RzBuffer *b) {
 	return false;
 }
 
+static const RzBinMagic magics[] = {
+	RZ_BIN_MAGIC("MENUET0"),
+	{ 0 }
+};
+
 static bool load_buffer(RzBinFile *bf, RzBinObject *obj, RzBuffer *b, Sdb *sdb) {
 	return check_buffer(b);
 }
@@ -209,6 +214,7 @@ RzBinPlugin rz_bin_plugin_menuet = {
 	.load_buffer = &load_buffer,
 	.size = &size,
 	.check_buffer = &check_buffer,
+	.magics = magics,
 	.baddr = &baddr,
 	.entries = &entries,
 	.maps = &rz_bin_maps_of_file_sections,
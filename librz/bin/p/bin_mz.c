@@ -121,6 +121,11 @@ static bool check_buffer(RzBuffer *b) {
 	return true;
 }
 
+static const RzBinMagic magics[] = {
+	RZ_BIN_MAGIC("MZ"),
+	{ 0 }
+};
+
 static bool load(RzBinFile *bf, RzBinObject *obj, RzBuffer *buf, Sdb *sdb) {
 	struct rz_bin_mz_obj_t *mz_obj = rz_bin_mz_new_buf(buf);
 	if (mz_obj) {
@@ -262,6 +267,7 @@ RzBinPlugin rz_bin_plugin_mz = {
 	.load_buffer = &load,
 	.destroy = &destroy,
 	.check_buffer = &check_buffer,
+	.magics = magics,
 	.binsym = &binsym,
 	.entries = &entries,
 	.maps = &rz_bin_maps_of_file_sections,
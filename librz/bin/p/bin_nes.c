@@ -14,6 +14,11 @@ static bool check_buffer(RzBuffer *b) {
 	return false;
 }
 
+static const RzBinMagic magics[] = {
+	RZ_BIN_MAGIC(INES_MAGIC),
+	{ 0 }
+};
+
 static bool load_buffer(RzBinFile *bf, RzBinObject *obj, RzBuffer *buf, Sdb *sdb) {
 	return check_buffer(buf);
 }
@@ -227,6 +232,7 @@ RzBinPlugin rz_bin_plugin_nes = {
 	.load_buffer = &load_buffer,
 	.baddr = &baddr,
 	.check_buffer = &check_buffer,
+	.magics = magics,
 	.entries = &entries,
 	.maps = &rz_bin_maps_of_file_sections,
 	.sections = sections,
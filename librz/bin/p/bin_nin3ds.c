@@ -79,6 +79,11 @@ static bool n3ds_check_buffer(RzBuffer *b) {
 	return (!memcmp(magic, "FIRM", 4));
 }
 
+static const RzBinMagic magics[] = {
+	RZ_BIN_MAGIC("FIRM"),
+	{ 0 }
+};
+
 static bool n3ds_load_buffer(RzBinFile *bf, RzBinObject *obj, RzBuffer *b, Sdb *sdb) {
 	N3DSFirmHdr *hdr = RZ_NEW0(N3DSFirmHdr);
 	if (!n3ds_read_firm_hdr(b, hdr)) {
@@ -317,6 +322,7 @@ RzBinPlugin rz_bin_plugin_nin3ds = {
 	.license = "LGPL3",
 	.load_buffer = &n3ds_load_buffer,
 	.check_buffer = &n3ds_check_buffer,
+	.magics = magics,
 	.destroy = &n3ds_destroy,
 	.entries = &n3ds_entries,
 	.maps = &rz_bin_maps_of_file_sections,
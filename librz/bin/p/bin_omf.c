@@ -63,6 +63,12 @@ static bool check_buffer(RzBuffer *b) {
 	return rz_bin_checksum_omf_ok(buf, length);
 }
 
+static const RzBinMagic magics[] = {
+	RZ_BIN_MAGIC("\x80"),
+	RZ_BIN_MAGIC("\x82"),
+	{ 0 }
+};
+
 static ut64 baddr(RzBinFile *bf) {
 	return OMF_BASE_ADDR;
 }
@@ -169,6 +175,7 @@ RzBinPlugin rz_bin_plugin_omf = {
 	.load_buffer = &load_buffer,
 	.destroy = &destroy,
 	.check_buffer = &check_buffer,
+	.magics = magics,
 	.baddr = &baddr,
 	.entries = &entries,
 	.maps = &rz_bin_maps_of_file_sections,
@@ -46,6 +46,11 @@ static bool check_buffer(RzBuffer *b) {
 	return !memcmp(magic, "PBLAPP\x00\x00", 8);
 }
 
+static const RzBinMagic magics[] = {
+	RZ_BIN_MAGIC("PBLAPP\x00\x00"),
+	{ 0 }
+};
+
 static bool load_buffer(RzBinFile *bf, RzBinObject *obj, RzBuffer *b, Sdb *sdb) {
 	return check_buffer(b);
 }
@@ -188,6 +193,7 @@ RzBinPlugin rz_bin_plugin_pebble = {
 	.license = "LGPL",
 	.load_buffer = &load_buffer,
 	.check_buffer = &check_buffer,
+	.magics = magics,
 	.baddr = &baddr,
 	.entries = entries,
 	.maps = &rz_bin_maps_of_file_sections,
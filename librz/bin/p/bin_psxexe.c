@@ -17,6 +17,11 @@ static bool check_buffer(RzBuffer *b) {
 	return false;
 }
 
+static const RzBinMagic magics[] = {
+	RZ_BIN_MAGIC(PSXEXE_ID),
+	{ 0 }
+};
+
 static bool load_buffer(RzBinFile *bf, RzBinObject *obj, RzBuffer *b, Sdb *sdb) {
 	return check_buffer(b);
 }
@@ -120,6 +125,7 @@ RzBinPlugin rz_bin_plugin_psxexe = {
 	.license = "LGPL3",
 	.load_buffer = &load_buffer,
 	.check_buffer = &check_buffer,
+	.magics = magics,
 	.info = &info,
 	.maps = &rz_bin_maps_of_file_sections,
 	.sections = &sections,
@@ -54,6 +54,11 @@ static bool check_buffer(RzBuffer *buf) {
 	return r == sizeof(tmp) && !memcmp(tmp, QNX_MAGIC, sizeof(tmp));
 }
 
+static const RzBinMagic magics[] = {
+	RZ_BIN_MAGIC(QNX_MAGIC),
+	{ 0 }
+};
+
 static void destroy(RzBinFile *bf) {
 	QnxObj *qo = bf->o->bin_obj;
 	rz_list_free(qo->sections);
@@ -389,6 +394,7 @@ RzBinPlugin rz_bin_plugin_qnx = {
 	.baddr = &baddr,
 	.author = "deepakchethan",
 	.check_buffer = &check_buffer,
+	.magics = magics,
 	.header = &header,
 	.get_sdb = &get_sdb,
 	.entries = &entries,
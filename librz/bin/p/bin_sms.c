@@ -12,27 +12,34 @@ typedef struct gen_hdr {
 	ut8 RegionRomSize; // Low 4 bits RomSize, Top 4 bits Region
 } SMS_Header;
 
-static ut32 cb = 0;
-
-static bool check_buffer(RzBuffer *b) {
+/**
+ * Finds the offset of the header, looked up again when needed instead of
+ * being kept in a global, so that several files can be loaded in parallel.
+ */
+static bool find_header(RzBuffer *b, ut32 *hdr_off) {
 	ut32 *off, offs[] = { 0x2000, 0x4000, 0x8000, 0x9000, 0 };
 	ut8 signature[8];
 	for (off = (ut32 *)&offs; *off; off++) {
 		rz_buf_read_at(b, *off - 16, (ut8 *)&signature, 8);
 		if (!strncmp((const char *)signature, "TMR SEGA", 8)) {
-			cb = *off - 16;
-			return true; // int)(*off - 16);
+			*hdr_off = *off - 16;
+			return true;
 		}
 		if (*off == 0x8000) {
 			if (!strncmp((const char *)signature, "SDSC", 4)) {
-				cb = *off - 16;
-				return true; // (int)(*off - 16);
+				*hdr_off = *off - 16;
+				return true;
 			}
 		}
 	}
 	return false;
 }
 
+static bool check_buffer(RzBuffer *b) {
+	ut32 hdr_off;
+	return find_header(b, &hdr_off);
+}
+
 static bool load_buffer(RzBinFile *bf, RzBinObject *obj, RzBuffer *buf, Sdb *sdb) {
 	return check_buffer(buf);
 }
@@ -50,13 +57,14 @@ static RzBinInfo *info(RzBinFile *bf) {
 	ret->arch = strdup("z80");
 	ret->has_va = 1;
 	ret->bits = 8;
-	if (!check_buffer(bf->buf)) {
+	ut32 hdr_off;
+	if (!find_header(bf->buf, &hdr_off)) {
 		eprintf("Cannot find magic SEGA copyright\n");
 		free(ret);
 		return NULL;
 	}
 	SMS_Header hdr = { { 0 } };
-	rz_buf_read_at(bf->buf, cb, (ut8 *)&hdr, sizeof(hdr));
+	rz_buf_read_at(bf->buf, hdr_off, (ut8 *)&hdr, sizeof(hdr));
 	hdr.CheckSum = rz_read_le16(&hdr.CheckSum);
 
 	eprintf("Checksum: 0x%04x\n", (ut32)hdr.CheckSum); // use endian safe apis here
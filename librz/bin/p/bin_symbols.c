@@ -353,6 +353,11 @@ static bool check_buffer(RzBuffer *b) {
 	return !memcmp(buf, "\x02\xff\x01\xff", 4);
 }
 
+static const RzBinMagic magics[] = {
+	RZ_BIN_MAGIC("\x02\xff\x01\xff"),
+	{ 0 }
+};
+
 static RzList /*<RzBinSymbol *>*/ *symbols(RzBinFile *bf) {
 	RzList *res = rz_list_newf((RzListFree)rz_bin_symbol_free);
 	rz_return_val_if_fail(res && bf->o && bf->o->bin_obj, res);
@@ -471,6 +476,7 @@ RzBinPlugin rz_bin_plugin_symbols = {
 	.license = "MIT",
 	.load_buffer = &load_buffer,
 	.check_buffer = &check_buffer,
+	.magics = magics,
 	.symbols = &symbols,
 	.maps = &rz_bin_maps_of_file_sections,
 	.sections = &sections,
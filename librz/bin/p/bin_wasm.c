@@ -17,6 +17,11 @@ static bool check_buffer(RzBuffer *rbuf) {
 	return rbuf && rz_buf_read_at(rbuf, 0, buf, 4) == 4 && !memcmp(buf, RZ_BIN_WASM_MAGIC_BYTES, 4);
 }
 
+static const RzBinMagic magics[] = {
+	RZ_BIN_MAGIC(RZ_BIN_WASM_MAGIC_BYTES),
+	{ 0 }
+};
+
 static bool find_export(const ut32 *p, const RzBinWasmExportEntry *q) {
 	if (q->kind != RZ_BIN_WASM_EXTERNALKIND_Function) {
 		return true;
@@ -332,6 +337,7 @@ RzBinPlugin rz_bin_plugin_wasm = {
 	.size = &size,
 	.destroy = &destroy,
 	.check_buffer = &check_buffer,
+	.magics = magics,
 	.baddr = &baddr,
 	.binsym = &binsym,
 	.entries = &entries,
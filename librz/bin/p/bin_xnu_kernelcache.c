@@ -985,6 +985,11 @@ static bool check_buffer(RzBuffer *b) {
 	return false;
 }
 
+static const RzBinMagic magics[] = {
+	RZ_BIN_MAGIC("\xcf\xfa\xed\xfe"),
+	{ 0 }
+};
+
 static RzList /*<RzBinVirtualFile *>*/ *virtual_files(RzBinFile *bf) {
 	rz_return_val_if_fail(bf, NULL);
 	RzList *ret = rz_list_newf((RzListFree)rz_bin_virtual_file_free);
@@ -1942,6 +1947,7 @@ RzBinPlugin rz_bin_plugin_xnu_kernelcache = {
 	.symbols = &symbols,
 	.sections = &sections,
 	.check_buffer = &check_buffer,
+	.magics = magics,
 	.info = &info
 };
 
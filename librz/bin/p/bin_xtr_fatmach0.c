@@ -42,6 +42,11 @@ static bool check_buffer(RzBuffer *buf) {
 	return checkHeader(buf);
 }
 
+static const RzBinMagic magics[] = {
+	RZ_BIN_MAGIC("\xca\xfe\xba\xbe"),
+	{ 0 }
+};
+
 static void free_xtr(void *xtr_obj) {
 	rz_bin_fatmach0_free((struct rz_bin_fatmach0_obj_t *)xtr_obj);
 }
@@ -160,6 +165,7 @@ RzBinXtrPlugin rz_bin_xtr_plugin_xtr_fatmach0 = {
 	.extractall_from_buffer = &oneshotall_buffer,
 	.free_xtr = &free_xtr,
 	.check_buffer = check_buffer,
+	.magics = magics,
 };
 
 #ifndef RZ_PLUGIN_INCORE
@@ -64,10 +64,9 @@ typedef struct {
 	// BOOT CODE?
 } N64Header;
 
-static N64Header n64_header;
-
 static ut64 baddr(RzBinFile *bf) {
-	return (ut64)rz_read_be32(&n64_header.BootAddress);
+	N64Header *hdr = bf && bf->o ? bf->o->bin_obj : NULL;
+	return hdr ? (ut64)rz_read_be32(&hdr->BootAddress) : 0;
 }
 
 static bool check_buffer(RzBuffer *b) {
@@ -79,14 +78,27 @@ static bool check_buffer(RzBuffer *b) {
 	return !memcmp(magic, "\x80\x37\x12\x40", 4);
 }
 
+static const RzBinMagic magics[] = {
+	RZ_BIN_MAGIC("\x80\x37\x12\x40"),
+	{ 0 }
+};
+
 static bool load_buffer(RzBinFile *bf, RzBinObject *obj, RzBuffer *b, Sdb *sdb) {
-	if (check_buffer(b)) {
-		ut8 buf[sizeof(N64Header)] = { 0 };
-		rz_buf_read_at(b, 0, buf, sizeof(buf));
-		obj->bin_obj = memcpy(&n64_header, buf, sizeof(N64Header));
-		return true;
+	if (!check_buffer(b)) {
+		return false;
 	}
-	return false;
+	// the header belongs to the object, files may be loaded by several threads
+	N64Header *hdr = RZ_NEW0(N64Header);
+	if (!hdr) {
+		return false;
+	}
+	rz_buf_read_at(b, 0, (ut8 *)hdr, sizeof(N64Header));
+	obj->bin_obj = hdr;
+	return true;
+}
+
+static void destroy(RzBinFile *bf) {
+	free(bf->o->bin_obj);
 }
 
 static RzList /*<RzBinAddr *>*/ *entries(RzBinFile *bf) {
@@ -129,12 +141,13 @@ static ut64 boffset(RzBinFile *bf) {
 
 static RzBinInfo *info(RzBinFile *bf) {
 	char GameName[21] = { 0 };
+	N64Header *hdr = bf->o->bin_obj;
 	RzBinInfo *ret = RZ_NEW0(RzBinInfo);
 	if (!ret) {
 		return NULL;
 	}
-	memcpy(GameName, n64_header.Name, sizeof(n64_header.Name));
-	ret->file = rz_str_newf("%s (%c)", GameName, n64_header.CountryCode);
+	memcpy(GameName, hdr->Name, sizeof(hdr->Name));
+	ret->file = rz_str_newf("%s (%c)", GameName, hdr->CountryCode);
 	ret->os = strdup("n64");
 	ret->arch = strdup("mips");
 	ret->machine = strdup("Nintendo 64");
@@ -152,7 +165,9 @@ RzBinPlugin rz_bin_plugin_z64 = {
 	.desc = "Nintendo 64 Bin-BE plugin",
 	.license = "LGPL3",
 	.load_buffer = &load_buffer,
+	.destroy = &destroy,
 	.check_buffer = &check_buffer,
+	.magics = magics,
 	.baddr = baddr,
 	.boffset = &boffset,
 	.entries = &entries,
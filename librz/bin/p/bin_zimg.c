@@ -33,6 +33,11 @@ static bool check_buffer(RzBuffer *b) {
 	return false;
 }
 
+static const RzBinMagic magics[] = {
+	RZ_BIN_MAGIC("\x00\x00\xa0\xe1\x00\x00\xa0\xe1"),
+	{ 0 }
+};
+
 static RzBinInfo *info(RzBinFile *bf) {
 	RzBinInfo *ret = RZ_NEW0(RzBinInfo);
 	if (!ret) {
@@ -61,6 +66,7 @@ RzBinPlugin rz_bin_plugin_zimg = {
 	.get_sdb = &get_sdb,
 	.load_buffer = &load_buffer,
 	.check_buffer = &check_buffer,
+	.magics = magics,
 	.baddr = &baddr,
 	.info = &info,
 };
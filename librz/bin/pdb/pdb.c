@@ -92,9 +92,139 @@ static bool parse_streams(RzPdb *pdb) {
 static void msf_stream_free(void *data) {
 	RzPdbMsfStream *msfstream = data;
 	rz_buf_free(msfstream->stream_data);
+	free(msfstream->blocks);
 	RZ_FREE(msfstream);
 }
 
+/*
+ * MSF streams are read in place from the PDB file: the stream offsets are
+ * translated into the blocks of the file on each read, nothing is copied
+ * up front. When the file buffer exposes its bytes (mmap or memory), reads
+ * do not touch its cursor, so that the views of a stream can be read from
+ * different threads.
+ */
+struct msf_stream_user {
+	RzBuffer *file;
+	ut32 block_size;
+	const ut32 *blocks;
+	ut32 size;
+};
+
+struct msf_stream_priv {
+	RzBuffer *file;
+	const ut8 *bytes; ///< contents of file, if addressable
+	ut64 bytes_size;
+	ut32 block_size;
+	const ut32 *blocks; ///< owned by the RzPdbMsfStream
+	ut64 size;
+	ut64 cur;
+};
+
+static const ut8 *file_bytes(RzBuffer *file, ut64 *size) {
+	// buffers without a native whole buffer would be copied, read them in chunks instead
+	return file->methods->get_whole_buf ? rz_buf_data(file, size) : NULL;
+}
+
+static bool msf_stream_buf_init(RzBuffer *b, const void *user) {
+	const struct msf_stream_user *u = user;
+	struct msf_stream_priv *priv = RZ_NEW0(struct msf_stream_priv);
+	if (!priv) {
+		return false;
+	}
+	priv->file = rz_buf_ref(u->file);
+	priv->bytes = file_bytes(priv->file, &priv->bytes_size);
+	priv->block_size = u->block_size;
+	priv->blocks = u->blocks;
+	priv->size = u->size;
+	b->readonly = true;
+	b->priv = priv;
+	return true;
+}
+
+static bool msf_stream_buf_fini(RzBuffer *b) {
+	struct msf_stream_priv *priv = b->priv;
+	rz_buf_free(priv->file);
+	RZ_FREE(b->priv);
+	return true;
+}
+
+static st64 msf_stream_buf_read(RzBuffer *b, ut8 *buf, ut64 len) {
+	struct msf_stream_priv *priv = b->priv;
+	if (priv->cur >= priv->size) {
+		return 0;
+	}
+	len = RZ_MIN(len, priv->size - priv->cur);
+	ut64 done = 0;
+	while (done < len) {
+		ut64 in_block = priv->cur % priv->block_size;
+		ut64 chunk = RZ_MIN(len - done, priv->block_size - in_block);
+		ut64 addr = (ut64)priv->blocks[priv->cur / priv->block_size] * priv->block_size + in_block;
+		if (priv->bytes) {
+			if (addr >= priv->bytes_size) {
+				break;
+			}
+			chunk = RZ_MIN(chunk, priv->bytes_size - addr);
+			memcpy(buf + done, priv->bytes + addr, chunk);
+		} else {
+			st64 r = rz_buf_read_at(priv->file, addr, buf + done, chunk);
+			if (r <= 0) {
+				break;
+			}
+			chunk = r;
+		}
+		done += chunk;
+		priv->cur += chunk;
+	}
+	return done;
+}
+
+static ut64 msf_stream_buf_get_size(RzBuffer *b) {
+	struct msf_stream_priv *priv = b->priv;
+	return priv->size;
+}
+
+static st64 msf_stream_buf_seek(RzBuffer *b, st64 addr, int whence) {
+	struct msf_stream_priv *priv = b->priv;
+	st64 val = rz_seek_offset(priv->cur, priv->size, addr, whence);
+	if (val == -1) {
+		return -1;
+	}
+	return priv->cur = val;
+}
+
+static const RzBufferMethods msf_stream_buf_methods = {
+	.init = msf_stream_buf_init,
+	.fini = msf_stream_buf_fini,
+	.read = msf_stream_buf_read,
+	.get_size = msf_stream_buf_get_size,
+	.seek = msf_stream_buf_seek,
+};
+
+/**
+ * \brief Returns a new read-only view over the data of \p stream
+ *
+ * Each view has its own cursor, see pdb_msf_concurrent_reads().
+ */
+RZ_IPI RZ_OWN RzBuffer *pdb_msf_stream_buf_new(RZ_NONNULL const RzPdb *pdb, RZ_NONNULL const RzPdbMsfStream *stream) {
+	rz_return_val_if_fail(pdb && stream, NULL);
+	struct msf_stream_user u = {
+		.file = pdb->buf,
+		.block_size = pdb->super_block->block_size,
+		.blocks = stream->blocks,
+		.size = stream->stream_size
+	};
+	return rz_buf_new_with_methods(&msf_stream_buf_methods, &u);
+}
+
+/**
+ * \brief Whether distinct views of the streams can be read at the same time
+ */
+RZ_IPI bool pdb_msf_concurrent_reads(RZ_NONNULL const RzPdb *pdb) {
+	rz_return_val_if_fail(pdb, false);
+	ut64 size;
+	return file_bytes(pdb->buf, &size) != NULL;
+}
+
 static void msf_stream_directory_free(void *data) {
 	RzPdbMsfStreamDirectory *msd = data;
 	RZ_FREE(msd->StreamSizes);
@@ -132,32 +262,29 @@ static RzList /*<RzPdbMsfStream *>*/ *pdb7_extract_streams(RzPdb *pdb, RzPdbMsfS
 			rz_list_append(streams, stream);
 			continue;
 		}
-		ut8 *stream_data = (ut8 *)malloc((size_t)stream->blocks_num * pdb->super_block->block_size);
-		if (!stream_data) {
+		stream->blocks = RZ_NEWS(ut32, stream->blocks_num);
+		if (!stream->blocks) {
 			RZ_FREE(stream);
 			rz_list_free(streams);
-			RZ_LOG_ERROR("Error allocating memory.\n");
-			return NULL;
+			goto error_memory;
 		}
+		rz_list_append(streams, stream);
 		for (size_t j = 0; j < stream->blocks_num; j++) {
-			ut32 block_idx;
-			if (!rz_buf_read_le32(msd->sd, &block_idx)) {
-				RZ_FREE(stream);
-				RZ_FREE(stream_data);
+			if (!rz_buf_read_le32(msd->sd, &stream->blocks[j])) {
+				rz_list_free(streams);
+				return NULL;
+			}
+			if (stream->blocks[j] >= pdb->super_block->num_blocks) {
+				RZ_LOG_ERROR("Error block index.\n");
 				rz_list_free(streams);
 				return NULL;
 			}
-			rz_buf_seek(pdb->buf, (long long)block_idx * pdb->super_block->block_size, RZ_BUF_SET);
-			rz_buf_read(pdb->buf, stream_data + j * pdb->super_block->block_size, pdb->super_block->block_size);
 		}
-		stream->stream_data = rz_buf_new_with_pointers(stream_data, stream->stream_size, true);
+		stream->stream_data = pdb_msf_stream_buf_new(pdb, stream);
 		if (!stream->stream_data) {
-			RZ_FREE(stream);
-			RZ_FREE(stream_data);
 			rz_list_free(streams);
 			goto error_memory;
 		}
-		rz_list_append(streams, stream);
 	}
 	msf_stream_directory_free(msd);
 	return streams;
@@ -291,7 +418,11 @@ bool is_compressed_pdb(RzBuffer *buf) {
  */
 RZ_API RZ_OWN RzPdb *rz_bin_pdb_parse_from_file(RZ_NONNULL const char *filename) {
 	rz_return_val_if_fail(filename, NULL);
-	RzBuffer *buf = rz_buf_new_slurp(filename);
+	// the streams are read in place, so map the file rather than loading it
+	RzBuffer *buf = rz_buf_new_mmap(filename, RZ_PERM_R, 0);
+	if (!buf) {
+		buf = rz_buf_new_slurp(filename);
+	}
 	if (!buf) {
 		RZ_LOG_ERROR("%s: Error reading file \"%s\"\n", __FUNCTION__, filename);
 		return false;
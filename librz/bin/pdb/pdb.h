@@ -10,6 +10,10 @@
 
 #ifndef PDB_PRIVATE_INCLUDE_H_
 #define PDB_PRIVATE_INCLUDE_H_
+// MSF
+RZ_IPI RZ_OWN RzBuffer *pdb_msf_stream_buf_new(RZ_NONNULL const RzPdb *pdb, RZ_NONNULL const RzPdbMsfStream *stream);
+RZ_IPI bool pdb_msf_concurrent_reads(RZ_NONNULL const RzPdb *pdb);
+
 // OMAP
 RZ_IPI bool parse_omap_stream(RzPdb *pdb, RzPdbMsfStream *stream);
 RZ_IPI void free_omap_stream(RzPdbOmapStream *stream);
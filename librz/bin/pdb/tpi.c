@@ -708,6 +708,7 @@ RZ_IPI void free_tpi_stream(RzPdbTpiStream *stream) {
 	}
 	rz_rbtree_free(stream->types, free_tpi_rbtree, NULL);
 	rz_list_free(stream->print_type);
+	free(stream->type_offsets);
 	free(stream);
 }
 
@@ -1796,6 +1797,73 @@ static bool parse_tpi_stream_header(RzPdbTpiStream *s, RzBuffer *buf) {
 		rz_buf_read_le32(buf, &s->header.HashAdjBufferLength);
 }
 
+/**
+ * \brief Locates the records with the index offsets of the TPI hash stream
+ *
+ * These are spread across the stream, so that a record is never far from
+ * a known one.
+ */
+static void tpi_load_index_offsets(RzPdb *pdb, RzPdbTpiStream *s) {
+	RzPdbMsfStream *hash = s->header.HashStreamIndex != UT16_MAX ? rz_list_get_n(pdb->streams, s->header.HashStreamIndex) : NULL;
+	if (!hash || !hash->stream_data || s->header.IndexOffsetBufferOffset < 0) {
+		return;
+	}
+	ut64 at = s->header.IndexOffsetBufferOffset;
+	for (ut32 i = 0; i < s->header.IndexOffsetBufferLength / (2 * sizeof(ut32)); i++, at += 2 * sizeof(ut32)) {
+		ut32 index, offset;
+		if (!rz_buf_read_le32_at(hash->stream_data, at, &index) ||
+			!rz_buf_read_le32_at(hash->stream_data, at + sizeof(ut32), &offset)) {
+			break;
+		}
+		if (index < s->header.TypeIndexBegin || index >= s->header.TypeIndexEnd || offset >= s->header.TypeRecordBytes) {
+			continue;
+		}
+		s->type_offsets[index - s->header.TypeIndexBegin] = s->header.HeaderSize + offset;
+	}
+}
+
+/**
+ * \brief Finds the offset of the record of type \p index, walking the
+ *        records from the closest one already located
+ */
+static bool tpi_type_offset(RzPdbTpiStream *s, ut32 index, ut32 *offset) {
+	ut32 i = index - s->header.TypeIndexBegin;
+	ut32 j = i;
+	while (!s->type_offsets[j]) { // the first record is always located
+		j--;
+	}
+	ut64 end = RZ_MIN((ut64)s->header.HeaderSize + s->header.TypeRecordBytes, rz_buf_size(s->buf));
+	for (; j < i; j++) {
+		ut16 length;
+		if (!rz_buf_read_le16_at(s->buf, s->type_offsets[j], &length)) {
+			return false;
+		}
+		ut64 next = (ut64)s->type_offsets[j] + sizeof(ut16) + length;
+		if (next >= end) {
+			return false;
+		}
+		s->type_offsets[j + 1] = next;
+	}
+	*offset = s->type_offsets[i];
+	return true;
+}
+
+static RzPdbTpiType *tpi_parse_type_at(RzBuffer *buf, ut32 index, ut32 offset) {
+	if (rz_buf_seek(buf, offset, RZ_BUF_SET) < 0) {
+		return NULL;
+	}
+	RzPdbTpiType *type = RZ_NEW0(RzPdbTpiType);
+	if (!type) {
+		return NULL;
+	}
+	type->type_index = index;
+	if (!parse_tpi_types(buf, type) || !type->type_data) {
+		RZ_LOG_ERROR("Parse TPI type error. idx in stream: 0x%" PFMT32x "\n", index);
+		RZ_FREE(type);
+	}
+	return type;
+}
+
 RZ_IPI bool parse_tpi_stream(RzPdb *pdb, RzPdbMsfStream *stream) {
 	if (!pdb || !stream) {
 		return false;
@@ -1815,29 +1883,31 @@ RZ_IPI bool parse_tpi_stream(RzPdb *pdb, RzPdbMsfStream *stream) {
 	if (!parse_tpi_stream_header(s, buf)) {
 		return false;
 	}
-	if (s->header.HeaderSize != sizeof(RzPdbTpiStreamHeader)) {
+	if (s->header.HeaderSize != sizeof(RzPdbTpiStreamHeader) || s->header.TypeIndexEnd < s->header.TypeIndexBegin) {
 		RZ_LOG_ERROR("Corrupted TPI stream.\n");
 		return false;
 	}
-	RzPdbTpiType *type;
-	for (ut32 i = s->header.TypeIndexBegin; i < s->header.TypeIndexEnd; i++) {
-		type = RZ_NEW0(RzPdbTpiType);
-		if (!type) {
-			continue;
-		}
-		type->type_index = i;
-		if (!parse_tpi_types(buf, type) || !type->type_data) {
-			RZ_LOG_ERROR("Parse TPI type error. idx in stream: 0x%" PFMT32x "\n", i);
-			RZ_FREE(type);
-			return false;
-		}
-		rz_rbtree_insert(&s->types, &type->type_index, &type->rb, tpi_type_node_cmp, NULL);
+	// the records are parsed on lookup, only their offsets are kept for now
+	s->buf = buf;
+	ut32 count = s->header.TypeIndexEnd - s->header.TypeIndexBegin;
+	if (!count) {
+		return true;
+	}
+	s->type_offsets = RZ_NEWS0(ut32, count);
+	if (!s->type_offsets) {
+		RZ_LOG_ERROR("Error allocating memory.\n");
+		return false;
 	}
+	s->type_offsets[0] = s->header.HeaderSize;
+	tpi_load_index_offsets(pdb, s);
 	return true;
 }
 
 /**
  * \brief Get RzPdbTpiType that matches tpi stream index
+ *
+ * The record of the type is parsed on the first lookup.
+ *
  * \param stream TPI Stream
  * \param index TPI Stream Index
  */
@@ -1848,13 +1918,141 @@ RZ_API RZ_BORROW RzPdbTpiType *rz_bin_pdb_get_type_by_index(RZ_NONNULL RzPdbTpiS
 	}
 
 	RBNode *node = rz_rbtree_find(stream->types, &index, tpi_type_node_cmp, NULL);
-	if (!node) {
-		if (!is_simple_type(stream, index)) {
-			return NULL;
-		} else {
-			return parse_simple_type(stream, index);
-		}
+	if (node) {
+		return container_of(node, RzPdbTpiType, rb);
+	}
+	if (is_simple_type(stream, index)) {
+		return parse_simple_type(stream, index);
+	}
+	ut32 offset;
+	if (index >= stream->header.TypeIndexEnd || !stream->type_offsets || !tpi_type_offset(stream, index, &offset)) {
+		return NULL;
+	}
+	RzPdbTpiType *type = tpi_parse_type_at(stream->buf, index, offset);
+	if (type) {
+		rz_rbtree_insert(&stream->types, &type->type_index, &type->rb, tpi_type_node_cmp, NULL);
 	}
-	RzPdbTpiType *type = container_of(node, RzPdbTpiType, rb);
 	return type;
 }
+
+/* below this number of types, the records are parsed by the calling thread */
+#define TPI_PARALLEL_MIN 0x1000
+
+typedef struct {
+	RzPdbTpiStream *stream;
+	RzBuffer *buf;
+	RzPdbTpiType **parsed;
+	ut32 from;
+	ut32 to;
+} TpiParseSlice;
+
+static void *tpi_parse_slice_runner(TpiParseSlice *slice) {
+	RzPdbTpiStream *s = slice->stream;
+	for (ut32 i = slice->from; i < slice->to; i++) {
+		ut32 index = s->header.TypeIndexBegin + i;
+		if (rz_rbtree_find(s->types, &index, tpi_type_node_cmp, NULL)) {
+			continue;
+		}
+		slice->parsed[i] = tpi_parse_type_at(slice->buf, index, s->type_offsets[i]);
+	}
+	return NULL;
+}
+
+/**
+ * \brief Parses the records of all the types of the TPI stream in parallel
+ *
+ * Gives each thread its own view of the stream and returns false if
+ * they cannot be read at the same time.
+ */
+static bool tpi_parse_parallel(const RzPdb *pdb, RzPdbTpiType **parsed, ut32 count) {
+	RzPdbMsfStream *msf = rz_list_get_n(pdb->streams, PDB_STREAM_TPI);
+	if (!msf || !pdb_msf_concurrent_reads(pdb)) {
+		return false;
+	}
+	RzThreadPool *pool = rz_th_pool_new(RZ_THREAD_POOL_ALL_CORES);
+	if (!pool) {
+		return false;
+	}
+	size_t pool_size = rz_th_pool_size(pool);
+	ut32 per_thread = (count + pool_size - 1) / pool_size;
+	TpiParseSlice *slices = RZ_NEWS0(TpiParseSlice, pool_size);
+	if (!slices) {
+		rz_th_pool_free(pool);
+		return false;
+	}
+	ut32 done = 0;
+	for (size_t i = 0; i < pool_size && done < count; i++) {
+		TpiParseSlice *slice = &slices[i];
+		slice->stream = pdb->s_tpi;
+		slice->parsed = parsed;
+		slice->from = done;
+		slice->to = RZ_MIN(done + per_thread, count);
+		slice->buf = pdb_msf_stream_buf_new(pdb, msf);
+		RzThread *th = slice->buf ? rz_th_new((RzThreadFunction)tpi_parse_slice_runner, slice) : NULL;
+		if (!th) {
+			break;
+		} else if (!rz_th_pool_add_thread(pool, th)) {
+			rz_th_wait(th);
+			rz_th_free(th);
+			break;
+		}
+		done = slice->to;
+	}
+	rz_th_pool_wait(pool);
+	rz_th_pool_free(pool);
+	for (size_t i = 0; i < pool_size; i++) {
+		rz_buf_free(slices[i].buf);
+	}
+	free(slices);
+	if (done < count) {
+		// the records left out by a failure are parsed by the calling thread
+		TpiParseSlice rest = { pdb->s_tpi, pdb->s_tpi->buf, parsed, done, count };
+		tpi_parse_slice_runner(&rest);
+	}
+	return true;
+}
+
+/**
+ * \brief Parses the records of all the types of the TPI stream
+ *
+ * Types are otherwise parsed on lookup. Large streams are parsed
+ * in parallel, the types are then stored in index order.
+ *
+ * \param pdb PDB instance
+ * \return false if a record could not be parsed
+ */
+RZ_API bool rz_bin_pdb_load_all_types(RZ_NONNULL const RzPdb *pdb) {
+	rz_return_val_if_fail(pdb, false);
+	RzPdbTpiStream *s = pdb->s_tpi;
+	if (!s || !s->type_offsets) {
+		return true;
+	}
+	ut32 count = s->header.TypeIndexEnd - s->header.TypeIndexBegin;
+	// locates all the records in a single walk, each one right after the previous
+	for (ut32 i = 1; i < count; i++) {
+		ut32 offset;
+		if (!s->type_offsets[i] && !tpi_type_offset(s, s->header.TypeIndexBegin + i, &offset)) {
+			RZ_LOG_ERROR("Corrupted TPI stream.\n");
+			return false;
+		}
+	}
+	RzPdbTpiType **parsed = RZ_NEWS0(RzPdbTpiType *, count);
+	if (!parsed) {
+		return false;
+	}
+	if (count < TPI_PARALLEL_MIN || !tpi_parse_parallel(pdb, parsed, count)) {
+		TpiParseSlice all = { s, s->buf, parsed, 0, count };
+		tpi_parse_slice_runner(&all);
+	}
+	bool ret = true;
+	for (ut32 i = 0; i < count; i++) {
+		if (parsed[i]) {
+			rz_rbtree_insert(&s->types, &parsed[i]->type_index, &parsed[i]->rb, tpi_type_node_cmp, NULL);
+			continue;
+		}
+		ut32 index = s->header.TypeIndexBegin + i;
+		ret &= !!rz_rbtree_find(s->types, &index, tpi_type_node_cmp, NULL);
+	}
+	free(parsed);
+	return ret;
+}
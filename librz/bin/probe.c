@@ -0,0 +1,142 @@
+// SPDX-FileCopyrightText: 2024 RizinOrg <info@rizin.re>
+// SPDX-License-Identifier: LGPL-3.0-only
+
+/**
+ * \file probe.c
+ * Dispatch table used to find the plugins that may handle a file.
+ *
+ * Plugins declaring magics are only registered in the buckets of the first
+ * byte of their magics, plugins without magics are registered in all of them.
+ * Every bucket keeps the registration order, so probing the candidates of a
+ * bucket gives the same result as probing all the plugins in order.
+ */
+
+#include <rz_bin.h>
+#include "i/private.h"
+
+struct rz_bin_probe_t {
+	RzPVector /*<RzBinProbeEntry *>*/ entries; ///< all the entries in registration order
+	RzPVector /*<RzBinProbeEntry *>*/ buckets[256]; ///< candidates by first byte of the header
+};
+
+RZ_IPI RzBinProbe *rz_bin_probe_new(void) {
+	RzBinProbe *probe = RZ_NEW0(RzBinProbe);
+	if (!probe) {
+		return NULL;
+	}
+	rz_pvector_init(&probe->entries, free);
+	for (size_t i = 0; i < RZ_ARRAY_SIZE(probe->buckets); i++) {
+		rz_pvector_init(&probe->buckets[i], NULL);
+	}
+	return probe;
+}
+
+RZ_IPI void rz_bin_probe_free(RZ_NULLABLE RzBinProbe *probe) {
+	if (!probe) {
+		return;
+	}
+	for (size_t i = 0; i < RZ_ARRAY_SIZE(probe->buckets); i++) {
+		rz_pvector_fini(&probe->buckets[i]);
+	}
+	rz_pvector_fini(&probe->entries);
+	free(probe);
+}
+
+static bool bucket_push(RzPVector *bucket, RzBinProbeEntry *entry) {
+	// several magics may start with the same byte
+	if (!rz_pvector_empty(bucket) && rz_pvector_tail(bucket) == entry) {
+		return true;
+	}
+	return rz_pvector_push(bucket, entry) != NULL;
+}
+
+/**
+ * \brief Registers \p plugin after all the plugins already added to \p probe
+ */
+RZ_IPI bool rz_bin_probe_add(RZ_NONNULL RzBinProbe *probe, RZ_NONNULL void *plugin, RZ_NULLABLE const RzBinMagic *magics) {
+	rz_return_val_if_fail(probe && plugin, false);
+	RzBinProbeEntry *entry = RZ_NEW0(RzBinProbeEntry);
+	if (!entry) {
+		return false;
+	}
+	entry->plugin = plugin;
+	entry->magics = magics && magics->len ? magics : NULL;
+	if (!rz_pvector_push(&probe->entries, entry)) {
+		free(entry);
+		return false;
+	}
+	bool ok = true;
+	if (!entry->magics) {
+		for (size_t i = 0; i < RZ_ARRAY_SIZE(probe->buckets); i++) {
+			ok &= bucket_push(&probe->buckets[i], entry);
+		}
+		return ok;
+	}
+	for (const RzBinMagic *m = entry->magics; m->len; m++) {
+		rz_warn_if_fail(m->len <= RZ_BIN_MAGIC_SIZE);
+		ok &= bucket_push(&probe->buckets[(ut8)m->bytes[0]], entry);
+	}
+	return ok;
+}
+
+/**
+ * \brief Removes \p plugin from \p probe
+ */
+RZ_IPI void rz_bin_probe_del(RZ_NONNULL RzBinProbe *probe, RZ_NONNULL void *plugin) {
+	rz_return_if_fail(probe && plugin);
+	void **it;
+	RzBinProbeEntry *entry = NULL;
+	rz_pvector_foreach (&probe->entries, it) {
+		RzBinProbeEntry *e = *it;
+		if (e->plugin == plugin) {
+			entry = e;
+			break;
+		}
+	}
+	if (!entry) {
+		return;
+	}
+	for (size_t i = 0; i < RZ_ARRAY_SIZE(probe->buckets); i++) {
+		rz_pvector_remove_data(&probe->buckets[i], entry);
+	}
+	rz_pvector_remove_data(&probe->entries, entry);
+	free(entry);
+}
+
+/**
+ * \brief Reads the bytes compared against the magics into \p header
+ *
+ * \return the number of bytes read, 0 for empty or unreadable files
+ */
+RZ_IPI size_t rz_bin_probe_read_header(RZ_NONNULL RzBuffer *buf, ut8 header[RZ_BIN_MAGIC_SIZE]) {
+	rz_return_val_if_fail(buf && header, 0);
+	st64 r = rz_buf_read_at(buf, 0, header, RZ_BIN_MAGIC_SIZE);
+	return r > 0 ? (size_t)r : 0;
+}
+
+/**
+ * \brief Returns the entries that may handle a file starting with \p header, in registration order
+ *
+ * Entries of plugins with magics must still be checked with rz_bin_probe_entry_match().
+ */
+RZ_IPI const RzPVector /*<RzBinProbeEntry *>*/ *rz_bin_probe_candidates(RZ_NONNULL RzBinProbe *probe, RZ_NONNULL const ut8 *header, size_t header_size) {
+	rz_return_val_if_fail(probe && header, NULL);
+	// no plugin with magics can match an empty file
+	return header_size ? &probe->buckets[header[0]] : &probe->entries;
+}
+
+/**
+ * \brief Whether the file starting with \p header may be handled by the plugin of \p entry
+ */
+RZ_IPI bool rz_bin_probe_entry_match(RZ_NONNULL const RzBinProbeEntry *entry, RZ_NONNULL const ut8 *header, size_t header_size) {
+	rz_return_val_if_fail(entry && header, false);
+	if (!entry->magics) {
+		return true;
+	}
+	for (const RzBinMagic *m = entry->magics; m->len; m++) {
+		if (m->len <= header_size && !memcmp(header, m->bytes, m->len)) {
+			return true;
+		}
+	}
+	return false;
+}
@@ -506,29 +506,6 @@ RZ_IPI void rz_core_analysis_bb_info_print(RzCore *core, RzAnalysisBlock *bb, ut
 	bb_info_print(core, fcn, bb, addr, state->mode, state->d.pj, state->d.t);
 }
 
-/*this only autoname those function that start with fcn.* or sym.func.* */
-RZ_API void rz_core_analysis_autoname_all_fcns(RzCore *core) {
-	RzListIter *it;
-	RzAnalysisFunction *fcn;
-
-	rz_list_foreach (core->analysis->fcns, it, fcn) {
-		if (!strncmp(fcn->name, "fcn.", 4) || !strncmp(fcn->name, "sym.func.", 9)) {
-			RzFlagItem *item = rz_flag_get(core->flags, fcn->name);
-			if (item) {
-				char *name = rz_core_analysis_function_autoname(core, fcn);
-				if (name) {
-					rz_flag_rename(core->flags, item, name);
-					free(fcn->name);
-					fcn->name = name;
-				}
-			} else {
-				// there should always be a flag for a function
-				rz_warn_if_reached();
-			}
-		}
-	}
-}
-
 static bool blacklisted_word(const char *name) {
 	const char *list[] = {
 		"__stack_chk_guard",
@@ -546,19 +523,19 @@ static bool blacklisted_word(const char *name) {
 }
 
 /**
- * \brief Suggest a name for the function
+ * Computes the suggested name of \p fcn from the given xrefs.
+ * This only reads the flags and never evaluates flag aliases, thus
+ * it can be called concurrently as long as nobody modifies the flags.
  */
-RZ_API RZ_OWN char *rz_core_analysis_function_autoname(RZ_NONNULL RzCore *core, RZ_NONNULL RzAnalysisFunction *fcn) {
-	rz_return_val_if_fail(core && fcn, NULL);
-
+static char *function_autoname(RzFlag *flags, RzAnalysisFunction *fcn, RzList /*<RzAnalysisXRef *>*/ *xrefs, ut64 main_addr) {
 	RzAnalysisXRef *xref;
 	RzListIter *iter;
 	bool use_getopt = false;
 	bool use_isatty = false;
 	char *do_call = NULL;
-	RzList *xrefs = rz_analysis_function_get_xrefs_from(fcn);
 	rz_list_foreach (xrefs, iter, xref) {
-		RzFlagItem *f = rz_flag_get_i(core->flags, xref->to);
+		const RzList *fl = rz_flag_get_list(flags, xref->to);
+		RzFlagItem *f = fl ? rz_list_get_top(fl) : NULL;
 		if (f && !blacklisted_word(f->name)) {
 			if (strstr(f->name, ".isatty")) {
 				use_isatty = 1;
@@ -588,13 +565,11 @@ RZ_API RZ_OWN char *rz_core_analysis_function_autoname(RZ_NONNULL RzCore *core,
 			}
 		}
 	}
-	rz_list_free(xrefs);
 	// TODO: append counter if name already exists
 	if (use_getopt) {
-		RzFlagItem *item = rz_flag_get(core->flags, "main");
 		free(do_call);
 		// if referenced from entrypoint. this should be main
-		if (item && item->offset == fcn->addr) {
+		if (main_addr == fcn->addr) {
 			return strdup("main"); // main?
 		}
 		return strdup("parse_args"); // main?
@@ -612,6 +587,172 @@ RZ_API RZ_OWN char *rz_core_analysis_function_autoname(RZ_NONNULL RzCore *core,
 	return NULL;
 }
 
+static ut64 main_flag_addr(RzCore *core) {
+	RzFlagItem *item = rz_flag_get(core->flags, "main");
+	return item ? item->offset : UT64_MAX;
+}
+
+static bool is_autoname_candidate(RzAnalysisFunction *fcn) {
+	return !strncmp(fcn->name, "fcn.", 4) || !strncmp(fcn->name, "sym.func.", 9);
+}
+
+typedef struct {
+	RzAnalysisFunction *fcn;
+	RzList /*<RzAnalysisXRef *>*/ *xrefs;
+	char *name;
+} AutonameJob;
+
+typedef struct {
+	RzFlag *flags;
+	ut64 main_addr;
+	RzThreadQueue *queue;
+} AutonameShared;
+
+static void autoname_job_free(AutonameJob *job) {
+	if (!job) {
+		return;
+	}
+	rz_list_free(job->xrefs);
+	free(job->name);
+	free(job);
+}
+
+static void *autoname_thread(AutonameShared *shared) {
+	AutonameJob *job;
+	while ((job = rz_th_queue_pop(shared->queue, false))) {
+		job->xrefs = rz_analysis_function_get_xrefs_from(job->fcn);
+		job->name = function_autoname(shared->flags, job->fcn, job->xrefs, shared->main_addr);
+	}
+	return NULL;
+}
+
+/**
+ * Suggests the names of all the jobs in parallel; the analysis and the
+ * flags are only read here, the results are committed by the caller.
+ */
+static bool autoname_run_jobs(RzCore *core, RzList /*<AutonameJob *>*/ *jobs) {
+	size_t max_threads = rz_config_get_i(core->config, "analysis.threads");
+	RzThreadPool *pool = rz_th_pool_new(max_threads);
+	RzList *pending = rz_list_clone(jobs);
+	RzThreadQueue *queue = pending ? rz_th_queue_new2(pending) : NULL;
+	if (!pool || !queue) {
+		if (!queue) {
+			rz_list_free(pending);
+		}
+		rz_th_queue_free(queue);
+		rz_th_pool_free(pool);
+		return false;
+	}
+
+	AutonameShared shared = {
+		.flags = core->flags,
+		.main_addr = main_flag_addr(core),
+		.queue = queue,
+	};
+
+	size_t pool_size = rz_th_pool_size(pool);
+	RZ_LOG_VERBOSE("autoname: using %u threads\n", (ut32)pool_size);
+	for (size_t i = 0; i < pool_size; ++i) {
+		RzThread *th = rz_th_new((RzThreadFunction)autoname_thread, &shared);
+		if (!th || !rz_th_pool_add_thread(pool, th)) {
+			rz_th_free(th);
+			break;
+		}
+	}
+	rz_th_pool_wait(pool);
+	// any job left in the queue (i.e. no thread could be started) is handled here.
+	autoname_thread(&shared);
+
+	rz_th_pool_free(pool);
+	rz_th_queue_free(queue);
+	return true;
+}
+
+static bool xrefs_to_renamed(RzList /*<RzAnalysisXRef *>*/ *xrefs, SetU *renamed) {
+	RzAnalysisXRef *xref;
+	RzListIter *iter;
+	rz_list_foreach (xrefs, iter, xref) {
+		if (set_u_contains(renamed, xref->to)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+/*this only autoname those function that start with fcn.* or sym.func.* */
+RZ_API void rz_core_analysis_autoname_all_fcns(RzCore *core) {
+	RzListIter *it;
+	RzAnalysisFunction *fcn;
+
+	RzList *jobs = rz_list_newf((RzListFree)autoname_job_free);
+	SetU *renamed = set_u_new();
+	if (!jobs || !renamed) {
+		goto beach;
+	}
+	rz_list_foreach (core->analysis->fcns, it, fcn) {
+		if (!is_autoname_candidate(fcn)) {
+			continue;
+		}
+		AutonameJob *job = RZ_NEW0(AutonameJob);
+		if (!job || !rz_list_append(jobs, job)) {
+			free(job);
+			goto beach;
+		}
+		job->fcn = fcn;
+	}
+	if (rz_list_empty(jobs)) {
+		goto beach;
+	}
+	if (!autoname_run_jobs(core, jobs)) {
+		RZ_LOG_WARN("autoname: cannot start the worker threads, falling back to serial mode\n");
+	}
+
+	// Commit the names in the same order of the serial implementation.
+	// A name suggested from a flag that has been renamed by a previous
+	// job is stale, so it is computed again against the current flags.
+	AutonameJob *job;
+	rz_list_foreach (jobs, it, job) {
+		fcn = job->fcn;
+		RzFlagItem *item = rz_flag_get(core->flags, fcn->name);
+		if (!item) {
+			// there should always be a flag for a function
+			rz_warn_if_reached();
+			continue;
+		}
+		char *name = job->name;
+		job->name = NULL;
+		if (!job->xrefs) {
+			job->xrefs = rz_analysis_function_get_xrefs_from(fcn);
+			name = function_autoname(core->flags, fcn, job->xrefs, main_flag_addr(core));
+		} else if (xrefs_to_renamed(job->xrefs, renamed)) {
+			free(name);
+			name = function_autoname(core->flags, fcn, job->xrefs, main_flag_addr(core));
+		}
+		if (name) {
+			set_u_add(renamed, item->offset);
+			rz_flag_rename(core->flags, item, name);
+			free(fcn->name);
+			fcn->name = name;
+		}
+	}
+
+beach:
+	set_u_free(renamed);
+	rz_list_free(jobs);
+}
+
+/**
+ * \brief Suggest a name for the function
+ */
+RZ_API RZ_OWN char *rz_core_analysis_function_autoname(RZ_NONNULL RzCore *core, RZ_NONNULL RzAnalysisFunction *fcn) {
+	rz_return_val_if_fail(core && fcn, NULL);
+
+	RzList *xrefs = rz_analysis_function_get_xrefs_from(fcn);
+	char *name = function_autoname(core->flags, fcn, xrefs, main_flag_addr(core));
+	rz_list_free(xrefs);
+	return name;
+}
+
 /**
  * \brief Print all string flags referenced by the function
  */
@@ -851,7 +992,7 @@ static int __core_analysis_fcn(RzCore *core, ut64 at, ut64 from, int reftype, in
 	if (!fcn->name) {
 		fcn->name = rz_str_newf("%s.%08" PFMT64x, fcnpfx, at);
 	}
-	rz_analysis_fcn_invalidate_read_ahead_cache();
+	rz_analysis_fcn_invalidate_read_ahead_cache(core->analysis);
 	do {
 		RzFlagItem *f;
 		ut64 delta = rz_analysis_function_linear_size(fcn);
@@ -895,13 +1036,13 @@ static int __core_analysis_fcn(RzCore *core, ut64 at, ut64 from, int reftype, in
 			f = rz_core_flag_get_by_spaces(core->flags, fcn->addr);
 			if (f && f->name && strncmp(f->name, "sect", 4)) { /* Check if it's already flagged */
 				char *new_name = strdup(f->name);
-				if (is_entry_flag(f)) {
-					RzListIter *iter;
-					RzBinSymbol *sym;
-					const RzList *syms = rz_bin_get_symbols(core->bin);
-					ut64 baddr = rz_config_get_i(core->config, "bin.baddr");
-					rz_list_foreach (syms, iter, sym) {
-						if ((sym->paddr + baddr) == fcn->addr && !strcmp(sym->type, RZ_BIN_TYPE_FUNC_STR)) {
+				RzBinObject *o = rz_bin_cur_object(core->bin);
+				RzBinSymbolIndex *index = o ? rz_bin_object_get_symbol_index(o) : NULL;
+				if (is_entry_flag(f) && index) {
+					ut64 paddr = fcn->addr - rz_config_get_i(core->config, "bin.baddr");
+					for (size_t i = rz_bin_symbol_index_lower_paddr(index, paddr); i < index->count && index->paddrs[i] == paddr; i++) {
+						RzBinSymbol *sym = index->by_paddr[i];
+						if (!strcmp(sym->type, RZ_BIN_TYPE_FUNC_STR)) {
 							free(new_name);
 							new_name = rz_str_newf("sym.%s", sym->name);
 							break;
@@ -2548,7 +2689,6 @@ RZ_API RZ_OWN RzCoreAnalysisStats *rz_core_analysis_get_stats(RZ_NONNULL RzCore
 	rz_return_val_if_fail(core && to >= from && step, NULL);
 	RzAnalysisFunction *F;
 	RzAnalysisBlock *B;
-	RzBinSymbol *S;
 	RzListIter *iter, *iter2;
 	ut64 at;
 	RzCoreAnalysisStats *as = RZ_NEW0(RzCoreAnalysisStats);
@@ -2606,13 +2746,14 @@ RZ_API RZ_OWN RzCoreAnalysisStats *rz_core_analysis_get_stats(RZ_NONNULL RzCore
 			blocks[piece].blocks++;
 		}
 	}
-	// iter all symbols
-	rz_list_foreach (rz_bin_get_symbols(core->bin), iter, S) {
-		if (S->vaddr < from || S->vaddr > to) {
-			continue;
+	// iter the symbols in range
+	RzBinObject *o = rz_bin_cur_object(core->bin);
+	RzBinSymbolIndex *index = o ? rz_bin_object_get_symbol_index(o) : NULL;
+	if (index) {
+		for (size_t i = rz_bin_symbol_index_lower_vaddr(index, from); i < index->count && index->vaddrs[i] <= to; i++) {
+			size_t piece = (index->vaddrs[i] - from) / step;
+			blocks[piece].symbols++;
 		}
-		size_t piece = (S->vaddr - from) / step;
-		blocks[piece].symbols++;
 	}
 	RzPVector *metas = to > from ? rz_meta_get_all_intersect(core->analysis, from, to - from, RZ_META_TYPE_ANY) : NULL;
 	if (metas) {
@@ -4355,15 +4496,14 @@ struct core_noretl {
 	SetU *todo;
 };
 
-static bool process_reference_noreturn_cb(void *u, const ut64 k, const void *v) {
+static bool process_reference_noreturn_cb(RzAnalysisXRef *xref, void *u) {
 	RzCore *core = ((struct core_noretl *)u)->core;
 	RzList *noretl = ((struct core_noretl *)u)->noretl;
 	SetU *todo = ((struct core_noretl *)u)->todo;
-	RzAnalysisXRef *xref = (RzAnalysisXRef *)v;
 	if (xref->type == RZ_ANALYSIS_XREF_TYPE_CALL || xref->type == RZ_ANALYSIS_XREF_TYPE_CODE) {
 		// At first we check if there are any relocations that override the call address
 		// Note, that the relocation overrides only the part of the instruction
-		ut64 addr = k;
+		ut64 addr = xref->from;
 		ut8 buf[CALL_BUF_SIZE] = { 0 };
 		RzAnalysisOp op = { 0 };
 		if (core->analysis->iob.read_at(core->analysis->iob.io, addr, buf, CALL_BUF_SIZE)) {
@@ -4387,12 +4527,6 @@ static bool process_reference_noreturn_cb(void *u, const ut64 k, const void *v)
 	return true;
 }
 
-static bool process_refs_cb(void *u, const ut64 k, const void *v) {
-	HtUP *ht = (HtUP *)v;
-	ht_up_foreach(ht, process_reference_noreturn_cb, u);
-	return true;
-}
-
 static bool reanalyze_fcns_cb(void *u, const ut64 k, const void *v) {
 	RzCore *core = u;
 	RzAnalysisFunction *fcn = (RzAnalysisFunction *)(size_t)k;
@@ -4414,7 +4548,7 @@ RZ_API void rz_core_analysis_propagate_noreturn_relocs(RzCore *core, ut64 addr)
 	// List of the potentially noreturn functions
 	SetU *todo = set_u_new();
 	struct core_noretl u = { core, noretl, todo };
-	ht_up_foreach(core->analysis->ht_xrefs_to, process_refs_cb, &u);
+	rz_analysis_xrefs_foreach(core->analysis, process_reference_noreturn_cb, &u);
 	rz_list_free(noretl);
 	core->analysis->bits = bits1;
 	core->rasm->bits = bits2;
@@ -660,7 +660,7 @@ RZ_API bool rz_core_bin_apply_dwarf(RzCore *core, RzBinFile *binfile) {
 	RzBinObject *o = binfile->o;
 	const RzBinSourceLineInfo *li = NULL;
 	RzBinDwarfDebugAbbrev *da = rz_bin_dwarf_parse_abbrev(binfile);
-	RzBinDwarfDebugInfo *info = da ? rz_bin_dwarf_parse_info(binfile, da) : NULL;
+	RzBinDwarfDebugInfo *info = da ? rz_bin_dwarf_index_info(binfile, da) : NULL;
 	HtUP /*<offset, List *<LocListEntry>*/ *loc_table = rz_bin_dwarf_parse_loc(binfile, core->analysis->bits / 8);
 	if (info) {
 		RzAnalysisDwarfContext ctx = {
@@ -1461,6 +1461,9 @@ RZ_API bool rz_core_bin_apply_symbols(RzCore *core, RzBinFile *binfile, bool va)
 	rz_flag_space_push(core->flags, RZ_FLAGS_FS_SYMBOLS);
 
 	RzList *symbols = rz_bin_get_symbols(core->bin);
+	if (lang && symbols) {
+		rz_bin_demangle_batch(binfile, lang, symbols);
+	}
 	size_t count = 0;
 	RzListIter *iter;
 	RzBinSymbol *symbol;
@@ -1940,6 +1943,10 @@ static bool symbols_print(RzCore *core, RzBinFile *bf, RzCmdStateOutput *state,
 	RzBinSymbol *symbol;
 	RzListIter *iter;
 
+	if (lang && symbols) {
+		rz_bin_demangle_batch(bf, lang, symbols);
+	}
+
 	rz_cmd_state_output_array_start(state);
 	rz_cmd_state_output_set_columnsf(state, "dXXssnss", "nth", "paddr", "vaddr", "bind", "type", "size", "lib", "name");
 
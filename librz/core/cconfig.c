@@ -139,6 +139,11 @@ static bool cb_analysis_jmpretpoline(void *user, void *data) {
 	core->analysis->opt.retpoline = node->i_value;
 	return true;
 }
+static bool cb_analysis_opcache(void *user, void *data) {
+	RzCore *core = (RzCore *)user;
+	RzConfigNode *node = (RzConfigNode *)data;
+	return rz_analysis_op_cache_enable(core->analysis, node->i_value);
+}
 static bool cb_analysis_jmptailcall(void *user, void *data) {
 	RzCore *core = (RzCore *)user;
 	RzConfigNode *node = (RzConfigNode *)data;
@@ -160,6 +165,13 @@ static bool cb_analysis_depth(void *user, void *data) {
 	return true;
 }
 
+static bool cb_analysis_threads(void *user, void *data) {
+	RzCore *core = (RzCore *)user;
+	RzConfigNode *node = (RzConfigNode *)data;
+	core->analysis->opt.threads = node->i_value;
+	return true;
+}
+
 static bool cb_analysis_graphdepth(void *user, void *data) {
 	RzCore *core = (RzCore *)user;
 	RzConfigNode *node = (RzConfigNode *)data;
@@ -1036,6 +1048,20 @@ static bool cb_binforce(void *user, void *data) {
 	return true;
 }
 
+static bool cb_bincache(void *user, void *data) {
+	RzCore *core = (RzCore *)user;
+	RzConfigNode *node = (RzConfigNode *)data;
+	rz_bin_set_cache_dir(core->bin, node->value);
+	return true;
+}
+
+static bool cb_bincachemaxsize(void *user, void *data) {
+	RzCore *core = (RzCore *)user;
+	RzConfigNode *node = (RzConfigNode *)data;
+	core->bin->cache_max_size = node->i_value;
+	return true;
+}
+
 static bool cb_asmsyntax(void *user, void *data) {
 	RzCore *core = (RzCore *)user;
 	RzConfigNode *node = (RzConfigNode *)data;
@@ -1943,6 +1969,60 @@ static bool cb_io_cache(void *user, void *data) {
 	return true;
 }
 
+static bool cb_io_rcache(void *user, void *data) {
+	RzCore *core = (RzCore *)user;
+	RzConfigNode *node = (RzConfigNode *)data;
+	core->io->rcache = node->i_value;
+	if (!core->io->rcache) {
+		rz_io_rcache_flush(core->io);
+	}
+	return true;
+}
+
+static bool cb_io_rcache_pagesize(void *user, void *data) {
+	RzCore *core = (RzCore *)user;
+	RzConfigNode *node = (RzConfigNode *)data;
+	if (node->i_value < 1 || node->i_value > ST32_MAX) {
+		RZ_LOG_ERROR("core: invalid io.rcache.pagesize value\n");
+		return false;
+	}
+	core->io->rcache_pagesize = node->i_value;
+	rz_io_rcache_flush(core->io);
+	return true;
+}
+
+static bool cb_io_rcache_pages(void *user, void *data) {
+	RzCore *core = (RzCore *)user;
+	RzConfigNode *node = (RzConfigNode *)data;
+	if (node->i_value > UT32_MAX) {
+		RZ_LOG_ERROR("core: invalid io.rcache.pages value\n");
+		return false;
+	}
+	core->io->rcache_pages = node->i_value;
+	rz_io_rcache_flush(core->io);
+	return true;
+}
+
+static void config_node_update_i(RzConfigNode *node, ut64 value) {
+	node->i_value = value;
+	char buf[128];
+	rz_config_node_value_format_i(buf, sizeof(buf), value, node);
+	if (!node->value || strcmp(node->value, buf) != 0) {
+		free(node->value);
+		node->value = strdup(buf);
+	}
+}
+
+static bool cb_io_rcache_hits_getter(RzCore *core, RzConfigNode *node) {
+	config_node_update_i(node, core->io->rcache_hits);
+	return true;
+}
+
+static bool cb_io_rcache_misses_getter(RzCore *core, RzConfigNode *node) {
+	config_node_update_i(node, core->io->rcache_misses);
+	return true;
+}
+
 static bool cb_ioaslr(void *user, void *data) {
 	RzCore *core = (RzCore *)user;
 	RzConfigNode *node = (RzConfigNode *)data;
@@ -2911,6 +2991,8 @@ RZ_API int rz_core_config_init(RzCore *core) {
 	SETCB("analysis.ignbithints", "false", &cb_analysis_ignbithints, "Ignore the ahb hints (only obey asm.bits)");
 	SETBPREF("analysis.calls", "false", "Make basic af analysis walk into calls");
 	SETBPREF("analysis.autoname", "false", "Speculatively set a name for the functions, may result in some false positives");
+	SETCB("analysis.opcache", "false", &cb_analysis_opcache, "Cache the instructions decoded by the analysis plugin (faster repeated analysis passes)");
+	SETICB("analysis.threads", RZ_THREAD_POOL_ALL_CORES, &cb_analysis_threads, "Max number of threads used by the parallel analysis stages (when 0 uses all available cores)");
 	SETBPREF("analysis.hasnext", "false", "Continue analysis after each function");
 	SETICB("analysis.nonull", 0, &cb_analysis_nonull, "Do not analyze regions of N null bytes");
 	SETBPREF("analysis.esil", "false", "Use the new ESIL code analysis");
@@ -3176,6 +3258,8 @@ RZ_API int rz_core_config_init(RzCore *core) {
 	SETOPTIONS(n, "a", "8", "p", "e", "u", "i", "U", "f", NULL);
 	SETCB("bin.filter", "true", &cb_binfilter, "Filter symbol names to fix dupped names");
 	SETCB("bin.force", "", &cb_binforce, "Force that rbin plugin");
+	SETCB("bin.cache", "", &cb_bincache, "Directory where to keep snapshots of the loaded binaries to reopen them faster (empty to disable)");
+	SETICB("bin.cache.maxsize", RZ_BIN_CACHE_MAX_SIZE, &cb_bincachemaxsize, "Remove the oldest snapshots when bin.cache grows beyond this size in bytes (0 for no limit)");
 	SETPREF("bin.lang", "", "Language for bin.demangle");
 	SETBPREF("bin.demangle", "true", "Import demangled symbols from RzBin");
 	SETBPREF("bin.demangle.libs", "false", "Show library name on demangled symbols names");
@@ -3198,6 +3282,7 @@ RZ_API int rz_core_config_init(RzCore *core) {
 	/* prj */
 	SETPREF("prj.file", "", "Path of the currently opened project");
 	SETBPREF("prj.compress", "false", "Compress the project file while saving");
+	SETBPREF("prj.binary", "false", "Save the project in the binary sdb format, faster to load than plaintext");
 
 	/* cfg */
 	SETBPREF("cfg.plugins", "true", "Load plugins at startup");
@@ -3617,6 +3702,15 @@ RZ_API int rz_core_config_init(RzCore *core) {
 	SETCB("io.pcache", "false", &cb_iopcache, "io.cache for p-level");
 	SETCB("io.pcache.write", "false", &cb_iopcachewrite, "Enable write-cache");
 	SETCB("io.pcache.read", "false", &cb_iopcacheread, "Enable read-cache");
+	SETCB("io.rcache", "false", &cb_io_rcache, "Cache the reads of all descs in pages, the pages of debugger descs are dropped when the target resumes");
+	SETICB("io.rcache.pagesize", 0x1000, &cb_io_rcache_pagesize, "Size in bytes of the pages of io.rcache");
+	SETICB("io.rcache.pages", 64, &cb_io_rcache_pages, "Maximum number of pages cached for each desc by io.rcache");
+	SETI("io.rcache.hits", 0, "Number of reads served by io.rcache");
+	rz_config_set_getter(cfg, "io.rcache.hits", (RzConfigCallback)cb_io_rcache_hits_getter);
+	rz_config_readonly(cfg, "io.rcache.hits");
+	SETI("io.rcache.misses", 0, "Number of pages read by io.rcache");
+	rz_config_set_getter(cfg, "io.rcache.misses", (RzConfigCallback)cb_io_rcache_misses_getter);
+	rz_config_readonly(cfg, "io.rcache.misses");
 	SETCB("io.ff", "true", &cb_ioff, "Fill invalid buffers with 0xff instead of returning error");
 	SETBPREF("io.exec", "true", "See !!rizin -h~-x");
 	SETICB("io.0xff", 0xff, &cb_io_oxff, "Use this value instead of 0xff to fill unallocated areas");
@@ -702,6 +702,7 @@ RZ_API bool rz_core_debug_process_close(RzCore *core) {
 		rz_debug_session_free(dbg->session);
 		dbg->session = NULL;
 	}
+	rz_debug_trace_log_clear(dbg->trace_log);
 #ifndef SIGKILL
 #define SIGKILL 9
 #endif
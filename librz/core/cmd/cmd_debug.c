@@ -832,7 +832,6 @@ RZ_IPI RzCmdStatus rz_cmd_debug_dump_maps_writable_handler(RzCore *core, int arg
 RZ_IPI int rz_cmd_debug_dmi(void *data, const char *input) {
 	RzCore *core = (RzCore *)data;
 	CMD_CHECK_DEBUG_DEAD(core);
-	RzListIter *iter;
 	RzDebugMap *map;
 	ut64 addr = core->offset;
 	switch (input[0]) {
@@ -960,25 +959,9 @@ RZ_IPI int rz_cmd_debug_dmi(void *data, const char *input) {
 	{
 		map = get_closest_map(core, addr);
 		if (map) {
-			ut64 closest_addr = UT64_MAX;
-			RzList *symbols = rz_bin_get_symbols(core->bin);
-			RzBinSymbol *symbol, *closest_symbol = NULL;
-
-			rz_list_foreach (symbols, iter, symbol) {
-				if (symbol->vaddr > addr) {
-					if (symbol->vaddr - addr < closest_addr) {
-						closest_addr = symbol->vaddr - addr;
-						closest_symbol = symbol;
-					}
-				} else {
-					if (addr - symbol->vaddr < closest_addr) {
-						closest_addr = addr - symbol->vaddr;
-						closest_symbol = symbol;
-					}
-				}
-			}
 			RzBinFile *bf = rz_bin_cur(core->bin);
-			if (closest_symbol && bf) {
+			RzBinSymbol *closest_symbol = bf && bf->o ? rz_bin_object_get_symbol_nearest(bf->o, addr) : NULL;
+			if (closest_symbol) {
 				RzCoreBinFilter filter;
 				filter.offset = UT64_MAX;
 				filter.name = (char *)closest_symbol->name;
@@ -1608,6 +1591,41 @@ RZ_IPI RzCmdStatus rz_cmd_debug_traces_ascii_handler(RzCore *core, int argc, con
 	return RZ_CMD_STATUS_OK;
 }
 
+// dtr
+RZ_IPI RzCmdStatus rz_cmd_debug_trace_log_handler(RzCore *core, int argc, const char **argv, RzCmdStateOutput *state) {
+	RzDebugTraceLog *log = core->dbg->trace_log;
+	rz_cmd_state_output_array_start(state);
+	rz_cmd_state_output_set_columnsf(state, "Xddd", "addr", "cnum", "size", "writes");
+	for (size_t i = 0; log && i < log->count; i++) {
+		RzDebugTraceRecord *rec = rz_debug_trace_log_get(log, i);
+		switch (state->mode) {
+		case RZ_OUTPUT_MODE_STANDARD:
+			rz_cons_printf("0x%08" PFMT64x " cnum=%u size=%u writes=%u\n",
+				rec->addr, rec->cnum, rec->size, rec->writes);
+			break;
+		case RZ_OUTPUT_MODE_TABLE:
+			rz_table_add_rowf(state->d.t, "Xddd", rec->addr, rec->cnum, rec->size, rec->writes);
+			break;
+		case RZ_OUTPUT_MODE_JSON:
+			pj_o(state->d.pj);
+			pj_kn(state->d.pj, "addr", rec->addr);
+			pj_kn(state->d.pj, "cnum", rec->cnum);
+			pj_kn(state->d.pj, "size", rec->size);
+			pj_kn(state->d.pj, "writes", rec->writes);
+			pj_end(state->d.pj);
+			break;
+		case RZ_OUTPUT_MODE_QUIET:
+			rz_cons_printf("0x%08" PFMT64x "\n", rec->addr);
+			break;
+		default:
+			rz_warn_if_reached();
+			break;
+		}
+	}
+	rz_cmd_state_output_array_end(state);
+	return RZ_CMD_STATUS_OK;
+}
+
 // dt+
 RZ_IPI RzCmdStatus rz_cmd_debug_trace_add_handler(RzCore *core, int argc, const char **argv) {
 	int count = argc > 1 ? rz_num_math(core->num, argv[1]) : 1;
@@ -1646,6 +1664,7 @@ RZ_IPI RzCmdStatus rz_cmd_debug_traces_reset_handler(RzCore *core, int argc, con
 	rz_debug_trace_free(core->dbg->trace);
 	rz_debug_tracenodes_reset(core->dbg);
 	core->dbg->trace = rz_debug_trace_new();
+	rz_debug_trace_log_clear(core->dbg->trace_log);
 	return RZ_CMD_STATUS_OK;
 }
 
@@ -1727,6 +1746,7 @@ RZ_IPI RzCmdStatus rz_cmd_debug_start_trace_session_handler(RzCore *core, int ar
 		return RZ_CMD_STATUS_ERROR;
 	}
 	core->dbg->session = rz_debug_session_new();
+	rz_debug_trace_log_clear(core->dbg->trace_log);
 	rz_debug_add_checkpoint(core->dbg);
 	return RZ_CMD_STATUS_OK;
 }
@@ -1739,6 +1759,7 @@ RZ_IPI RzCmdStatus rz_cmd_debug_stop_trace_session_handler(RzCore *core, int arg
 	}
 	rz_debug_session_free(core->dbg->session);
 	core->dbg->session = NULL;
+	rz_debug_trace_log_clear(core->dbg->trace_log);
 	return RZ_CMD_STATUS_OK;
 }
 
@@ -1759,6 +1780,7 @@ RZ_IPI RzCmdStatus rz_cmd_debug_load_trace_session_handler(RzCore *core, int arg
 		core->dbg->session = NULL;
 	}
 	core->dbg->session = rz_debug_session_new();
+	rz_debug_trace_log_clear(core->dbg->trace_log);
 	rz_debug_session_load(core->dbg, argv[1]);
 	return RZ_CMD_STATUS_OK;
 }
@@ -151,7 +151,6 @@ static const char *help_msg_slash_x[] = {
 	NULL
 };
 
-static int preludecnt = 0;
 static int searchflags = 0;
 static int searchshow = 0;
 static const char *searchprefix = NULL;
@@ -281,31 +280,47 @@ static void cmd_search_bin(RzCore *core, RzInterval itv) {
 }
 
 static int __prelude_cb_hit(RzSearchKeyword *kw, void *user, ut64 addr) {
-	RzCore *core = (RzCore *)user;
-	int depth = rz_config_get_i(core->config, "analysis.depth");
-	// eprintf ("ap: Found function prelude %d at 0x%08"PFMT64x"\n", preludecnt, addr);
-	rz_core_analysis_fcn(core, addr, -1, RZ_ANALYSIS_XREF_TYPE_NULL, depth);
-	preludecnt++;
+	// analysis is deferred until the whole range is scanned, see search_preludes_in()
+	RzVector *hits = kw->data;
+	rz_vector_push(hits, &addr);
 	return 1;
 }
 
-RZ_API int rz_core_search_prelude(RzCore *core, ut64 from, ut64 to, const ut8 *buf, int blen, const ut8 *mask, int mlen) {
+/**
+ * Looks for all the \p preludes at once in [from, to) and analyzes a function at each hit.
+ * The functions are analyzed prelude by prelude, in the order of \p preludes, to keep
+ * the results of one search per prelude.
+ */
+static int search_preludes_in(RzCore *core, ut64 from, ut64 to, RzList /*<RzSearchKeyword *>*/ *preludes) {
 	ut64 at;
-	ut8 *b = (ut8 *)malloc(core->blocksize);
-	if (!b) {
-		return 0;
-	}
 	// TODO: handle sections ?
 	if (from >= to) {
 		RZ_LOG_ERROR("core: Invalid search range 0x%08" PFMT64x " - 0x%08" PFMT64x "\n", from, to);
+		return 0;
+	}
+	size_t count = rz_list_length(preludes);
+	ut8 *b = (ut8 *)malloc(core->blocksize);
+	RzVector *hits = RZ_NEWS(RzVector, count);
+	if (!b || !hits) {
 		free(b);
+		free(hits);
 		return 0;
 	}
 	rz_search_reset(core->search, RZ_SEARCH_KEYWORD);
-	rz_search_kw_add(core->search, rz_search_keyword_new(buf, blen, mask, mlen, NULL));
+	RzListIter *iter;
+	RzSearchKeyword *kw;
+	size_t i = 0;
+	rz_list_foreach (preludes, iter, kw) {
+		rz_vector_init(&hits[i], sizeof(ut64), NULL, NULL);
+		RzSearchKeyword *skw = rz_search_keyword_new(kw->bin_keyword, kw->keyword_length, kw->bin_binmask, kw->binmask_length, NULL);
+		if (skw) {
+			skw->data = &hits[i];
+			rz_search_kw_add(core->search, skw);
+		}
+		i++;
+	}
 	rz_search_begin(core->search);
-	rz_search_set_callback(core->search, &__prelude_cb_hit, core);
-	preludecnt = 0;
+	rz_search_set_callback(core->search, &__prelude_cb_hit, NULL);
 	for (at = from; at < to; at += core->blocksize) {
 		if (rz_cons_is_breaked()) {
 			break;
@@ -313,8 +328,14 @@ RZ_API int rz_core_search_prelude(RzCore *core, ut64 from, ut64 to, const ut8 *b
 		if (!rz_io_is_valid_offset(core->io, at, 0)) {
 			break;
 		}
-		(void)rz_io_read_at(core->io, at, b, core->blocksize);
-		if (rz_search_update(core->search, at, b, core->blocksize) == -1) {
+		const ut8 *data = b;
+		if (core->search->bckwrds) {
+			// a backward search reverses the data in place, it must own it
+			rz_io_read_at(core->io, at, b, core->blocksize);
+		} else {
+			data = rz_io_read_at_borrow(core->io, at, b, core->blocksize);
+		}
+		if (rz_search_update(core->search, at, data, core->blocksize) == -1) {
 			RZ_LOG_ERROR("core: update read error at 0x%08" PFMT64x "\n", at);
 			break;
 		}
@@ -324,9 +345,38 @@ RZ_API int rz_core_search_prelude(RzCore *core, ut64 from, ut64 to, const ut8 *b
 	// For now we will just use rz_search_kw_reset
 	rz_search_kw_reset(core->search);
 	free(b);
+
+	int depth = rz_config_get_i(core->config, "analysis.depth");
+	int preludecnt = 0;
+	for (i = 0; i < count; i++) {
+		ut64 *addr;
+		rz_vector_foreach (&hits[i], addr) {
+			if (rz_cons_is_breaked()) {
+				break;
+			}
+			rz_core_analysis_fcn(core, *addr, -1, RZ_ANALYSIS_XREF_TYPE_NULL, depth);
+			preludecnt++;
+		}
+		rz_vector_fini(&hits[i]);
+	}
+	free(hits);
 	return preludecnt;
 }
 
+RZ_API int rz_core_search_prelude(RzCore *core, ut64 from, ut64 to, const ut8 *buf, int blen, const ut8 *mask, int mlen) {
+	RzSearchKeyword *kw = rz_search_keyword_new(buf, blen, mask, mlen, NULL);
+	RzList *preludes = rz_list_newf((RzListFree)rz_search_keyword_free);
+	if (!kw || !preludes) {
+		rz_search_keyword_free(kw);
+		rz_list_free(preludes);
+		return 0;
+	}
+	rz_list_append(preludes, kw);
+	int ret = search_preludes_in(core, from, to, preludes);
+	rz_list_free(preludes);
+	return ret;
+}
+
 RZ_API int rz_core_search_preludes(RzCore *core, bool log) {
 	int ret = -1;
 	ut64 from = UT64_MAX;
@@ -338,9 +388,8 @@ RZ_API int rz_core_search_preludes(RzCore *core, bool log) {
 
 	RzList *list = rz_core_get_boundaries_prot(core, RZ_PERM_X, where, "search");
 	RzList *arch_preludes = NULL;
-	RzListIter *iter = NULL, *iter2 = NULL;
+	RzListIter *iter = NULL;
 	RzIOMap *p = NULL;
-	RzSearchKeyword *kw = NULL;
 
 	if (!list) {
 		return -1;
@@ -371,11 +420,8 @@ RZ_API int rz_core_search_preludes(RzCore *core, bool log) {
 		if (keyword && keyword_length > 0) {
 			ret = rz_core_search_prelude(core, from, to, keyword, keyword_length, NULL, 0);
 		} else {
-			rz_list_foreach (arch_preludes, iter2, kw) {
-				ret = rz_core_search_prelude(core, from, to,
-					kw->bin_keyword, kw->keyword_length,
-					kw->bin_binmask, kw->binmask_length);
-			}
+			// a single pass for all the preludes, RzSearch matches them together
+			ret = search_preludes_in(core, from, to, arch_preludes);
 		}
 	}
 	free(keyword);
@@ -2362,6 +2408,7 @@ static void do_string_search(RzCore *core, RzInterval search_itv, struct search_
 				   from1 = search->bckwrds ? to : from,
 				   to1 = search->bckwrds ? from : to;
 			ut64 len;
+			const ut8 *data;
 			for (at = from1; at != to1; at = search->bckwrds ? at - len : at + len) {
 				print_search_progress(at, to1, search->nhits, param);
 				if (rz_cons_is_breaked()) {
@@ -2374,15 +2421,17 @@ static void do_string_search(RzCore *core, RzInterval search_itv, struct search_
 					if (!rz_io_is_valid_offset(core->io, at - len, 0)) {
 						break;
 					}
-					(void)rz_io_read_at(core->io, at - len, buf, len);
+					// a backward search reverses the data in place, it must own it
+					rz_io_read_at(core->io, at - len, buf, len);
+					data = buf;
 				} else {
 					len = RZ_MIN(core->blocksize, to - at);
 					if (!rz_io_is_valid_offset(core->io, at, 0)) {
 						break;
 					}
-					(void)rz_io_read_at(core->io, at, buf, len);
+					data = rz_io_read_at_borrow(core->io, at, buf, len);
 				}
-				rz_search_update(core->search, at, buf, len);
+				rz_search_update(core->search, at, data, len);
 				if (param->aes_search) {
 					// Adjust length to search between blocks.
 					if (len == core->blocksize) {
@@ -8334,6 +8334,14 @@ static const RzCmdDescHelp cmd_debug_traces_ascii_help = {
 	.args = cmd_debug_traces_ascii_args,
 };
 
+static const RzCmdDescArg cmd_debug_trace_log_args[] = {
+	{ 0 },
+};
+static const RzCmdDescHelp cmd_debug_trace_log_help = {
+	.summary = "List the last traced instructions, oldest first",
+	.args = cmd_debug_trace_log_args,
+};
+
 static const RzCmdDescArg cmd_debug_trace_add_args[] = {
 	{
 		.name = "times",
@@ -19821,6 +19829,9 @@ RZ_IPI void rzshell_cmddescs_init(RzCore *core) {
 	RzCmdDesc *cmd_debug_traces_ascii_cd = rz_cmd_desc_argv_new(core->rcmd, dt_cd, "dtl=", rz_cmd_debug_traces_ascii_handler, &cmd_debug_traces_ascii_help);
 	rz_warn_if_fail(cmd_debug_traces_ascii_cd);
 
+	RzCmdDesc *cmd_debug_trace_log_cd = rz_cmd_desc_argv_state_new(core->rcmd, dt_cd, "dtr", RZ_OUTPUT_MODE_STANDARD | RZ_OUTPUT_MODE_JSON | RZ_OUTPUT_MODE_TABLE | RZ_OUTPUT_MODE_QUIET, rz_cmd_debug_trace_log_handler, &cmd_debug_trace_log_help);
+	rz_warn_if_fail(cmd_debug_trace_log_cd);
+
 	RzCmdDesc *cmd_debug_trace_add_cd = rz_cmd_desc_argv_new(core->rcmd, dt_cd, "dt+", rz_cmd_debug_trace_add_handler, &cmd_debug_trace_add_help);
 	rz_warn_if_fail(cmd_debug_trace_add_cd);
 
@@ -1084,6 +1084,8 @@ RZ_IPI RzCmdStatus rz_cmd_debug_trace_handler(RzCore *core, int argc, const char
 RZ_IPI RzCmdStatus rz_cmd_debug_traces_handler(RzCore *core, int argc, const char **argv, RzCmdStateOutput *state);
 // "dtl="
 RZ_IPI RzCmdStatus rz_cmd_debug_traces_ascii_handler(RzCore *core, int argc, const char **argv);
+// "dtr"
+RZ_IPI RzCmdStatus rz_cmd_debug_trace_log_handler(RzCore *core, int argc, const char **argv, RzCmdStateOutput *state);
 // "dt+"
 RZ_IPI RzCmdStatus rz_cmd_debug_trace_add_handler(RzCore *core, int argc, const char **argv);
 // "dt++"
@@ -489,7 +489,8 @@ static bool add_new_bin_string(RzCore *core, char *string, ut64 vaddr, ut32 size
 	RzBinString *bstr;
 	RzBin *bin = core->bin;
 	RzBinFile *bf = rz_bin_cur(bin);
-	if (!bf || !bf->o || !bf->o->strings) {
+	// the getter also scans the strings when it was not done yet
+	if (!bf || !bf->o || !rz_bin_object_get_strings(bf->o)) {
 		free(string);
 		return false;
 	}
@@ -31,8 +31,6 @@ static GHT GH(get_va_symbol)(RzCore *core, const char *path, const char *sym_nam
 	GHT vaddr = GHT_MAX;
 	RzBin *bin = core->bin;
 	RzBinFile *current_bf = rz_bin_cur(bin);
-	RzListIter *iter;
-	RzBinSymbol *s;
 
 	RzBinOptions opt;
 	rz_bin_options_init(&opt, -1, 0, 0, false);
@@ -45,12 +43,9 @@ static GHT GH(get_va_symbol)(RzCore *core, const char *path, const char *sym_nam
 		return vaddr;
 	}
 
-	RzList *syms = rz_bin_get_symbols(bin);
-	rz_list_foreach (syms, iter, s) {
-		if (!strcmp(s->name, sym_name)) {
-			vaddr = s->vaddr;
-			break;
-		}
+	RzBinSymbol *s = libc_bf->o ? rz_bin_object_get_symbol_by_name(libc_bf->o, sym_name) : NULL;
+	if (s) {
+		vaddr = s->vaddr;
 	}
 
 	rz_bin_file_delete(bin, libc_bf);
@@ -52,6 +52,7 @@ RZ_API RzProjectErr rz_project_save_file(RzCore *core, const char *file, bool co
 
 	RzProjectErr err;
 	const char *save_file = compress ? tmp_file : file;
+	bool binary = rz_config_get_b(core->config, "prj.binary");
 	RzProject *prj = sdb_new0();
 	if (!prj) {
 		err = RZ_PROJECT_ERR_UNKNOWN;
@@ -62,7 +63,7 @@ RZ_API RzProjectErr rz_project_save_file(RzCore *core, const char *file, bool co
 		sdb_free(prj);
 		return err;
 	}
-	if (!sdb_text_save(prj, save_file, true)) {
+	if (!(binary ? sdb_binary_save(prj, save_file, true) : sdb_text_save(prj, save_file, true))) {
 		err = RZ_PROJECT_ERR_FILE;
 	}
 	sdb_free(prj);
@@ -84,6 +85,15 @@ tmp_file_err:
 	return err;
 }
 
+// Loads either a binary or a plaintext sdb file
+static bool project_db_load(Sdb *db, const char *file) {
+	int hdr_sz = 0;
+	ut8 *hdr = (ut8 *)rz_file_slurp_range(file, 0, 8, &hdr_sz);
+	bool binary = hdr && hdr_sz > 0 && sdb_binary_check(hdr, hdr_sz);
+	free(hdr);
+	return binary ? sdb_binary_load(db, file) : sdb_text_load(db, file);
+}
+
 /// Load a file into an RzProject but don't actually migrate anything or load it into an RzCore
 RZ_API RzProject *rz_project_load_file_raw(const char *file) {
 	RzProject *prj = sdb_new0();
@@ -115,7 +125,7 @@ RZ_API RzProject *rz_project_load_file_raw(const char *file) {
 		load_file = file;
 	}
 
-	if (!sdb_text_load(prj, load_file)) {
+	if (!project_db_load(prj, load_file)) {
 		sdb_free(prj);
 		prj = NULL;
 	}
@@ -220,6 +220,16 @@ static int rz_debug_bps_enable(RzDebug *dbg) {
  *
  * if the user wants to step, the single step here does the job.
  */
+/*
+ * drop the io pages cached for the debugger descs, since the memory of the
+ * target may have changed while it was running.
+ */
+static void debug_io_invalidate(RzDebug *dbg) {
+	if (dbg->iob.io && dbg->iob.rcache_invalidate_dbg) {
+		dbg->iob.rcache_invalidate_dbg(dbg->iob.io);
+	}
+}
+
 static int rz_debug_recoil(RzDebug *dbg, RzDebugRecoilMode rc_mode) {
 	/* if bp_addr is not set, we must not have actually hit a breakpoint */
 	if (!dbg->reason.bp_addr) {
@@ -429,7 +439,8 @@ RZ_API RzDebug *rz_debug_free(RzDebug *dbg) {
 		free(dbg->btalgo);
 		rz_debug_trace_free(dbg->trace);
 		rz_debug_session_free(dbg->session);
-		rz_analysis_op_free(dbg->cur_op);
+		ht_up_free(dbg->trace_plans);
+		rz_debug_trace_log_free(dbg->trace_log);
 		dbg->trace = NULL;
 		rz_egg_free(dbg->egg);
 		rz_reg_free(dbg->reg);
@@ -501,6 +512,7 @@ RZ_API bool rz_debug_set_arch(RzDebug *dbg, const char *arch, int bits) {
 		}
 		free(dbg->arch);
 		dbg->arch = strdup(arch);
+		rz_debug_trace_plans_reset(dbg);
 		return true;
 	}
 	return false;
@@ -577,6 +589,7 @@ RZ_API int rz_debug_detach(RzDebug *dbg, int pid) {
 	int ret = 0;
 	if (dbg->cur && dbg->cur->detach) {
 		ret = dbg->cur->detach(dbg, pid);
+		debug_io_invalidate(dbg);
 		if (dbg->pid == pid) {
 			dbg->pid = -1;
 			dbg->tid = -1;
@@ -693,6 +706,7 @@ RZ_API RzDebugReasonType rz_debug_wait(RzDebug *dbg, RzBreakpointItem **bp) {
 	/* if our debugger plugin has wait */
 	if (dbg->cur && dbg->cur->wait) {
 		reason = dbg->cur->wait(dbg, dbg->pid);
+		debug_io_invalidate(dbg);
 		if (reason == RZ_DEBUG_REASON_DEAD) {
 			eprintf("\n==> Process finished\n\n");
 			RzEventDebugProcessFinished event = {
@@ -1044,7 +1058,9 @@ RZ_API int rz_debug_step_over(RzDebug *dbg, int steps) {
 				dbg->session->maxcnum++;
 				rz_debug_trace_ins_before(dbg);
 			}
-			if (!dbg->cur->step_over(dbg)) {
+			bool stepped = dbg->cur->step_over(dbg);
+			debug_io_invalidate(dbg);
+			if (!stepped) {
 				return steps_taken;
 			}
 			if (dbg->session && dbg->recoil_mode == RZ_DBG_RECOIL_NONE) {
@@ -1577,6 +1593,7 @@ RZ_API int rz_debug_syscall(RzDebug *dbg, int num) {
 	bool ret = true;
 	if (dbg->cur->contsc) {
 		ret = dbg->cur->contsc(dbg, dbg->pid, num);
+		debug_io_invalidate(dbg);
 	}
 	eprintf("TODO: show syscall information\n");
 	/* rz_testc task? ala inject? */
@@ -1594,7 +1611,9 @@ RZ_API int rz_debug_kill(RzDebug *dbg, int pid, int tid, int sig) {
 	}
 	if (dbg->cur && dbg->cur->kill) {
 		if (pid > 0) {
-			return dbg->cur->kill(dbg, pid, tid, sig);
+			int ret = dbg->cur->kill(dbg, pid, tid, sig);
+			debug_io_invalidate(dbg);
+			return ret;
 		}
 		return -1;
 	}
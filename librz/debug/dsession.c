@@ -3,16 +3,24 @@
 
 #include <rz_debug.h>
 #include <rz_util/rz_json.h>
+#if __linux__
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
-#define CMP_CNUM_REG(x, y)   ((x) >= ((RzDebugChangeReg *)y)->cnum ? 1 : -1)
-#define CMP_CNUM_MEM(x, y)   ((x) >= ((RzDebugChangeMem *)y)->cnum ? 1 : -1)
-#define CMP_CNUM_CHKPT(x, y) ((x) >= ((RzDebugCheckpoint *)y)->cnum ? 1 : -1)
+#define CMP_CNUM_REG(x, y)      ((x) >= ((RzDebugChangeReg *)y)->cnum ? 1 : -1)
+#define CMP_CNUM_MEM(x, y)      ((x) >= ((RzDebugChangeMem *)y)->cnum ? 1 : -1)
+#define CMP_CNUM_MEMRANGE(x, y) ((x) >= ((RzDebugChangeMemRange *)y)->cnum ? 1 : -1)
+#define CMP_CNUM_CHKPT(x, y)    ((x) >= ((RzDebugCheckpoint *)y)->cnum ? 1 : -1)
 
 RZ_API void rz_debug_session_free(RzDebugSession *session) {
 	if (session) {
+		// snaps release their pages into the store, free them first
 		rz_vector_free(session->checkpoints);
+		rz_vector_free(session->memory_ranges);
 		ht_up_free(session->registers);
 		ht_up_free(session->memory);
+		ht_up_free(session->pages);
 		RZ_FREE(session);
 	}
 }
@@ -30,6 +38,11 @@ static void htup_vector_free(HtUPKv *kv) {
 	rz_vector_free(kv->value);
 }
 
+static void mem_range_fini(void *element, void *user) {
+	RzDebugChangeMemRange *range = element;
+	free(range->data);
+}
+
 RZ_API RzDebugSession *rz_debug_session_new(void) {
 	RzDebugSession *session = RZ_NEW0(RzDebugSession);
 	if (!session) {
@@ -51,10 +64,108 @@ RZ_API RzDebugSession *rz_debug_session_new(void) {
 		rz_debug_session_free(session);
 		return NULL;
 	}
+	session->memory_ranges = rz_vector_new(sizeof(RzDebugChangeMemRange), mem_range_fini, NULL);
+	if (!session->memory_ranges) {
+		rz_debug_session_free(session);
+		return NULL;
+	}
+	session->pages = ht_up_new0();
+	if (!session->pages) {
+		rz_debug_session_free(session);
+		return NULL;
+	}
 
 	return session;
 }
 
+#if __linux__
+#define PAGEMAP_SOFT_DIRTY (1ULL << 55)
+#define PAGEMAP_SWAPPED    (1ULL << 62)
+#define PAGEMAP_PRESENT    (1ULL << 63)
+
+static bool soft_dirty_supported(RzDebug *dbg) {
+	return dbg->cur && !strcmp(dbg->cur->name, "native") && dbg->pid > 0 &&
+		sysconf(_SC_PAGESIZE) == SNAP_PAGE_SIZE;
+}
+
+/**
+ * Clears the soft-dirty bits of the debuggee, so that the pages written from
+ * now on can be told from the ones still matching the last checkpoint.
+ */
+static bool soft_dirty_clear(RzDebug *dbg) {
+	if (!soft_dirty_supported(dbg)) {
+		return false;
+	}
+	char *path = rz_str_newf("/proc/%d/clear_refs", dbg->pid);
+	int fd = path ? open(path, O_WRONLY) : -1;
+	free(path);
+	if (fd < 0) {
+		return false;
+	}
+	bool ret = write(fd, "4", 1) == 1;
+	close(fd);
+	return ret;
+}
+
+/**
+ * Returns which pages of \p snap may have been written since the soft-dirty
+ * bits were cleared. Pages that are not mapped in are reported as dirty too,
+ * since they read as zeroes whatever the snap holds.
+ */
+static RzBitVector *soft_dirty_pages(RzDebug *dbg, RzDebugSnap *snap) {
+	if (!soft_dirty_supported(dbg)) {
+		return NULL;
+	}
+	char *path = rz_str_newf("/proc/%d/pagemap", dbg->pid);
+	int fd = path ? open(path, O_RDONLY) : -1;
+	free(path);
+	if (fd < 0) {
+		return NULL;
+	}
+	RzBitVector *dirty = NULL;
+	ut64 *entries = RZ_NEWS(ut64, snap->pages_count);
+	if (!entries) {
+		goto beach;
+	}
+	ssize_t len = (ssize_t)snap->pages_count * sizeof(ut64);
+	if (pread(fd, entries, len, (snap->addr / SNAP_PAGE_SIZE) * sizeof(ut64)) != len) {
+		goto beach;
+	}
+	dirty = rz_bv_new(snap->pages_count);
+	if (!dirty) {
+		goto beach;
+	}
+	ut32 i;
+	for (i = 0; i < snap->pages_count; i++) {
+		ut64 e = entries[i];
+		rz_bv_set(dirty, i, (e & PAGEMAP_SOFT_DIRTY) || !(e & (PAGEMAP_PRESENT | PAGEMAP_SWAPPED)));
+	}
+beach:
+	free(entries);
+	close(fd);
+	return dirty;
+}
+#else
+static bool soft_dirty_clear(RzDebug *dbg) {
+	return false;
+}
+
+static RzBitVector *soft_dirty_pages(RzDebug *dbg, RzDebugSnap *snap) {
+	return NULL;
+}
+#endif
+
+static RzDebugSnap *checkpoint_find_snap(RzDebugCheckpoint *checkpoint, RzDebugMap *map) {
+	RzListIter *iter;
+	RzDebugSnap *snap;
+	rz_list_foreach (checkpoint->snaps, iter, snap) {
+		if (snap->addr == map->addr && snap->size == map->size) {
+			return snap;
+		}
+	}
+	return NULL;
+}
+
 RZ_API bool rz_debug_add_checkpoint(RzDebug *dbg) {
 	rz_return_val_if_fail(dbg->session, false);
 	size_t i;
@@ -76,10 +187,17 @@ RZ_API bool rz_debug_add_checkpoint(RzDebug *dbg) {
 	}
 	RzListIter *iter;
 	RzDebugMap *map;
+	// Pages are shared with the previous checkpoint, which is only read
+	// again where written to since, if soft-dirty bits tell us so
+	RzDebugCheckpoint *prev = rz_vector_empty(dbg->session->checkpoints) ? NULL : rz_vector_tail(dbg->session->checkpoints);
+	bool soft_dirty = prev && dbg->session->soft_dirty;
 	rz_debug_map_sync(dbg);
 	rz_list_foreach (dbg->maps, iter, map) {
 		if ((map->perm & RZ_PERM_RW) == RZ_PERM_RW) {
-			RzDebugSnap *snap = rz_debug_snap_map(dbg, map);
+			RzDebugSnap *base = prev ? checkpoint_find_snap(prev, map) : NULL;
+			RzBitVector *dirty = soft_dirty && base && base->pages ? soft_dirty_pages(dbg, base) : NULL;
+			RzDebugSnap *snap = rz_debug_snap_map_pages(dbg, map, dbg->session->pages, base, dirty);
+			rz_bv_free(dirty);
 			if (snap) {
 				rz_list_append(checkpoint.snaps, snap);
 			}
@@ -88,6 +206,7 @@ RZ_API bool rz_debug_add_checkpoint(RzDebug *dbg) {
 
 	checkpoint.cnum = dbg->session->cnum;
 	rz_vector_push(dbg->session->checkpoints, &checkpoint);
+	dbg->session->soft_dirty = soft_dirty_clear(dbg);
 
 	// Add PC register change so we can check for breakpoints when continue [back]
 	RzRegItem *ripc = rz_reg_get(dbg->reg, dbg->reg->name[RZ_REG_NAME_PC], RZ_REG_TYPE_GPR);
@@ -136,7 +255,7 @@ static void _set_initial_memory(RzDebug *dbg) {
 	RzListIter *iter;
 	RzDebugSnap *snap;
 	rz_list_foreach (dbg->session->cur_chkpt->snaps, iter, snap) {
-		dbg->iob.write_at(dbg->iob.io, snap->addr, snap->data, snap->size);
+		rz_debug_snap_restore(dbg, snap);
 	}
 }
 
@@ -155,9 +274,24 @@ static bool _restore_memory_cb(void *user, const ut64 key, const void *value) {
 	return true;
 }
 
+static void _restore_memory_ranges(RzDebug *dbg, ut32 cnum) {
+	RzVector *vranges = dbg->session->memory_ranges;
+	size_t index;
+	// Replay in order the writes done after the checkpoint, up to cnum
+	rz_vector_upper_bound(vranges, dbg->session->cur_chkpt->cnum, index, CMP_CNUM_MEMRANGE);
+	for (; index < vranges->len; index++) {
+		RzDebugChangeMemRange *range = rz_vector_index_ptr(vranges, index);
+		if (range->cnum > cnum) {
+			break;
+		}
+		dbg->iob.write_at(dbg->iob.io, range->addr, range->data, range->size);
+	}
+}
+
 static void _restore_memory(RzDebug *dbg, ut32 cnum) {
 	_set_initial_memory(dbg);
 	ht_up_foreach(dbg->session->memory, _restore_memory_cb, dbg);
+	_restore_memory_ranges(dbg, cnum);
 }
 
 static RzDebugCheckpoint *_get_checkpoint_before(RzDebugSession *session, ut32 cnum) {
@@ -245,6 +379,28 @@ RZ_API bool rz_debug_session_add_mem_change(RzDebugSession *session, ut64 addr,
 	return true;
 }
 
+/**
+ * \brief Records the contents of \p size bytes at \p addr after a write
+ *
+ * Unlike rz_debug_session_add_mem_change() the whole range is kept in a single
+ * record, which is replayed as a single write on restore.
+ */
+RZ_API bool rz_debug_session_add_mem_range(RzDebugSession *session, ut64 addr, RZ_NONNULL const ut8 *buf, ut32 size) {
+	rz_return_val_if_fail(session && buf, false);
+	if (!size) {
+		return true;
+	}
+	RzDebugChangeMemRange range = { session->cnum, addr, size, rz_mem_dup(buf, size) };
+	if (!range.data) {
+		return false;
+	}
+	if (!rz_vector_push(session->memory_ranges, &range)) {
+		free(range.data);
+		return false;
+	}
+	return true;
+}
+
 /* Save and Load Session */
 
 // 0x<addr>=[<RzDebugChangeReg>]
@@ -297,8 +453,38 @@ static bool serialize_memory_cb(void *db, const ut64 k, const void *v) {
 	return true;
 }
 
-static void serialize_memory(Sdb *db, HtUP *memory) {
+// ranges=[<RzDebugChangeMemRange>]
+static void serialize_memory_ranges(Sdb *db, RzVector /*<RzDebugChangeMemRange>*/ *ranges) {
+	RzDebugChangeMemRange *range;
+	if (rz_vector_empty(ranges)) {
+		return;
+	}
+	PJ *j = pj_new();
+	if (!j) {
+		return;
+	}
+	pj_a(j);
+	rz_vector_foreach(ranges, range) {
+		char *edata = sdb_encode(range->data, range->size);
+		if (!edata) {
+			pj_free(j);
+			return;
+		}
+		pj_o(j);
+		pj_kN(j, "cnum", range->cnum);
+		pj_kn(j, "addr", range->addr);
+		pj_ks(j, "data", edata);
+		pj_end(j);
+		free(edata);
+	}
+	pj_end(j);
+	sdb_set(db, "ranges", pj_string(j), 0);
+	pj_free(j);
+}
+
+static void serialize_memory(Sdb *db, HtUP *memory, RzVector /*<RzDebugChangeMemRange>*/ *ranges) {
 	ht_up_foreach(memory, serialize_memory_cb, db);
+	serialize_memory_ranges(db, ranges);
 }
 
 static void serialize_checkpoints(Sdb *db, RzVector /*<RzDebugCheckpoint>*/ *checkpoints) {
@@ -345,7 +531,11 @@ static void serialize_checkpoints(Sdb *db, RzVector /*<RzDebugCheckpoint>*/ *che
 			pj_kn(j, "addr", snap->addr);
 			pj_kn(j, "addr_end", snap->addr_end);
 			pj_kn(j, "size", snap->size);
-			char *edata = sdb_encode((const void *)snap->data, snap->size);
+			ut8 *data = snap->data ? snap->data : rz_debug_snap_dup_data(snap);
+			char *edata = data ? sdb_encode((const void *)data, snap->size) : NULL;
+			if (data != snap->data) {
+				free(data);
+			}
 			if (!edata) {
 				pj_free(j);
 				return;
@@ -376,6 +566,7 @@ static void serialize_checkpoints(Sdb *db, RzVector /*<RzDebugCheckpoint>*/ *che
  *
  *   /memory
  *     0x<addr>={"size":<size_t>, "a":[<RzDebugChangeMem>]}
+ *     ranges=[<RzDebugChangeMemRange>]
  *
  *   /checkpoints
  *     0x<cnum>={
@@ -389,6 +580,9 @@ static void serialize_checkpoints(Sdb *db, RzVector /*<RzDebugCheckpoint>*/ *che
  * RzDebugChangeMem JSON:
  * {"cnum":<int>, "data":<ut8>}
  *
+ * RzDebugChangeMemRange JSON:
+ * {"cnum":<int>, "addr":<ut64>, "data":"<base64>"}
+ *
  * RzRegArena JSON:
  * {"size":<int>, "bytes":"<base64>"}
  *
@@ -402,7 +596,7 @@ static void serialize_checkpoints(Sdb *db, RzVector /*<RzDebugCheckpoint>*/ *che
 RZ_API void rz_debug_session_serialize(RzDebugSession *session, Sdb *db) {
 	sdb_num_set(db, "maxcnum", session->maxcnum, 0);
 	serialize_registers(sdb_ns(db, "registers", true), session->registers);
-	serialize_memory(sdb_ns(db, "memory", true), session->memory);
+	serialize_memory(sdb_ns(db, "memory", true), session->memory, session->memory_ranges);
 	serialize_checkpoints(sdb_ns(db, "checkpoints", true), session->checkpoints);
 }
 
@@ -461,7 +655,50 @@ RZ_API bool rz_debug_session_save(RzDebugSession *session, const char *path) {
 	if (!v || v->type != t) \
 	continue
 
+static void deserialize_memory_ranges(RzVector /*<RzDebugChangeMemRange>*/ *ranges, const char *v) {
+	const RzJson *child;
+	char *json_str = strdup(v);
+	if (!json_str) {
+		return;
+	}
+	RzJson *ranges_json = rz_json_parse(json_str);
+	if (!ranges_json || ranges_json->type != RZ_JSON_ARRAY) {
+		free(json_str);
+		return;
+	}
+	for (child = ranges_json->children.first; child; child = child->next) {
+		if (child->type != RZ_JSON_OBJECT) {
+			continue;
+		}
+		const RzJson *cnumj = rz_json_get(child, "cnum");
+		CHECK_TYPE(cnumj, RZ_JSON_INTEGER);
+		const RzJson *addrj = rz_json_get(child, "addr");
+		CHECK_TYPE(addrj, RZ_JSON_INTEGER);
+		const RzJson *dataj = rz_json_get(child, "data");
+		CHECK_TYPE(dataj, RZ_JSON_STRING);
+
+		int size = 0;
+		ut8 *data = sdb_decode(dataj->str_value, &size);
+		if (!data || size <= 0) {
+			free(data);
+			continue;
+		}
+		RzDebugChangeMemRange range = { cnumj->num.s_value, addrj->num.u_value, size, data };
+		if (!rz_vector_push(ranges, &range)) {
+			free(data);
+		}
+	}
+	rz_json_free(ranges_json);
+	free(json_str);
+}
+
 static bool deserialize_memory_cb(void *user, const char *addr, const char *v) {
+	RzDebugSession *session = user;
+	if (!strcmp(addr, "ranges")) {
+		deserialize_memory_ranges(session->memory_ranges, v);
+		return true;
+	}
+
 	RzJson *child;
 	char *json_str = strdup(v);
 	if (!json_str) {
@@ -473,7 +710,7 @@ static bool deserialize_memory_cb(void *user, const char *addr, const char *v) {
 		return true;
 	}
 
-	HtUP *memory = user;
+	HtUP *memory = session->memory;
 	// Insert a new vector into `memory` HtUP at `addr`
 	RzVector *vmem = rz_vector_new(sizeof(RzDebugChangeMem), NULL, NULL);
 	if (!vmem) {
@@ -506,8 +743,8 @@ static bool deserialize_memory_cb(void *user, const char *addr, const char *v) {
 	return true;
 }
 
-static void deserialize_memory(Sdb *db, HtUP *memory) {
-	sdb_foreach(db, deserialize_memory_cb, memory);
+static void deserialize_memory(Sdb *db, RzDebugSession *session) {
+	sdb_foreach(db, deserialize_memory_cb, session);
 }
 
 static bool deserialize_registers_cb(void *user, const char *addr, const char *v) {
@@ -708,6 +945,8 @@ RZ_API void rz_debug_session_deserialize(RzDebugSession *session, Sdb *db) {
 	Sdb *subdb;
 
 	session->maxcnum = sdb_num_get(db, "maxcnum", 0);
+	// the loaded checkpoints do not match the debuggee soft-dirty state
+	session->soft_dirty = false;
 
 #define DESERIALIZE(ns, func) \
 	do { \
@@ -719,7 +958,7 @@ RZ_API void rz_debug_session_deserialize(RzDebugSession *session, Sdb *db) {
 		func; \
 	} while (0)
 
-	DESERIALIZE("memory", deserialize_memory(subdb, session->memory));
+	DESERIALIZE("memory", deserialize_memory(subdb, session));
 	DESERIALIZE("registers", deserialize_registers(subdb, session->registers));
 	DESERIALIZE("checkpoints", deserialize_checkpoints(subdb, session->checkpoints));
 }
@@ -4,16 +4,65 @@
 
 #include <rz_debug.h>
 
+#define SNAP_CHUNK_PAGES 64
+
+static RzDebugSnapPage *snap_page_ref(RzDebugSnapPage *page) {
+	page->refs++;
+	return page;
+}
+
+static void snap_page_unref(HtUP *store, RzDebugSnapPage *page) {
+	if (!page || --page->refs) {
+		return;
+	}
+	if (page->interned && store) {
+		ht_up_delete(store, page->hash);
+	}
+	free(page);
+}
+
+/**
+ * Returns a reference to the page of \p store holding the same bytes as
+ * \p buf, creating it when there is none.
+ */
+static RzDebugSnapPage *snap_page_intern(HtUP *store, const ut8 *buf) {
+	ut32 hash = rz_hash_xxhash(buf, SNAP_PAGE_SIZE);
+	RzDebugSnapPage *page = ht_up_find(store, hash, NULL);
+	if (page && !memcmp(page->data, buf, SNAP_PAGE_SIZE)) {
+		return snap_page_ref(page);
+	}
+	RzDebugSnapPage *fresh = RZ_NEW(RzDebugSnapPage);
+	if (!fresh) {
+		return NULL;
+	}
+	memcpy(fresh->data, buf, SNAP_PAGE_SIZE);
+	fresh->hash = hash;
+	fresh->refs = 1;
+	// on a hash collision the page just stays out of the store
+	fresh->interned = !page && ht_up_insert(store, hash, fresh);
+	return fresh;
+}
+
+static const ut8 *snap_page_bytes(RzDebugSnap *snap, ut32 idx) {
+	return snap->data ? snap->data + (ut64)idx * SNAP_PAGE_SIZE : snap->pages[idx]->data;
+}
+
 RZ_API void rz_debug_snap_free(RzDebugSnap *snap) {
 	if (snap) {
 		free(snap->name);
 		free(snap->data);
+		if (snap->pages) {
+			ut32 i;
+			for (i = 0; i < snap->pages_count; i++) {
+				snap_page_unref(snap->store, snap->pages[i]);
+			}
+			free(snap->pages);
+		}
 		RZ_FREE(snap);
 	}
 }
 
-RZ_API RzDebugSnap *rz_debug_snap_map(RzDebug *dbg, RzDebugMap *map) {
-	rz_return_val_if_fail(dbg && map, NULL);
+static RzDebugSnap *snap_new(RzDebugMap *map) {
 	if (map->size < 1) {
 		eprintf("Invalid map size\n");
 		return NULL;
@@ -31,6 +80,18 @@ RZ_API RzDebugSnap *rz_debug_snap_map(RzDebug *dbg, RzDebugMap *map) {
 	snap->perm = map->perm;
 	snap->user = map->user;
 	snap->shared = map->shared;
+	return snap;
+}
+
+/**
+ * \brief Takes a flat snapshot of \p map, holding a full copy of its memory
+ */
+RZ_API RzDebugSnap *rz_debug_snap_map(RzDebug *dbg, RzDebugMap *map) {
+	rz_return_val_if_fail(dbg && map, NULL);
+	RzDebugSnap *snap = snap_new(map);
+	if (!snap) {
+		return NULL;
+	}
 
 	snap->data = malloc(map->size);
 	if (!snap->data) {
@@ -43,12 +104,137 @@ RZ_API RzDebugSnap *rz_debug_snap_map(RzDebug *dbg, RzDebugMap *map) {
 	return snap;
 }
 
+/**
+ * \brief Takes a page-granular snapshot of \p map
+ *
+ * Every page is interned in the content-addressed \p store, so identical pages
+ * are kept only once across all the snaps sharing it. When \p base is a snap of
+ * the same map and \p dirty tells which of its pages changed since it was taken,
+ * clean pages are shared with \p base without reading them from the debuggee.
+ *
+ * \param store page store, must outlive the returned snap
+ * \param base previous snap of \p map, may be NULL
+ * \param dirty one bit per page of \p map, set when the page may have changed
+ */
+RZ_API RzDebugSnap *rz_debug_snap_map_pages(RzDebug *dbg, RzDebugMap *map, RZ_NONNULL HtUP *store, RZ_NULLABLE RzDebugSnap *base, RZ_NULLABLE const RzBitVector *dirty) {
+	rz_return_val_if_fail(dbg && map && store, NULL);
+	RzDebugSnap *snap = snap_new(map);
+	if (!snap) {
+		return NULL;
+	}
+	snap->store = store;
+	snap->pages_count = (snap->size + SNAP_PAGE_SIZE - 1) / SNAP_PAGE_SIZE;
+	snap->pages = RZ_NEWS0(RzDebugSnapPage *, snap->pages_count);
+	ut8 *buf = malloc(SNAP_CHUNK_PAGES * SNAP_PAGE_SIZE);
+	if (!snap->pages || !buf) {
+		goto fail;
+	}
+
+	bool reuse = base && dirty && base->pages && base->store == store &&
+		base->addr == snap->addr && base->size == snap->size &&
+		rz_bv_len(dirty) >= snap->pages_count;
+#define PAGE_IS_CLEAN(i) (reuse && !rz_bv_get(dirty, i))
+	ut32 i = 0, j;
+	while (i < snap->pages_count) {
+		if (PAGE_IS_CLEAN(i)) {
+			snap->pages[i] = snap_page_ref(base->pages[i]);
+			i++;
+			continue;
+		}
+		// read consecutive pages to capture in a single go
+		ut32 run = 1;
+		while (i + run < snap->pages_count && run < SNAP_CHUNK_PAGES && !PAGE_IS_CLEAN(i + run)) {
+			run++;
+		}
+		ut64 off = (ut64)i * SNAP_PAGE_SIZE;
+		ut32 len = RZ_MIN(run * SNAP_PAGE_SIZE, snap->size - off);
+		memset(buf + len, 0, run * SNAP_PAGE_SIZE - len);
+		dbg->iob.read_at(dbg->iob.io, snap->addr + off, buf, len);
+		for (j = 0; j < run; j++) {
+			snap->pages[i + j] = snap_page_intern(store, buf + j * SNAP_PAGE_SIZE);
+			if (!snap->pages[i + j]) {
+				goto fail;
+			}
+		}
+		i += run;
+	}
+#undef PAGE_IS_CLEAN
+	free(buf);
+	return snap;
+
+fail:
+	free(buf);
+	rz_debug_snap_free(snap);
+	return NULL;
+}
+
+/**
+ * \brief Returns a flat copy of the memory held by \p snap
+ */
+RZ_API RZ_OWN ut8 *rz_debug_snap_dup_data(RZ_NONNULL RzDebugSnap *snap) {
+	rz_return_val_if_fail(snap, NULL);
+	if (snap->data) {
+		return rz_mem_dup(snap->data, snap->size);
+	}
+	if (!snap->pages) {
+		return NULL;
+	}
+	ut8 *data = malloc(snap->size);
+	if (!data) {
+		return NULL;
+	}
+	ut32 i;
+	for (i = 0; i < snap->pages_count; i++) {
+		ut64 off = (ut64)i * SNAP_PAGE_SIZE;
+		memcpy(data + off, snap->pages[i]->data, RZ_MIN(SNAP_PAGE_SIZE, snap->size - off));
+	}
+	return data;
+}
+
+/**
+ * \brief Writes the memory of \p snap back into the debuggee
+ *
+ * Only the pages differing from the current memory are written.
+ */
+RZ_API bool rz_debug_snap_restore(RZ_NONNULL RzDebug *dbg, RZ_NONNULL RzDebugSnap *snap) {
+	rz_return_val_if_fail(dbg && snap, false);
+	if (!snap->data && !snap->pages) {
+		return false;
+	}
+	ut8 *cur = malloc(SNAP_CHUNK_PAGES * SNAP_PAGE_SIZE);
+	if (!cur) {
+		return false;
+	}
+	ut64 off;
+	for (off = 0; off < snap->size; off += SNAP_CHUNK_PAGES * SNAP_PAGE_SIZE) {
+		ut32 len = RZ_MIN(SNAP_CHUNK_PAGES * SNAP_PAGE_SIZE, snap->size - off);
+		dbg->iob.read_at(dbg->iob.io, snap->addr + off, cur, len);
+		ut32 poff;
+		for (poff = 0; poff < len; poff += SNAP_PAGE_SIZE) {
+			ut32 plen = RZ_MIN(SNAP_PAGE_SIZE, len - poff);
+			const ut8 *want = snap_page_bytes(snap, (off + poff) / SNAP_PAGE_SIZE);
+			if (memcmp(cur + poff, want, plen)) {
+				dbg->iob.write_at(dbg->iob.io, snap->addr + off + poff, want, plen);
+			}
+		}
+	}
+	free(cur);
+	return true;
+}
+
 RZ_API bool rz_debug_snap_contains(RzDebugSnap *snap, ut64 addr) {
 	return (snap->addr <= addr && addr >= snap->addr_end);
 }
 
 RZ_API ut8 *rz_debug_snap_get_hash(RzDebug *dbg, RzDebugSnap *snap, RzHashSize *size) {
-	ut8 *digest = rz_hash_cfg_calculate_small_block(dbg->hash, "sha256", snap->data, snap->size, size);
+	ut8 *data = snap->data ? snap->data : rz_debug_snap_dup_data(snap);
+	if (!data) {
+		return NULL;
+	}
+	ut8 *digest = rz_hash_cfg_calculate_small_block(dbg->hash, "sha256", data, snap->size, size);
+	if (data != snap->data) {
+		free(data);
+	}
 	if (!digest) {
 		return NULL;
 	}
@@ -43,71 +43,218 @@ RZ_API int rz_debug_trace_tag(RzDebug *dbg, int tag) {
 	return (dbg->trace->tag = (tag > 0) ? tag : UT32_MAX);
 }
 
-RZ_API bool rz_debug_trace_ins_before(RzDebug *dbg) {
-	RzListIter *it, *it_tmp;
-	RzAnalysisValue *val;
-	ut8 buf_pc[32];
+#define TRACE_LOG_SIZE 0x10000
+#define TRACE_MAX_MEMREF 32
 
-	// Analyze current instruction
-	ut64 pc = rz_debug_reg_get(dbg, dbg->reg->name[RZ_REG_NAME_PC]);
-	if (!dbg->iob.read_at) {
-		RZ_LOG_ERROR("dbg->iob.read_at missing\n");
-		return false;
+/**
+ * Register operand of a trace plan, kept by value so it does not depend
+ * on the lifetime of the RzRegItem it was compiled from.
+ */
+typedef struct {
+	int arena;
+	int offset; ///< in bits, negative if unused
+	int size; ///< in bits
+} TracePlanReg;
+
+typedef struct {
+	RzAnalysisValueType type; ///< RZ_ANALYSIS_VAL_REG or RZ_ANALYSIS_VAL_MEM
+	TracePlanReg reg; ///< written register, or base register of a memory write
+	TracePlanReg seg;
+	TracePlanReg index;
+	st64 delta;
+	int mul;
+	int memref;
+	ut64 addr; ///< memory write address, resolved by rz_debug_trace_ins_before()
+} TracePlanWrite;
+
+struct rz_debug_trace_plan_t {
+	ut8 bytes[32]; ///< instruction bytes the plan was compiled from
+	int size;
+	size_t writes_count;
+	TracePlanWrite writes[];
+};
+
+static void trace_plan_kv_free(HtUPKv *kv) {
+	free(kv->value);
+}
+
+static void trace_plan_reg_init(TracePlanReg *r, RzRegItem *item) {
+	if (!item) {
+		r->offset = -1;
+		return;
 	}
-	if (!dbg->iob.read_at(dbg->iob.io, pc, buf_pc, sizeof(buf_pc))) {
-		RZ_LOG_ERROR("dbg->iob.read_at failure -- pc 0x%" PFMT64x "\n", pc);
-		return false;
+	r->arena = item->arena;
+	r->offset = item->offset;
+	r->size = item->size;
+}
+
+/**
+ * Read a plan register from the register arena, directly for the
+ * byte-aligned scalar case and through rz_reg_get_value() otherwise.
+ */
+static ut64 trace_plan_reg_value(RzReg *reg, const TracePlanReg *r) {
+	if (r->offset < 0) {
+		return 0;
 	}
-	dbg->cur_op = RZ_NEW0(RzAnalysisOp);
-	if (!dbg->cur_op) {
-		RZ_LOG_ERROR("RZ_NEW0 failure\n");
-		return false;
+	RzRegArena *arena = reg->regset[r->arena].arena;
+	if (!arena) {
+		return 0;
 	}
-	if (rz_analysis_op(dbg->analysis, dbg->cur_op, pc, buf_pc, sizeof(buf_pc), RZ_ANALYSIS_OP_MASK_VAL) < 1) {
+	if (!(r->offset & 7) && (r->size == 8 || r->size == 16 || r->size == 32 || r->size == 64) &&
+		r->offset / 8 + r->size / 8 <= arena->size) {
+		return rz_read_ble(arena->bytes + r->offset / 8, reg->big_endian, r->size);
+	}
+	RzRegItem item = { 0 };
+	item.arena = r->arena;
+	item.offset = r->offset;
+	item.size = r->size;
+	return rz_reg_get_value(reg, &item);
+}
+
+static RzDebugTracePlan *trace_plan_compile(RzDebug *dbg, ut64 pc, const ut8 *buf, int len) {
+	RzAnalysisOp op;
+	rz_analysis_op_init(&op);
+	if (rz_analysis_op(dbg->analysis, &op, pc, buf, len, RZ_ANALYSIS_OP_MASK_VAL) < 1 || op.size < 1) {
 		RZ_LOG_ERROR("rz_analysis_op failure -- pc 0x%" PFMT64x "\n", pc);
-		rz_analysis_op_free(dbg->cur_op);
-		dbg->cur_op = NULL;
-		return false;
+		rz_analysis_op_fini(&op);
+		return NULL;
+	}
+	size_t count = op.access ? rz_list_length(op.access) : 0;
+	RzDebugTracePlan *plan = calloc(1, sizeof(RzDebugTracePlan) + count * sizeof(TracePlanWrite));
+	if (!plan) {
+		rz_analysis_op_fini(&op);
+		return NULL;
 	}
+	plan->size = RZ_MIN(op.size, len);
+	memcpy(plan->bytes, buf, plan->size);
 
-	// resolve mem write address
-	rz_list_foreach_safe (dbg->cur_op->access, it, it_tmp, val) {
+	RzListIter *it;
+	RzAnalysisValue *val;
+	rz_list_foreach (op.access, it, val) {
+		if (!(val->access & RZ_ANALYSIS_ACC_W)) {
+			continue;
+		}
+		TracePlanWrite *w = &plan->writes[plan->writes_count];
 		switch (val->type) {
 		case RZ_ANALYSIS_VAL_REG:
-			if (!(val->access & RZ_ANALYSIS_ACC_W)) {
-				rz_list_delete(dbg->cur_op->access, it);
+			if (!val->reg) {
+				RZ_LOG_ERROR("invalid register, unable to trace register state\n");
+				continue;
 			}
 			break;
 		case RZ_ANALYSIS_VAL_MEM:
-			if (val->memref > 32) {
+			if (val->memref > TRACE_MAX_MEMREF) {
 				eprintf("Error: adding changes to %d bytes in memory.\n", val->memref);
-				rz_list_delete(dbg->cur_op->access, it);
-				break;
-			}
-
-			if (val->access & RZ_ANALYSIS_ACC_W) {
-				// resolve memory address
-				ut64 addr = 0;
-				addr += val->delta;
-				if (val->seg) {
-					addr += rz_reg_get_value(dbg->reg, val->seg);
-				}
-				if (val->reg) {
-					addr += rz_reg_get_value(dbg->reg, val->reg);
-				}
-				if (val->regdelta) {
-					int mul = val->mul ? val->mul : 1;
-					addr += mul * rz_reg_get_value(dbg->reg, val->regdelta);
-				}
-				// resolve address into base for ins_after
-				val->base = addr;
-			} else {
-				rz_list_delete(dbg->cur_op->access, it);
+				continue;
 			}
-		default:
+			trace_plan_reg_init(&w->seg, val->seg);
+			trace_plan_reg_init(&w->index, val->regdelta);
+			w->delta = val->delta;
+			w->mul = val->mul ? val->mul : 1;
+			w->memref = val->memref;
 			break;
+		default:
+			continue;
 		}
+		w->type = val->type;
+		trace_plan_reg_init(&w->reg, val->reg);
+		plan->writes_count++;
+	}
+	rz_analysis_op_fini(&op);
+	return plan;
+}
+
+/**
+ * \brief Drop all compiled trace plans.
+ *
+ * Needs to be called whenever the architecture changes, since plans keep
+ * decoded operands. Changes of the register profile are detected on their own.
+ */
+RZ_API void rz_debug_trace_plans_reset(RZ_NONNULL RzDebug *dbg) {
+	rz_return_if_fail(dbg);
+	ht_up_free(dbg->trace_plans);
+	dbg->trace_plans = NULL;
+	dbg->cur_plan = NULL;
+}
+
+/**
+ * \brief Prepare recording the changes of the instruction at the current pc.
+ *
+ * The instruction is decoded once per address into a trace plan, later
+ * steps over the same address only compare its bytes to detect
+ * self-modifying code and resolve the memory write addresses.
+ */
+RZ_API bool rz_debug_trace_ins_before(RzDebug *dbg) {
+	ut8 buf_pc[32];
+
+	dbg->cur_plan = NULL;
+	if (!dbg->iob.read_at) {
+		RZ_LOG_ERROR("dbg->iob.read_at missing\n");
+		return false;
+	}
+	rz_debug_reg_sync(dbg, RZ_REG_TYPE_ANY, false);
+	RzRegItem *pc_item = rz_reg_get_by_role(dbg->reg, RZ_REG_NAME_PC);
+	ut64 pc = 0;
+	if (pc_item) {
+		TracePlanReg pc_reg;
+		trace_plan_reg_init(&pc_reg, pc_item);
+		pc = trace_plan_reg_value(dbg->reg, &pc_reg);
+	}
+	if (dbg->trace_plans && dbg->trace_plans_reg_generation != dbg->reg->generation) {
+		// the register profile changed, e.g. with drp, since the plans were compiled
+		rz_debug_trace_plans_reset(dbg);
 	}
+	if (!dbg->trace_plans) {
+		dbg->trace_plans = ht_up_new(NULL, trace_plan_kv_free, NULL);
+		if (!dbg->trace_plans) {
+			return false;
+		}
+		dbg->trace_plans_reg_generation = dbg->reg->generation;
+	}
+
+	RzDebugTracePlan *plan = ht_up_find(dbg->trace_plans, pc, NULL);
+	if (plan) {
+		if (!dbg->iob.read_at(dbg->iob.io, pc, buf_pc, plan->size)) {
+			RZ_LOG_ERROR("dbg->iob.read_at failure -- pc 0x%" PFMT64x "\n", pc);
+			return false;
+		}
+		if (memcmp(buf_pc, plan->bytes, plan->size)) {
+			ht_up_delete(dbg->trace_plans, pc);
+			plan = NULL;
+		}
+	}
+	if (!plan) {
+		// Analyze current instruction
+		if (!dbg->iob.read_at(dbg->iob.io, pc, buf_pc, sizeof(buf_pc))) {
+			RZ_LOG_ERROR("dbg->iob.read_at failure -- pc 0x%" PFMT64x "\n", pc);
+			return false;
+		}
+		plan = trace_plan_compile(dbg, pc, buf_pc, sizeof(buf_pc));
+		if (!plan) {
+			return false;
+		}
+		ht_up_insert(dbg->trace_plans, pc, plan);
+	}
+
+	// resolve mem write addresses
+	for (size_t i = 0; i < plan->writes_count; i++) {
+		TracePlanWrite *w = &plan->writes[i];
+		if (w->type != RZ_ANALYSIS_VAL_MEM) {
+			continue;
+		}
+		w->addr = w->delta + trace_plan_reg_value(dbg->reg, &w->seg) +
+			trace_plan_reg_value(dbg->reg, &w->reg) +
+			w->mul * trace_plan_reg_value(dbg->reg, &w->index);
+	}
+
+	if (!dbg->trace_log) {
+		dbg->trace_log = rz_debug_trace_log_new(TRACE_LOG_SIZE);
+	}
+	if (dbg->trace_log) {
+		rz_debug_trace_log_push(dbg->trace_log, pc, dbg->session ? dbg->session->cnum : 0,
+			plan->size, plan->writes_count);
+	}
+	dbg->cur_plan = plan;
 	return true;
 }
 
@@ -120,54 +267,109 @@ RZ_API bool rz_debug_trace_ins_before(RzDebug *dbg) {
  */
 RZ_API bool rz_debug_trace_ins_after(RZ_NONNULL RzDebug *dbg) {
 	rz_return_val_if_fail(dbg, false);
-	if (!dbg->cur_op) { // Can happen if hard stepping is available and code is unknown to Rizin
+	RzDebugTracePlan *plan = dbg->cur_plan;
+	if (!plan) { // Can happen if hard stepping is available and code is unknown to Rizin
 		return false;
 	}
-	RzListIter *it;
-	RzAnalysisValue *val;
 
 	// Add reg/mem write change
 	rz_debug_reg_sync(dbg, RZ_REG_TYPE_ANY, false);
-	rz_list_foreach (dbg->cur_op->access, it, val) {
-		if (!(val->access & RZ_ANALYSIS_ACC_W)) {
-			continue;
-		}
-
-		switch (val->type) {
+	for (size_t i = 0; i < plan->writes_count; i++) {
+		TracePlanWrite *w = &plan->writes[i];
+		switch (w->type) {
 		case RZ_ANALYSIS_VAL_REG: {
-			if (!val->reg) {
-				RZ_LOG_ERROR("invalid register, unable to trace register state\n");
-				continue;
-			}
-			ut64 data = rz_reg_get_value(dbg->reg, val->reg);
+			ut64 data = trace_plan_reg_value(dbg->reg, &w->reg);
 
 			// add reg write
-			rz_debug_session_add_reg_change(dbg->session, val->reg->arena, val->reg->offset, data);
+			rz_debug_session_add_reg_change(dbg->session, w->reg.arena, w->reg.offset, data);
 			break;
 		}
 		case RZ_ANALYSIS_VAL_MEM: {
-			ut8 buf[32] = { 0 };
-			if (!dbg->iob.read_at(dbg->iob.io, val->base, buf, val->memref)) {
-				eprintf("Error reading memory at 0x%" PFMT64x "\n", val->base);
+			ut8 buf[TRACE_MAX_MEMREF] = { 0 };
+			if (!dbg->iob.read_at(dbg->iob.io, w->addr, buf, w->memref)) {
+				eprintf("Error reading memory at 0x%" PFMT64x "\n", w->addr);
 				break;
 			}
 
 			// add mem write
-			size_t i;
-			for (i = 0; i < val->memref; i++) {
-				rz_debug_session_add_mem_change(dbg->session, val->base + i, buf[i]);
-			}
+			rz_debug_session_add_mem_range(dbg->session, w->addr, buf, w->memref);
 			break;
 		}
 		default:
 			break;
 		}
 	}
-	rz_analysis_op_free(dbg->cur_op);
-	dbg->cur_op = NULL;
+	dbg->cur_plan = NULL;
 	return true;
 }
 
+/**
+ * \brief Create a trace log keeping the last \p capacity records.
+ */
+RZ_API RZ_OWN RzDebugTraceLog *rz_debug_trace_log_new(size_t capacity) {
+	rz_return_val_if_fail(capacity, NULL);
+	RzDebugTraceLog *log = RZ_NEW0(RzDebugTraceLog);
+	if (!log) {
+		return NULL;
+	}
+	log->records = RZ_NEWS(RzDebugTraceRecord, capacity);
+	if (!log->records) {
+		free(log);
+		return NULL;
+	}
+	log->capacity = capacity;
+	return log;
+}
+
+RZ_API void rz_debug_trace_log_free(RZ_NULLABLE RzDebugTraceLog *log) {
+	if (!log) {
+		return;
+	}
+	free(log->records);
+	free(log);
+}
+
+/**
+ * \brief Drop all the records of \p log, if any.
+ */
+RZ_API void rz_debug_trace_log_clear(RZ_NULLABLE RzDebugTraceLog *log) {
+	if (!log) {
+		return;
+	}
+	log->head = 0;
+	log->count = 0;
+}
+
+/**
+ * \brief Append a record to the log, overwriting the oldest one if it is full.
+ */
+RZ_API void rz_debug_trace_log_push(RZ_NONNULL RzDebugTraceLog *log, ut64 addr, ut32 cnum, ut16 size, ut16 writes) {
+	rz_return_if_fail(log);
+	RzDebugTraceRecord *rec = &log->records[log->head];
+	rec->addr = addr;
+	rec->cnum = cnum;
+	rec->size = size;
+	rec->writes = writes;
+	log->head = (log->head + 1) % log->capacity;
+	if (log->count < log->capacity) {
+		log->count++;
+	}
+}
+
+/**
+ * \brief Get the \p idx th record of the log, counting from the oldest one.
+ *
+ * \return the record or NULL if \p idx is out of range
+ */
+RZ_API RZ_BORROW RzDebugTraceRecord *rz_debug_trace_log_get(RZ_NONNULL RzDebugTraceLog *log, size_t idx) {
+	rz_return_val_if_fail(log, NULL);
+	if (idx >= log->count) {
+		return NULL;
+	}
+	size_t first = (log->head + log->capacity - log->count) % log->capacity;
+	return &log->records[(first + idx) % log->capacity];
+}
+
 /*
  * something happened at the given pc that we need to trace
  */
@@ -302,4 +504,5 @@ RZ_API void rz_debug_trace_reset(RzDebug *dbg) {
 	t->ht = ht_pp_new0();
 	t->traces = rz_list_new();
 	t->traces->free = free;
+	rz_debug_trace_log_clear(dbg->trace_log);
 }
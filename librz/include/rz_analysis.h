@@ -36,7 +36,7 @@ RZ_LIB_VERSION_HEADER(rz_analysis);
 
 /* dwarf processing context */
 typedef struct rz_analysis_dwarf_context {
-	const RzBinDwarfDebugInfo *info;
+	RzBinDwarfDebugInfo *info;
 	HtUP /*<offset, RzBinDwarfLocList*>*/ *loc;
 	// const RzBinDwarfCfa *cfa; TODO
 } RzAnalysisDwarfContext;
@@ -438,6 +438,7 @@ typedef struct rz_analysis_options_t {
 	bool delay;
 	int tailcall;
 	bool retpoline;
+	size_t threads; // max threads of the parallel stages, RZ_THREAD_POOL_ALL_CORES for all the cores
 } RzAnalysisOptions;
 
 typedef enum {
@@ -452,6 +453,11 @@ typedef struct rz_analysis_hint_cb_t {
 
 typedef struct rz_analysis_il_vm_t RzAnalysisILVM;
 
+#define RZ_ANALYSIS_OP_CACHE_SIZE 4096
+#define RZ_ANALYSIS_READ_AHEAD_SIZE 0x1000
+
+typedef struct rz_analysis_op_cache_t RzAnalysisOpCache;
+
 typedef struct rz_analysis_t {
 	char *cpu; // analysis.cpu
 	char *os; // asm.os
@@ -522,6 +528,9 @@ typedef struct rz_analysis_t {
 	HtPP *ht_global_var; // global variables
 	RBTree global_var_tree; // global variables by address. must not overlap
 	RzHash *hash;
+	RzAnalysisOpCache *opcache; ///< decoded instructions cache (analysis.opcache), NULL when disabled
+	ut64 read_ahead_addr; ///< address of the bytes in read_ahead, UT64_MAX when invalid
+	ut8 read_ahead[RZ_ANALYSIS_READ_AHEAD_SIZE]; ///< bytes read ahead by the function analysis
 } RzAnalysis;
 
 typedef enum rz_analysis_addr_hint_type_t {
@@ -882,6 +891,8 @@ typedef struct rz_analysis_ref_t {
 	ut64 to;
 	RzAnalysisXRefType type;
 } RzAnalysisXRef;
+
+typedef bool (*RzAnalysisXRefCb)(RzAnalysisXRef *xref, void *user);
 RZ_API const char *rz_analysis_ref_type_tostring(RzAnalysisXRefType t);
 
 /* represents a reference line from one address (from) to another (to) */
@@ -1460,6 +1471,16 @@ RZ_API int rz_analysis_op_reg_delta(RzAnalysis *analysis, ut64 addr, const char
 RZ_API bool rz_analysis_op_is_eob(RzAnalysisOp *op);
 RZ_API RzList /*<RzAnalysisOp *>*/ *rz_analysis_op_list_new(void);
 RZ_API int rz_analysis_op(RzAnalysis *analysis, RzAnalysisOp *op, ut64 addr, const ut8 *data, int len, RzAnalysisOpMask mask);
+
+/* op_cache.c */
+RZ_API RZ_OWN RzAnalysisOpCache *rz_analysis_op_cache_new(void);
+RZ_API void rz_analysis_op_cache_free(RZ_NULLABLE RzAnalysisOpCache *cache);
+RZ_API void rz_analysis_op_cache_flush(RZ_NULLABLE RzAnalysisOpCache *cache);
+RZ_API void rz_analysis_op_cache_sync_reg(RZ_NONNULL RzAnalysisOpCache *cache, RZ_NONNULL RzReg *reg);
+RZ_API bool rz_analysis_op_cache_get(RZ_NONNULL RzAnalysisOpCache *cache, RZ_NONNULL RZ_OUT RzAnalysisOp *op, ut64 addr, RZ_NONNULL const ut8 *data, int len, int bits, RzAnalysisOpMask mask, RZ_NONNULL RZ_OUT int *ret);
+RZ_API void rz_analysis_op_cache_set(RZ_NONNULL RzAnalysisOpCache *cache, RZ_NONNULL const RzAnalysisOp *op, ut64 addr, RZ_NONNULL const ut8 *data, int len, int bits, RzAnalysisOpMask mask, int ret);
+RZ_API void rz_analysis_op_cache_stats(RZ_NONNULL RzAnalysisOpCache *cache, RZ_NULLABLE RZ_OUT ut64 *hits, RZ_NULLABLE RZ_OUT ut64 *misses);
+RZ_API bool rz_analysis_op_cache_enable(RZ_NONNULL RzAnalysis *analysis, bool enable);
 RZ_API RzAnalysisOp *rz_analysis_op_hexstr(RzAnalysis *analysis, ut64 addr, const char *hexstr);
 RZ_API char *rz_analysis_op_to_string(RzAnalysis *analysis, RzAnalysisOp *op);
 
@@ -1593,7 +1614,7 @@ RZ_API int rz_analysis_fcn_del(RzAnalysis *analysis, ut64 addr);
 RZ_API int rz_analysis_fcn_del_locs(RzAnalysis *analysis, ut64 addr);
 RZ_API bool rz_analysis_fcn_add_bb(RzAnalysis *analysis, RzAnalysisFunction *fcn, ut64 addr, ut64 size, ut64 jump, ut64 fail);
 RZ_API bool rz_analysis_check_fcn(RzAnalysis *analysis, ut8 *buf, ut16 bufsz, ut64 addr, ut64 low, ut64 high);
-RZ_API void rz_analysis_fcn_invalidate_read_ahead_cache(void);
+RZ_API void rz_analysis_fcn_invalidate_read_ahead_cache(RZ_NONNULL RzAnalysis *analysis);
 
 RZ_API void rz_analysis_function_check_bp_use(RzAnalysisFunction *fcn);
 RZ_API void rz_analysis_update_analysis_range(RzAnalysis *analysis, ut64 addr, int size);
@@ -1620,6 +1641,8 @@ RZ_API bool rz_analysis_function_purity(RzAnalysisFunction *fcn);
 typedef bool (*RzAnalysisRefCmp)(RzAnalysisXRef *ref, void *data);
 RZ_API RZ_OWN RzList /*<RzAnalysisXRef *>*/ *rz_analysis_xref_list_new(void);
 RZ_API ut64 rz_analysis_xrefs_count(RzAnalysis *analysis);
+RZ_API void rz_analysis_xrefs_foreach(RZ_NONNULL RzAnalysis *analysis, RZ_NONNULL RzAnalysisXRefCb cb, RZ_NULLABLE void *user);
+RZ_API void rz_analysis_xrefs_rebase(RZ_NONNULL RzAnalysis *analysis, ut64 diff);
 RZ_API const char *rz_analysis_xrefs_type_tostring(RzAnalysisXRefType type);
 RZ_API RzAnalysisXRefType rz_analysis_xrefs_type(char ch);
 RZ_API RZ_OWN RzList /*<RzAnalysisXRef *>*/ *rz_analysis_xrefs_get_to(RzAnalysis *analysis, ut64 addr);
@@ -1793,6 +1816,7 @@ typedef struct rz_jmptable_params_t {
 	ut64 default_case; ///< Code address of the default case of the switch
 	RzStackAddr sp; ///< Value of the stack pointer after the jump instruction is executed
 	RzVector /*<RzAnalysisTaskItem>*/ *tasks; /// RzVector of RzAnalysisTaskItem to add new tasks to
+	SetU *pending; ///< Start addresses of the items in tasks, used to skip duplicates. If NULL, tasks is scanned instead
 } RzAnalysisJmpTableParams;
 
 RZ_API bool rz_analysis_get_delta_jmptbl_info(RZ_NONNULL RzAnalysis *analysis, RZ_NONNULL RzAnalysisFunction *fcn, ut64 jmp_address, ut64 lea_address, RZ_NONNULL RzAnalysisJmpTableParams *params);
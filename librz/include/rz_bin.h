@@ -14,6 +14,7 @@ typedef struct rz_bin_t RzBin;
 typedef struct rz_bin_file_t RzBinFile;
 typedef struct rz_bin_source_line_info_t RzBinSourceLineInfo;
 typedef struct rz_bin_reloc_storage_t RzBinRelocStorage;
+typedef struct rz_bin_symbol_index_t RzBinSymbolIndex;
 
 #include <rz_bin_dwarf.h>
 #include <rz_pdb.h>
@@ -30,6 +31,8 @@ RZ_LIB_VERSION_HEADER(rz_bin);
 #define RZ_BIN_DBG_SYMS     0x08
 #define RZ_BIN_DBG_RELOCS   0x10
 
+#define RZ_BIN_CACHE_MAX_SIZE (256 * 1024 * 1024) ///< default bin.cache.maxsize
+
 #define RZ_BIN_ENTRY_TYPE_PROGRAM 0
 #define RZ_BIN_ENTRY_TYPE_MAIN    1
 #define RZ_BIN_ENTRY_TYPE_INIT    2
@@ -257,6 +260,7 @@ typedef struct rz_bin_file_load_options_t {
 } RzBinObjectLoadOptions;
 
 typedef struct rz_bin_string_database_t RzBinStrDb;
+typedef struct rz_bin_object_cache_t RzBinObjectCache;
 
 typedef struct rz_bin_object_t {
 	RzBinObjectLoadOptions opts;
@@ -269,6 +273,7 @@ typedef struct rz_bin_object_t {
 	RzList /*<RzBinSection *>*/ *sections;
 	RzList /*<RzBinImport *>*/ *imports;
 	RzList /*<RzBinSymbol *>*/ *symbols;
+	RzBinSymbolIndex *symbols_index; ///< built on first query, see rz_bin_object_get_symbol_index()
 	RzList /*<RzBinResource *>*/ *resources;
 	/**
 	 * \brief Acceleration structure for fast access of the symbol for a given import.
@@ -293,6 +298,11 @@ typedef struct rz_bin_object_t {
 	RZ_DEPRECATE RZ_BORROW Sdb *kv; ///< deprecated, put info in C structures instead of this (holds a copy of another pointer.)
 	HtUP *addrzklassmethod;
 	void *bin_obj; // internal pointer used by formats
+	RZ_BORROW struct rz_bin_file_t *bf; ///< file the lazy items are loaded from
+	RzThreadLock *lazy_lock; ///< guards the items loaded on first access
+	bool strings_pending; ///< strings are scanned on first access
+	bool resources_pending; ///< resources are parsed on first access
+	RzBinObjectCache *cache; ///< bin.cache snapshot of the object, NULL when disabled
 } RzBinObject;
 
 // XXX: RbinFile may hold more than one RzBinObject
@@ -327,6 +337,9 @@ typedef struct rz_bin_file_options_t {
 	// const char *xtrname;
 } RzBinFileOptions;
 
+typedef struct rz_bin_demangle_cache_t RzBinDemangleCache;
+typedef struct rz_bin_probe_t RzBinProbe;
+
 struct rz_bin_t {
 	const char *file;
 	RZ_DEPRECATE RzBinFile *cur; ///< never use this in new code! Get a file from the binfiles list or track it yourself.
@@ -357,6 +370,8 @@ struct rz_bin_t {
 	char *srcdir; // dir.source
 	char *prefix; // bin.prefix
 	char *strenc;
+	char *cache_dir; ///< bin.cache, directory of the object snapshots
+	ut64 cache_max_size; ///< bin.cache.maxsize, older snapshots are removed beyond it, 0 for no limit
 	ut64 filter_rules;
 	bool verbose;
 	bool use_xtr; // use extract plugins when loading a file?
@@ -364,6 +379,9 @@ struct rz_bin_t {
 	RzStrConstPool constpool;
 	bool is_reloc_patched; // used to indicate whether relocations were patched or not
 	RzDemangler *demangler;
+	RzBinDemangleCache *demangle_cache; ///< cache of the demangled names, shared by all the files
+	RzBinProbe *probe; ///< candidate plugins by the first byte of the file
+	RzBinProbe *xtr_probe; ///< candidate extract plugins by the first byte of the file
 	RzHash *hash;
 };
 
@@ -391,6 +409,18 @@ typedef struct rz_bin_xtr_extract_t {
 RZ_API RzBinXtrData *rz_bin_xtrdata_new(RzBuffer *buf, ut64 offset, ut64 size, ut32 file_count, RzBinXtrMetadata *metadata);
 RZ_API void rz_bin_xtrdata_free(void /*RzBinXtrData*/ *data);
 
+/**
+ * \brief Bytes a file must start with to be handled by a plugin
+ */
+typedef struct rz_bin_magic_t {
+	const char *bytes;
+	size_t len; ///< at most RZ_BIN_MAGIC_SIZE
+} RzBinMagic;
+
+#define RZ_BIN_MAGIC_SIZE 32
+#define RZ_BIN_MAGIC(x) \
+	{ .bytes = (x), .len = sizeof(x) - 1 }
+
 typedef struct rz_bin_xtr_plugin_t {
 	char *name;
 	char *desc;
@@ -398,6 +428,7 @@ typedef struct rz_bin_xtr_plugin_t {
 	int (*init)(void *user);
 	int (*fini)(void *user);
 	bool (*check_buffer)(RzBuffer *b);
+	const RzBinMagic *magics; ///< optional, terminated by an empty entry, see RzBinPlugin.magics
 
 	RzBinXtrData *(*extract_from_bytes)(RzBin *bin, const ut8 *buf, ut64 size, int idx);
 	RzBinXtrData *(*extract_from_buffer)(RzBin *bin, RzBuffer *buf, int idx);
@@ -519,6 +550,11 @@ typedef struct rz_bin_plugin_t {
 	void (*destroy)(RzBinFile *bf);
 	bool (*check_bytes)(const ut8 *buf, ut64 length);
 	bool (*check_buffer)(RzBuffer *buf);
+	/**
+	 * Optional list of magics terminated by an empty entry.
+	 * When set, check_buffer is only called for files starting with one of them.
+	 */
+	const RzBinMagic *magics;
 	bool (*check_filename)(const char *filename);
 	ut64 (*baddr)(RzBinFile *bf);
 	ut64 (*boffset)(RzBinFile *bf);
@@ -749,6 +785,22 @@ static inline bool rz_bin_reloc_storage_targets_available(RzBinRelocStorage *sto
 
 RZ_API RzBinReloc *rz_bin_reloc_storage_get_reloc_to(RzBinRelocStorage *storage, ut64 vaddr);
 
+/// Efficient storage of symbols to query by address or name
+struct rz_bin_symbol_index_t {
+	size_t count;
+	ut64 *vaddrs; ///< vaddr of every entry of by_vaddr, in the same order
+	RzBinSymbol **by_vaddr; ///< all symbols, ordered by their vaddr (ties keep the list order)
+	ut64 *paddrs; ///< paddr of every entry of by_paddr, in the same order
+	RzBinSymbol **by_paddr; ///< all symbols, ordered by their paddr (ties keep the list order)
+	HtPP /*<const char *, RzBinSymbol *>*/ *by_name; ///< first symbol with each name
+	RZ_BORROW const RzList /*<RzBinSymbol *>*/ *list; ///< list the index was built from
+}; // RzBinSymbolIndex
+
+RZ_API RZ_OWN RzBinSymbolIndex *rz_bin_symbol_index_new(RZ_NONNULL const RzList /*<RzBinSymbol *>*/ *symbols);
+RZ_API void rz_bin_symbol_index_free(RZ_NULLABLE RzBinSymbolIndex *index);
+RZ_API size_t rz_bin_symbol_index_lower_vaddr(RZ_NONNULL const RzBinSymbolIndex *index, ut64 vaddr);
+RZ_API size_t rz_bin_symbol_index_lower_paddr(RZ_NONNULL const RzBinSymbolIndex *index, ut64 paddr);
+
 typedef struct rz_bin_string_t {
 	// TODO: rename string->name (avoid colisions)
 	char *string;
@@ -891,6 +943,7 @@ RZ_API RzBinPlugin *rz_bin_get_binplugin_by_buffer(RzBin *bin, RzBuffer *buf);
 RZ_API const RzBinPlugin *rz_bin_plugin_get(RZ_NONNULL RzBin *bin, RZ_NONNULL const char *name);
 RZ_API const RzBinXtrPlugin *rz_bin_xtrplugin_get(RZ_NONNULL RzBin *bin, RZ_NONNULL const char *name);
 RZ_API void rz_bin_force_plugin(RzBin *bin, const char *pname);
+RZ_API void rz_bin_set_cache_dir(RzBin *bin, const char *dir);
 
 // get/set various bin information
 RZ_API ut64 rz_bin_get_baddr(RzBin *bin);
@@ -987,11 +1040,18 @@ RZ_API ut64 rz_bin_object_get_vaddr(RzBinObject *o, ut64 paddr, ut64 vaddr);
 RZ_API const RzBinAddr *rz_bin_object_get_special_symbol(RzBinObject *o, RzBinSpecialSymbol sym);
 RZ_API RzBinRelocStorage *rz_bin_object_patch_relocs(RzBinFile *bf, RzBinObject *o);
 RZ_API RzBinSymbol *rz_bin_object_get_symbol_of_import(RzBinObject *o, RzBinImport *imp);
+RZ_API RZ_BORROW RzBinSymbolIndex *rz_bin_object_get_symbol_index(RZ_NONNULL RzBinObject *o);
+RZ_API RZ_BORROW RzBinSymbol *rz_bin_object_get_symbol_at(RZ_NONNULL RzBinObject *o, ut64 vaddr);
+RZ_API RZ_BORROW RzBinSymbol *rz_bin_object_get_symbol_at_paddr(RZ_NONNULL RzBinObject *o, ut64 paddr);
+RZ_API RZ_BORROW RzBinSymbol *rz_bin_object_get_symbol_by_name(RZ_NONNULL RzBinObject *o, RZ_NONNULL const char *name);
+RZ_API RZ_BORROW RzBinSymbol *rz_bin_object_get_symbol_nearest(RZ_NONNULL RzBinObject *o, ut64 vaddr);
+RZ_API RZ_OWN RzPVector /*<RzBinSymbol *>*/ *rz_bin_object_get_symbols_in(RZ_NONNULL RzBinObject *o, ut64 vaddr, ut64 size);
 RZ_API RzBinVirtualFile *rz_bin_object_get_virtual_file(RzBinObject *o, const char *name);
 RZ_API void rz_bin_mem_free(void *data);
 
 // demangle functions
 RZ_API RZ_OWN char *rz_bin_demangle(RZ_NULLABLE RzBinFile *bf, RZ_NULLABLE const char *language, RZ_NULLABLE const char *symbol, ut64 vaddr, bool libs);
+RZ_API void rz_bin_demangle_batch(RZ_NONNULL RzBinFile *bf, RZ_NULLABLE const char *language, RZ_NONNULL const RzList /*<RzBinSymbol *>*/ *symbols);
 RZ_API const char *rz_bin_get_meth_flag_string(ut64 flag, bool compact);
 
 RZ_API RZ_BORROW RzBinSection *rz_bin_get_section_at(RzBinObject *o, ut64 off, int va);
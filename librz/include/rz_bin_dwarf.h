@@ -761,26 +761,11 @@ typedef struct {
 	ut64 offset;
 	size_t count;
 	size_t capacity;
-	RzBinDwarfDie *dies;
+	RzBinDwarfDie *dies; ///< NULL until the unit is expanded, when the info was indexed
+	size_t first_abbr_idx; ///< index in the abbreviations of the first one used by this unit
+	ut32 pins; ///< users keeping the DIEs decoded, see rz_bin_dwarf_debug_info_pin_unit()
 } RzBinDwarfCompUnit;
 
-#define COMP_UNIT_CAPACITY  8
-#define DEBUG_INFO_CAPACITY 8
-typedef struct {
-	size_t count;
-	size_t capacity;
-	RzBinDwarfCompUnit *comp_units;
-	HtUP /*<ut64 offset, DwarfDie *die>*/ *lookup_table;
-	size_t n_dwarf_dies;
-
-	/**
-	 * Cache mapping from an offset in the debug_line section to a string
-	 * representing the DW_AT_comp_dir attribute of the compilation unit
-	 * that references this particular line information.
-	 */
-	HtUP /*<ut64, char *>*/ *line_info_offset_comp_dir;
-} RzBinDwarfDebugInfo;
-
 #define ABBREV_DECL_CAP 8
 
 typedef struct {
@@ -801,6 +786,37 @@ typedef struct {
 	RzBinDwarfAbbrevDecl *decls;
 } RzBinDwarfDebugAbbrev;
 
+#define COMP_UNIT_CAPACITY  8
+#define DEBUG_INFO_CAPACITY 8
+typedef struct {
+	size_t count;
+	size_t capacity;
+	RzBinDwarfCompUnit *comp_units;
+	HtUP /*<ut64 offset, DwarfDie *die>*/ *lookup_table;
+	size_t n_dwarf_dies;
+
+	/**
+	 * Cache mapping from an offset in the debug_line section to a string
+	 * representing the DW_AT_comp_dir attribute of the compilation unit
+	 * that references this particular line information.
+	 */
+	HtUP /*<ut64, char *>*/ *line_info_offset_comp_dir;
+
+	/**
+	 * Data used by rz_bin_dwarf_index_info() to decode the units on demand,
+	 * the buffers are NULL when the whole section was parsed at once.
+	 */
+	struct {
+		const RzBinDwarfDebugAbbrev *abbrevs; ///< borrowed, must outlive the debug info
+		ut8 *debug_info;
+		size_t debug_info_len;
+		ut8 *debug_str;
+		size_t debug_str_len;
+		bool big_endian;
+		RzThreadLock *lock; ///< guards the expansion and release of the units and their pins, also set when parsed whole
+	} lazy;
+} RzBinDwarfDebugInfo;
+
 #define DWARF_FALSE 0
 #define DWARF_TRUE  1
 
@@ -950,6 +966,13 @@ RZ_API const char *rz_bin_dwarf_get_lang_name(ut64 lang);
 RZ_API RzList /*<RzBinDwarfARangeSet *>*/ *rz_bin_dwarf_parse_aranges(RzBinFile *binfile);
 RZ_API RzBinDwarfDebugAbbrev *rz_bin_dwarf_parse_abbrev(RzBinFile *binfile);
 RZ_API RzBinDwarfDebugInfo *rz_bin_dwarf_parse_info(RzBinFile *binfile, RzBinDwarfDebugAbbrev *da);
+RZ_API RzBinDwarfDebugInfo *rz_bin_dwarf_index_info(RzBinFile *binfile, RzBinDwarfDebugAbbrev *da);
+RZ_API RZ_BORROW RzBinDwarfCompUnit *rz_bin_dwarf_debug_info_get_unit(RZ_NONNULL RzBinDwarfDebugInfo *info, size_t idx);
+RZ_API void rz_bin_dwarf_debug_info_release_unit(RZ_NONNULL RzBinDwarfDebugInfo *info, size_t idx);
+RZ_API RZ_BORROW RzBinDwarfCompUnit *rz_bin_dwarf_debug_info_pin_unit(RZ_NONNULL RzBinDwarfDebugInfo *info, size_t idx);
+RZ_API void rz_bin_dwarf_debug_info_unpin_unit(RZ_NONNULL RzBinDwarfDebugInfo *info, size_t idx);
+RZ_API size_t rz_bin_dwarf_debug_info_unit_index(RZ_NONNULL RzBinDwarfDebugInfo *info, ut64 offset);
+RZ_API RZ_BORROW RzBinDwarfDie *rz_bin_dwarf_debug_info_find_die(RZ_NONNULL RzBinDwarfDebugInfo *info, ut64 offset);
 RZ_API HtUP /*<offset, RzBinDwarfLocList *>*/ *rz_bin_dwarf_parse_loc(RzBinFile *binfile, int addr_size);
 RZ_API void rz_bin_dwarf_arange_set_free(RzBinDwarfARangeSet *set);
 RZ_API void rz_bin_dwarf_loc_free(HtUP /*<offset, RzBinDwarfLocList *>*/ *loc_table);
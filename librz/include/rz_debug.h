@@ -159,15 +159,28 @@ typedef struct rz_debug_desc_t {
 	ut64 off;
 } RzDebugDesc;
 
+/**
+ * \brief A page of snapshotted memory, shared by every snap holding the same content
+ */
+typedef struct rz_debug_snap_page_t {
+	ut32 hash; ///< xxhash of \p data, key in the page store
+	ut32 refs;
+	bool interned; ///< whether the page is registered in the page store
+	ut8 data[SNAP_PAGE_SIZE];
+} RzDebugSnapPage;
+
 typedef struct rz_debug_snap_t {
 	char *name;
 	ut64 addr;
 	ut64 addr_end;
 	ut32 size;
-	ut8 *data;
+	ut8 *data; ///< flat copy of the map, NULL when the snap is backed by \p pages
 	int perm;
 	int user;
 	bool shared;
+	HtUP /*<ut32, RzDebugSnapPage *>*/ *store; ///< page store \p pages are interned in
+	RzDebugSnapPage **pages;
+	ut32 pages_count;
 } RzDebugSnap;
 
 typedef struct {
@@ -180,6 +193,16 @@ typedef struct {
 	ut8 data;
 } RzDebugChangeMem;
 
+/**
+ * \brief Contents of a whole range of memory after a write
+ */
+typedef struct {
+	int cnum;
+	ut64 addr;
+	ut32 size;
+	ut8 *data;
+} RzDebugChangeMemRange;
+
 typedef struct rz_debug_checkpoint_t {
 	int cnum;
 	RzRegArena *arena[RZ_REG_TYPE_LAST];
@@ -192,7 +215,10 @@ typedef struct rz_debug_session_t {
 	RzDebugCheckpoint *cur_chkpt;
 	RzVector /*<RzDebugCheckpoint>*/ *checkpoints;
 	HtUP *memory; /* RzVector<RzDebugChangeMem> */
+	RzVector /*<RzDebugChangeMemRange>*/ *memory_ranges; ///< sorted by cnum
 	HtUP *registers; /* RzVector<RzDebugChangeReg> */
+	HtUP /*<ut32, RzDebugSnapPage *>*/ *pages; ///< content-addressed store of checkpointed pages
+	bool soft_dirty; ///< soft-dirty bits were cleared right after the last checkpoint
 	int reasontype /*RzDebugReasonType*/;
 	RzBreakpointItem *bp;
 } RzDebugSession;
@@ -228,6 +254,32 @@ typedef struct rz_debug_trace_t {
 	HtPP *ht;
 } RzDebugTrace;
 
+/**
+ * \brief Compiled per-address description of what an instruction writes,
+ * used by rz_debug_trace_ins_before/after to avoid decoding on every step.
+ */
+typedef struct rz_debug_trace_plan_t RzDebugTracePlan;
+
+/**
+ * \brief Fixed-size record of the binary instruction trace log
+ */
+typedef struct rz_debug_trace_record_t {
+	ut64 addr; ///< address of the traced instruction
+	ut32 cnum; ///< session change number the instruction was executed at
+	ut16 size; ///< instruction size in bytes
+	ut16 writes; ///< number of register and memory writes recorded for it
+} RzDebugTraceRecord;
+
+/**
+ * \brief Ring buffer of RzDebugTraceRecord, overwriting the oldest records once full
+ */
+typedef struct rz_debug_trace_log_t {
+	RzDebugTraceRecord *records;
+	size_t capacity;
+	size_t head; ///< index the next record will be written to
+	size_t count; ///< number of valid records, at most capacity
+} RzDebugTraceLog;
+
 typedef struct rz_debug_tracepoint_t {
 	ut64 addr;
 	ut64 tags; // XXX
@@ -305,7 +357,10 @@ typedef struct rz_debug_t {
 	RzList /*<RzDebugMap *>*/ *maps_user;
 
 	bool trace_continue;
-	RzAnalysisOp *cur_op;
+	HtUP /*<RzDebugTracePlan *>*/ *trace_plans; ///< compiled trace plans by instruction address
+	RzDebugTracePlan *cur_plan; ///< plan of the instruction being stepped, borrowed from trace_plans
+	ut32 trace_plans_reg_generation; ///< generation of dbg->reg the trace plans were compiled for
+	RzDebugTraceLog *trace_log;
 	RzDebugSession *session;
 
 	Sdb *sgnls;
@@ -576,6 +631,7 @@ RZ_API void rz_debug_esil_prestep(RzDebug *d, int p);
 RZ_API bool rz_debug_add_checkpoint(RzDebug *dbg);
 RZ_API bool rz_debug_session_add_reg_change(RzDebugSession *session, int arena, ut64 offset, ut64 data);
 RZ_API bool rz_debug_session_add_mem_change(RzDebugSession *session, ut64 addr, ut8 data);
+RZ_API bool rz_debug_session_add_mem_range(RzDebugSession *session, ut64 addr, RZ_NONNULL const ut8 *buf, ut32 size);
 RZ_API void rz_debug_session_restore_reg_mem(RzDebug *dbg, ut32 cnum);
 RZ_API void rz_debug_session_list_memory(RzDebug *dbg);
 RZ_API void rz_debug_session_serialize(RzDebugSession *session, Sdb *db);
@@ -584,11 +640,20 @@ RZ_API bool rz_debug_session_save(RzDebugSession *session, const char *file);
 RZ_API bool rz_debug_session_load(RzDebug *dbg, const char *file);
 RZ_API bool rz_debug_trace_ins_before(RzDebug *dbg);
 RZ_API bool rz_debug_trace_ins_after(RZ_NONNULL RzDebug *dbg);
+RZ_API void rz_debug_trace_plans_reset(RZ_NONNULL RzDebug *dbg);
+RZ_API RZ_OWN RzDebugTraceLog *rz_debug_trace_log_new(size_t capacity);
+RZ_API void rz_debug_trace_log_free(RZ_NULLABLE RzDebugTraceLog *log);
+RZ_API void rz_debug_trace_log_clear(RZ_NULLABLE RzDebugTraceLog *log);
+RZ_API void rz_debug_trace_log_push(RZ_NONNULL RzDebugTraceLog *log, ut64 addr, ut32 cnum, ut16 size, ut16 writes);
+RZ_API RZ_BORROW RzDebugTraceRecord *rz_debug_trace_log_get(RZ_NONNULL RzDebugTraceLog *log, size_t idx);
 
 RZ_API RzDebugSession *rz_debug_session_new(void);
 RZ_API void rz_debug_session_free(RzDebugSession *session);
 
 RZ_API RzDebugSnap *rz_debug_snap_map(RzDebug *dbg, RzDebugMap *map);
+RZ_API RzDebugSnap *rz_debug_snap_map_pages(RzDebug *dbg, RzDebugMap *map, RZ_NONNULL HtUP *store, RZ_NULLABLE RzDebugSnap *base, RZ_NULLABLE const RzBitVector *dirty);
+RZ_API RZ_OWN ut8 *rz_debug_snap_dup_data(RZ_NONNULL RzDebugSnap *snap);
+RZ_API bool rz_debug_snap_restore(RZ_NONNULL RzDebug *dbg, RZ_NONNULL RzDebugSnap *snap);
 RZ_API bool rz_debug_snap_contains(RzDebugSnap *snap, ut64 addr);
 RZ_API ut8 *rz_debug_snap_get_hash(RzDebug *dbg, RzDebugSnap *snap, RzHashSize *size);
 RZ_API bool rz_debug_snap_is_equal(RzDebug *dbg, RzDebugSnap *a, RzDebugSnap *b);
@@ -69,6 +69,11 @@ typedef struct rz_io_t {
 	int cached;
 	bool cachemode; // write in cache all the read operations (EXPERIMENTAL)
 	int p_cache;
+	bool rcache; ///< cache the reads of the descs in pages, see io_rcache.c
+	ut32 rcache_pagesize;
+	ut32 rcache_pages; ///< maximum number of pages cached for each desc
+	ut64 rcache_hits;
+	ut64 rcache_misses;
 	RzIDPool *map_ids;
 	RzPVector /*<RzIOMap *>*/ maps; // from tail backwards maps with higher priority are found
 	RzSkyline map_skyline; // map parts that are not covered by others
@@ -92,6 +97,8 @@ typedef struct rz_io_t {
 	RzCoreBind corebind;
 } RzIO;
 
+typedef struct rz_io_desc_rcache_t RzIODescRCache;
+
 typedef struct rz_io_desc_t {
 	int fd;
 	int perm;
@@ -99,6 +106,7 @@ typedef struct rz_io_desc_t {
 	char *name;
 	char *referer;
 	HtUP /*<ut64, RzIODescCache *>*/ *cache;
+	RzIODescRCache *rcache;
 	void *data;
 	struct rz_io_plugin_t *plugin;
 	RzIO *io;
@@ -111,6 +119,16 @@ typedef struct {
 	void *data;
 } RzIODescData;
 
+/**
+ * \brief One fragment of a vectored read, see RzIOPlugin.readv_at
+ */
+typedef struct rz_io_read_vec_t {
+	ut64 addr; ///< offset in the desc
+	ut8 *buf;
+	int len;
+	int ret; ///< set to what a read of this fragment alone would have returned
+} RzIOReadVec;
+
 typedef struct rz_io_plugin_t {
 	const char *name;
 	const char *desc;
@@ -127,6 +145,16 @@ typedef struct rz_io_plugin_t {
 	RzIODesc *(*open)(RzIO *io, const char *, int perm, int mode);
 	RzList /*<RzIODesc *>*/ *(*open_many)(RzIO *io, const char *, int perm, int mode);
 	int (*read)(RzIO *io, RzIODesc *fd, ut8 *buf, int count);
+	/**
+	 * Optional positional read, avoiding the lseek + read pair.
+	 * Unlike read, the seek of the desc is left unspecified.
+	 */
+	int (*read_at)(RzIO *io, RzIODesc *fd, ut64 addr, ut8 *buf, int count);
+	/**
+	 * Optional vectored read, performing all the reads of \p vec at once and
+	 * setting their ret. Returns false, leaving vec untouched, if it cannot be done.
+	 */
+	bool (*readv_at)(RzIO *io, RzIODesc *fd, RzIOReadVec *vec, size_t count);
 	ut64 (*lseek)(RzIO *io, RzIODesc *fd, ut64 offset, int whence);
 	int (*write)(RzIO *io, RzIODesc *fd, const ut8 *buf, int count);
 	int (*close)(RzIODesc *desc);
@@ -140,6 +168,11 @@ typedef struct rz_io_plugin_t {
 	int (*create)(RzIO *io, const char *file, int mode, int type);
 	bool (*check)(RzIO *io, const char *, bool many);
 	ut8 *(*get_buf)(RzIODesc *desc, ut64 *size);
+	/**
+	 * Optional: pointer to the \p len bytes at \p addr if they live in memory
+	 * (e.g. a file mapping), or NULL. See rz_io_desc_borrow_at().
+	 */
+	const ut8 *(*borrow)(RzIODesc *desc, ut64 addr, int len);
 } RzIOPlugin;
 
 typedef struct rz_io_map_t {
@@ -210,6 +243,7 @@ typedef int (*RzIOFdWrite)(RzIO *io, int fd, const ut8 *buf, int len);
 typedef int (*RzIOFdReadAt)(RzIO *io, int fd, ut64 addr, ut8 *buf, int len);
 typedef int (*RzIOFdWriteAt)(RzIO *io, int fd, ut64 addr, const ut8 *buf, int len);
 typedef bool (*RzIOFdIsDbg)(RzIO *io, int fd);
+typedef void (*RzIORCacheInvalidateDbg)(RzIO *io);
 typedef const char *(*RzIOFdGetName)(RzIO *io, int fd);
 typedef RzList *(*RzIOFdGetMap)(RzIO *io, int fd);
 typedef bool (*RzIOFdRemap)(RzIO *io, int fd, ut64 addr);
@@ -250,6 +284,7 @@ typedef struct rz_io_bind_t {
 	RzIOFdReadAt fd_read_at;
 	RzIOFdWriteAt fd_write_at;
 	RzIOFdIsDbg fd_is_dbg;
+	RzIORCacheInvalidateDbg rcache_invalidate_dbg;
 	RzIOFdGetName fd_get_name;
 	RzIOFdGetMap fd_get_map;
 	RzIOFdRemap fd_remap;
@@ -327,6 +362,7 @@ RZ_API bool rz_io_vread_at_mapped(RzIO *io, ut64 vaddr, ut8 *buf, int len);
 RZ_API bool rz_io_read_at(RzIO *io, ut64 addr, ut8 *buf, int len);
 RZ_API bool rz_io_read_at_mapped(RzIO *io, ut64 addr, ut8 *buf, int len);
 RZ_API int rz_io_nread_at(RzIO *io, ut64 addr, ut8 *buf, int len);
+RZ_API RZ_BORROW const ut8 *rz_io_read_at_borrow(RZ_NONNULL RzIO *io, ut64 addr, RZ_NONNULL RZ_OUT ut8 *buf, int len);
 RZ_API bool rz_io_write_at(RzIO *io, ut64 addr, const ut8 *buf, int len);
 RZ_API bool rz_io_read(RzIO *io, ut8 *buf, int len);
 RZ_API bool rz_io_write(RzIO *io, const ut8 *buf, int len);
@@ -376,6 +412,8 @@ RZ_API int rz_io_desc_get_pid(RzIODesc *desc);
 RZ_API int rz_io_desc_get_tid(RzIODesc *desc);
 RZ_API bool rz_io_desc_get_base(RzIODesc *desc, ut64 *base);
 RZ_API int rz_io_desc_read_at(RzIODesc *desc, ut64 addr, ut8 *buf, int len);
+RZ_API void rz_io_desc_readv_at(RZ_NONNULL RzIODesc *desc, RZ_NONNULL RzIOReadVec *vec, size_t count);
+RZ_API RZ_BORROW const ut8 *rz_io_desc_borrow_at(RZ_NULLABLE RzIODesc *desc, ut64 addr, int len);
 RZ_API int rz_io_desc_write_at(RzIODesc *desc, ut64 addr, const ut8 *buf, int len);
 
 /* lifecycle */
@@ -402,6 +440,14 @@ RZ_API void rz_io_desc_cache_fini(RzIODesc *desc);
 RZ_API void rz_io_desc_cache_fini_all(RzIO *io);
 RZ_API RzList /*<RzIOCache *>*/ *rz_io_desc_cache_list(RzIODesc *desc);
 
+/* io/io_rcache.c */
+RZ_API bool rz_io_desc_rcache_usable(RZ_NONNULL RzIODesc *desc);
+RZ_API int rz_io_desc_rcache_read(RZ_NONNULL RzIODesc *desc, ut64 paddr, RZ_NONNULL RZ_OUT ut8 *buf, int len);
+RZ_API void rz_io_desc_rcache_invalidate(RZ_NONNULL RzIODesc *desc, ut64 paddr, ut64 len);
+RZ_API void rz_io_desc_rcache_fini(RZ_NONNULL RzIODesc *desc);
+RZ_API void rz_io_rcache_flush(RZ_NONNULL RzIO *io);
+RZ_API void rz_io_rcache_invalidate_dbg(RZ_NONNULL RzIO *io);
+
 /* io/fd.c */
 RZ_API int rz_io_fd_open(RzIO *io, const char *uri, int flags, int mode);
 RZ_API bool rz_io_fd_close(RzIO *io, int fd);
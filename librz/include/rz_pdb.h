@@ -152,9 +152,11 @@ typedef struct tpi_types {
 
 typedef struct tpi_stream_t {
 	RzPdbTpiStreamHeader header;
-	RBTree types;
+	RBTree types; ///< parsed types, filled on lookup or by rz_bin_pdb_load_all_types()
 	ut64 type_index_base;
 	RzList /*<RzBaseType *>*/ *print_type;
+	RzBuffer *buf; ///< type records, owned by the MSF stream
+	ut32 *type_offsets; ///< offset in buf of the record of each type index, 0 if not located yet
 } RzPdbTpiStream;
 
 // PDB
@@ -229,7 +231,8 @@ typedef struct {
 	ut32 stream_idx;
 	ut32 stream_size;
 	ut32 blocks_num;
-	RzBuffer *stream_data;
+	RzBuffer *stream_data; ///< read in place from the blocks of the file
+	ut32 *blocks; ///< index of each block of the stream in the file
 } RzPdbMsfStream;
 
 typedef struct {
@@ -258,6 +261,7 @@ RZ_API void rz_bin_pdb_free(RzPdb *pdb);
 
 // TPI
 RZ_API RZ_BORROW RzPdbTpiType *rz_bin_pdb_get_type_by_index(RZ_NONNULL RzPdbTpiStream *stream, ut32 index);
+RZ_API bool rz_bin_pdb_load_all_types(RZ_NONNULL const RzPdb *pdb);
 RZ_API RZ_OWN char *rz_bin_pdb_calling_convention_as_string(RZ_NONNULL RzPdbTpiCallingConvention idx);
 RZ_API bool rz_bin_pdb_type_is_fwdref(RZ_NONNULL RzPdbTpiType *t);
 RZ_API RZ_BORROW RzList /*<RzPdbTpiType *>*/ *rz_bin_pdb_get_type_members(RZ_NONNULL RzPdbTpiStream *stream, RzPdbTpiType *t);
@@ -15,19 +15,78 @@
 
 RZ_LIB_VERSION(rz_io);
 
-static int fd_read_at_wrap(RzIO *io, int fd, ut64 addr, ut8 *buf, int len, RzIOMap *map, void *user) {
-	return rz_io_fd_read_at(io, fd, addr, buf, len);
-}
-
 static int fd_write_at_wrap(RzIO *io, int fd, ut64 addr, ut8 *buf, int len, RzIOMap *map, void *user) {
 	return rz_io_fd_write_at(io, fd, addr, buf, len);
 }
 
 typedef int (*cbOnIterMap)(RzIO *io, int fd, ut64 addr, ut8 *buf, int len, RzIOMap *map, void *user);
 
+#define READV_BATCH 16
+
+/**
+ * Fragments of a read spanning several maps, gathered by on_map_skyline()
+ * so that the fragments on the same desc are read with one vectored call.
+ */
+typedef struct {
+	RzIO *io;
+	bool prefix_mode;
+	RzIOReadVec vec[READV_BATCH];
+	int fds[READV_BATCH];
+	size_t count;
+	st64 done; ///< prefix mode: bytes of the prefix read so far, or the error
+	bool stopped; ///< prefix mode: a fragment was not read completely
+	bool last_complete; ///< the last fragment was read completely
+} ReadGather;
+
+static void read_gather_flush(ReadGather *g) {
+	size_t i = 0;
+	while (i < g->count) {
+		// runs of fragments on the same desc go in one call
+		size_t n = 1;
+		while (i + n < g->count && g->fds[i + n] == g->fds[i]) {
+			n++;
+		}
+		RzIODesc *desc = rz_io_desc_get(g->io, g->fds[i]);
+		if (desc) {
+			rz_io_desc_readv_at(desc, g->vec + i, n);
+		} else {
+			for (size_t j = i; j < i + n; j++) {
+				g->vec[j].ret = 0;
+			}
+		}
+		i += n;
+	}
+	for (i = 0; i < g->count; i++) {
+		RzIOReadVec *v = &g->vec[i];
+		g->last_complete = v->ret == v->len;
+		if (!g->prefix_mode || g->stopped) {
+			continue;
+		}
+		if (v->ret < 0) {
+			g->done = v->ret;
+			g->stopped = true;
+		} else {
+			g->done += v->ret;
+			g->stopped = v->ret != v->len;
+		}
+	}
+	g->count = 0;
+}
+
+static int fd_read_gather_wrap(RzIO *io, int fd, ut64 addr, ut8 *buf, int len, RzIOMap *map, void *user) {
+	ReadGather *g = user;
+	g->vec[g->count] = (RzIOReadVec){ .addr = addr, .buf = buf, .len = len };
+	g->fds[g->count] = fd;
+	if (++g->count == READV_BATCH) {
+		read_gather_flush(g);
+	}
+	// pretend success until a flush tells otherwise, so the walk of the maps goes on
+	return g->stopped ? 0 : len;
+}
+
 // If prefix_mode is true, returns the number of bytes of operated prefix; returns < 0 on error.
 // If prefix_mode is false, operates in non-stop mode and returns true iff all IO operations on overlapped maps are complete.
-static st64 on_map_skyline(RzIO *io, ut64 vaddr, ut8 *buf, int len, int match_flg, cbOnIterMap op, bool prefix_mode) {
+static st64 on_map_skyline(RzIO *io, ut64 vaddr, ut8 *buf, int len, int match_flg, cbOnIterMap op, void *user, bool prefix_mode) {
 	RzVector *skyline = &io->map_skyline.v;
 	ut64 addr = vaddr;
 	size_t i;
@@ -74,7 +133,7 @@ static st64 on_map_skyline(RzIO *io, ut64 vaddr, ut8 *buf, int len, int match_fl
 		// The map satisfies the permission requirement or p_cache is enabled
 		if (((map->perm & match_flg) == match_flg || io->p_cache)) {
 			st64 result = op(io, map->fd, map->delta + addr - map->itv.addr,
-				buf + (addr - vaddr), len1, map, NULL);
+				buf + (addr - vaddr), len1, map, user);
 			if (prefix_mode) {
 				if (result < 0) {
 					return result;
@@ -105,6 +164,14 @@ static st64 on_map_skyline(RzIO *io, ut64 vaddr, ut8 *buf, int len, int match_fl
 	return prefix_mode ? addr - vaddr : ret;
 }
 
+// Reads through on_map_skyline(), handing the fragments on the same desc to the plugin in batches.
+static st64 on_map_skyline_read(RzIO *io, ut64 vaddr, ut8 *buf, int len, bool prefix_mode) {
+	ReadGather g = { .io = io, .prefix_mode = prefix_mode };
+	st64 ret = on_map_skyline(io, vaddr, buf, len, RZ_PERM_R, fd_read_gather_wrap, &g, prefix_mode);
+	read_gather_flush(&g);
+	return prefix_mode ? g.done : ret && g.last_complete;
+}
+
 RZ_API RzIO *rz_io_new(void) {
 	return rz_io_init(RZ_NEW0(RzIO));
 }
@@ -112,6 +179,8 @@ RZ_API RzIO *rz_io_new(void) {
 RZ_API RzIO *rz_io_init(RzIO *io) {
 	rz_return_val_if_fail(io, NULL);
 	io->addrbytes = 1;
+	io->rcache_pagesize = 0x1000;
+	io->rcache_pages = 64;
 	rz_io_desc_init(io);
 	rz_skyline_init(&io->map_skyline);
 	rz_io_map_init(io);
@@ -283,11 +352,11 @@ RZ_API bool rz_io_vread_at_mapped(RzIO *io, ut64 vaddr, ut8 *buf, int len) {
 	if (io->ff) {
 		memset(buf, io->Oxff, len);
 	}
-	return on_map_skyline(io, vaddr, buf, len, RZ_PERM_R, fd_read_at_wrap, false);
+	return on_map_skyline_read(io, vaddr, buf, len, false);
 }
 
 static bool rz_io_vwrite_at(RzIO *io, ut64 vaddr, const ut8 *buf, int len) {
-	return on_map_skyline(io, vaddr, (ut8 *)buf, len, RZ_PERM_W, fd_write_at_wrap, false);
+	return on_map_skyline(io, vaddr, (ut8 *)buf, len, RZ_PERM_W, fd_write_at_wrap, NULL, false);
 }
 
 // Deprecated, use either rz_io_read_at_mapped or rz_io_nread_at instead.
@@ -320,7 +389,7 @@ RZ_API bool rz_io_read_at_mapped(RzIO *io, ut64 addr, ut8 *buf, int len) {
 		memset(buf, io->Oxff, len);
 	}
 	if (io->va) {
-		ret = on_map_skyline(io, addr, buf, len, RZ_PERM_R, fd_read_at_wrap, false);
+		ret = on_map_skyline_read(io, addr, buf, len, false);
 	} else {
 		ret = rz_io_pread_at(io, addr, buf, len) > 0;
 	}
@@ -343,7 +412,7 @@ RZ_API int rz_io_nread_at(RzIO *io, ut64 addr, ut8 *buf, int len) {
 		if (io->ff) {
 			memset(buf, io->Oxff, len);
 		}
-		ret = on_map_skyline(io, addr, buf, len, RZ_PERM_R, fd_read_at_wrap, true);
+		ret = on_map_skyline_read(io, addr, buf, len, true);
 	} else {
 		ret = rz_io_pread_at(io, addr, buf, len);
 	}
@@ -353,6 +422,39 @@ RZ_API int rz_io_nread_at(RzIO *io, ut64 addr, ut8 *buf, int len) {
 	return ret;
 }
 
+/**
+ * \brief Reads \p len bytes at \p addr, lending them without a copy when possible
+ *
+ * When the whole range lies in a single map (or in the current desc in
+ * physical mode) whose desc can lend its data (see rz_io_desc_borrow_at())
+ * and the io cache is off, a pointer straight into the data is returned.
+ * Otherwise the bytes are read into \p buf as rz_io_read_at() does, and \p buf
+ * is returned.
+ *
+ * \param buf Buffer of at least \p len bytes, only used when the data cannot be lent
+ * \return Pointer to the bytes, valid until the next write to io or change of its maps
+ */
+RZ_API RZ_BORROW const ut8 *rz_io_read_at_borrow(RZ_NONNULL RzIO *io, ut64 addr, RZ_NONNULL RZ_OUT ut8 *buf, int len) {
+	rz_return_val_if_fail(io && buf && len >= 0, NULL);
+	const ut8 *data = NULL;
+	if (len > 0 && !(io->cached & RZ_PERM_R)) {
+		if (!io->va) {
+			data = rz_io_desc_borrow_at(io->desc, addr, len);
+		} else if (!UT64_ADD_OVFCHK(addr, len - 1)) {
+			const RzSkylineItem *part = rz_skyline_get_item(&io->map_skyline, addr);
+			RzIOMap *map = part ? part->user : NULL;
+			if (map && (map->perm & RZ_PERM_R) && addr + len - 1 <= rz_itv_end(part->itv) - 1) {
+				data = rz_io_desc_borrow_at(rz_io_desc_get(io, map->fd), map->delta + addr - map->itv.addr, len);
+			}
+		}
+	}
+	if (data) {
+		return data;
+	}
+	(void)rz_io_read_at(io, addr, buf, len);
+	return buf;
+}
+
 RZ_API bool rz_io_write_at(RzIO *io, ut64 addr, const ut8 *buf, int len) {
 	int i;
 	bool ret = false;
@@ -408,6 +510,8 @@ RZ_API bool rz_io_is_listener(RzIO *io) {
 
 RZ_API char *rz_io_system(RzIO *io, const char *cmd) {
 	if (io && io->desc && io->desc->plugin && io->desc->plugin->system && RZ_STR_ISNOTEMPTY(cmd)) {
+		// the command may change the contents of any desc
+		rz_io_rcache_flush(io);
 		return io->desc->plugin->system(io, io->desc, cmd);
 	}
 	return NULL;
@@ -572,6 +676,7 @@ RZ_API void rz_io_bind(RzIO *io, RzIOBind *bnd) {
 	bnd->fd_read_at = rz_io_fd_read_at;
 	bnd->fd_write_at = rz_io_fd_write_at;
 	bnd->fd_is_dbg = rz_io_fd_is_dbg;
+	bnd->rcache_invalidate_dbg = rz_io_rcache_invalidate_dbg;
 	bnd->fd_get_name = rz_io_fd_get_name;
 	bnd->fd_get_map = rz_io_map_get_for_fd;
 	bnd->fd_remap = rz_io_map_remap_fd;
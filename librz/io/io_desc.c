@@ -38,6 +38,7 @@ RZ_API void rz_io_desc_free(RzIODesc *desc) {
 		free(desc->referer);
 		free(desc->name);
 		rz_io_desc_cache_fini(desc);
+		rz_io_desc_rcache_fini(desc);
 		if (desc->io && desc->io->files) {
 			rz_id_storage_delete(desc->io->files, desc->fd);
 		}
@@ -194,18 +195,20 @@ RZ_API int rz_io_desc_write(RzIODesc *desc, const ut8 *buf, int len) {
 }
 
 // returns length of read bytes
-RZ_API int rz_io_desc_read(RzIODesc *desc, ut8 *buf, int len) {
-	// check pointers and permissions
-	if (!buf || !desc || !desc->plugin || !(desc->perm & RZ_PERM_R)) {
-		return -1;
-	}
-	ut64 seek = rz_io_desc_seek(desc, 0LL, RZ_IO_SEEK_CUR);
+static int desc_read(RzIODesc *desc, ut64 seek, ut8 *buf, int len, bool positional) {
 	if (desc->io->cachemode) {
 		if (seek != UT64_MAX && rz_io_cache_at(desc->io, seek)) {
 			return rz_io_cache_read(desc->io, seek, buf, len);
 		}
 	}
-	int ret = rz_io_plugin_read(desc, buf, len);
+	int ret;
+	if (seek != UT64_MAX && rz_io_desc_rcache_usable(desc)) {
+		ret = rz_io_desc_rcache_read(desc, seek, buf, len);
+	} else if (positional) {
+		ret = rz_io_plugin_read_at(desc, seek, buf, len);
+	} else {
+		ret = rz_io_plugin_read(desc, buf, len);
+	}
 	if (ret > 0 && desc->io->cachemode) {
 		rz_io_cache_write(desc->io, seek, buf, len);
 	} else if ((ret > 0) && desc->io && (desc->io->p_cache & 1)) {
@@ -214,6 +217,15 @@ RZ_API int rz_io_desc_read(RzIODesc *desc, ut8 *buf, int len) {
 	return ret;
 }
 
+RZ_API int rz_io_desc_read(RzIODesc *desc, ut8 *buf, int len) {
+	// check pointers and permissions
+	if (!buf || !desc || !desc->plugin || !(desc->perm & RZ_PERM_R)) {
+		return -1;
+	}
+	ut64 seek = rz_io_desc_seek(desc, 0LL, RZ_IO_SEEK_CUR);
+	return desc_read(desc, seek, buf, len, false);
+}
+
 RZ_API ut64 rz_io_desc_seek(RzIODesc *desc, ut64 offset, int whence) {
 	if (!desc || !desc->plugin || !desc->plugin->lseek) {
 		return (ut64)-1;
@@ -250,6 +262,7 @@ RZ_API ut8 *rz_io_desc_get_buf(RzIODesc *desc, RZ_OUT RZ_NONNULL ut64 *size) {
 RZ_API bool rz_io_desc_resize(RzIODesc *desc, ut64 newsize) {
 	if (desc && desc->plugin && desc->plugin->resize) {
 		bool ret = desc->plugin->resize(desc->io, desc, newsize);
+		rz_io_desc_rcache_fini(desc);
 		if (desc->io && desc->io->p_cache) {
 			rz_io_desc_cache_cleanup(desc);
 		}
@@ -281,6 +294,8 @@ RZ_API bool rz_io_desc_exchange(RzIO *io, int fd, int fdx) {
 	descx->fd = fd;
 	rz_id_storage_set(io->files, desc, fdx);
 	rz_id_storage_set(io->files, descx, fd);
+	rz_io_desc_rcache_fini(desc);
+	rz_io_desc_rcache_fini(descx);
 	if (io->p_cache) {
 		HtUP *cache = desc->cache;
 		desc->cache = descx->cache;
@@ -349,6 +364,13 @@ RZ_API bool rz_io_desc_get_base(RzIODesc *desc, ut64 *base) {
 }
 
 RZ_API int rz_io_desc_read_at(RzIODesc *desc, ut64 addr, ut8 *buf, int len) {
+	if (desc && desc->plugin && desc->plugin->read_at) {
+		// no need to seek first
+		if (!buf || !(desc->perm & RZ_PERM_R)) {
+			return -1;
+		}
+		return desc_read(desc, addr, buf, len, true);
+	}
 	ut64 val = rz_io_desc_seek(desc, addr, RZ_IO_SEEK_SET);
 	if (desc && buf && val != UT64_MAX && val == addr) {
 		return rz_io_desc_read(desc, buf, len);
@@ -356,6 +378,47 @@ RZ_API int rz_io_desc_read_at(RzIODesc *desc, ut64 addr, ut8 *buf, int len) {
 	return 0;
 }
 
+/**
+ * \brief Reads all the fragments of \p vec from \p desc, with a single plugin call when possible
+ *
+ * The ret of every fragment is set to what rz_io_desc_read_at() returns for it.
+ * The plugin is only asked for a vectored read when no cache layer of RzIO
+ * sits between the desc and its plugin.
+ */
+RZ_API void rz_io_desc_readv_at(RZ_NONNULL RzIODesc *desc, RZ_NONNULL RzIOReadVec *vec, size_t count) {
+	rz_return_if_fail(desc && vec);
+	RzIO *io = desc->io;
+	if (count > 1 && desc->plugin && desc->plugin->readv_at && (desc->perm & RZ_PERM_R) &&
+		io && !io->cachemode && !(io->p_cache & 1) && !rz_io_desc_rcache_usable(desc) &&
+		desc->plugin->readv_at(io, desc, vec, count)) {
+		return;
+	}
+	for (size_t i = 0; i < count; i++) {
+		vec[i].ret = rz_io_desc_read_at(desc, vec[i].addr, vec[i].buf, vec[i].len);
+	}
+}
+
+/**
+ * \brief Returns a pointer to the \p len bytes at \p addr of \p desc, without copying them
+ *
+ * Only plugins keeping the data in memory (mmap'ed files, malloc://) can lend
+ * it, and only when no cache of RzIO holds bytes of the desc that differ from
+ * the plugin data.
+ * The pointer is valid until the next write, resize or close of \p desc.
+ *
+ * \return The bytes or NULL if they cannot be borrowed; then they must be read.
+ */
+RZ_API RZ_BORROW const ut8 *rz_io_desc_borrow_at(RZ_NULLABLE RzIODesc *desc, ut64 addr, int len) {
+	if (!desc || len < 1 || !desc->plugin || !desc->plugin->borrow || !(desc->perm & RZ_PERM_R)) {
+		return NULL;
+	}
+	RzIO *io = desc->io;
+	if (!io || io->cachemode || (io->p_cache & 1)) {
+		return NULL;
+	}
+	return desc->plugin->borrow(desc, addr, len);
+}
+
 RZ_API int rz_io_desc_write_at(RzIODesc *desc, ut64 addr, const ut8 *buf, int len) {
 	ut64 val = rz_io_desc_seek(desc, addr, RZ_IO_SEEK_SET);
 	if (desc && buf && val != UT64_MAX && val == addr) {
@@ -111,6 +111,17 @@ int io_memory_read(RzIO *io, RzIODesc *fd, ut8 *buf, int count) {
 	return count;
 }
 
+const ut8 *io_memory_borrow(RzIODesc *fd, ut64 addr, int len) {
+	if (!fd || !fd->data) {
+		return NULL;
+	}
+	ut32 mallocsz = _io_malloc_sz(fd);
+	if (addr > mallocsz || len > mallocsz - addr) {
+		return NULL;
+	}
+	return _io_malloc_buf(fd) + addr;
+}
+
 int io_memory_close(RzIODesc *fd) {
 	RzIOMalloc *riom;
 	if (!fd || !fd->data) {
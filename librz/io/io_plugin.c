@@ -97,12 +97,21 @@ RZ_API int rz_io_plugin_write(RzIODesc *desc, const ut8 *buf, int len) {
 	}
 	const ut64 cur_addr = rz_io_desc_seek(desc, 0LL, RZ_IO_SEEK_CUR);
 	int ret = desc->plugin->write(desc->io, desc, buf, len);
+	if (cur_addr != UT64_MAX) {
+		rz_io_desc_rcache_invalidate(desc, cur_addr, len);
+	}
 	RzEventIOWrite iow = { cur_addr, buf, len };
 	rz_event_send(desc->io->event, RZ_EVENT_IO_WRITE, &iow);
 	return ret;
 }
 
 RZ_API int rz_io_plugin_read_at(RzIODesc *desc, ut64 addr, ut8 *buf, int len) {
+	if (desc && desc->plugin && desc->plugin->read_at) {
+		if (!buf || len < 1 || !(desc->perm & RZ_PERM_R)) {
+			return 0;
+		}
+		return desc->plugin->read_at(desc->io, desc, addr, buf, len);
+	}
 	if (rz_io_desc_is_chardevice(desc) || (rz_io_desc_seek(desc, addr, RZ_IO_SEEK_SET) == addr)) {
 		return rz_io_plugin_read(desc, buf, len);
 	}
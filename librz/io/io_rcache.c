@@ -0,0 +1,221 @@
+// SPDX-FileCopyrightText: 2023 RizinOrg <info@rizin.re>
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#include <rz_io.h>
+
+/*
+ * Per-descriptor read cache.
+ *
+ * Reads of the plugin are done in pages of io->rcache_pagesize bytes and
+ * kept until they are evicted (least recently used first), invalidated by a
+ * write of the plugin or the whole cache is flushed. At most
+ * io->rcache_pages pages are kept for each descriptor.
+ *
+ * The cache sits below the p-level cache (io.pcache) and io.cache.auto,
+ * thus it only holds bytes as returned by the plugin. Descriptors of
+ * char devices are never cached since their contents change without going
+ * through RzIO. The memory of a debugger desc only changes while the target
+ * runs, so the debugger drops these pages with rz_io_rcache_invalidate_dbg()
+ * every time the target stops.
+ */
+
+typedef struct {
+	ut64 paddr; ///< address of the first byte of the page, valid only when in the index
+	ut64 stamp; ///< last time the page has been used, 0 when unused
+	int size; ///< bytes in data, less than the page size at the end of the desc
+	ut8 *data;
+} RCachePage;
+
+struct rz_io_desc_rcache_t {
+	HtUP /*<ut64, RCachePage *>*/ *index;
+	RCachePage *pages;
+	ut32 count; ///< number of entries in pages
+	ut32 pagesize;
+	ut64 clock;
+};
+
+static RzIODescRCache *rcache_new(RzIO *io) {
+	if (!io->rcache_pagesize || !io->rcache_pages) {
+		return NULL;
+	}
+	RzIODescRCache *rc = RZ_NEW0(RzIODescRCache);
+	if (!rc) {
+		return NULL;
+	}
+	rc->index = ht_up_new(NULL, NULL, NULL);
+	rc->pages = RZ_NEWS0(RCachePage, io->rcache_pages);
+	if (!rc->index || !rc->pages) {
+		ht_up_free(rc->index);
+		free(rc->pages);
+		free(rc);
+		return NULL;
+	}
+	rc->count = io->rcache_pages;
+	rc->pagesize = io->rcache_pagesize;
+	return rc;
+}
+
+static void page_drop(RzIODescRCache *rc, RCachePage *page) {
+	if (page->stamp) {
+		ht_up_delete(rc->index, page->paddr);
+		page->stamp = 0;
+	}
+}
+
+static RCachePage *page_get(RzIODesc *desc, RzIODescRCache *rc, ut64 paddr) {
+	RzIO *io = desc->io;
+	RCachePage *page = ht_up_find(rc->index, paddr, NULL);
+	if (page) {
+		io->rcache_hits++;
+		page->stamp = ++rc->clock;
+		return page;
+	}
+	io->rcache_misses++;
+	// reuse the least recently used page, unused pages have the lowest stamp
+	page = &rc->pages[0];
+	for (ut32 i = 1; i < rc->count && page->stamp; i++) {
+		if (rc->pages[i].stamp < page->stamp) {
+			page = &rc->pages[i];
+		}
+	}
+	page_drop(rc, page);
+	if (!page->data && !(page->data = malloc(rc->pagesize))) {
+		return NULL;
+	}
+	int ret = rz_io_plugin_read_at(desc, paddr, page->data, (int)rc->pagesize);
+	if (ret <= 0) {
+		return NULL;
+	}
+	page->paddr = paddr;
+	page->size = ret;
+	page->stamp = ++rc->clock;
+	if (!ht_up_insert(rc->index, paddr, page)) {
+		page->stamp = 0;
+		return NULL;
+	}
+	return page;
+}
+
+/**
+ * \brief Returns true if the reads of \p desc can go through the read cache
+ */
+RZ_API bool rz_io_desc_rcache_usable(RZ_NONNULL RzIODesc *desc) {
+	rz_return_val_if_fail(desc, false);
+	return desc->io && desc->io->rcache && !rz_io_desc_is_chardevice(desc);
+}
+
+/**
+ * \brief Reads \p len bytes at \p paddr from the plugin of \p desc through the read cache
+ *
+ * On return the desc is seeked right after the bytes read, as rz_io_plugin_read() does.
+ *
+ * \return The number of bytes read, or the value returned by the plugin on failure
+ */
+RZ_API int rz_io_desc_rcache_read(RZ_NONNULL RzIODesc *desc, ut64 paddr, RZ_NONNULL RZ_OUT ut8 *buf, int len) {
+	rz_return_val_if_fail(desc && desc->io && buf, -1);
+	if (!desc->rcache) {
+		desc->rcache = rcache_new(desc->io);
+		if (!desc->rcache) {
+			return rz_io_plugin_read_at(desc, paddr, buf, len);
+		}
+	}
+	RzIODescRCache *rc = desc->rcache;
+	int done = 0;
+	while (done < len && !UT64_ADD_OVFCHK(paddr, done)) {
+		ut64 addr = paddr + done;
+		ut64 page_addr = addr - addr % rc->pagesize;
+		RCachePage *page = page_get(desc, rc, page_addr);
+		if (!page || addr - page_addr >= page->size) {
+			break;
+		}
+		int n = RZ_MIN(len - done, page->size - (int)(addr - page_addr));
+		memcpy(buf + done, page->data + (addr - page_addr), n);
+		done += n;
+		if (page->size < rc->pagesize) {
+			// reached the end of the desc
+			break;
+		}
+	}
+	if (!done) {
+		// let the plugin report the error by itself
+		return rz_io_plugin_read_at(desc, paddr, buf, len);
+	}
+	rz_io_desc_seek(desc, paddr + done, RZ_IO_SEEK_SET);
+	return done;
+}
+
+/**
+ * \brief Drops the cached pages of \p desc overlapping [\p paddr, \p paddr + \p len)
+ *
+ * Must be called after writing to the plugin of \p desc.
+ */
+RZ_API void rz_io_desc_rcache_invalidate(RZ_NONNULL RzIODesc *desc, ut64 paddr, ut64 len) {
+	rz_return_if_fail(desc);
+	RzIODescRCache *rc = desc->rcache;
+	if (!rc || !len) {
+		return;
+	}
+	ut64 end = UT64_ADD_OVFCHK(paddr, len) ? UT64_MAX : paddr + len;
+	for (ut32 i = 0; i < rc->count; i++) {
+		RCachePage *page = &rc->pages[i];
+		// a short page at the end of the desc is stale also when the desc grows
+		bool overlaps = page->paddr < end && paddr < page->paddr + rc->pagesize;
+		if (page->stamp && (overlaps || page->size < rc->pagesize)) {
+			page_drop(rc, page);
+		}
+	}
+}
+
+/**
+ * \brief Frees the read cache of \p desc
+ */
+RZ_API void rz_io_desc_rcache_fini(RZ_NONNULL RzIODesc *desc) {
+	rz_return_if_fail(desc);
+	RzIODescRCache *rc = desc->rcache;
+	if (!rc) {
+		return;
+	}
+	for (ut32 i = 0; i < rc->count; i++) {
+		free(rc->pages[i].data);
+	}
+	free(rc->pages);
+	ht_up_free(rc->index);
+	free(rc);
+	desc->rcache = NULL;
+}
+
+static bool rcache_invalidate_dbg_cb(void *user, void *data, ut32 id) {
+	RzIODesc *desc = data;
+	if (rz_io_desc_is_dbg(desc)) {
+		rz_io_desc_rcache_invalidate(desc, 0, UT64_MAX);
+	}
+	return true;
+}
+
+/**
+ * \brief Drops the cached pages of all the debugger descs of \p io
+ *
+ * Must be called whenever the debugged target has run, since its memory
+ * may have changed.
+ */
+RZ_API void rz_io_rcache_invalidate_dbg(RZ_NONNULL RzIO *io) {
+	rz_return_if_fail(io);
+	if (io->files) {
+		rz_id_storage_foreach(io->files, rcache_invalidate_dbg_cb, NULL);
+	}
+}
+
+static bool rcache_fini_cb(void *user, void *data, ut32 id) {
+	rz_io_desc_rcache_fini((RzIODesc *)data);
+	return true;
+}
+
+/**
+ * \brief Frees the read cache of all the descs of \p io
+ */
+RZ_API void rz_io_rcache_flush(RZ_NONNULL RzIO *io) {
+	rz_return_if_fail(io);
+	if (io->files) {
+		rz_id_storage_foreach(io->files, rcache_fini_cb, NULL);
+	}
+}
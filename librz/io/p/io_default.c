@@ -5,12 +5,16 @@
 #include <rz_io.h>
 #include <rz_lib.h>
 #include <stdio.h>
+#if HAVE_PREADV
+#include <sys/uio.h>
+#endif
 
 typedef struct rz_io_mmo_t {
 	char *filename;
 	int mode;
 	int perm;
 	bool nocache;
+	bool fdbuf; ///< buf is a plain file buffer, its fd is read with pread()
 	ut8 modified;
 	RzBuffer *buf;
 } RzIOMMapFileObj;
@@ -84,6 +88,7 @@ RzIOMMapFileObj *rz_io_def_mmap_create_new_file(RzIO *io, const char *filename,
 			rz_io_def_mmap_free(mmo);
 			return NULL;
 		}
+		mmo->fdbuf = true;
 		if (mmo->nocache) {
 			disable_fd_cache(mmo->buf->fd);
 		}
@@ -116,6 +121,65 @@ static int rz_io_def_mmap_read(RzIO *io, RzIODesc *fd, ut8 *buf, int count) {
 	return (int)rz_buf_read(mmo->buf, buf, count);
 }
 
+static int rz_io_def_mmap_read_at(RzIO *io, RzIODesc *fd, ut64 addr, ut8 *buf, int count) {
+	rz_return_val_if_fail(fd && fd->data && buf, -1);
+	RzIOMMapFileObj *mmo = (RzIOMMapFileObj *)fd->data;
+	rz_return_val_if_fail(mmo && mmo->buf, -1);
+#if __UNIX__
+	if (mmo->fdbuf) {
+		// rz_buf_read_at() would seek there and back around the read
+		ssize_t r = pread(mmo->buf->fd, buf, count, (off_t)addr);
+		if (r < 0) {
+			return -1;
+		}
+		if (r < count) {
+			memset(buf + r, mmo->buf->Oxff_priv, count - r);
+		}
+		return (int)r;
+	}
+#endif
+	return (int)rz_buf_read_at(mmo->buf, addr, buf, count);
+}
+
+#if HAVE_PREADV
+static bool rz_io_def_mmap_readv_at(RzIO *io, RzIODesc *fd, RzIOReadVec *vec, size_t count) {
+	rz_return_val_if_fail(fd && fd->data && vec, false);
+	RzIOMMapFileObj *mmo = (RzIOMMapFileObj *)fd->data;
+	if (!mmo->fdbuf) {
+		// mmap'ed files are read without any syscall anyway
+		return false;
+	}
+	struct iovec iov[16];
+	size_t i = 0;
+	while (i < count) {
+		// fragments contiguous in the file are read with a single preadv()
+		size_t n = 1;
+		while (i + n < count && n < RZ_ARRAY_SIZE(iov) && vec[i + n].addr == vec[i + n - 1].addr + vec[i + n - 1].len) {
+			n++;
+		}
+		for (size_t j = 0; j < n; j++) {
+			iov[j].iov_base = vec[i + j].buf;
+			iov[j].iov_len = vec[i + j].len;
+		}
+		ssize_t r = preadv(mmo->buf->fd, iov, (int)n, (off_t)vec[i].addr);
+		for (size_t j = i; j < i + n; j++) {
+			RzIOReadVec *v = &vec[j];
+			if (r < 0) {
+				v->ret = -1;
+				continue;
+			}
+			v->ret = (int)RZ_MIN(r, v->len);
+			r -= v->ret;
+			if (v->ret < v->len) {
+				memset(v->buf + v->ret, mmo->buf->Oxff_priv, v->len - v->ret);
+			}
+		}
+		i += n;
+	}
+	return true;
+}
+#endif
+
 static int rz_io_def_mmap_write(RzIO *io, RzIODesc *fd, const ut8 *buf, int count) {
 	rz_return_val_if_fail(io && fd && fd->data && buf, -1);
 	RzIOMMapFileObj *mmo = (RzIOMMapFileObj *)fd->data;
@@ -161,6 +225,10 @@ static int __read(RzIO *io, RzIODesc *fd, ut8 *buf, int len) {
 	return rz_io_def_mmap_read(io, fd, buf, len);
 }
 
+static int __read_at(RzIO *io, RzIODesc *fd, ut64 addr, ut8 *buf, int len) {
+	return rz_io_def_mmap_read_at(io, fd, addr, buf, len);
+}
+
 static int __write(RzIO *io, RzIODesc *fd, const ut8 *buf, int len) {
 	return rz_io_def_mmap_write(io, fd, buf, len);
 }
@@ -200,6 +268,21 @@ static ut8 *io_default_get_buf(RzIODesc *desc, ut64 *size) {
 	return rz_buf_data(mmo->buf, size);
 }
 
+static const ut8 *io_default_borrow(RzIODesc *desc, ut64 addr, int len) {
+	rz_return_val_if_fail(desc && desc->data, NULL);
+	RzIOMMapFileObj *mmo = desc->data;
+	if (mmo->fdbuf) {
+		// the data of file buffers is not in memory
+		return NULL;
+	}
+	ut64 size;
+	const ut8 *data = rz_buf_data(mmo->buf, &size);
+	if (!data || addr > size || len > size - addr) {
+		return NULL;
+	}
+	return data + addr;
+}
+
 RzIOPlugin rz_io_plugin_default = {
 	.name = "default",
 	.desc = "Open local files",
@@ -208,6 +291,10 @@ RzIOPlugin rz_io_plugin_default = {
 	.open = __open_default,
 	.close = __close,
 	.read = __read,
+	.read_at = __read_at,
+#if HAVE_PREADV
+	.readv_at = rz_io_def_mmap_readv_at,
+#endif
 	.check = __plugin_open_default,
 	.lseek = __lseek,
 	.write = __write,
@@ -215,7 +302,8 @@ RzIOPlugin rz_io_plugin_default = {
 #if __UNIX__
 	.is_blockdevice = __is_blockdevice,
 #endif
-	.get_buf = io_default_get_buf
+	.get_buf = io_default_get_buf,
+	.borrow = io_default_borrow
 };
 
 #ifndef RZ_PLUGIN_INCORE
@@ -218,6 +218,8 @@ static char *__system(RzIO *io, RzIODesc *fd, const char *cmd) {
 			" to target interpreter\n"
 			" R!detach [pid]    - detach from remote/detach specific pid\n"
 			" R!inv.reg         - invalidate reg cache\n"
+			" R!inv.mem         - invalidate memory cache\n"
+			" R!memcache [0|1]  - get/set caching of memory reads while stopped\n"
 			" R!pktsz           - get max packet size used\n"
 			" R!pktsz bytes     - set max. packet size as 'bytes' bytes\n"
 			" R!exec_file [pid] - get file which was executed for"
@@ -259,6 +261,8 @@ static char *__system(RzIO *io, RzIODesc *fd, const char *cmd) {
 		if (!gdbr_lock_enter(desc)) {
 			goto gdb_lock_leave;
 		}
+		// the packet may resume the target or write to it
+		gdbr_invalidate_mem_cache(desc);
 		if (send_msg(desc, cmd + 4) >= 0) {
 			(void)read_packet(desc, false);
 			desc->data[desc->data_len] = '\0';
@@ -300,6 +304,7 @@ static char *__system(RzIO *io, RzIODesc *fd, const char *cmd) {
 				}
 			}
 			gdbr_invalidate_reg_cache();
+			gdbr_invalidate_mem_cache(desc);
 		}
 		goto gdb_lock_leave;
 	}
@@ -324,6 +329,7 @@ static char *__system(RzIO *io, RzIODesc *fd, const char *cmd) {
 				}
 			}
 			gdbr_invalidate_reg_cache();
+			gdbr_invalidate_mem_cache(desc);
 		}
 		goto gdb_lock_leave;
 	}
@@ -349,6 +355,20 @@ static char *__system(RzIO *io, RzIODesc *fd, const char *cmd) {
 		gdbr_invalidate_reg_cache();
 		return NULL;
 	}
+	if (rz_str_startswith(cmd, "inv.mem")) {
+		gdbr_invalidate_mem_cache(desc);
+		return NULL;
+	}
+	if (rz_str_startswith(cmd, "memcache")) {
+		const char *ptr = rz_str_trim_head_ro(cmd + 8);
+		if (!*ptr) {
+			io->cb_printf("%d\n", desc->mem_cache.enabled);
+			return NULL;
+		}
+		desc->mem_cache.enabled = rz_str_is_true(ptr);
+		gdbr_invalidate_mem_cache(desc);
+		return NULL;
+	}
 	if (rz_str_startswith(cmd, "exec_file")) {
 		const char *ptr = cmd + strlen("exec_file");
 		char *file;
@@ -14,6 +14,9 @@
 #include <sys/types.h>
 #include <sys/wait.h>
 #include <errno.h>
+#if HAVE_PROCESS_VM_READV
+#include <sys/uio.h>
+#endif
 
 typedef struct {
 	int pid;
@@ -81,11 +84,10 @@ static int debug_os_read_at(RzIO *io, int pid, ut32 *buf, int sz, ut64 addr) {
 	return sz;
 }
 
-static int __read(RzIO *io, RzIODesc *desc, ut8 *buf, int len) {
+static int ptrace_read_at(RzIO *io, RzIODesc *desc, ut64 addr, ut8 *buf, int len) {
 #if USE_PROC_PID_MEM
 	int ret, fd;
 #endif
-	ut64 addr = io->off;
 	if (!desc || !desc->data) {
 		return -1;
 	}
@@ -127,6 +129,62 @@ static int __read(RzIO *io, RzIODesc *desc, ut8 *buf, int len) {
 	return -1;
 }
 
+static int __read(RzIO *io, RzIODesc *desc, ut8 *buf, int len) {
+	return ptrace_read_at(io, desc, io->off, buf, len);
+}
+
+#if HAVE_PROCESS_VM_READV
+/*
+ * process_vm_readv() reads any number of ranges with a single syscall instead
+ * of one PTRACE_PEEKTEXT per word. It stops at the first range it cannot read
+ * completely (unmapped or not readable pages, which ptrace may still be able to
+ * peek), so the rest of that fragment is read with ptrace and the following
+ * fragments with another process_vm_readv().
+ */
+static bool __readv_at(RzIO *io, RzIODesc *desc, RzIOReadVec *vec, size_t count) {
+	if (!desc || !desc->data) {
+		return false;
+	}
+	struct iovec local[16];
+	struct iovec remote[16];
+	size_t i = 0;
+	while (i < count) {
+		size_t n = RZ_MIN(count - i, RZ_ARRAY_SIZE(local));
+		for (size_t j = 0; j < n; j++) {
+			local[j].iov_base = vec[i + j].buf;
+			local[j].iov_len = vec[i + j].len;
+			remote[j].iov_base = (void *)(size_t)vec[i + j].addr;
+			remote[j].iov_len = vec[i + j].len;
+		}
+		ssize_t r = process_vm_readv(RzIOPTRACE_PID(desc), local, n, remote, n, 0);
+		if (r < 0) {
+			r = 0;
+		}
+		size_t end = i + n;
+		while (i < end) {
+			RzIOReadVec *v = &vec[i++];
+			int got = (int)RZ_MIN(r, v->len);
+			r -= got;
+			v->ret = got;
+			if (got < v->len) {
+				int rest = ptrace_read_at(io, desc, v->addr + got, v->buf + got, v->len - got);
+				v->ret = rest > 0 ? got + rest : (got ? got : rest);
+				break;
+			}
+		}
+	}
+	return true;
+}
+
+static int __read_at(RzIO *io, RzIODesc *desc, ut64 addr, ut8 *buf, int len) {
+	RzIOReadVec vec = { .addr = addr, .buf = buf, .len = len };
+	if (!__readv_at(io, desc, &vec, 1)) {
+		return -1;
+	}
+	return vec.ret;
+}
+#endif
+
 static int ptrace_write_at(RzIO *io, int pid, const ut8 *pbuf, int sz, ut64 addr) {
 	ptrace_word *buf = (ptrace_word *)pbuf;
 	ut32 words = sz / sizeof(ptrace_word);
@@ -349,6 +407,10 @@ RzIOPlugin rz_io_plugin_ptrace = {
 	.open = __open,
 	.close = __close,
 	.read = __read,
+#if HAVE_PROCESS_VM_READV
+	.read_at = __read_at,
+	.readv_at = __readv_at,
+#endif
 	.check = __plugin_open,
 	.lseek = __lseek,
 	.system = __system,
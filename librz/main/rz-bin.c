@@ -153,7 +153,8 @@ static ut32 actions2mask(ut64 action) {
 static int rabin_show_help(int v) {
 	printf("Usage: rz-bin [-AcdeEghHiIjlLMqrRsSUvVxzZ] [-@ at] [-a arch] [-b bits] [-B addr]\n"
 	       "              [-C F:C:D] [-f str] [-m addr] [-n str] [-N m:M] [-P[-P] pdb]\n"
-	       "              [-o str] [-O str] [-k query] [-D lang symname] file\n");
+	       "              [-o str] [-O str] [-k query] [-t n] [-W list|dir]\n"
+	       "              [-D lang symname] file\n");
 	if (v) {
 		printf(
 			" -@ [addr]       show section, symbol or import at addr\n"
@@ -195,6 +196,7 @@ static int rabin_show_help(int v) {
 			" -qq             show less info (no offset/size for -z for ex.)\n"
 			" -Q              show load address used by dlopen (non-aslr libs)\n"
 			" -r              rizin output\n"
+			" -t [n]          number of worker threads for -W (0 for all the cores)\n"
 			" -R              relocations\n"
 			" -s              symbols\n"
 			" -S              sections\n"
@@ -206,6 +208,7 @@ static int rabin_show_help(int v) {
 			" -v              display version and quit\n"
 			" -V              Show binary version information\n"
 			" -w              display try/catch blocks\n"
+			" -W [list|dir]   batch mode, one json line per file of list (- for stdin) or dir (see -IisKz)\n"
 			" -x              extract bins contained in file\n"
 			" -X [fmt] [f] .. package in fat or zip the given files and bins contained in file\n"
 			" -Y [fw file]    calculates all the possibles base address candidates of a firmware bin\n"
@@ -670,6 +673,366 @@ static void print_string(RzBinFile *bf, RzBinString *string, PJ *pj, int mode) {
 	}
 }
 
+#define BATCH_MAX_DEPTH 32
+
+typedef struct {
+	ut64 action; ///< RZ_BIN_REQ_* to report for every file
+	RzList /*<char *>*/ *hashes; ///< algorithms to hash the whole files with, may be NULL
+	RzBin *bin; ///< settings the bins of the workers are configured with
+	RzBinObjectLoadOptions obj_opts;
+	const char *forcebin;
+	bool rawstr;
+	RzThreadQueue *queue; ///< paths left to process
+	RzThreadLock *lock; ///< serializes the output lines
+	RzAtomicBool *failed;
+} RzBinBatch;
+
+static bool batch_collect(RzList /*<char *>*/ *files, const char *path, int depth) {
+	if (!rz_file_is_directory(path)) {
+		return rz_list_append(files, strdup(path)) != NULL;
+	}
+	if (depth < 1) {
+		RZ_LOG_WARN("rz-bin: skipping '%s', too deep\n", path);
+		return true;
+	}
+	RzList *dir = rz_sys_dir(path);
+	if (!dir) {
+		RZ_LOG_ERROR("rz-bin: cannot list directory '%s'\n", path);
+		return false;
+	}
+	rz_list_sort(dir, (RzListComparator)strcmp);
+	bool ok = true;
+	RzListIter *it;
+	const char *name;
+	rz_list_foreach (dir, it, name) {
+		if (!strcmp(name, ".") || !strcmp(name, "..")) {
+			continue;
+		}
+		char *sub = rz_file_path_join(path, name);
+		if (!sub) {
+			ok = false;
+			break;
+		}
+		ok = batch_collect(files, sub, depth - 1);
+		free(sub);
+		if (!ok) {
+			break;
+		}
+	}
+	rz_list_free(dir);
+	return ok;
+}
+
+/**
+ * Returns the files listed in \p src: a directory is recursed, any other
+ * path is read as a list of files, one per line ("-" for stdin).
+ */
+static RzList /*<char *>*/ *batch_files(const char *src) {
+	RzList *files = rz_list_newf(free);
+	if (!files) {
+		return NULL;
+	}
+	if (rz_file_is_directory(src)) {
+		if (!batch_collect(files, src, BATCH_MAX_DEPTH)) {
+			rz_list_free(files);
+			return NULL;
+		}
+		return files;
+	}
+	char *content = NULL;
+	if (!strcmp(src, "-")) {
+		int len = 0;
+		content = rz_stdin_slurp(&len);
+	} else {
+		content = rz_file_slurp(src, NULL);
+	}
+	if (!content) {
+		RZ_LOG_ERROR("rz-bin: cannot read the file list '%s'\n", src);
+		rz_list_free(files);
+		return NULL;
+	}
+	RzList *lines = rz_str_split_duplist(content, "\n", true);
+	free(content);
+	RzListIter *it;
+	char *line;
+	rz_list_foreach (lines, it, line) {
+		if (RZ_STR_ISNOTEMPTY(line)) {
+			rz_list_append(files, strdup(line));
+		}
+	}
+	rz_list_free(lines);
+	return files;
+}
+
+static RzBin *batch_bin_new(RzBinBatch *batch, RzIO *io) {
+	RzBin *bin = rz_bin_new();
+	if (!bin) {
+		return NULL;
+	}
+	rz_io_bind(io, &bin->iob);
+	RzBin *cfg = batch->bin;
+	bin->filter = cfg->filter;
+	bin->minstrlen = cfg->minstrlen;
+	bin->maxstrlen = cfg->maxstrlen;
+	bin->maxstrbuf = cfg->maxstrbuf;
+	bin->debase64 = cfg->debase64;
+	bin->strfilter = cfg->strfilter;
+	// borrowed from the main bin, see batch_bin_free()
+	bin->strpurge = cfg->strpurge;
+	bin->prefix = cfg->prefix;
+	bin->strenc = cfg->strenc ? strdup(cfg->strenc) : NULL;
+	rz_bin_set_cache_dir(bin, cfg->cache_dir);
+	rz_bin_force_plugin(bin, batch->forcebin);
+	rz_bin_load_filter(bin, batch->action);
+	return bin;
+}
+
+static void batch_bin_free(RzBin *bin) {
+	bin->strpurge = NULL;
+	bin->prefix = NULL;
+	rz_bin_free(bin);
+}
+
+static ut64 batch_hash_update(const ut8 *buf, ut64 size, void *user) {
+	return rz_hash_cfg_update((RzHashCfg *)user, buf, size) ? size : 0;
+}
+
+static void batch_print_hashes(RzBin *bin, RzBinFile *bf, RzList /*<char *>*/ *hashes, PJ *pj) {
+	RzHashCfg *md = rz_hash_cfg_new(bin->hash);
+	if (!md) {
+		return;
+	}
+	RzListIter *it;
+	const char *algo;
+	rz_list_foreach (hashes, it, algo) {
+		if (!rz_hash_cfg_configure(md, algo)) {
+			RZ_LOG_WARN("rz-bin: unknown hash algorithm '%s'\n", algo);
+		}
+	}
+	ut64 size = rz_buf_size(bf->buf);
+	if (!rz_hash_cfg_init(md) ||
+		rz_buf_fwd_scan(bf->buf, 0, size, batch_hash_update, md) != size ||
+		!rz_hash_cfg_final(md)) {
+		rz_hash_cfg_free(md);
+		return;
+	}
+	pj_ko(pj, "hashes");
+	rz_list_foreach (hashes, it, algo) {
+		char *digest = rz_hash_cfg_get_result_string(md, algo, NULL, false);
+		if (digest) {
+			pj_ks(pj, algo, digest);
+			free(digest);
+		}
+	}
+	pj_end(pj);
+	rz_hash_cfg_free(md);
+}
+
+static void batch_print_info(RzBinFile *bf, PJ *pj) {
+	const RzBinInfo *info = rz_bin_object_get_info(bf->o);
+	pj_ko(pj, "info");
+	pj_ks(pj, "format", bf->o->plugin ? bf->o->plugin->name : "");
+	pj_kN(pj, "size", rz_buf_size(bf->buf));
+	if (info) {
+		pj_ks(pj, "arch", rz_str_get(info->arch));
+		pj_ki(pj, "bits", info->bits);
+		pj_ks(pj, "machine", rz_str_get(info->machine));
+		pj_ks(pj, "os", rz_str_get(info->os));
+		pj_ks(pj, "type", rz_str_get(info->type));
+		pj_ks(pj, "class", rz_str_get(info->bclass));
+		pj_ks(pj, "lang", rz_str_get(info->lang));
+		pj_ks(pj, "endian", info->big_endian ? "big" : "little");
+		pj_kn(pj, "baddr", rz_bin_file_get_baddr(bf));
+		pj_kb(pj, "pic", info->has_pi);
+		pj_kb(pj, "nx", info->has_nx);
+		pj_kb(pj, "canary", info->has_canary);
+		pj_kb(pj, "stripped", RZ_BIN_DBG_STRIPPED & info->dbg_info);
+	}
+	pj_end(pj);
+}
+
+static void batch_print_symbols(RzBinFile *bf, PJ *pj) {
+	const RzList *symbols = rz_bin_object_get_symbols(bf->o);
+	RzListIter *it;
+	RzBinSymbol *symbol;
+	pj_ka(pj, "symbols");
+	rz_list_foreach (symbols, it, symbol) {
+		pj_o(pj);
+		pj_ks(pj, "name", rz_str_get(symbol->name));
+		if (symbol->dname) {
+			pj_ks(pj, "demname", symbol->dname);
+		}
+		pj_ks(pj, "bind", rz_str_get(symbol->bind));
+		pj_ks(pj, "type", rz_str_get(symbol->type));
+		pj_kn(pj, "size", symbol->size);
+		pj_kn(pj, "vaddr", symbol->vaddr);
+		pj_kn(pj, "paddr", symbol->paddr);
+		pj_kb(pj, "is_imported", symbol->is_imported);
+		pj_end(pj);
+	}
+	pj_end(pj);
+}
+
+static void batch_print_imports(RzBinFile *bf, PJ *pj) {
+	const RzList *imports = rz_bin_object_get_imports(bf->o);
+	RzListIter *it;
+	RzBinImport *import;
+	pj_ka(pj, "imports");
+	rz_list_foreach (imports, it, import) {
+		pj_o(pj);
+		pj_ki(pj, "ordinal", import->ordinal);
+		pj_ks(pj, "name", rz_str_get(import->name));
+		pj_ks(pj, "bind", rz_str_get(import->bind));
+		pj_ks(pj, "type", rz_str_get(import->type));
+		if (import->libname) {
+			pj_ks(pj, "libname", import->libname);
+		}
+		pj_end(pj);
+	}
+	pj_end(pj);
+}
+
+static void batch_print_strings(RzBinBatch *batch, RzBin *bin, RzBinFile *bf, PJ *pj) {
+	RzListIter *it;
+	RzBinString *string;
+	pj_ka(pj, "strings");
+	if (batch->rawstr) {
+		RzList *list = rz_bin_file_strings(bf, bin->minstrlen, true);
+		rz_list_foreach (list, it, string) {
+			print_string(bf, string, pj, RZ_MODE_JSON);
+		}
+		rz_list_free(list);
+	} else {
+		const RzList *list = rz_bin_object_get_strings(bf->o);
+		rz_list_foreach (list, it, string) {
+			print_string(bf, string, pj, RZ_MODE_JSON);
+		}
+	}
+	pj_end(pj);
+}
+
+/**
+ * Loads \p file in \p bin and returns its json line; the file is unloaded
+ * again before returning, so a worker never keeps more than one file.
+ */
+static char *batch_process(RzBinBatch *batch, RzBin *bin, const char *file) {
+	PJ *pj = pj_new();
+	if (!pj) {
+		return NULL;
+	}
+	pj_o(pj);
+	pj_ks(pj, "file", file);
+
+	RzBinOptions bo;
+	rz_bin_options_init(&bo, -1, UT64_MAX, 0, false);
+	bo.obj_opts = batch->obj_opts;
+	RzBinFile *bf = rz_bin_open(bin, file, &bo);
+	if (!bf || !bf->o) {
+		pj_ks(pj, "error", "cannot open file");
+		rz_atomic_bool_set(batch->failed, true);
+		goto end;
+	}
+	if (batch->action & RZ_BIN_REQ_INFO) {
+		batch_print_info(bf, pj);
+	}
+	if (batch->hashes) {
+		batch_print_hashes(bin, bf, batch->hashes, pj);
+	}
+	if (batch->action & RZ_BIN_REQ_IMPORTS) {
+		batch_print_imports(bf, pj);
+	}
+	if (batch->action & RZ_BIN_REQ_SYMBOLS) {
+		batch_print_symbols(bf, pj);
+	}
+	if (batch->action & RZ_BIN_REQ_STRINGS || batch->rawstr) {
+		batch_print_strings(batch, bin, bf, pj);
+	}
+
+end:
+	if (bf) {
+		rz_bin_file_delete(bin, bf);
+	}
+	if (bo.fd >= 0) {
+		bin->iob.fd_close(bin->iob.io, bo.fd);
+	}
+	pj_end(pj);
+	return pj_drain(pj);
+}
+
+static void *batch_worker(RzBinBatch *batch) {
+	RzIO *io = rz_io_new();
+	RzBin *bin = io ? batch_bin_new(batch, io) : NULL;
+	if (!bin) {
+		rz_io_free(io);
+		return NULL;
+	}
+	char *file;
+	while ((file = rz_th_queue_pop(batch->queue, false))) {
+		char *line = batch_process(batch, bin, file);
+		if (line) {
+			rz_th_lock_enter(batch->lock);
+			printf("%s\n", line);
+			fflush(stdout);
+			rz_th_lock_leave(batch->lock);
+			free(line);
+		}
+		free(file);
+	}
+	batch_bin_free(bin);
+	rz_io_free(io);
+	return NULL;
+}
+
+/**
+ * Batch mode (-W): every file of \p src is loaded by a pool of workers, each
+ * one keeping its own RzBin across files, and reported on its own json line
+ * (in completion order) with the requested info, symbols, imports, strings
+ * and hashes.
+ */
+static int rabin_batch(RzBinBatch *batch, const char *src, size_t n_threads) {
+	if (batch->action & ~(RZ_BIN_REQ_INFO | RZ_BIN_REQ_SYMBOLS | RZ_BIN_REQ_IMPORTS | RZ_BIN_REQ_STRINGS)) {
+		RZ_LOG_WARN("rz-bin: only -I, -s, -i, -z and -K are supported in batch mode\n");
+	}
+	RzList *files = batch_files(src);
+	if (!files) {
+		return 1;
+	}
+	RzThreadPool *pool = rz_th_pool_new(n_threads);
+	batch->queue = rz_th_queue_new2(files);
+	batch->lock = rz_th_lock_new(false);
+	batch->failed = rz_atomic_bool_new(false);
+	if (!pool || !batch->queue || !batch->lock || !batch->failed) {
+		if (!batch->queue) {
+			rz_list_free(files);
+		}
+		rz_th_queue_free(batch->queue);
+		rz_th_lock_free(batch->lock);
+		rz_atomic_bool_free(batch->failed);
+		rz_th_pool_free(pool);
+		return 1;
+	}
+
+	size_t pool_size = rz_th_pool_size(pool);
+	RZ_LOG_VERBOSE("rz-bin: using %u threads\n", (ut32)pool_size);
+	for (size_t i = 0; i < pool_size; ++i) {
+		RzThread *th = rz_th_new((RzThreadFunction)batch_worker, batch);
+		if (!th || !rz_th_pool_add_thread(pool, th)) {
+			rz_th_free(th);
+			break;
+		}
+	}
+	rz_th_pool_wait(pool);
+	// any file left in the queue (i.e. no thread could be started) is handled here.
+	batch_worker(batch);
+
+	int result = rz_atomic_bool_get(batch->failed) ? 1 : 0;
+	rz_th_pool_free(pool);
+	rz_th_queue_free(batch->queue);
+	rz_th_lock_free(batch->lock);
+	rz_atomic_bool_free(batch->failed);
+	return result;
+}
+
 RZ_API int rz_main_rz_bin(int argc, const char **argv) {
 	RzBin *bin = NULL;
 	const char *name = NULL;
@@ -688,6 +1051,8 @@ RZ_API int rz_main_rz_bin(int argc, const char **argv) {
 	const char *forcebin = NULL;
 	const char *chksum = NULL;
 	const char *op = NULL;
+	const char *batch_src = NULL;
+	size_t batch_threads = 0;
 	RzCoreFile *fh = NULL;
 	RzCoreBinFilter filter;
 	int xtr_idx = 0; // load all files if extraction is necessary.
@@ -770,7 +1135,7 @@ RZ_API int rz_main_rz_bin(int argc, const char **argv) {
 	}
 #define unset_action(x) action &= ~x
 	RzGetopt opt;
-	rz_getopt_init(&opt, argc, argv, "DjgAf:F:a:B:G:b:cC:k:K:dD:Mm:n:N:@:isSVIHeEUlRwO:o:pPqQrTvLhuxYXzZ");
+	rz_getopt_init(&opt, argc, argv, "DjgAf:F:a:B:G:b:cC:k:K:dD:Mm:n:N:@:isSVIHeEUlRwO:o:pPqQrt:TvLhuW:xYXzZ");
 	while ((c = rz_getopt_next(&opt)) != -1) {
 		switch (c) {
 		case 'g':
@@ -911,6 +1276,8 @@ RZ_API int rz_main_rz_bin(int argc, const char **argv) {
 		case 'o': output = opt.arg; break;
 		case 'p': core.io->va = false; break;
 		case 'r': out_mode = RZ_MODE_RIZINCMD; break;
+		case 't': batch_threads = rz_num_math(NULL, opt.arg); break;
+		case 'W': batch_src = opt.arg; break;
 		case 'v':
 			rz_core_fini(&core);
 			return rz_main_version_print("rz-bin");
@@ -1019,6 +1386,31 @@ RZ_API int rz_main_rz_bin(int argc, const char **argv) {
 		rz_core_fini(&core);
 		return ret_num;
 	}
+	if (batch_src) {
+		RzBinBatch batch = {
+			.action = action,
+			.bin = bin,
+			.forcebin = forcebin,
+			.rawstr = rawstr,
+		};
+		batch.obj_opts.elf_load_sections = rz_config_get_b(core.config, "elf.load.sections");
+		batch.obj_opts.elf_checks_sections = rz_config_get_b(core.config, "elf.checks.sections");
+		batch.obj_opts.elf_checks_segments = rz_config_get_b(core.config, "elf.checks.segments");
+		batch.obj_opts.big_endian = rz_config_get_b(core.config, "cfg.bigendian");
+		bin->minstrlen = rz_config_get_i(core.config, "bin.minstr");
+		bin->maxstrlen = rz_config_get_i(core.config, "bin.maxstr");
+		bin->maxstrbuf = rz_config_get_i(core.config, "bin.maxstrbuf");
+		if (RZ_STR_ISNOTEMPTY(chksum)) {
+			batch.hashes = rz_str_split_duplist_n(chksum, ",", 0, true);
+		}
+		if (action == RZ_BIN_REQ_UNK && !batch.hashes && !rawstr) {
+			batch.action = RZ_BIN_REQ_INFO;
+		}
+		result = rabin_batch(&batch, batch_src, batch_threads);
+		rz_list_free(batch.hashes);
+		rz_core_fini(&core);
+		return result;
+	}
 	file = argv[opt.ind];
 
 	if (file && !*file) {
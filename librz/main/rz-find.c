@@ -29,6 +29,8 @@ typedef struct {
 	int mode;
 	int align;
 	ut8 *buf;
+	const ut8 *block; ///< bytes being searched, either buf or borrowed from the io
+	ut64 blocklen; ///< number of valid bytes in block
 	ut64 bsize;
 	ut64 from;
 	ut64 to;
@@ -62,7 +64,7 @@ static int hit(RzSearchKeyword *kw, void *user, ut64 addr) {
 		// This case occurs when there is hit in search left over
 		delta = ro->cur - addr;
 	}
-	if (delta < 0 || delta >= ro->bsize) {
+	if (delta < 0 || delta >= ro->blocklen) {
 		eprintf("Invalid delta\n");
 		return 0;
 	}
@@ -73,8 +75,8 @@ static int hit(RzSearchKeyword *kw, void *user, ut64 addr) {
 		if (ro->widestr) {
 			str = _str;
 			int i, j = 0;
-			for (i = delta; ro->buf[i] && i < sizeof(_str); i++) {
-				char ch = ro->buf[i];
+			for (i = delta; i < ro->blocklen && ro->block[i] && i < sizeof(_str); i++) {
+				char ch = ro->block[i];
 				if (ch == '"' || ch == '\\') {
 					ch = '\'';
 				}
@@ -88,15 +90,15 @@ static int hit(RzSearchKeyword *kw, void *user, ut64 addr) {
 					j += 3;
 					break;
 				}
-				if (ro->buf[i]) {
+				if (i >= ro->blocklen || ro->block[i]) {
 					break;
 				}
 			}
 			str[j] = 0;
 		} else {
 			size_t i;
-			for (i = 0; i < sizeof(_str) - 1; i++) {
-				char ch = ro->buf[delta + i];
+			for (i = 0; i < sizeof(_str) - 1 && delta + i < ro->blocklen; i++) {
+				char ch = ro->block[delta + i];
 				if (ch == '"' || ch == '\\') {
 					ch = '\'';
 				}
@@ -109,8 +111,8 @@ static int hit(RzSearchKeyword *kw, void *user, ut64 addr) {
 		}
 	} else {
 		size_t i;
-		for (i = 0; i < sizeof(_str) - 1; i++) {
-			char ch = ro->buf[delta + i];
+		for (i = 0; i < sizeof(_str) - 1 && delta + i < ro->blocklen; i++) {
+			char ch = ro->block[delta + i];
 			if (ch == '"' || ch == '\\') {
 				ch = '\'';
 			}
@@ -134,7 +136,7 @@ static int hit(RzSearchKeyword *kw, void *user, ut64 addr) {
 		} else {
 			printf("0x%" PFMT64x "\n", addr);
 			if (ro->pr) {
-				char *dump = rz_print_hexdump_str(ro->pr, addr, (ut8 *)ro->buf + delta, 78, 16, 1, 1);
+				char *dump = rz_print_hexdump_str(ro->pr, addr, (ut8 *)ro->block + delta, RZ_MIN(78, ro->blocklen - delta), 16, 1, 1);
 				printf("%s", dump);
 				free(dump);
 			}
@@ -403,7 +405,13 @@ static int rzfind_open_file(RzfindOptions *ro, const char *file, const ut8 *data
 			bsize = to - ro->cur;
 			last = true;
 		}
-		ret = rz_io_pread_at(io, ro->cur, ro->buf, bsize);
+		ro->block = rz_io_desc_borrow_at(io->desc, ro->cur, bsize);
+		if (ro->block) {
+			ret = bsize;
+		} else {
+			ro->block = ro->buf;
+			ret = rz_io_pread_at(io, ro->cur, ro->buf, bsize);
+		}
 		if (ret == 0) {
 			if (ro->nonstop) {
 				continue;
@@ -415,7 +423,8 @@ static int rzfind_open_file(RzfindOptions *ro, const char *file, const ut8 *data
 			bsize = ret;
 		}
 
-		if (rz_search_update(rs, ro->cur, ro->buf, ret) == -1) {
+		ro->blocklen = RZ_MAX(ret, 0);
+		if (rz_search_update(rs, ro->cur, ro->block, ret) == -1) {
 			eprintf("search: update read error at 0x%08" PFMT64x "\n", ro->cur);
 			break;
 		}
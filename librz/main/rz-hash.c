@@ -799,6 +799,20 @@ static RzList /*<char *>*/ *parse_hash_algorithms(RzHashContext *ctx) {
 	return rz_str_split_list(ctx->algorithm, ",", 0);
 }
 
+/**
+ * Returns the \p len bytes at \p paddr of the current desc, straight from the
+ * file mapping when possible or read into \p block otherwise.
+ */
+static const ut8 *hash_read_block(RzIO *io, ut64 paddr, ut8 *block, int len, int *read) {
+	const ut8 *data = rz_io_desc_borrow_at(io->desc, paddr, len);
+	if (data) {
+		*read = len;
+		return data;
+	}
+	*read = rz_io_pread_at(io, paddr, block, len);
+	return block;
+}
+
 static bool calculate_hash(RzHashContext *ctx, RzIO *io, const char *filename) {
 	bool result = false;
 	const char *algorithm;
@@ -873,8 +887,9 @@ static bool calculate_hash(RzHashContext *ctx, RzIO *io, const char *filename) {
 		}
 
 		for (ut64 j = ctx->offset.from; j < to; j += bsize) {
-			int read = rz_io_pread_at(io, j, block, to - j > bsize ? bsize : (to - j));
-			if (!rz_hash_cfg_update(md, block, read)) {
+			int read;
+			const ut8 *data = hash_read_block(io, j, block, to - j > bsize ? bsize : (to - j), &read);
+			if (!rz_hash_cfg_update(md, data, read)) {
 				goto calculate_hash_end;
 			}
 		}
@@ -907,9 +922,10 @@ static bool calculate_hash(RzHashContext *ctx, RzIO *io, const char *filename) {
 	} else if (ctx->show_blocks) {
 		ut64 to = ctx->offset.to ? ctx->offset.to : filesize;
 		for (ut64 j = ctx->offset.from; j < to; j += bsize) {
-			int read = rz_io_pread_at(io, j, block, to - j > bsize ? bsize : (to - j));
+			int read;
+			const ut8 *data = hash_read_block(io, j, block, to - j > bsize ? bsize : (to - j), &read);
 			if (!rz_hash_cfg_init(md) ||
-				!rz_hash_cfg_update(md, block, read) ||
+				!rz_hash_cfg_update(md, data, read) ||
 				!rz_hash_cfg_final(md) ||
 				!rz_hash_cfg_iterate(md, ctx->iterate)) {
 				goto calculate_hash_end;
@@ -938,8 +954,9 @@ static bool calculate_hash(RzHashContext *ctx, RzIO *io, const char *filename) {
 		}
 
 		for (ut64 j = ctx->offset.from; j < to; j += bsize) {
-			int read = rz_io_pread_at(io, j, block, to - j > bsize ? bsize : (to - j));
-			if (!rz_hash_cfg_update(md, block, read)) {
+			int read;
+			const ut8 *data = hash_read_block(io, j, block, to - j > bsize ? bsize : (to - j), &read);
+			if (!rz_hash_cfg_update(md, data, read)) {
 				goto calculate_hash_end;
 			}
 		}
@@ -10,6 +10,8 @@
 
 RZ_LIB_VERSION(rz_search);
 
+static void kw_index_free(RzSearchKwIndex *index);
+
 typedef struct {
 	ut64 end;
 	int len;
@@ -55,6 +57,7 @@ RZ_API RzSearch *rz_search_free(RzSearch *s) {
 	}
 	rz_list_free(s->hits);
 	rz_list_free(s->kws);
+	kw_index_free(s->kw_index);
 	// rz_io_free(s->iob.io); this is supposed to be a weak reference
 	free(s->data);
 	free(s);
@@ -135,6 +138,8 @@ RZ_API int rz_search_begin(RzSearch *s) {
 		kw->count = 0;
 		kw->last = 0;
 	}
+	// keywords may have been changed, the index is built again on the first update
+	RZ_FREE_CUSTOM(s->kw_index, kw_index_free);
 	return true;
 }
 
@@ -390,6 +395,202 @@ static bool brute_force_match(RzSearch *s, RzSearchKeyword *kw, const ut8 *buf,
 	return j == kw->keyword_length;
 }
 
+/*
+ * Multi-keyword prefilter
+ *
+ * Matching every keyword at every offset costs O(keywords * bytes). Instead,
+ * the keywords are indexed by all the values their first two bytes can match
+ * (taking binmask and icase into account), and a single pass over the block
+ * collects the candidate offsets of each keyword. The keywords are then still
+ * matched one after another in list order, but only at their candidates, so
+ * the hits are reported exactly like without the index.
+ */
+
+#define KW_INDEX_BUCKETS (UT16_MAX + 1)
+// keywords whose first two bytes can match more values are always matched at every offset
+#define KW_INDEX_MAX_KEYS 256
+// the index only pays off when there is more than one keyword to match
+#define KW_INDEX_MIN_KWS 2
+
+typedef struct {
+	bool indexed;
+	RzVector /*<ut32>*/ cands; ///< candidate offsets in the leftover, then in the block
+	ut32 n_left; ///< number of candidates in the leftover
+} KwCandidates;
+
+struct rz_search_kw_index_t {
+	ut32 *buckets; ///< KW_INDEX_BUCKETS + 1 offsets into entries, NULL if the index is not used
+	ut32 *entries; ///< indices into kws, bucketed by the value of the first two bytes
+	KwCandidates *kws; ///< one for each keyword of the search, in list order
+	ut32 n_kws;
+};
+
+static void kw_index_free(RzSearchKwIndex *index) {
+	if (!index) {
+		return;
+	}
+	for (ut32 i = 0; i < index->n_kws; i++) {
+		rz_vector_fini(&index->kws[i].cands);
+	}
+	free(index->kws);
+	free(index->buckets);
+	free(index->entries);
+	free(index);
+}
+
+// Same as brute_force_match() for a single byte, without distance
+static bool kw_byte_matches(RzSearchKeyword *kw, ut32 j, ut8 a) {
+	ut8 b = kw->bin_keyword[j];
+	if (kw->binmask_length > 0) {
+		ut8 m = kw->bin_binmask[j % kw->binmask_length];
+		if (kw->icase) {
+			a = tolower(a);
+			b = tolower(b);
+		}
+		return (a & m) == (b & m);
+	}
+	if (kw->icase) {
+		return tolower(a) == tolower(b);
+	}
+	return a == b;
+}
+
+// Fills vals with the bytes matching the byte j of kw, returns their count
+static ut32 kw_byte_values(RzSearchKeyword *kw, ut32 j, ut8 vals[256]) {
+	ut32 n = 0;
+	for (ut32 a = 0; a < 256; a++) {
+		if (kw_byte_matches(kw, j, a)) {
+			vals[n++] = a;
+		}
+	}
+	return n;
+}
+
+static RzSearchKwIndex *kw_index_new(RzSearch *s) {
+	RzSearchKwIndex *index = RZ_NEW0(RzSearchKwIndex);
+	if (!index) {
+		return NULL;
+	}
+	index->n_kws = rz_list_length(s->kws);
+	index->kws = RZ_NEWS0(KwCandidates, index->n_kws);
+	index->buckets = RZ_NEWS0(ut32, KW_INDEX_BUCKETS + 1);
+	if (!index->kws || !index->buckets) {
+		goto err;
+	}
+	ut8 vals0[256], vals1[256];
+	RzListIter *iter;
+	RzSearchKeyword *kw;
+	ut32 n = 0, n_indexed = 0, n_entries = 0;
+	// first pass, count the keys of each bucket
+	rz_list_foreach (s->kws, iter, kw) {
+		KwCandidates *kc = &index->kws[n++];
+		rz_vector_init(&kc->cands, sizeof(ut32), NULL, NULL);
+		if (kw->keyword_length < 2) {
+			continue;
+		}
+		ut32 n0 = kw_byte_values(kw, 0, vals0);
+		ut32 n1 = kw_byte_values(kw, 1, vals1);
+		if (n0 * n1 > KW_INDEX_MAX_KEYS) {
+			continue;
+		}
+		for (ut32 i = 0; i < n0; i++) {
+			for (ut32 j = 0; j < n1; j++) {
+				index->buckets[vals0[i] | vals1[j] << 8]++;
+			}
+		}
+		kc->indexed = true;
+		n_indexed++;
+		n_entries += n0 * n1;
+	}
+	if (n_indexed < KW_INDEX_MIN_KWS) {
+		// remember the index is useless for these keywords, instead of building it for each block
+		RZ_FREE(index->buckets);
+		return index;
+	}
+	index->entries = RZ_NEWS(ut32, n_entries);
+	if (!index->entries) {
+		goto err;
+	}
+	// turn the counts into the end of each bucket, then fill them backwards
+	for (ut32 i = 1; i <= KW_INDEX_BUCKETS; i++) {
+		index->buckets[i] += index->buckets[i - 1];
+	}
+	n = 0;
+	rz_list_foreach (s->kws, iter, kw) {
+		KwCandidates *kc = &index->kws[n];
+		if (kc->indexed) {
+			ut32 n0 = kw_byte_values(kw, 0, vals0);
+			ut32 n1 = kw_byte_values(kw, 1, vals1);
+			for (ut32 i = 0; i < n0; i++) {
+				for (ut32 j = 0; j < n1; j++) {
+					index->entries[--index->buckets[vals0[i] | vals1[j] << 8]] = n;
+				}
+			}
+		}
+		n++;
+	}
+	return index;
+err:
+	kw_index_free(index);
+	return NULL;
+}
+
+// Appends the offsets < end of data where each keyword may match to its candidates
+static void kw_index_scan(RzSearchKwIndex *index, const ut8 *data, int end) {
+	for (ut32 i = 0; i + 1 < (ut32)end; i++) {
+		ut16 key = data[i] | data[i + 1] << 8;
+		for (ut32 e = index->buckets[key]; e < index->buckets[key + 1]; e++) {
+			rz_vector_push(&index->kws[index->entries[e]].cands, &i);
+		}
+	}
+}
+
+/**
+ * Collects the candidates of all the keywords in the leftover and the block.
+ * Returns NULL if the keywords must be matched at every offset.
+ */
+static RzSearchKwIndex *kw_index_update(RzSearch *s, const ut8 *left, int left_end, const ut8 *buf, int len) {
+	if (s->inverse || s->distance) {
+		// hits are not limited to matching offsets
+		return NULL;
+	}
+	if (!s->kw_index) {
+		s->kw_index = kw_index_new(s);
+		if (!s->kw_index) {
+			return NULL;
+		}
+	}
+	RzSearchKwIndex *index = s->kw_index;
+	if (!index->buckets) {
+		return NULL;
+	}
+	for (ut32 i = 0; i < index->n_kws; i++) {
+		// elements are plain offsets, keep the memory for the next block
+		index->kws[i].cands.len = 0;
+	}
+	kw_index_scan(index, left, left_end);
+	for (ut32 i = 0; i < index->n_kws; i++) {
+		index->kws[i].n_left = rz_vector_len(&index->kws[i].cands);
+	}
+	kw_index_scan(index, buf, len);
+	return index;
+}
+
+/**
+ * Returns the first offset >= i where the keyword may match, or limit if
+ * there is none. Without candidates, every offset may match.
+ */
+static inline int kw_next_candidate(const KwCandidates *kc, ut32 n, ut32 *ci, int i, int limit) {
+	if (!kc || !kc->indexed) {
+		return i;
+	}
+	const ut32 *cands = kc->cands.a;
+	while (*ci < n && cands[*ci] < (ut32)i) {
+		(*ci)++;
+	}
+	return *ci < n ? cands[*ci] : limit;
+}
+
 // Supported search variants: backward, binmask, icase, inverse, overlap
 RZ_API int rz_search_mybinparse_update(RzSearch *s, ut64 from, const ut8 *buf, int len) {
 	RzSearchKeyword *kw;
@@ -429,11 +630,21 @@ RZ_API int rz_search_mybinparse_update(RzSearch *s, ut64 from, const ut8 *buf, i
 
 	ut64 len1 = left->len + RZ_MIN(longest - 1, len);
 	memcpy(left->data + left->len, buf, len1 - left->len);
+	// candidates can only start in the leftover, matches ending in buf are found there
+	RzSearchKwIndex *index = kw_index_update(s, left->data, RZ_MIN(left->len + 1, len1), buf, len);
+	ut32 kw_n = 0;
 	rz_list_foreach (s->kws, iter, kw) {
+		KwCandidates *kc = index ? &index->kws[kw_n] : NULL;
+		kw_n++;
+		ut32 n_left = kc ? kc->n_left : 0;
+		ut32 n_cands = kc ? rz_vector_len(&kc->cands) : 0;
+		ut32 ci = 0;
 		i = s->overlap || !kw->count ? 0 : s->bckwrds ? kw->last - from < left->len ? from + left->len - kw->last : 0
 			: from - kw->last < left->len         ? kw->last + left->len - from
 							      : 0;
-		for (; i + kw->keyword_length <= len1 && i < left->len; i++) {
+		for (i = kw_next_candidate(kc, n_left, &ci, i, len1);
+			i + kw->keyword_length <= len1 && i < left->len;
+			i = kw_next_candidate(kc, n_left, &ci, i + 1, len1)) {
 			if (brute_force_match(s, kw, left->data, i) != s->inverse) {
 				int t = rz_search_hit_new(s, kw, s->bckwrds ? from - kw->keyword_length - i + left->len : from + i - left->len);
 				if (!t) {
@@ -450,7 +661,10 @@ RZ_API int rz_search_mybinparse_update(RzSearch *s, ut64 from, const ut8 *buf, i
 		i = s->overlap || !kw->count ? 0 : s->bckwrds ? from > kw->last ? from - kw->last : 0
 			: from < kw->last                     ? kw->last - from
 							      : 0;
-		for (; i + kw->keyword_length <= len; i++) {
+		ci = n_left;
+		for (i = kw_next_candidate(kc, n_cands, &ci, i, len);
+			i + kw->keyword_length <= len;
+			i = kw_next_candidate(kc, n_cands, &ci, i + 1, len)) {
 			if (brute_force_match(s, kw, buf, i) != s->inverse) {
 				int t = rz_search_hit_new(s, kw, s->bckwrds ? from - kw->keyword_length - i : from + i);
 				if (!t) {
@@ -544,6 +758,7 @@ RZ_API int rz_search_kw_add(RzSearch *s, RzSearchKeyword *kw) {
 	}
 	kw->kwidx = s->n_kws++;
 	rz_list_append(s->kws, kw);
+	RZ_FREE_CUSTOM(s->kw_index, kw_index_free);
 	return true;
 }
 
@@ -551,6 +766,7 @@ RZ_API int rz_search_kw_add(RzSearch *s, RzSearchKeyword *kw) {
 RZ_API void rz_search_string_prepare_backward(RzSearch *s) {
 	RzListIter *iter;
 	RzSearchKeyword *kw;
+	RZ_FREE_CUSTOM(s->kw_index, kw_index_free);
 	// Precondition: !kw->binmask_length || kw->keyword_length % kw->binmask_length == 0
 	rz_list_foreach (s->kws, iter, kw) {
 		ut8 *i = kw->bin_keyword, *j = kw->bin_keyword + kw->keyword_length;
@@ -580,4 +796,5 @@ RZ_API void rz_search_kw_reset(RzSearch *s) {
 	rz_list_purge(s->kws);
 	rz_list_purge(s->hits);
 	RZ_FREE(s->data);
+	RZ_FREE_CUSTOM(s->kw_index, kw_index_free);
 }
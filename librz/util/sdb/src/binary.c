@@ -0,0 +1,257 @@
+// SPDX-FileCopyrightText: 2023 RizinOrg <info@rizin.re>
+// SPDX-License-Identifier: MIT
+
+#include "sdb.h"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#if HAVE_HEADER_SYS_MMAN_H
+#include <sys/mman.h>
+#endif
+#include "sdb_private.h"
+
+/**
+ * *****************
+ * Binary SDB Format
+ * *****************
+ *
+ * A compact alternative to the plaintext format, which doesn't need any
+ * escaping and can be loaded without parsing the text:
+ *
+ *   file      := magic "SDBB" | version (1 byte) | 3 reserved bytes | namespace
+ *   namespace := uleb128 kv_count | kv{kv_count} | uleb128 ns_count | subns{ns_count}
+ *   kv        := string key | string value
+ *   subns     := string name | namespace
+ *   string    := uleb128 size | bytes{size}
+ *
+ * The size of a string includes its terminating null byte, so the strings
+ * can be used straight from the (mapped) file.
+ */
+
+#define BINARY_VERSION  1
+#define BINARY_HDR_SIZE 8
+#define BINARY_BUF_SIZE 0x10000
+// protects the loader from a corrupted file making it recurse forever
+#define BINARY_MAX_DEPTH 256
+
+typedef struct {
+	int fd;
+	ut8 buf[BINARY_BUF_SIZE];
+	size_t len;
+	bool err;
+} SaveCtx;
+
+static void save_flush(SaveCtx *ctx) {
+	if (ctx->len && !ctx->err && (st64)write(ctx->fd, ctx->buf, ctx->len) != (st64)ctx->len) {
+		ctx->err = true;
+	}
+	ctx->len = 0;
+}
+
+static void save_bytes(SaveCtx *ctx, const void *data, size_t size) {
+	const ut8 *p = data;
+	while (size) {
+		if (ctx->len == BINARY_BUF_SIZE) {
+			save_flush(ctx);
+		}
+		size_t n = RZ_MIN(size, BINARY_BUF_SIZE - ctx->len);
+		memcpy(ctx->buf + ctx->len, p, n);
+		ctx->len += n;
+		p += n;
+		size -= n;
+	}
+}
+
+static void save_uleb(SaveCtx *ctx, ut64 v) {
+	ut8 b[10];
+	size_t n = 0;
+	do {
+		b[n] = v & 0x7f;
+		v >>= 7;
+		if (v) {
+			b[n] |= 0x80;
+		}
+		n++;
+	} while (v);
+	save_bytes(ctx, b, n);
+}
+
+static void save_string(SaveCtx *ctx, const char *s) {
+	size_t size = strlen(s) + 1;
+	save_uleb(ctx, size);
+	save_bytes(ctx, s, size);
+}
+
+static int cmp_ns(const void *a, const void *b) {
+	const SdbNs *nsa = a;
+	const SdbNs *nsb = b;
+	return strcmp(nsa->name, nsb->name);
+}
+
+static void binary_save(SaveCtx *ctx, Sdb *s, bool sort) {
+	SdbList *l = sdb_foreach_list(s, sort);
+	if (!l) {
+		ctx->err = true;
+		return;
+	}
+	save_uleb(ctx, ls_length(l));
+	SdbKv *kv;
+	SdbListIter *it;
+	ls_foreach (l, it, kv) {
+		save_string(ctx, sdbkv_key(kv));
+		save_string(ctx, sdbkv_value(kv));
+	}
+	ls_free(l);
+
+	l = s->ns;
+	if (sort) {
+		l = ls_clone(l);
+		ls_sort(l, cmp_ns);
+	}
+	save_uleb(ctx, ls_length(l));
+	SdbNs *ns;
+	ls_foreach (l, it, ns) {
+		save_string(ctx, ns->name);
+		binary_save(ctx, ns->sdb, sort);
+	}
+	if (l != s->ns) {
+		ls_free(l);
+	}
+}
+
+RZ_API bool sdb_binary_save_fd(Sdb *s, int fd, bool sort) {
+	SaveCtx *ctx = RZ_NEW0(SaveCtx);
+	if (!ctx) {
+		return false;
+	}
+	ctx->fd = fd;
+	const ut8 hdr[BINARY_HDR_SIZE] = { 'S', 'D', 'B', 'B', BINARY_VERSION, 0, 0, 0 };
+	save_bytes(ctx, hdr, sizeof(hdr));
+	binary_save(ctx, s, sort);
+	save_flush(ctx);
+	bool r = !ctx->err;
+	free(ctx);
+	return r;
+}
+
+RZ_API bool sdb_binary_save(Sdb *s, const char *file, bool sort) {
+	int fd = open(file, O_WRONLY | O_CREAT | O_TRUNC | O_BINARY, 0644);
+	if (fd < 0) {
+		return false;
+	}
+	bool r = sdb_binary_save_fd(s, fd, sort);
+	close(fd);
+	return r;
+}
+
+/**
+ * \brief Returns true if \p buf starts with the header of the binary format
+ */
+RZ_API bool sdb_binary_check(const ut8 *buf, size_t sz) {
+	return sz >= BINARY_HDR_SIZE && !memcmp(buf, "SDBB", 4) && buf[4] == BINARY_VERSION;
+}
+
+typedef struct {
+	const ut8 *buf;
+	size_t size;
+	size_t pos;
+} LoadCtx;
+
+static bool load_uleb(LoadCtx *ctx, ut64 *v) {
+	ut64 r = 0;
+	for (int shift = 0; shift < 64; shift += 7) {
+		if (ctx->pos >= ctx->size) {
+			return false;
+		}
+		ut8 b = ctx->buf[ctx->pos++];
+		r |= (ut64)(b & 0x7f) << shift;
+		if (!(b & 0x80)) {
+			*v = r;
+			return true;
+		}
+	}
+	return false;
+}
+
+static const char *load_string(LoadCtx *ctx) {
+	ut64 size;
+	if (!load_uleb(ctx, &size) || !size || size > ctx->size - ctx->pos) {
+		return NULL;
+	}
+	const char *s = (const char *)ctx->buf + ctx->pos;
+	if (s[size - 1]) {
+		return NULL;
+	}
+	ctx->pos += size;
+	return s;
+}
+
+static bool binary_load(LoadCtx *ctx, Sdb *s, int depth) {
+	ut64 count;
+	if (depth > BINARY_MAX_DEPTH || !load_uleb(ctx, &count)) {
+		return false;
+	}
+	for (ut64 i = 0; i < count; i++) {
+		const char *k = load_string(ctx);
+		const char *v = k ? load_string(ctx) : NULL;
+		if (!v) {
+			return false;
+		}
+		sdb_set(s, k, v, 0);
+	}
+	if (!load_uleb(ctx, &count)) {
+		return false;
+	}
+	for (ut64 i = 0; i < count; i++) {
+		const char *name = load_string(ctx);
+		Sdb *ns = name ? sdb_ns(s, name, true) : NULL;
+		if (!ns || !binary_load(ctx, ns, depth + 1)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+RZ_API bool sdb_binary_load_buf(Sdb *s, const ut8 *buf, size_t sz) {
+	if (!sdb_binary_check(buf, sz)) {
+		return false;
+	}
+	LoadCtx ctx = { buf, sz, BINARY_HDR_SIZE };
+	return binary_load(&ctx, s, 0) && ctx.pos == sz;
+}
+
+RZ_API bool sdb_binary_load(Sdb *s, const char *file) {
+	int fd = open(file, O_RDONLY | O_BINARY);
+	if (fd < 0) {
+		return false;
+	}
+	bool r = false;
+	struct stat st;
+	if (fstat(fd, &st) || !st.st_size) {
+		goto beach;
+	}
+#if HAVE_HEADER_SYS_MMAN_H
+	ut8 *x = mmap(0, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	if (x == MAP_FAILED) {
+		goto beach;
+	}
+#else
+	ut8 *x = calloc(1, st.st_size);
+	if (!x) {
+		goto beach;
+	}
+	if (read(fd, x, st.st_size) != st.st_size) {
+		free(x);
+		goto beach;
+	}
+#endif
+	r = sdb_binary_load_buf(s, x, st.st_size);
+#if HAVE_HEADER_SYS_MMAN_H
+	munmap(x, st.st_size);
+#else
+	free(x);
+#endif
+beach:
+	close(fd);
+	return r;
+}
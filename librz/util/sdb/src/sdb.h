@@ -196,6 +196,13 @@ RZ_API bool sdb_text_save(Sdb *s, const char *file, bool sort);
 RZ_API bool sdb_text_load_buf(Sdb *s, char *buf, size_t sz);
 RZ_API bool sdb_text_load(Sdb *s, const char *file);
 
+/* binary sdb files */
+RZ_API bool sdb_binary_save_fd(Sdb *s, int fd, bool sort);
+RZ_API bool sdb_binary_save(Sdb *s, const char *file, bool sort);
+RZ_API bool sdb_binary_check(const ut8 *buf, size_t sz);
+RZ_API bool sdb_binary_load_buf(Sdb *s, const ut8 *buf, size_t sz);
+RZ_API bool sdb_binary_load(Sdb *s, const char *file);
+
 /* iterate */
 RZ_API void sdb_dump_begin(Sdb *s);
 RZ_API SdbKv *sdb_dump_next(Sdb *s);
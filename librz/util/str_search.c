@@ -7,6 +7,14 @@
 #include <rz_util/rz_utf32.h>
 #include <rz_util/rz_ebcdic.h>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define STR_SCAN_SSE2 1
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define STR_SCAN_NEON 1
+#endif
+
 typedef enum {
 	SKIP_STRING,
 	RETRY_ASCII,
@@ -347,6 +355,148 @@ static inline bool can_be_ebcdic(const ut8 *buf, ut64 size) {
 	return buf[0] < 0x20 || buf[0] > 0x3f;
 }
 
+/*
+ * Pre-filter for the main loop of rz_scan_strings_raw(), classifying 16 bytes
+ * at a time to skip the offsets where no string can start, so the slow path
+ * only runs on candidates. It must never skip an offset the slow path would
+ * have detected a string at.
+ */
+#define SCAN_BLOCK_SIZE 16
+
+/*
+ * Bytes terminating any string decoded as utf8/8-bit: ascii control chars
+ * which are not escape sequences, and DEL. Anything >= 0x80 may be part of
+ * a multi-byte rune, so it is never considered dead.
+ */
+static inline bool is_dead_byte(ut8 b) {
+	return b < 0x07 || (b >= 0x0e && b < 0x1b) || (b >= 0x1c && b < 0x20) || b == 0x7f;
+}
+
+#if STR_SCAN_SSE2
+static inline __m128i block_in_range(__m128i v, char lo, char hi) {
+	// bytes >= 0x80 are negative and never in range since lo >= 0
+	return _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8(lo - 1)), _mm_cmplt_epi8(v, _mm_set1_epi8(hi)));
+}
+
+static inline bool block_has_dead(const ut8 *buf) {
+	__m128i v = _mm_loadu_si128((const __m128i *)buf);
+	__m128i dead = _mm_or_si128(
+		_mm_or_si128(block_in_range(v, 0x00, 0x07), block_in_range(v, 0x0e, 0x1b)),
+		_mm_or_si128(block_in_range(v, 0x1c, 0x20), _mm_cmpeq_epi8(v, _mm_set1_epi8(0x7f))));
+	return _mm_movemask_epi8(dead);
+}
+
+static inline bool block_is_zero(const ut8 *buf) {
+	__m128i v = _mm_loadu_si128((const __m128i *)buf);
+	return _mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_setzero_si128())) == 0xffff;
+}
+#elif STR_SCAN_NEON
+static inline bool block_has_dead(const ut8 *buf) {
+	uint8x16_t v = vld1q_u8(buf);
+	uint8x16_t dead = vorrq_u8(
+		vorrq_u8(vcltq_u8(v, vdupq_n_u8(0x07)), vandq_u8(vcgeq_u8(v, vdupq_n_u8(0x0e)), vcltq_u8(v, vdupq_n_u8(0x1b)))),
+		vorrq_u8(vandq_u8(vcgeq_u8(v, vdupq_n_u8(0x1c)), vcltq_u8(v, vdupq_n_u8(0x20))), vceqq_u8(v, vdupq_n_u8(0x7f))));
+	return vmaxvq_u8(dead);
+}
+
+static inline bool block_is_zero(const ut8 *buf) {
+	return !vmaxvq_u8(vld1q_u8(buf));
+}
+#else
+static inline bool block_has_dead(const ut8 *buf) {
+	for (int i = 0; i < SCAN_BLOCK_SIZE; i++) {
+		if (is_dead_byte(buf[i])) {
+			return true;
+		}
+	}
+	return false;
+}
+
+static inline bool block_is_zero(const ut8 *buf) {
+	ut64 a, b;
+	memcpy(&a, buf, sizeof(a));
+	memcpy(&b, buf + sizeof(a), sizeof(b));
+	return !(a | b);
+}
+#endif
+
+/**
+ * Returns the offset of the first position in \p buf followed by at least
+ * \p min_len bytes which are not dead, or \p size if there is none.
+ * Since every rune decoded as utf8/8-bit consumes at least one byte and
+ * stops at the first dead one, no string of \p min_len runes can start
+ * at the skipped offsets.
+ */
+static ut64 skip_dead_bytes(const ut8 *buf, ut64 size, ut64 min_len) {
+	ut64 run = 0;
+	ut64 i = 0;
+	while (i < size) {
+		if (i + SCAN_BLOCK_SIZE <= size && !block_has_dead(buf + i)) {
+			run += SCAN_BLOCK_SIZE;
+			i += SCAN_BLOCK_SIZE;
+			if (run >= min_len) {
+				return i - run;
+			}
+			continue;
+		}
+		ut64 end = RZ_MIN(i + SCAN_BLOCK_SIZE, size);
+		for (; i < end; i++) {
+			if (is_dead_byte(buf[i])) {
+				run = 0;
+			} else if (++run >= min_len) {
+				return i + 1 - run;
+			}
+		}
+	}
+	return size;
+}
+
+static ut64 count_zeros(const ut8 *buf, ut64 size) {
+	ut64 i = 0;
+	while (i + SCAN_BLOCK_SIZE <= size && block_is_zero(buf + i)) {
+		i += SCAN_BLOCK_SIZE;
+	}
+	while (i < size && !buf[i]) {
+		i++;
+	}
+	return i;
+}
+
+/**
+ * Returns how many offsets at \p buf can be skipped when guessing the
+ * encoding. A rune starting at a zero byte is null in every encoding, so
+ * only the detection of utf16/32-be strings, which looks at the following
+ * 7 bytes, can make a zero byte start a string.
+ */
+static ut64 skip_zeros_guess(const ut8 *buf, ut64 size) {
+	if (buf[0]) {
+		return 0;
+	}
+	ut64 zeros = count_zeros(buf, size);
+	if (zeros == size) {
+		return size;
+	}
+	return zeros > 6 ? zeros - 6 : 0;
+}
+
+static inline bool is_decoded_as_utf8(RzStrEnc type) {
+	switch (type) {
+	case RZ_STRING_ENC_UTF16LE:
+	case RZ_STRING_ENC_UTF16BE:
+	case RZ_STRING_ENC_UTF32LE:
+	case RZ_STRING_ENC_UTF32BE:
+	case RZ_STRING_ENC_IBM037:
+	case RZ_STRING_ENC_IBM290:
+	case RZ_STRING_ENC_EBCDIC_ES:
+	case RZ_STRING_ENC_EBCDIC_UK:
+	case RZ_STRING_ENC_EBCDIC_US:
+	case RZ_STRING_ENC_GUESS:
+		return false;
+	default:
+		return true;
+	}
+}
+
 /**
  * \brief Look for strings in an RzBuffer.
  * \param buf Pointer to a raw buffer to scan
@@ -383,9 +533,26 @@ RZ_API int rz_scan_strings_raw(RZ_NONNULL const ut8 *buf, RZ_NONNULL RzList /*<R
 	const ut8 *ptr = NULL;
 	ut64 size = 0;
 	int skip_ibm037 = 0;
+	// without a minimum length, even empty strings are detected and nothing can be skipped
+	bool prefilter = opt->min_str_length > 0;
 	while (needle < to) {
 		ptr = buf + needle - from;
 		size = to - needle;
+		if (prefilter && type == RZ_STRING_ENC_GUESS) {
+			ut64 skip = skip_zeros_guess(ptr, size);
+			if (skip) {
+				// every skipped offset would have decremented it, down to 0 at most
+				skip_ibm037 = skip_ibm037 > 0 && skip < (ut64)skip_ibm037 ? skip_ibm037 - (int)skip : 0;
+				needle += skip;
+				continue;
+			}
+		} else if (prefilter && is_decoded_as_utf8(type)) {
+			ut64 skip = skip_dead_bytes(ptr, size, opt->min_str_length);
+			if (skip) {
+				needle += skip;
+				continue;
+			}
+		}
 		--skip_ibm037;
 		if (type == RZ_STRING_ENC_GUESS) {
 			if (can_be_utf32_le(ptr, size)) {
@@ -38,6 +38,11 @@ int gdbr_disconnect(libgdbr_t *g);
  */
 void gdbr_invalidate_reg_cache(void);
 
+/*!
+ * \brief drops the memory cached since the target stopped
+ */
+void gdbr_invalidate_mem_cache(libgdbr_t *g);
+
 /*!
  * \brief gets reason why remote target stopped
  */
@@ -20,12 +20,13 @@
 #define CMD_DETACH_MP "D;"
 #define CMD_KILL_MP   "vKill;"
 
-#define CMD_READREGS  "g"
-#define CMD_WRITEREGS "G"
-#define CMD_READREG   "p"
-#define CMD_WRITEREG  "P"
-#define CMD_WRITEMEM  "M"
-#define CMD_READMEM   "m"
+#define CMD_READREGS    "g"
+#define CMD_WRITEREGS   "G"
+#define CMD_READREG     "p"
+#define CMD_WRITEREG    "P"
+#define CMD_WRITEMEM    "M"
+#define CMD_READMEM     "m"
+#define CMD_READMEM_BIN "x"
 
 #define CMD_BP         "Z0"
 #define CMD_RBP        "z0"
@@ -11,6 +11,7 @@
 #include "rz_types_base.h"
 #include "rz_socket.h"
 #include "rz_th.h"
+#include "ht_up.h"
 
 #define MSG_OK            0
 #define MSG_NOT_SUPPORTED -1
@@ -20,6 +21,9 @@
 #define GDB_REMOTE_TYPE_LLDB 1
 #define GDB_MAX_PKTSZ        4
 
+#define GDB_MEM_CACHE_LINE  0x100 // granularity of the memory read cache
+#define GDB_MEM_CACHE_LINES 0x1000 // cache is flushed beyond this many lines
+
 /*!
  * Structure that saves a gdb message
  */
@@ -100,6 +104,7 @@ typedef struct libgdbr_stub_features_t {
 		bool c, C, s, S, t, r;
 	} vcont;
 	bool P;
+	bool binary_upload; // binary memory reads with the 'x' packet
 } libgdbr_stub_features_t;
 
 /*!
@@ -200,6 +205,12 @@ typedef struct libgdbr_t {
 	} target;
 
 	bool isbreaked;
+
+	// memory read while the target is stopped, dropped when it resumes
+	struct {
+		HtUP *lines; // line address -> ut8[GDB_MEM_CACHE_LINE]
+		bool enabled;
+	} mem_cache;
 } libgdbr_t;
 
 /*!
@@ -118,6 +118,8 @@ int handle_qSupported(libgdbr_t *g) {
 			g->stub_features.ReverseStep = (tok[strlen("ReverseStep")] == '+');
 		} else if (rz_str_startswith(tok, "ReverseContinue")) {
 			g->stub_features.ReverseContinue = (tok[strlen("ReverseContinue")] == '+');
+		} else if (rz_str_startswith(tok, "binary-upload")) {
+			g->stub_features.binary_upload = (tok[strlen("binary-upload")] == '+');
 		}
 		// TODO
 		tok = strtok(NULL, ";");
@@ -71,6 +71,9 @@ static int set_interface_attribs(int fd, int speed, int parity) {
 }
 #endif
 
+// Larger reads bypass the memory cache
+#define MEM_CACHE_MAX_READ (GDB_MEM_CACHE_LINE * 0x40)
+
 static struct {
 	ut8 *buf;
 	ut64 buflen, maxlen;
@@ -87,6 +90,69 @@ static void reg_cache_init(libgdbr_t *g) {
 	}
 }
 
+/*
+ * Fills the register cache from the registers expedited in a T stop reply,
+ * sparing the 'g' packet when the stub sent all of them.
+ */
+static void reg_cache_expedite(libgdbr_t *g) {
+	size_t regnum, tot_regs, seen = 0;
+	ut64 buflen = 0;
+	if (!reg_cache.init || !g->registers || g->data_len < 3 || g->data[0] != 'T') {
+		return;
+	}
+	// offsets and sizes of the profile are in bits
+	for (regnum = 0; *g->registers[regnum].name; regnum++) {
+		buflen = RZ_MAX(buflen, (g->registers[regnum].offset + g->registers[regnum].size + 7) / 8);
+	}
+	tot_regs = regnum;
+	if (!tot_regs || buflen > reg_cache.maxlen) {
+		return;
+	}
+	bool *present = calloc(tot_regs, sizeof(bool));
+	if (!present) {
+		return;
+	}
+	memset(reg_cache.buf, 0, buflen);
+	const char *ptr = g->data + 3, *end = g->data + g->data_len;
+	while (ptr < end) {
+		const char *sep = memchr(ptr, ';', end - ptr);
+		if (!sep) {
+			sep = end;
+		}
+		const char *colon = memchr(ptr, ':', sep - ptr);
+		const char *digit = ptr;
+		while (colon && digit < colon && isxdigit((ut8)*digit)) {
+			digit++;
+		}
+		// Other stop reply fields, such as thread:, are not register numbers
+		if (colon && digit == colon && colon > ptr) {
+			regnum = strtoul(ptr, NULL, 16);
+			if (regnum < tot_regs) {
+				gdb_reg_t *reg = &g->registers[regnum];
+				// unpack_hex() would NUL terminate over the next register
+				ut64 nbytes = RZ_MIN((ut64)(sep - colon - 1) / 2, (reg->size + 7) / 8);
+				ut8 *dst = reg_cache.buf + reg->offset / 8;
+				ut64 i;
+				for (i = 0; i < nbytes; i++) {
+					int hi = hex2int(colon[1 + i * 2]);
+					int lo = hex2int(colon[2 + i * 2]);
+					dst[i] = (hi > 0 ? hi << 4 : 0) | (lo > 0 ? lo : 0);
+				}
+				if (!present[regnum]) {
+					present[regnum] = true;
+					seen++;
+				}
+			}
+		}
+		ptr = sep + 1;
+	}
+	if (seen == tot_regs) {
+		reg_cache.buflen = buflen;
+		reg_cache.valid = true;
+	}
+	free(present);
+}
+
 static void gdbr_break_process(void *arg) {
 	libgdbr_t *g = (libgdbr_t *)arg;
 	(void)g;
@@ -289,6 +355,7 @@ int gdbr_disconnect(libgdbr_t *g) {
 		goto end;
 	}
 	reg_cache.valid = false;
+	gdbr_invalidate_mem_cache(g);
 	g->stop_reason.is_valid = false;
 	free(reg_cache.buf);
 	if (g->target.valid) {
@@ -309,6 +376,7 @@ int gdbr_select(libgdbr_t *g, int pid, int tid) {
 		goto end;
 	}
 	reg_cache.valid = false;
+	gdbr_invalidate_mem_cache(g);
 	g->pid = pid;
 	g->tid = tid;
 	strcpy(cmd, "Hg");
@@ -411,6 +479,7 @@ int gdbr_check_extended_mode(libgdbr_t *g) {
 	}
 	g->stop_reason.is_valid = false;
 	reg_cache.valid = false;
+	gdbr_invalidate_mem_cache(g);
 	// Activate extended mode if possible.
 	ret = send_msg(g, "!");
 	if (ret < 0) {
@@ -450,6 +519,7 @@ int gdbr_attach(libgdbr_t *g, int pid) {
 	}
 	g->stop_reason.is_valid = false;
 	reg_cache.valid = false;
+	gdbr_invalidate_mem_cache(g);
 
 	if (g->stub_features.extended_mode == -1) {
 		gdbr_check_extended_mode(g);
@@ -504,6 +574,7 @@ int gdbr_detach(libgdbr_t *g) {
 	}
 
 	reg_cache.valid = false;
+	gdbr_invalidate_mem_cache(g);
 	g->stop_reason.is_valid = false;
 	ret = send_msg(g, "D");
 	if (ret < 0) {
@@ -531,6 +602,7 @@ int gdbr_detach_pid(libgdbr_t *g, int pid) {
 	}
 
 	reg_cache.valid = false;
+	gdbr_invalidate_mem_cache(g);
 	g->stop_reason.is_valid = false;
 
 	buffer_size = strlen(CMD_DETACH_MP) + (sizeof(pid) * 2) + 1;
@@ -581,6 +653,7 @@ int gdbr_kill(libgdbr_t *g) {
 	}
 
 	reg_cache.valid = false;
+	gdbr_invalidate_mem_cache(g);
 	g->stop_reason.is_valid = false;
 
 	if (g->stub_features.multiprocess) {
@@ -616,6 +689,7 @@ int gdbr_kill_pid(libgdbr_t *g, int pid) {
 	}
 
 	reg_cache.valid = false;
+	gdbr_invalidate_mem_cache(g);
 	g->stop_reason.is_valid = false;
 
 	buffer_size = strlen(CMD_KILL_MP) + (sizeof(pid) * 2) + 1;
@@ -724,10 +798,40 @@ end:
 	return ret;
 }
 
-static int gdbr_read_memory_page(libgdbr_t *g, ut64 address, ut8 *buf, int len) {
+/*
+ * Reads at most len bytes with a single packet, using the binary 'x' packet
+ * when the stub supports it. Returns the number of bytes read or -1.
+ */
+static int read_memory_packet(libgdbr_t *g, ut64 address, ut8 *buf, int len) {
 	char command[128] = { 0 };
-	int last, ret_len, pkt;
-	ret_len = 0;
+	bool binary = g->stub_features.binary_upload;
+	if (snprintf(command, sizeof(command) - 1,
+		    "%s%" PFMT64x ",%" PFMT64x, binary ? CMD_READMEM_BIN : CMD_READMEM,
+		    address, (ut64)len) < 0) {
+		return -1;
+	}
+	if (send_msg(g, command) < 0 || read_packet(g, false) < 0) {
+		return -1;
+	}
+	if (binary) {
+		// 'b' followed by the data, already unescaped by read_packet
+		if (send_ack(g) < 0 || g->data_len < 1 || g->data[0] != 'b') {
+			return -1;
+		}
+		int ret = RZ_MIN(g->data_len - 1, len);
+		memcpy(buf, g->data + 1, ret);
+		return ret;
+	}
+	if (handle_m(g) < 0) {
+		return -1;
+	}
+	int ret = RZ_MIN(g->data_len, len);
+	memcpy(buf, g->data, ret);
+	return ret;
+}
+
+static int gdbr_read_memory_page(libgdbr_t *g, ut64 address, ut8 *buf, int len) {
+	int ret_len = 0;
 
 	if (!g) {
 		return -1;
@@ -742,74 +846,26 @@ static int gdbr_read_memory_page(libgdbr_t *g, ut64 address, ut8 *buf, int len)
 
 	g->stub_features.pkt_sz = RZ_MAX(g->stub_features.pkt_sz, GDB_MAX_PKTSZ);
 	int data_sz = g->stub_features.pkt_sz / 2;
-	int num_pkts = len / data_sz;
-	last = len % data_sz;
-	ret_len = 0;
-	for (pkt = 0; pkt < num_pkts; pkt++) {
-		if (snprintf(command, sizeof(command) - 1,
-			    "%s%" PFMT64x ",%" PFMT64x, CMD_READMEM,
-			    (ut64)address + (pkt * data_sz),
-			    (ut64)data_sz) < 0) {
-			ret_len = -1;
-			goto end;
-		}
-		if (send_msg(g, command) < 0) {
-			ret_len = -1;
-			goto end;
-		}
-		if (read_packet(g, false) < 0) {
-			ret_len = -1;
-			goto end;
-		}
-		if (handle_m(g) < 0) {
-			ret_len = -1;
+	while (ret_len < len) {
+		int ret = read_memory_packet(g, address + ret_len, buf + ret_len, RZ_MIN(data_sz, len - ret_len));
+		if (ret < 0) {
+			if (!ret_len) {
+				ret_len = -1;
+			}
 			goto end;
 		}
-		int delta = (pkt * data_sz);
-
-		if (delta > len) {
-			eprintf("oops\n");
+		if (!ret) {
 			break;
 		}
-		int left = RZ_MIN(g->data_len, len - delta);
-		if (left > 0) {
-			memcpy(buf + delta, g->data, left);
-			ret_len += g->data_len;
-		}
-	}
-	if (last) {
-		if (snprintf(command, sizeof(command) - 1,
-			    "%s%016" PFMT64x ",%" PFMT64x, CMD_READMEM,
-			    (ut64)(address + (num_pkts * data_sz)),
-			    (ut64)last) < 0) {
-			ret_len = -1;
-			goto end;
-		}
-		if (send_msg(g, command) < 0) {
-			ret_len = -1;
-			goto end;
-		}
-		if (read_packet(g, false) < 0) {
-			ret_len = -1;
-			goto end;
-		}
-		if (handle_m(g) < 0) {
-			ret_len = -1;
-			goto end;
-		}
-		int delta = num_pkts * data_sz;
-		int left = RZ_MIN(g->data_len, len - delta);
-		if (left > 0) {
-			memcpy(buf + delta, g->data, left);
-			ret_len += g->data_len;
-		}
+		// Stubs may send less than asked for, carry on from there
+		ret_len += ret;
 	}
 end:
 	gdbr_lock_leave(g);
 	return ret_len;
 }
 
-int gdbr_read_memory(libgdbr_t *g, ut64 address, ut8 *buf, int len) {
+static int gdbr_read_memory_uncached(libgdbr_t *g, ut64 address, ut8 *buf, int len) {
 	int ret_len, ret, tmp;
 	int page_size = g->page_size;
 	ret_len = 0;
@@ -857,6 +913,117 @@ end:
 	return ret_len;
 }
 
+
+static void mem_cache_line_free(HtUPKv *kv) {
+	free(kv->value);
+}
+
+void gdbr_invalidate_mem_cache(libgdbr_t *g) {
+	if (g) {
+		ht_up_free(g->mem_cache.lines);
+		g->mem_cache.lines = NULL;
+	}
+}
+
+static void mem_cache_drop(libgdbr_t *g, ut64 address, ut64 len) {
+	if (!g->mem_cache.lines || !len) {
+		return;
+	}
+	if (len > (ut64)GDB_MEM_CACHE_LINE * GDB_MEM_CACHE_LINES || address > UT64_MAX - len) {
+		gdbr_invalidate_mem_cache(g);
+		return;
+	}
+	// count the lines rather than comparing addresses, the topmost line ends at 0
+	ut64 line = address & ~(ut64)(GDB_MEM_CACHE_LINE - 1);
+	ut64 nlines = ((address + len - 1) - line) / GDB_MEM_CACHE_LINE + 1;
+	for (; nlines; nlines--, line += GDB_MEM_CACHE_LINE) {
+		ht_up_delete(g->mem_cache.lines, line);
+	}
+}
+
+/*
+ * Serves the read from the lines cached since the target stopped. The lines
+ * missing are fetched in runs of consecutive lines, so that nearby reads are
+ * merged into as few packets as possible. Returns len, or -1 when some line
+ * could not be read whole.
+ */
+static int mem_cache_read(libgdbr_t *g, ut64 address, ut8 *buf, int len) {
+	const ut64 mask = ~(ut64)(GDB_MEM_CACHE_LINE - 1);
+	if (address > UT64_MAX - len) {
+		return -1;
+	}
+	ut64 first = address & mask;
+	ut64 last = (address + len - 1) & mask;
+	if (last > UT64_MAX - GDB_MEM_CACHE_LINE) {
+		// the address after the topmost line wraps to 0, read it uncached
+		return -1;
+	}
+	ut64 nlines = (last - first) / GDB_MEM_CACHE_LINE + 1;
+	if (g->mem_cache.lines && g->mem_cache.lines->count + nlines > GDB_MEM_CACHE_LINES) {
+		gdbr_invalidate_mem_cache(g);
+	}
+	if (!g->mem_cache.lines && !(g->mem_cache.lines = ht_up_new(NULL, mem_cache_line_free, NULL))) {
+		return -1;
+	}
+	HtUP *lines = g->mem_cache.lines;
+	ut64 line = first;
+	while (line <= last) {
+		if (ht_up_find(lines, line, NULL)) {
+			line += GDB_MEM_CACHE_LINE;
+			continue;
+		}
+		ut64 run_end = line + GDB_MEM_CACHE_LINE;
+		while (run_end <= last && !ht_up_find(lines, run_end, NULL)) {
+			run_end += GDB_MEM_CACHE_LINE;
+		}
+		int run_len = (int)(run_end - line);
+		ut8 *run = malloc(run_len);
+		if (!run) {
+			return -1;
+		}
+		if (gdbr_read_memory_page(g, line, run, run_len) != run_len) {
+			free(run);
+			return -1;
+		}
+		int off;
+		for (off = 0; off < run_len; off += GDB_MEM_CACHE_LINE) {
+			ut8 *data = rz_mem_dup(run + off, GDB_MEM_CACHE_LINE);
+			if (!data || !ht_up_insert(lines, line + off, data)) {
+				free(data);
+				free(run);
+				return -1;
+			}
+		}
+		free(run);
+		line = run_end;
+	}
+	for (line = first; line <= last; line += GDB_MEM_CACHE_LINE) {
+		const ut8 *data = ht_up_find(lines, line, NULL);
+		ut64 from = RZ_MAX(line, address);
+		ut64 to = RZ_MIN(line + GDB_MEM_CACHE_LINE, address + len);
+		memcpy(buf + (from - address), data + (from - line), to - from);
+	}
+	return len;
+}
+
+int gdbr_read_memory(libgdbr_t *g, ut64 address, ut8 *buf, int len) {
+	int ret_len = 0;
+
+	if (!gdbr_lock_enter(g)) {
+		goto end;
+	}
+	if (g->mem_cache.enabled && len > 0 && len <= MEM_CACHE_MAX_READ) {
+		if ((ret_len = mem_cache_read(g, address, buf, len)) == len) {
+			goto end;
+		}
+		// Some line is not readable whole, read just what was asked for
+	}
+	ret_len = gdbr_read_memory_uncached(g, address, buf, len);
+end:
+	gdbr_lock_leave(g);
+	return ret_len;
+}
+
 int gdbr_write_memory(libgdbr_t *g, ut64 address, const uint8_t *data, ut64 len) {
 	int ret = -1;
 	int command_len, pkt, max_cmd_len = 64;
@@ -879,6 +1046,7 @@ int gdbr_write_memory(libgdbr_t *g, ut64 address, const uint8_t *data, ut64 len)
 	if (!gdbr_lock_enter(g)) {
 		goto end;
 	}
+	mem_cache_drop(g, address, len);
 
 	for (pkt = num_pkts - 1; pkt >= 0; pkt--) {
 		if ((command_len = snprintf(tmp, max_cmd_len,
@@ -1272,6 +1440,7 @@ int send_vcont(libgdbr_t *g, const char *command, const char *thread_id) {
 		goto end;
 	}
 	reg_cache.valid = false;
+	gdbr_invalidate_mem_cache(g);
 	g->stop_reason.is_valid = false;
 	ret = send_msg(g, tmp);
 	if (ret < 0) {
@@ -1292,6 +1461,7 @@ int send_vcont(libgdbr_t *g, const char *command, const char *thread_id) {
 		}
 	}
 
+	reg_cache_expedite(g);
 	ret = handle_cont(g);
 end:
 	rz_cons_sleep_end(bed);
@@ -1590,6 +1760,8 @@ int gdbr_send_qRcmd(libgdbr_t *g, const char *cmd, PrintfCallback cb_printf) {
 	}
 	g->stop_reason.is_valid = false;
 	reg_cache.valid = false;
+	// monitor commands may well change memory
+	gdbr_invalidate_mem_cache(g);
 	pack_hex(cmd, strlen(cmd), buf + 6);
 	if ((ret = send_msg(g, buf)) < 0) {
 		goto end;
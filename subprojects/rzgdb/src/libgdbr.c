@@ -46,6 +46,7 @@ int gdbr_init(libgdbr_t *g, bool is_server) {
 	}
 	g->remote_type = GDB_REMOTE_TYPE_GDB;
 	g->isbreaked = false;
+	g->mem_cache.enabled = !is_server;
 	return 0;
 }
 
@@ -153,5 +154,7 @@ int gdbr_cleanup(libgdbr_t *g) {
 	RZ_FREE(g->read_buff);
 	rz_socket_free(g->sock);
 	rz_th_lock_free(g->gdbr_lock);
+	ht_up_free(g->mem_cache.lines);
+	g->mem_cache.lines = NULL;
 	return 0;
 }
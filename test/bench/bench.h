@@ -0,0 +1,129 @@
+// SPDX-FileCopyrightText: 2023 RizinOrg <info@rizin.re>
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#ifndef RZ_BENCH_H
+#define RZ_BENCH_H
+
+/*
+ * Minimal benchmark harness.
+ *
+ * Each benchmark runs a fixed amount of iterations on fixed inputs, so that
+ * the numbers can be compared across commits. The results of all the
+ * benchmarks of an executable are printed to stdout as a single JSON object:
+ *
+ *   {"suite":"io","benchmarks":[{"name":"read_at.maps","iterations":N,
+ *     "time_us":T,"ns_per_iter":X,"alloc_bytes":A,"peak_rss_kb":R}]}
+ *
+ * alloc_bytes is the growth of the heap in use during the benchmark and is
+ * reported only with glibc, peak_rss_kb is the peak RSS of the whole process.
+ */
+
+#include <rz_util.h>
+#if __UNIX__
+#include <sys/resource.h>
+#endif
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+typedef struct {
+	PJ *pj;
+	const char *name; ///< name of the running benchmark
+	ut64 start; ///< rz_time_now_mono() at the start of the running benchmark
+	st64 heap_start;
+	int failed;
+} RzBench;
+
+/// Stores the results of the benchmarks so that the compiler can't optimize them out
+static volatile ut64 bench_sink;
+
+static inline st64 bench_heap_used(void) {
+#if defined(__GLIBC__)
+#if __GLIBC_PREREQ(2, 33)
+	return (st64)mallinfo2().uordblks;
+#else
+	return (st64)mallinfo().uordblks;
+#endif
+#else
+	return 0;
+#endif
+}
+
+static inline ut64 bench_peak_rss_kb(void) {
+#if __UNIX__
+	struct rusage ru;
+	if (!getrusage(RUSAGE_SELF, &ru)) {
+#if __APPLE__
+		return ru.ru_maxrss / 1024;
+#else
+		return ru.ru_maxrss;
+#endif
+	}
+#endif
+	return 0;
+}
+
+static inline void bench_init(RzBench *b, const char *suite) {
+	memset(b, 0, sizeof(*b));
+	b->pj = pj_new();
+	if (!b->pj) {
+		exit(1);
+	}
+	pj_o(b->pj);
+	pj_ks(b->pj, "suite", suite);
+	pj_ka(b->pj, "benchmarks");
+}
+
+static inline void bench_start(RzBench *b, const char *name) {
+	b->name = name;
+	b->heap_start = bench_heap_used();
+	b->start = rz_time_now_mono();
+}
+
+/**
+ * Ends the running benchmark, which executed \p iterations operations.
+ */
+static inline void bench_stop(RzBench *b, ut64 iterations) {
+	ut64 elapsed = rz_time_now_mono() - b->start;
+	st64 heap = bench_heap_used() - b->heap_start;
+	pj_o(b->pj);
+	pj_ks(b->pj, "name", b->name);
+	pj_kn(b->pj, "iterations", iterations);
+	pj_kn(b->pj, "time_us", elapsed);
+	pj_kd(b->pj, "ns_per_iter", iterations ? elapsed * 1000.0 / iterations : 0.0);
+	pj_kN(b->pj, "alloc_bytes", heap > 0 ? heap : 0);
+	pj_kn(b->pj, "peak_rss_kb", bench_peak_rss_kb());
+	pj_end(b->pj);
+	b->name = NULL;
+}
+
+/**
+ * Reports the benchmark \p name as not run, e.g. because a fixture is missing.
+ */
+static inline void bench_skip(RzBench *b, const char *name, const char *reason) {
+	pj_o(b->pj);
+	pj_ks(b->pj, "name", name);
+	pj_ks(b->pj, "skipped", reason);
+	pj_end(b->pj);
+}
+
+/**
+ * Reports the benchmark \p name as failed, the executable will return an error.
+ */
+static inline void bench_fail(RzBench *b, const char *name, const char *reason) {
+	pj_o(b->pj);
+	pj_ks(b->pj, "name", name);
+	pj_ks(b->pj, "failed", reason);
+	pj_end(b->pj);
+	b->failed++;
+}
+
+static inline int bench_end(RzBench *b) {
+	pj_end(b->pj);
+	pj_end(b->pj);
+	printf("%s\n", pj_string(b->pj));
+	pj_free(b->pj);
+	return b->failed ? 1 : 0;
+}
+
+#endif /* RZ_BENCH_H */
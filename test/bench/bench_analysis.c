@@ -0,0 +1,80 @@
+// SPDX-FileCopyrightText: 2023 RizinOrg <info@rizin.re>
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#include <rz_analysis.h>
+#include "bench.h"
+
+#define PASSES 20000
+
+typedef struct {
+	const char *name;
+	const char *arch;
+	int bits;
+	bool big_endian;
+	const ut8 *code;
+	int size;
+} ArchCode;
+
+// some prologue, body and epilogue instructions of each arch
+static const ut8 code_x86_64[] =
+	"\x55\x48\x89\xe5\x48\x83\xec\x20\x89\x7d\xec\x48\x89\x75\xe0\x8b"
+	"\x45\xec\x83\xc0\x01\x89\x45\xfc\x48\x8b\x44\x0b\x04\x48\xc7\xc0"
+	"\x04\x00\x00\x00\xe8\x00\x00\x00\x00\x85\xc0\x74\x05\xc9\xc3";
+static const ut8 code_arm_32[] =
+	"\x00\x48\x2d\xe9\x04\xb0\x8d\xe2\x08\xd0\x4d\xe2\x08\x00\x0b\xe5"
+	"\x08\x30\x1b\xe5\x01\x30\x83\xe2\x03\x00\xa0\xe1\x00\x00\x50\xe3"
+	"\x01\x00\x00\x0a\x04\xd0\x4b\xe2\x00\x88\xbd\xe8";
+static const ut8 code_arm_64[] =
+	"\xfd\x7b\xbe\xa9\xfd\x03\x00\x91\xe0\x1f\x00\xb9\xe0\x1f\x40\xb9"
+	"\x00\x04\x00\x11\x41\x68\x63\xf8\x01\x32\x80\xd2\x1f\x00\x00\x71"
+	"\x40\x00\x00\x54\xfd\x7b\xc2\xa8\xc0\x03\x5f\xd6";
+static const ut8 code_mips_32[] =
+	"\x27\xbd\xff\xe0\xaf\xbf\x00\x1c\xaf\xbe\x00\x18\x03\xa0\xf0\x25"
+	"\xaf\xc4\x00\x20\x8f\xc2\x00\x20\x24\x42\x00\x01\x10\x40\x00\x03"
+	"\x00\x00\x00\x00\x8f\xbf\x00\x1c\x03\xe0\x00\x08\x27\xbd\x00\x20";
+
+static const ArchCode archs[] = {
+	{ "op.x86.64", "x86", 64, false, code_x86_64, sizeof(code_x86_64) - 1 },
+	{ "op.arm.32", "arm", 32, false, code_arm_32, sizeof(code_arm_32) - 1 },
+	{ "op.arm.64", "arm", 64, false, code_arm_64, sizeof(code_arm_64) - 1 },
+	{ "op.mips.32", "mips", 32, true, code_mips_32, sizeof(code_mips_32) - 1 },
+};
+
+static void bench_op(RzBench *b, const ArchCode *ac, RzAnalysisOpMask mask, const char *name) {
+	RzAnalysis *analysis = rz_analysis_new();
+	if (!analysis || !rz_analysis_use(analysis, ac->arch)) {
+		bench_skip(b, name, "arch not available");
+		rz_analysis_free(analysis);
+		return;
+	}
+	rz_analysis_set_bits(analysis, ac->bits);
+	rz_analysis_set_big_endian(analysis, ac->big_endian);
+	ut64 count = 0;
+	RzAnalysisOp op;
+	bench_start(b, name);
+	for (int pass = 0; pass < PASSES; pass++) {
+		int off = 0;
+		while (off < ac->size) {
+			rz_analysis_op_init(&op);
+			int ret = rz_analysis_op(analysis, &op, 0x1000 + off, ac->code + off, ac->size - off, mask);
+			bench_sink += op.type;
+			rz_analysis_op_fini(&op);
+			off += ret > 0 ? ret : 1;
+			count++;
+		}
+	}
+	bench_stop(b, count);
+	rz_analysis_free(analysis);
+}
+
+int main(int argc, char **argv) {
+	RzBench b;
+	bench_init(&b, "analysis");
+	for (size_t i = 0; i < RZ_ARRAY_SIZE(archs); i++) {
+		bench_op(&b, &archs[i], RZ_ANALYSIS_OP_MASK_BASIC, archs[i].name);
+		char *name = rz_str_newf("%s.all", archs[i].name);
+		bench_op(&b, &archs[i], RZ_ANALYSIS_OP_MASK_ALL, name);
+		free(name);
+	}
+	return bench_end(&b);
+}
@@ -0,0 +1,78 @@
+// SPDX-FileCopyrightText: 2023 RizinOrg <info@rizin.re>
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#include <rz_core.h>
+#include <rz_bin.h>
+#include "bench.h"
+
+// fixtures from the test/bins repository, relative to test/
+static const char *fixtures[] = {
+	"bins/elf/ls",
+	"bins/pe/testapp-msvc64.exe",
+	"bins/mach0/hello-macos-arm64",
+};
+
+#define STRINGS_PASSES 10
+
+static void bench_bin_file_strings(RzBench *b, const char *path) {
+	char *name = rz_str_newf("bin_file_strings.%s", rz_file_basename(path));
+	if (!rz_file_exists(path)) {
+		bench_skip(b, name, "fixture not found");
+		free(name);
+		return;
+	}
+	RzBin *bin = rz_bin_new();
+	RzIO *io = rz_io_new();
+	rz_io_bind(io, &bin->iob);
+	RzBinOptions opt = { 0 };
+	rz_bin_options_init(&opt, 0, 0, 0, false);
+	RzBinFile *bf = rz_bin_open(bin, path, &opt);
+	if (!bf) {
+		bench_fail(b, name, "cannot open the fixture");
+		goto beach;
+	}
+	bench_start(b, name);
+	for (int i = 0; i < STRINGS_PASSES; i++) {
+		RzList *strings = rz_bin_file_strings(bf, 4, true);
+		bench_sink += rz_list_length(strings);
+		rz_list_free(strings);
+	}
+	bench_stop(b, STRINGS_PASSES);
+beach:
+	rz_bin_free(bin);
+	rz_io_free(io);
+	free(name);
+}
+
+static void bench_core_analysis_all(RzBench *b, const char *path) {
+	char *name = rz_str_newf("core_analysis_all.%s", rz_file_basename(path));
+	if (!rz_file_exists(path)) {
+		bench_skip(b, name, "fixture not found");
+		free(name);
+		return;
+	}
+	RzCore *core = rz_core_new();
+	if (!core || !rz_core_file_open_load(core, path, 0, RZ_PERM_R, false)) {
+		bench_fail(b, name, "cannot load the fixture");
+		goto beach;
+	}
+	bench_start(b, name);
+	rz_core_analysis_all(core);
+	bench_sink += rz_list_length(core->analysis->fcns);
+	bench_stop(b, 1);
+beach:
+	rz_core_free(core);
+	free(name);
+}
+
+int main(int argc, char **argv) {
+	RzBench b;
+	bench_init(&b, "core");
+	for (size_t i = 0; i < RZ_ARRAY_SIZE(fixtures); i++) {
+		bench_bin_file_strings(&b, fixtures[i]);
+	}
+	for (size_t i = 0; i < RZ_ARRAY_SIZE(fixtures); i++) {
+		bench_core_analysis_all(&b, fixtures[i]);
+	}
+	return bench_end(&b);
+}
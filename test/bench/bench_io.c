@@ -0,0 +1,55 @@
+// SPDX-FileCopyrightText: 2023 RizinOrg <info@rizin.re>
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#include <rz_io.h>
+#include "bench.h"
+
+#define MAPS_COUNT 1024
+#define MAP_SIZE   0x1000
+#define READ_SIZE  0x20
+#define READS      (1 << 20)
+
+static void bench_read_at_maps(RzBench *b) {
+	RzIO *io = rz_io_new();
+	io->va = true;
+	char *uri = rz_str_newf("malloc://%d", MAPS_COUNT * MAP_SIZE);
+	int fd = rz_io_fd_open(io, uri, RZ_PERM_RW, 0);
+	free(uri);
+	if (fd < 0) {
+		bench_fail(b, "read_at.maps", "cannot open the desc");
+		rz_io_free(io);
+		return;
+	}
+	// maps are spread with a gap between each other, in reverse order of priority
+	for (ut64 i = 0; i < MAPS_COUNT; i++) {
+		ut64 idx = MAPS_COUNT - 1 - i;
+		rz_io_map_add(io, fd, RZ_PERM_RW, idx * MAP_SIZE, idx * MAP_SIZE * 2, MAP_SIZE);
+	}
+	ut8 buf[READ_SIZE];
+	ut64 addr = 0;
+	bench_start(b, "read_at.maps");
+	for (ut64 i = 0; i < READS; i++) {
+		rz_io_read_at(io, addr, buf, sizeof(buf));
+		bench_sink += buf[0];
+		// deterministic walk over all the maps and the gaps in between
+		addr = (addr + 0x1234567) % (MAPS_COUNT * MAP_SIZE * 2);
+	}
+	bench_stop(b, READS);
+
+	io->rcache = true;
+	bench_start(b, "read_at.maps.rcache");
+	for (ut64 i = 0; i < READS; i++) {
+		rz_io_read_at(io, addr, buf, sizeof(buf));
+		bench_sink += buf[0];
+		addr = (addr + 0x1234567) % (MAPS_COUNT * MAP_SIZE * 2);
+	}
+	bench_stop(b, READS);
+	rz_io_free(io);
+}
+
+int main(int argc, char **argv) {
+	RzBench b;
+	bench_init(&b, "io");
+	bench_read_at_maps(&b);
+	return bench_end(&b);
+}
@@ -0,0 +1,99 @@
+// SPDX-FileCopyrightText: 2023 RizinOrg <info@rizin.re>
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#include <rz_flag.h>
+#include <rz_diff.h>
+#include <sdb.h>
+#include "bench.h"
+
+#define FLAGS_COUNT  0x10000
+#define FLAG_LOOKUPS (1 << 20)
+#define SDB_KEYS     0x10000
+#define SDB_PASSES   8
+#define DIFF_SIZE    0x1000
+#define DIFF_PASSES  4
+
+static void bench_flag_get_i(RzBench *b) {
+	RzFlag *flag = rz_flag_new();
+	char name[32];
+	for (ut64 i = 0; i < FLAGS_COUNT; i++) {
+		snprintf(name, sizeof(name), "sym.bench_%" PFMT64x, i);
+		rz_flag_set(flag, name, 0x400000 + i * 0x10, 0x10);
+	}
+	ut64 addr = 0;
+	bench_start(b, "flag_get_i");
+	for (ut64 i = 0; i < FLAG_LOOKUPS; i++) {
+		// hits and misses, flags are 0x10 aligned
+		RzFlagItem *fi = rz_flag_get_i(flag, 0x400000 + addr);
+		bench_sink += fi ? fi->offset : 0;
+		addr = (addr + 0x1238) % (FLAGS_COUNT * 0x10);
+	}
+	bench_stop(b, FLAG_LOOKUPS);
+	rz_flag_free(flag);
+}
+
+static void bench_sdb(RzBench *b) {
+	Sdb *db = sdb_new0();
+	char key[32], val[32];
+	bench_start(b, "sdb_set");
+	for (int pass = 0; pass < SDB_PASSES; pass++) {
+		for (int i = 0; i < SDB_KEYS; i++) {
+			snprintf(key, sizeof(key), "key.%d", i);
+			snprintf(val, sizeof(val), "0x%x", i * (pass + 1));
+			sdb_set(db, key, val, 0);
+		}
+	}
+	bench_stop(b, SDB_PASSES * SDB_KEYS);
+
+	bench_start(b, "sdb_get");
+	for (int pass = 0; pass < SDB_PASSES; pass++) {
+		for (int i = 0; i < SDB_KEYS; i++) {
+			snprintf(key, sizeof(key), "key.%d", (i * 7919) % SDB_KEYS);
+			const char *v = sdb_const_get(db, key, NULL);
+			bench_sink += v ? v[0] : 0;
+		}
+	}
+	bench_stop(b, SDB_PASSES * SDB_KEYS);
+	sdb_free(db);
+}
+
+static void bench_diff_bytes(RzBench *b) {
+	ut8 *a = malloc(DIFF_SIZE);
+	ut8 *c = malloc(DIFF_SIZE);
+	if (!a || !c) {
+		bench_fail(b, "diff_bytes", "cannot allocate the buffers");
+		free(a);
+		free(c);
+		return;
+	}
+	// same pseudo-random content, with some bytes changed, inserted and removed
+	ut32 seed = 0x1337;
+	for (int i = 0; i < DIFF_SIZE; i++) {
+		seed = seed * 1103515245 + 12345;
+		a[i] = c[i] = (seed >> 16) & 0xff;
+	}
+	for (int i = 0; i < DIFF_SIZE; i += 0x200) {
+		c[i] ^= 0xff;
+		memmove(c + i + 0x20, c + i + 0x21, 0x100);
+	}
+	bench_start(b, "diff_bytes");
+	for (int i = 0; i < DIFF_PASSES; i++) {
+		RzDiff *diff = rz_diff_bytes_new(a, DIFF_SIZE, c, DIFF_SIZE, NULL);
+		RzList *ops = diff ? rz_diff_opcodes_new(diff) : NULL;
+		bench_sink += rz_list_length(ops);
+		rz_list_free(ops);
+		rz_diff_free(diff);
+	}
+	bench_stop(b, DIFF_PASSES);
+	free(a);
+	free(c);
+}
+
+int main(int argc, char **argv) {
+	RzBench b;
+	bench_init(&b, "util");
+	bench_flag_get_i(&b);
+	bench_sdb(&b);
+	bench_diff_bytes(&b);
+	return bench_end(&b);
+}
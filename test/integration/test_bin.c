@@ -158,6 +158,62 @@ bool test_rz_bin_reloc_storage(void) {
 	mu_end;
 }
 
+bool test_rz_bin_symbol_index(void) {
+	RzBinObject o = { 0 };
+	o.lazy_lock = rz_th_lock_new(true);
+	o.symbols = rz_list_newf((RzListFree)rz_bin_symbol_free);
+	RzBinSymbol *s0 = rz_bin_symbol_new("foo", 0x300, 0x1300);
+	RzBinSymbol *s1 = rz_bin_symbol_new("bar", 0x100, 0x1100);
+	RzBinSymbol *s2 = rz_bin_symbol_new("foo", 0x200, 0x1200);
+	RzBinSymbol *s3 = rz_bin_symbol_new("baz", 0x100, 0x1100);
+	rz_list_append(o.symbols, s0);
+	rz_list_append(o.symbols, s1);
+	rz_list_append(o.symbols, s2);
+	rz_list_append(o.symbols, s3);
+
+	RzBinSymbolIndex *index = rz_bin_object_get_symbol_index(&o);
+	mu_assert_notnull(index, "index");
+	mu_assert_eq(index->count, 4, "count");
+	mu_assert_ptreq(index->by_vaddr[0], s1, "vaddr order");
+	mu_assert_ptreq(index->by_vaddr[1], s3, "vaddr order keeps the list order");
+	mu_assert_ptreq(index->by_vaddr[2], s2, "vaddr order");
+	mu_assert_ptreq(index->by_vaddr[3], s0, "vaddr order");
+	mu_assert_eq(rz_bin_symbol_index_lower_paddr(index, 0x101), 2, "lower paddr");
+	mu_assert_ptreq(rz_bin_object_get_symbol_index(&o), index, "index is kept");
+
+	mu_assert_ptreq(rz_bin_object_get_symbol_at(&o, 0x1100), s1, "at");
+	mu_assert_null(rz_bin_object_get_symbol_at(&o, 0x1101), "at");
+	mu_assert_ptreq(rz_bin_object_get_symbol_at_paddr(&o, 0x200), s2, "at paddr");
+	mu_assert_null(rz_bin_object_get_symbol_at_paddr(&o, 0x1200), "at paddr");
+	mu_assert_ptreq(rz_bin_object_get_symbol_by_name(&o, "foo"), s0, "by name gives the first one");
+	mu_assert_ptreq(rz_bin_object_get_symbol_by_name(&o, "baz"), s3, "by name");
+	mu_assert_null(rz_bin_object_get_symbol_by_name(&o, "qux"), "by name");
+
+	mu_assert_ptreq(rz_bin_object_get_symbol_nearest(&o, 0), s1, "nearest before all");
+	mu_assert_ptreq(rz_bin_object_get_symbol_nearest(&o, 0x1180), s1, "nearest on tie");
+	mu_assert_ptreq(rz_bin_object_get_symbol_nearest(&o, 0x1181), s2, "nearest after");
+	mu_assert_ptreq(rz_bin_object_get_symbol_nearest(&o, 0x1200), s2, "nearest exact");
+	mu_assert_ptreq(rz_bin_object_get_symbol_nearest(&o, UT64_MAX), s0, "nearest after all");
+
+	RzPVector *in = rz_bin_object_get_symbols_in(&o, 0x1100, 0x101);
+	mu_assert_eq(rz_pvector_len(in), 3, "symbols in");
+	mu_assert_ptreq(rz_pvector_at(in, 2), s2, "symbols in");
+	rz_pvector_free(in);
+	in = rz_bin_object_get_symbols_in(&o, 0x1301, UT64_MAX);
+	mu_assert_eq(rz_pvector_len(in), 0, "symbols in");
+	rz_pvector_free(in);
+
+	RzBinSymbol *s4 = rz_bin_symbol_new("qux", 0x50, 0x1050);
+	rz_list_append(o.symbols, s4);
+	mu_assert_ptreq(rz_bin_object_get_symbol_by_name(&o, "qux"), s4, "index follows new symbols");
+	mu_assert_ptreq(rz_bin_object_get_symbol_nearest(&o, 0), s4, "index follows new symbols");
+
+	rz_bin_symbol_index_free(o.symbols_index);
+	rz_list_free(o.symbols);
+	rz_th_lock_free(o.lazy_lock);
+	mu_end;
+}
+
 typedef struct {
 	RzList /*<RzBinFile>*/ *expect; /// things whose delete events are expected now
 	bool failed_unexpected;
@@ -335,13 +391,206 @@ bool test_rz_bin_p2v2p(void) {
 	mu_end;
 }
 
+static const RzBinPlugin *cache_elf_plugin;
+static RzBinPlugin cache_counted_plugin;
+static int cache_plugin_calls;
+
+static RzList /*<RzBinSymbol *>*/ *cache_counted_symbols(RzBinFile *bf) {
+	cache_plugin_calls++;
+	return cache_elf_plugin->symbols(bf);
+}
+
+static RzList /*<RzBinImport *>*/ *cache_counted_imports(RzBinFile *bf) {
+	cache_plugin_calls++;
+	return cache_elf_plugin->imports(bf);
+}
+
+static RzList /*<char *>*/ *cache_counted_libs(RzBinFile *bf) {
+	cache_plugin_calls++;
+	return cache_elf_plugin->libs(bf);
+}
+
+static RzList /*<RzBinReloc *>*/ *cache_counted_relocs(RzBinFile *bf) {
+	cache_plugin_calls++;
+	return cache_elf_plugin->relocs(bf);
+}
+
+/**
+ * Opens crackme0x00 with a copy of the elf plugin counting the calls
+ * to the callbacks whose items are taken from the snapshot.
+ */
+static RzBinObject *cache_open(RzBin *bin, RzIO *io, const char *cache_dir) {
+	rz_io_bind(io, &bin->iob);
+	rz_bin_set_cache_dir(bin, cache_dir);
+	if (!cache_elf_plugin) {
+		cache_elf_plugin = rz_bin_plugin_get(bin, "elf");
+		if (!cache_elf_plugin) {
+			return NULL;
+		}
+		cache_counted_plugin = *cache_elf_plugin;
+		cache_counted_plugin.name = "elf_counted";
+		cache_counted_plugin.magics = NULL;
+		cache_counted_plugin.symbols = cache_counted_symbols;
+		cache_counted_plugin.imports = cache_counted_imports;
+		cache_counted_plugin.libs = cache_counted_libs;
+		cache_counted_plugin.relocs = cache_counted_relocs;
+	}
+	rz_bin_plugin_add(bin, &cache_counted_plugin);
+	rz_bin_force_plugin(bin, "elf_counted");
+	RzBinOptions opt = { 0 };
+	rz_bin_options_init(&opt, 0, 0, 0, false);
+	cache_plugin_calls = 0;
+	RzBinFile *bf = rz_bin_open(bin, "bins/elf/ioli/crackme0x00", &opt);
+	return bf ? bf->o : NULL;
+}
+
+bool test_rz_bin_cache(void) {
+	char *tmp = rz_file_tmpdir();
+	char *dir = rz_str_newf("%s" RZ_SYS_DIR "rz-bin-cache-%d", tmp, rz_sys_getpid());
+	const char *file = "bins/elf/ioli/crackme0x00";
+	char *snapshot = rz_str_newf("%s" RZ_SYS_DIR "%" PFMT64x "-%" PFMT64x ".elf_counted", dir, rz_file_size(file), rz_file_mtime(file));
+	char *obj_path = rz_str_newf("%s.obj", snapshot);
+	char *str_path = rz_str_newf("%s.str", snapshot);
+	char *old_path = rz_str_newf("%s" RZ_SYS_DIR "0-0.elf_counted.obj", dir);
+
+	RzBin *bin = rz_bin_new();
+	RzIO *io = rz_io_new();
+	RzBinObject *obj = cache_open(bin, io, dir);
+	mu_assert_notnull(obj, "first open");
+	mu_assert_true(cache_plugin_calls > 0, "items loaded by the plugin");
+	mu_assert_true(rz_file_exists(obj_path), "object snapshot written");
+	mu_assert_false(rz_file_exists(str_path), "strings are not scanned yet");
+	mu_assert_eq(rz_list_length(rz_bin_object_get_strings(obj)), 5, "strings");
+	mu_assert_true(rz_file_exists(str_path), "strings snapshot written");
+
+	RzBin *cached_bin = rz_bin_new();
+	RzIO *cached_io = rz_io_new();
+	RzBinObject *cached = cache_open(cached_bin, cached_io, dir);
+	mu_assert_notnull(cached, "second open");
+	mu_assert_eq(cache_plugin_calls, 0, "items loaded from the snapshot");
+
+	const RzList *symbols = rz_bin_object_get_symbols(obj);
+	const RzList *cached_symbols = rz_bin_object_get_symbols(cached);
+	mu_assert_eq(rz_list_length(cached_symbols), rz_list_length(symbols), "symbols");
+	RzListIter *it, *cached_it;
+	RzBinSymbol *sym, *cached_sym;
+	for (it = rz_list_iterator(symbols), cached_it = rz_list_iterator(cached_symbols); it && cached_it; it = it->n, cached_it = cached_it->n) {
+		sym = it->data;
+		cached_sym = cached_it->data;
+		mu_assert_streq(cached_sym->name, sym->name, "symbol name");
+		mu_assert_streq(cached_sym->type, sym->type, "symbol type");
+		mu_assert_eq(cached_sym->vaddr, sym->vaddr, "symbol vaddr");
+		mu_assert_eq(cached_sym->paddr, sym->paddr, "symbol paddr");
+	}
+	mu_assert_eq(rz_list_length(rz_bin_object_get_imports(cached)), 5, "imports");
+	mu_assert_eq(rz_list_length(rz_bin_object_get_libs(cached)), rz_list_length(rz_bin_object_get_libs(obj)), "libs");
+
+	RzBinRelocStorage *relocs = obj->relocs;
+	RzBinRelocStorage *cached_relocs = cached->relocs;
+	mu_assert_notnull(relocs, "relocs");
+	mu_assert_notnull(cached_relocs, "cached relocs");
+	mu_assert_eq(cached_relocs->relocs_count, relocs->relocs_count, "relocs");
+	for (size_t i = 0; i < relocs->relocs_count; i++) {
+		mu_assert_eq(cached_relocs->relocs[i]->vaddr, relocs->relocs[i]->vaddr, "reloc vaddr");
+		mu_assert_eq(cached_relocs->relocs[i]->type, relocs->relocs[i]->type, "reloc type");
+		if (relocs->relocs[i]->import) {
+			mu_assert_streq(cached_relocs->relocs[i]->import->name, relocs->relocs[i]->import->name, "reloc import");
+		}
+	}
+
+	const RzList *cached_strings = rz_bin_object_get_strings(cached);
+	mu_assert_eq(rz_list_length(cached_strings), 5, "cached strings");
+	RzBinString *bstr = rz_list_first(cached_strings);
+	mu_assert_streq(bstr->string, "IOLI Crackme Level 0x00\n", "cached string");
+	mu_assert_notnull(rz_bin_object_get_string_at(cached, bstr->vaddr, true), "cached string lookup");
+
+	// other settings miss the snapshot, rewriting it evicts the others beyond bin.cache.maxsize
+	mu_assert_true(rz_file_dump(old_path, (const ut8 *)"RZBC", 4, false), "old snapshot");
+	RzBin *evict_bin = rz_bin_new();
+	RzIO *evict_io = rz_io_new();
+	evict_bin->minstrlen = 8;
+	evict_bin->cache_max_size = 1;
+	mu_assert_notnull(cache_open(evict_bin, evict_io, dir), "third open");
+	mu_assert_true(cache_plugin_calls > 0, "snapshot taken with other settings ignored");
+	mu_assert_true(rz_file_exists(obj_path), "new snapshot kept");
+	mu_assert_false(rz_file_exists(str_path), "strings snapshot evicted");
+	mu_assert_false(rz_file_exists(old_path), "old snapshot evicted");
+
+	rz_bin_free(evict_bin);
+	rz_io_free(evict_io);
+	rz_bin_free(cached_bin);
+	rz_io_free(cached_io);
+	rz_bin_free(bin);
+	rz_io_free(io);
+	rz_file_rm(obj_path);
+	rz_file_rm(str_path);
+	rz_file_rm(old_path);
+	rz_file_rm(dir);
+	free(old_path);
+	free(obj_path);
+	free(str_path);
+	free(snapshot);
+	free(dir);
+	free(tmp);
+	mu_end;
+}
+
+static bool probe_test_check_buffer(RzBuffer *b) {
+	ut8 tmp[6];
+	return rz_buf_read_at(b, 0, tmp, sizeof(tmp)) == sizeof(tmp) && !memcmp(tmp, "RZTEST", 6);
+}
+
+static const RzBinMagic probe_test_magics[] = {
+	RZ_BIN_MAGIC("RZTEST"),
+	{ 0 }
+};
+
+static const char *probe_plugin_name(RzBin *bin, const char *magic, size_t magic_len) {
+	ut8 header[0x40] = { 0 };
+	memcpy(header, magic, magic_len);
+	RzBuffer *buf = rz_buf_new_with_bytes(header, sizeof(header));
+	RzBinPlugin *plugin = rz_bin_get_binplugin_by_buffer(bin, buf);
+	rz_buf_free(buf);
+	return plugin ? plugin->name : NULL;
+}
+
+bool test_rz_bin_plugin_probe(void) {
+	RzBin *bin = rz_bin_new();
+	mu_assert_streq(probe_plugin_name(bin, "\x7f" "ELF\x01", 5), "elf", "elf32");
+	mu_assert_streq(probe_plugin_name(bin, "\x7f" "ELF\x02", 5), "elf64", "elf64");
+	mu_assert_streq(probe_plugin_name(bin, "\xce\xfa\xed\xfe", 4), "mach0", "mach0");
+	mu_assert_streq(probe_plugin_name(bin, "\xcf\xfa\xed\xfe", 4), "mach064", "mach064");
+	mu_assert_streq(probe_plugin_name(bin, "dex\n", 4), "dex", "dex");
+	// both ELF plugins match the plain prefix, their check_buffer tells the class apart
+	const char *elf_name = probe_plugin_name(bin, "\x7f" "ELF\x03", 5);
+	mu_assert_true(!elf_name || (strcmp(elf_name, "elf") && strcmp(elf_name, "elf64")), "unknown elf class");
+
+	RzBinPlugin test_plugin = {
+		.name = "rztest",
+		.check_buffer = probe_test_check_buffer,
+		.magics = probe_test_magics,
+	};
+	mu_assert_true(rz_bin_plugin_add(bin, &test_plugin), "add plugin");
+	mu_assert_streq(probe_plugin_name(bin, "RZTEST", 6), "rztest", "plugin added after rz_bin_new");
+	mu_assert_streq(probe_plugin_name(bin, "\x7f" "ELF\x01", 5), "elf", "elf32 with the new plugin");
+	mu_assert_true(rz_bin_plugin_del(bin, &test_plugin), "del plugin");
+	const char *name = probe_plugin_name(bin, "RZTEST", 6);
+	mu_assert_true(!name || strcmp(name, "rztest"), "deleted plugin");
+
+	rz_bin_free(bin);
+	mu_end;
+}
+
 bool all_tests() {
 	mu_run_test(test_rz_bin);
 	mu_run_test(test_rz_bin_reloc_storage);
+	mu_run_test(test_rz_bin_symbol_index);
 	mu_run_test(test_rz_bin_file_delete);
 	mu_run_test(test_rz_bin_file_delete_all);
 	mu_run_test(test_rz_bin_sections_mapping);
 	mu_run_test(test_rz_bin_p2v2p);
+	mu_run_test(test_rz_bin_cache);
+	mu_run_test(test_rz_bin_plugin_probe);
 	return tests_passed != tests_run;
 }
 
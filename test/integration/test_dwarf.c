@@ -1559,6 +1559,56 @@ bool test_dwarf3_aranges(void) {
 	mu_end;
 }
 
+bool test_dwarf_index_info(void) {
+	RzBin *bin = rz_bin_new();
+	RzIO *io = rz_io_new();
+	rz_io_bind(io, &bin->iob);
+
+	RzBinOptions opt = { 0 };
+	rz_bin_options_init(&opt, 0, 0, 0, false);
+	RzBinFile *bf = rz_bin_open(bin, "bins/elf/dwarf3_many_comp_units.elf", &opt);
+	mu_assert_notnull(bf, "couldn't open file");
+
+	RzBinDwarfDebugAbbrev *da = rz_bin_dwarf_parse_abbrev(bf);
+	mu_assert_notnull(da, "abbrevs");
+	RzBinDwarfDebugInfo *info = rz_bin_dwarf_parse_info(bf, da);
+	mu_assert_notnull(info, "parsed info");
+	RzBinDwarfDebugInfo *index = rz_bin_dwarf_index_info(bf, da);
+	mu_assert_notnull(index, "indexed info");
+	mu_assert_eq(index->count, info->count, "units count");
+	mu_assert_null(index->comp_units[0].dies, "units are not decoded by the index");
+	mu_assert_eq(index->line_info_offset_comp_dir->count, info->line_info_offset_comp_dir->count, "comp dirs");
+
+	for (size_t i = 0; i < info->count; i++) {
+		RzBinDwarfCompUnit *unit = &info->comp_units[i];
+		RzBinDwarfCompUnit *lazy = rz_bin_dwarf_debug_info_get_unit(index, i);
+		mu_assert_notnull(lazy, "decoded unit");
+		mu_assert_eq(lazy->offset, unit->offset, "unit offset");
+		mu_assert_eq(lazy->count, unit->count, "dies count");
+		for (size_t j = 0; j < unit->count; j++) {
+			RzBinDwarfDie *die = &unit->dies[j];
+			mu_assert_eq(lazy->dies[j].offset, die->offset, "die offset");
+			mu_assert_eq(lazy->dies[j].tag, die->tag, "die tag");
+			mu_assert_eq(lazy->dies[j].count, die->count, "die attributes");
+			RzBinDwarfDie *found = rz_bin_dwarf_debug_info_find_die(index, die->offset);
+			mu_assert_ptreq(found, &lazy->dies[j], "die lookup");
+		}
+		rz_bin_dwarf_debug_info_release_unit(index, i);
+		mu_assert_null(index->comp_units[i].dies, "released unit");
+	}
+	// units are decoded again on demand
+	RzBinDwarfDie *die = rz_bin_dwarf_debug_info_find_die(index, info->comp_units[1].dies[1].offset);
+	mu_assert_notnull(die, "die of released unit");
+	mu_assert_eq(die->tag, info->comp_units[1].dies[1].tag, "die tag");
+
+	rz_bin_dwarf_debug_info_free(index);
+	rz_bin_dwarf_debug_info_free(info);
+	rz_bin_dwarf_debug_abbrev_free(da);
+	rz_bin_free(bin);
+	rz_io_free(io);
+	mu_end;
+}
+
 bool all_tests() {
 	srand(time(0));
 	mu_run_test(test_dwarf3_c_basic);
@@ -1570,6 +1620,7 @@ bool all_tests() {
 	mu_run_test(test_dwarf4_multidir_comp_units);
 	mu_run_test(test_big_endian_dwarf2);
 	mu_run_test(test_dwarf3_aranges);
+	mu_run_test(test_dwarf_index_info);
 	return tests_passed != tests_run;
 }
 
@@ -321,11 +321,103 @@ static bool test_dwarf_function_parsing_rust(void) {
 	mu_end;
 }
 
+/**
+ * Imports the DWARF of \p path into a new analysis, using up to \p threads
+ * threads, from a fully parsed or only indexed .debug_info.
+ */
+static RzAnalysis *dwarf_import(const char *path, size_t threads, bool indexed) {
+	RzBin *bin = rz_bin_new();
+	RzIO *io = rz_io_new();
+	RzAnalysis *analysis = rz_analysis_new();
+	rz_io_bind(io, &bin->iob);
+	analysis->binb.demangle = rz_bin_demangle;
+	analysis->opt.threads = threads;
+	rz_analysis_set_cpu(analysis, "x86");
+	rz_analysis_set_bits(analysis, 64);
+	char *types_dir = rz_path_system(RZ_SDB_TYPES);
+	rz_type_db_init(analysis->typedb, types_dir, "x86", 64, "linux");
+	free(types_dir);
+
+	RzBinOptions opt = { 0 };
+	rz_bin_options_init(&opt, 0, 0, 0, false);
+	RzBinFile *bf = rz_bin_open(bin, path, &opt);
+	RzBinDwarfDebugAbbrev *abbrevs = bf ? rz_bin_dwarf_parse_abbrev(bf) : NULL;
+	RzBinDwarfDebugInfo *info = NULL;
+	if (abbrevs) {
+		info = indexed ? rz_bin_dwarf_index_info(bf, abbrevs) : rz_bin_dwarf_parse_info(bf, abbrevs);
+	}
+	HtUP /*<offset, List *<LocListEntry>*/ *loc_table = info ? rz_bin_dwarf_parse_loc(bf, 8) : NULL;
+	if (loc_table && info->count >= 16) {
+		RzAnalysisDwarfContext ctx = {
+			.info = info,
+			.loc = loc_table
+		};
+		rz_analysis_dwarf_process_info(analysis, &ctx);
+	} else {
+		rz_analysis_free(analysis);
+		analysis = NULL;
+	}
+	rz_bin_dwarf_debug_info_free(info);
+	rz_bin_dwarf_debug_abbrev_free(abbrevs);
+	rz_bin_dwarf_loc_free(loc_table);
+	rz_bin_free(bin);
+	rz_io_free(io);
+	return analysis;
+}
+
+static int base_type_cmp(const void *a, const void *b) {
+	return strcmp(((const RzBaseType *)a)->name, ((const RzBaseType *)b)->name);
+}
+
+static bool test_dwarf_parallel_import(void) {
+	RzAnalysis *serial = dwarf_import("bins/elf/dwarf_rust_bubble", 1, false);
+	mu_assert_notnull(serial, "serial import of enough units to go parallel");
+	RzAnalysis *parallel = dwarf_import("bins/elf/dwarf_rust_bubble", 4, true);
+	mu_assert_notnull(parallel, "parallel import");
+
+	RzList *expected = rz_type_db_get_base_types(serial->typedb);
+	RzList *types = rz_type_db_get_base_types(parallel->typedb);
+	rz_list_sort(expected, base_type_cmp);
+	rz_list_sort(types, base_type_cmp);
+	mu_assert_eq(rz_list_length(types), rz_list_length(expected), "types count");
+	RzListIter *it, *eit = rz_list_iterator(expected);
+	RzBaseType *btype;
+	rz_list_foreach (types, it, btype) {
+		RzBaseType *ebtype = rz_list_iter_get_data(eit);
+		mu_assert_streq(btype->name, ebtype->name, "type name");
+		mu_assert_eq(btype->kind, ebtype->kind, "type kind");
+		mu_assert_eq(btype->size, ebtype->size, "type size");
+		eit = rz_list_iter_get_next(eit);
+	}
+	rz_list_free(expected);
+	rz_list_free(types);
+
+	SdbList *expected_kvs = sdb_foreach_list(sdb_ns(serial->sdb, "dwarf", 0), true);
+	SdbList *kvs = sdb_foreach_list(sdb_ns(parallel->sdb, "dwarf", 0), true);
+	mu_assert_true(ls_length(kvs) > 0, "functions imported");
+	mu_assert_eq(ls_length(kvs), ls_length(expected_kvs), "sdb entries count");
+	SdbListIter *kit, *ekit = ls_iterator(expected_kvs);
+	SdbKv *kv;
+	ls_foreach (kvs, kit, kv) {
+		SdbKv *ekv = ekit->data;
+		mu_assert_streq(sdbkv_key(kv), sdbkv_key(ekv), "sdb key");
+		mu_assert_streq(sdbkv_value(kv), sdbkv_value(ekv), "sdb value");
+		ekit = ekit->n;
+	}
+	ls_free(expected_kvs);
+	ls_free(kvs);
+
+	rz_analysis_free(serial);
+	rz_analysis_free(parallel);
+	mu_end;
+}
+
 int all_tests(void) {
 	mu_run_test(test_parse_dwarf_types);
 	mu_run_test(test_dwarf_function_parsing_cpp);
 	mu_run_test(test_dwarf_function_parsing_rust);
 	mu_run_test(test_dwarf_function_parsing_go);
+	mu_run_test(test_dwarf_parallel_import);
 	return tests_passed != tests_run;
 }
 
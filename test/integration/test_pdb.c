@@ -35,6 +35,12 @@ bool test_pdb_tpi_cpp(void) {
 	mu_assert_notnull(stream, "TPIs stream not found in current PDB");
 	mu_assert_eq(stream->header.HeaderSize + stream->header.TypeRecordBytes, 117156, "Wrong TPI size");
 	mu_assert_eq(stream->header.TypeIndexBegin, 0x1000, "Wrong beginning index");
+	mu_assert_null(stream->types, "TPI types parsed before lookup");
+	RzPdbTpiType *proc = rz_bin_pdb_get_type_by_index(stream, 0x1028);
+	mu_assert_notnull(proc, "Type not parsed on lookup");
+	mu_assert_eq(proc->leaf_type, LF_PROCEDURE, "Incorrect data type");
+	mu_assert_ptreq(rz_bin_pdb_get_type_by_index(stream, 0x1028), proc, "Type parsed twice");
+	mu_assert_true(rz_bin_pdb_load_all_types(pdb), "Failed to parse the TPI types");
 	RBIter it;
 	RzPdbTpiType *type;
 
@@ -213,6 +219,7 @@ bool test_pdb_tpi_rust(void) {
 	mu_assert_notnull(stream, "TPIs stream not found in current PDB");
 	mu_assert_eq(stream->header.HeaderSize + stream->header.TypeRecordBytes, 305632, "Wrong TPI size");
 	mu_assert_eq(stream->header.TypeIndexBegin, 0x1000, "Wrong beginning index");
+	mu_assert_true(rz_bin_pdb_load_all_types(pdb), "Failed to parse the TPI types");
 	RBIter it;
 	RzPdbTpiType *type;
 
@@ -456,6 +463,7 @@ bool test_pdb_tpi_cpp_vs2019(void) {
 	mu_assert_notnull(stream, "TPIs stream not found in current PDB");
 	mu_assert_eq(stream->header.HeaderSize + stream->header.TypeRecordBytes, 233588, "Wrong TPI size");
 	mu_assert_eq(stream->header.TypeIndexBegin, 0x1000, "Wrong beginning index");
+	mu_assert_true(rz_bin_pdb_load_all_types(pdb), "Failed to parse the TPI types");
 	RBIter it;
 	RzPdbTpiType *type;
 
@@ -710,6 +718,7 @@ bool test_pdb_tpi_arm(void) {
 	mu_assert_notnull(stream, "TPIs stream not found in current PDB");
 	mu_assert_eq(stream->header.HeaderSize + stream->header.TypeRecordBytes, 454428, "Wrong TPI size");
 	mu_assert_eq(stream->header.TypeIndexBegin, 0x1000, "Wrong beginning index");
+	mu_assert_true(rz_bin_pdb_load_all_types(pdb), "Failed to parse the TPI types");
 	RBIter it;
 	RzPdbTpiType *type;
 
@@ -97,6 +97,80 @@ bool test_rz_analysis_op_val() {
 	mu_end;
 }
 
+bool test_rz_analysis_op_cache() {
+	RzAnalysis *analysis = rz_analysis_new();
+	RzAnalysisOp op;
+	ut64 hits = 0, misses = 0;
+	SWITCH_TO_ARCH_BITS("x86", 64);
+	mu_assert_true(rz_analysis_op_cache_enable(analysis, true), "enable op cache");
+
+	// mov rax, [rbx+rcx+4]
+	const ut8 *bytes = (const ut8 *)"\x48\x8b\x44\x0b\x04";
+	char *esil = NULL;
+	for (int i = 0; i < 2; i++) {
+		int len = rz_analysis_op(analysis, &op, 0x1000, bytes, 5, RZ_ANALYSIS_OP_MASK_VAL | RZ_ANALYSIS_OP_MASK_ESIL);
+		mu_assert_eq(len, 5, "Op is of size 5");
+		mu_assert_eq(op.addr, 0x1000, "Op address");
+		mu_assert_streq(op.dst->reg->name, "rax", "Dst reg should be rax");
+		mu_assert_streq(op.src[0]->regdelta->name, "rcx", "Source reg delta should be rcx");
+		if (!esil) {
+			esil = strdup(rz_strbuf_get(&op.esil));
+		} else {
+			mu_assert_streq(rz_strbuf_get(&op.esil), esil, "cached esil");
+		}
+		rz_analysis_op_fini(&op);
+	}
+	free(esil);
+	rz_analysis_op_cache_stats(analysis->opcache, &hits, &misses);
+	mu_assert_eq(hits, 1, "second decode is a cache hit");
+	mu_assert_eq(misses, 1, "first decode is a cache miss");
+
+	// same address, different bytes: mov rax, 4
+	int len = rz_analysis_op(analysis, &op, 0x1000, (const ut8 *)"\x48\xc7\xc0\x04\x00\x00\x00", 7, RZ_ANALYSIS_OP_MASK_VAL | RZ_ANALYSIS_OP_MASK_ESIL);
+	mu_assert_eq(len, 7, "Op is of size 7");
+	mu_assert_eq(op.src[0]->type, RZ_ANALYSIS_VAL_IMM, "Source should be imm");
+	rz_analysis_op_fini(&op);
+	rz_analysis_op_cache_stats(analysis->opcache, &hits, &misses);
+	mu_assert_eq(hits, 1, "changed bytes are not a cache hit");
+
+	// a different mask is decoded again
+	len = rz_analysis_op(analysis, &op, 0x1000, (const ut8 *)"\x48\xc7\xc0\x04\x00\x00\x00", 7, RZ_ANALYSIS_OP_MASK_BASIC);
+	mu_assert_eq(len, 7, "Op is of size 7");
+	rz_analysis_op_fini(&op);
+	rz_analysis_op_cache_stats(analysis->opcache, &hits, &misses);
+	mu_assert_eq(misses, 3, "different mask is a cache miss");
+
+	// replacing the register profile directly drops the ops borrowing its items
+	const ut8 *mov_rax = (const ut8 *)"\x48\xc7\xc0\x04\x00\x00\x00";
+	len = rz_analysis_op(analysis, &op, 0x1000, mov_rax, 7, RZ_ANALYSIS_OP_MASK_VAL);
+	rz_analysis_op_fini(&op);
+	char *profile = strdup(analysis->reg->reg_profile_str);
+	mu_assert_true(rz_reg_set_profile_string(analysis->reg, "=PC pc\ngpr pc .64 0 0\n"), "set other profile");
+	mu_assert_true(rz_reg_set_profile_string(analysis->reg, profile), "restore profile");
+	free(profile);
+	rz_analysis_op_cache_stats(analysis->opcache, &hits, &misses);
+	ut64 prev_hits = hits;
+	len = rz_analysis_op(analysis, &op, 0x1000, mov_rax, 7, RZ_ANALYSIS_OP_MASK_VAL);
+	mu_assert_eq(len, 7, "Op is of size 7");
+	mu_assert_ptreq(op.dst->reg, rz_reg_get(analysis->reg, "rax", -1), "Dst reg is an item of the current profile");
+	rz_analysis_op_fini(&op);
+	rz_analysis_op_cache_stats(analysis->opcache, &hits, &misses);
+	mu_assert_eq(hits, prev_hits, "register profile change is a cache miss");
+
+	// changing the arch flushes the cache
+	SWITCH_TO_ARCH_BITS("arm", 64);
+	// mov x1, 400
+	len = rz_analysis_op(analysis, &op, 0x1000, (const ut8 *)"\x01\x32\x80\xd2", 4, RZ_ANALYSIS_OP_MASK_VAL);
+	mu_assert_eq(len, 4, "Op is of size 4");
+	mu_assert_streq(op.dst->reg->name, "x1", "Dst reg should be x1");
+	rz_analysis_op_fini(&op);
+
+	mu_assert_true(rz_analysis_op_cache_enable(analysis, false), "disable op cache");
+	mu_assert_null(analysis->opcache, "op cache freed");
+	rz_analysis_free(analysis);
+	mu_end;
+}
+
 bool test_rz_core_analysis_bytes() {
 	RzCore *core = rz_core_new();
 	rz_core_set_asm_configs(core, "x86", 64, 0);
@@ -173,6 +247,7 @@ bool test_rz_core_print_disasm() {
 
 int all_tests() {
 	mu_run_test(test_rz_analysis_op_val);
+	mu_run_test(test_rz_analysis_op_cache);
 	mu_run_test(test_rz_core_analysis_bytes);
 	mu_run_test(test_rz_core_print_disasm);
 	return tests_passed != tests_run;
@@ -21,8 +21,97 @@ bool test_rz_analysis_xrefs_count() {
 	mu_end;
 }
 
+static bool sum_xrefs_cb(RzAnalysisXRef *xref, void *user) {
+	ut64 *sum = user;
+	*sum += xref->from + xref->to + xref->type;
+	return true;
+}
+
+static bool count_one_xref_cb(RzAnalysisXRef *xref, void *user) {
+	(*(int *)user)++;
+	return false;
+}
+
+bool test_rz_analysis_xrefs_get() {
+	RzAnalysis *analysis = rz_analysis_new();
+
+	rz_analysis_xrefs_set(analysis, 0x1337, 42, RZ_ANALYSIS_XREF_TYPE_DATA);
+	rz_analysis_xrefs_set(analysis, 0x1337, 43, RZ_ANALYSIS_XREF_TYPE_CODE);
+	rz_analysis_xrefs_set(analysis, 1234, 43, RZ_ANALYSIS_XREF_TYPE_CALL);
+	rz_analysis_xrefs_set(analysis, 1234, 43, RZ_ANALYSIS_XREF_TYPE_STRING);
+
+	RzList *xrefs = rz_analysis_xrefs_get_from(analysis, 0x1337);
+	mu_assert_eq(rz_list_length(xrefs), 2, "xrefs from count");
+	RzAnalysisXRef *xref = rz_list_first(xrefs);
+	mu_assert_eq(xref->from, 0x1337, "xref from");
+	mu_assert_eq(xref->to, 42, "xref to");
+	mu_assert_eq(xref->type, RZ_ANALYSIS_XREF_TYPE_DATA, "xref type");
+	rz_list_free(xrefs);
+
+	xrefs = rz_analysis_xrefs_get_to(analysis, 43);
+	mu_assert_eq(rz_list_length(xrefs), 2, "xrefs to count");
+	xref = rz_list_first(xrefs);
+	mu_assert_eq(xref->from, 1234, "xref from");
+	mu_assert_eq(xref->to, 43, "xref to");
+	mu_assert_eq(xref->type, RZ_ANALYSIS_XREF_TYPE_STRING, "updated xref type");
+	xref = rz_list_last(xrefs);
+	mu_assert_eq(xref->from, 0x1337, "xref from");
+	mu_assert_eq(xref->type, RZ_ANALYSIS_XREF_TYPE_CODE, "xref type");
+	rz_list_free(xrefs);
+
+	ut64 sum = 0;
+	rz_analysis_xrefs_foreach(analysis, sum_xrefs_cb, &sum);
+	mu_assert_eq(sum, 0x1337 + 42 + 'd' + 0x1337 + 43 + 'c' + 1234 + 43 + 's', "xrefs foreach");
+
+	int visited = 0;
+	rz_analysis_xrefs_foreach(analysis, count_one_xref_cb, &visited);
+	mu_assert_eq(visited, 1, "xrefs foreach stops when the callback returns false");
+
+	rz_analysis_xref_del(analysis, 0x1337, 43);
+	mu_assert_eq(rz_analysis_xrefs_count(analysis), 2, "xrefs count after delete");
+	xrefs = rz_analysis_xrefs_get_from(analysis, 0x1337);
+	mu_assert_eq(rz_list_length(xrefs), 1, "xrefs from count after delete");
+	rz_list_free(xrefs);
+
+	rz_analysis_free(analysis);
+	mu_end;
+}
+
+bool test_rz_analysis_xrefs_rebase() {
+	RzAnalysis *analysis = rz_analysis_new();
+
+	rz_analysis_xrefs_set(analysis, 0x1337, 42, RZ_ANALYSIS_XREF_TYPE_DATA);
+	rz_analysis_xrefs_set(analysis, 0x1337, 43, RZ_ANALYSIS_XREF_TYPE_CODE);
+	rz_analysis_xrefs_set(analysis, 1234, 43, RZ_ANALYSIS_XREF_TYPE_CALL);
+
+	rz_analysis_xrefs_rebase(analysis, 0x1000);
+	mu_assert_eq(rz_analysis_xrefs_count(analysis), 3, "xrefs count after rebase");
+	RzList *xrefs = rz_analysis_xrefs_get_from(analysis, 0x1337);
+	mu_assert_true(rz_list_empty(xrefs), "no xref left at the old address");
+	rz_list_free(xrefs);
+
+	xrefs = rz_analysis_xrefs_get_from(analysis, 0x2337);
+	mu_assert_eq(rz_list_length(xrefs), 2, "xrefs from count");
+	RzAnalysisXRef *xref = rz_list_first(xrefs);
+	mu_assert_eq(xref->to, 42 + 0x1000, "xref to");
+	mu_assert_eq(xref->type, RZ_ANALYSIS_XREF_TYPE_DATA, "xref type");
+	rz_list_free(xrefs);
+
+	xrefs = rz_analysis_xrefs_get_to(analysis, 43 + 0x1000);
+	mu_assert_eq(rz_list_length(xrefs), 2, "xrefs to count");
+	xref = rz_list_first(xrefs);
+	mu_assert_eq(xref->from, 1234 + 0x1000, "xref from");
+	mu_assert_eq(xref->type, RZ_ANALYSIS_XREF_TYPE_CALL, "xref type");
+	rz_list_free(xrefs);
+
+	rz_analysis_free(analysis);
+	mu_end;
+}
+
 int all_tests() {
 	mu_run_test(test_rz_analysis_xrefs_count);
+	mu_run_test(test_rz_analysis_xrefs_get);
+	mu_run_test(test_rz_analysis_xrefs_rebase);
 	return tests_passed != tests_run;
 }
 
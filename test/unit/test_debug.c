@@ -563,12 +563,101 @@ static bool test_debug_sw_bp_multibits(void) {
 }
 /// @}
 
+static bool test_debug_trace_log(void) {
+	RzDebugTraceLog *log = rz_debug_trace_log_new(4);
+	mu_assert_notnull(log, "log");
+	mu_assert_null(rz_debug_trace_log_get(log, 0), "empty log");
+	for (ut32 i = 0; i < 6; i++) {
+		rz_debug_trace_log_push(log, 0x1000 + i, i, 2, i & 1);
+	}
+	mu_assert_eq(log->count, 4, "count capped to capacity");
+	for (size_t i = 0; i < 4; i++) {
+		RzDebugTraceRecord *rec = rz_debug_trace_log_get(log, i);
+		mu_assert_notnull(rec, "record");
+		mu_assert_eq(rec->addr, 0x1002 + i, "oldest records overwritten");
+		mu_assert_eq(rec->cnum, 2 + i, "cnum");
+		mu_assert_eq(rec->size, 2, "size");
+		mu_assert_eq(rec->writes, i & 1, "writes");
+	}
+	mu_assert_null(rz_debug_trace_log_get(log, 4), "out of range");
+	rz_debug_trace_log_clear(log);
+	mu_assert_eq(log->count, 0, "cleared");
+	mu_assert_null(rz_debug_trace_log_get(log, 0), "cleared log");
+	rz_debug_trace_log_free(log);
+	mu_end;
+}
+
+static bool test_debug_trace_plans(void) {
+	RzBreakpointContext bp_ctx = { 0 };
+	RzDebug *dbg = rz_debug_new(&bp_ctx);
+	mu_assert_notnull(dbg, "create debug");
+	RzAnalysis *analysis = rz_analysis_new();
+	rz_analysis_use(analysis, "x86");
+	rz_analysis_set_bits(analysis, 64);
+	dbg->analysis = analysis;
+	RzIO *io = rz_io_new();
+	rz_io_bind(io, &dbg->iob);
+	rz_io_open_at(io, "malloc://0x1000", RZ_PERM_RW, 0644, 0x0, NULL);
+	rz_io_write_at(io, 0x100, (const ut8 *)"\x48\x89\x07", 3); // mov qword [rdi], rax
+	rz_io_write_at(io, 0x110, (const ut8 *)"\x90", 1); // nop
+	char *profile = rz_analysis_get_reg_profile(analysis);
+	mu_assert_notnull(profile, "reg profile");
+	mu_assert_true(rz_reg_set_profile_string(dbg->reg, profile), "set reg profile");
+
+	rz_reg_setv(dbg->reg, "rip", 0x100);
+	rz_reg_setv(dbg->reg, "rdi", 0x200);
+	mu_assert_true(rz_debug_trace_ins_before(dbg), "compile");
+	RzDebugTracePlan *plan = dbg->cur_plan;
+	mu_assert_notnull(plan, "plan");
+	mu_assert_eq(dbg->trace_plans->count, 1, "plan cached");
+
+	rz_reg_setv(dbg->reg, "rip", 0x110);
+	mu_assert_true(rz_debug_trace_ins_before(dbg), "compile");
+	mu_assert_eq(dbg->trace_plans->count, 2, "plan cached");
+
+	// same bytes at the same pc, the plan is reused
+	rz_reg_setv(dbg->reg, "rip", 0x100);
+	mu_assert_true(rz_debug_trace_ins_before(dbg), "hit");
+	mu_assert_ptreq(dbg->cur_plan, plan, "plan reused");
+	mu_assert_eq(dbg->trace_plans->count, 2, "no new plan");
+	ut64 records = dbg->trace_log->count;
+
+	// the code changed, the plan is compiled again
+	rz_io_write_at(io, 0x100, (const ut8 *)"\x90\x90\x90", 3);
+	mu_assert_true(rz_debug_trace_ins_before(dbg), "recompile");
+	mu_assert_eq(dbg->trace_plans->count, 2, "plan replaced");
+	RzDebugTraceRecord *rec = rz_debug_trace_log_get(dbg->trace_log, records);
+	mu_assert_notnull(rec, "record");
+	mu_assert_eq(rec->addr, 0x100, "record addr");
+	mu_assert_eq(rec->size, 1, "size of the new instruction");
+	mu_assert_eq(rec->writes, 0, "writes of the new instruction");
+
+	// a new register profile drops all the plans
+	char *changed = rz_str_newf("%s\n# changed\n", profile);
+	mu_assert_true(rz_reg_set_profile_string(dbg->reg, changed), "change reg profile");
+	rz_reg_setv(dbg->reg, "rip", 0x100);
+	mu_assert_true(rz_debug_trace_ins_before(dbg), "compile");
+	mu_assert_eq(dbg->trace_plans->count, 1, "plans dropped");
+
+	rz_debug_trace_reset(dbg);
+	mu_assert_eq(dbg->trace_log->count, 0, "log cleared with the traces");
+
+	free(changed);
+	free(profile);
+	rz_debug_free(dbg);
+	rz_io_free(io);
+	rz_analysis_free(analysis);
+	mu_end;
+}
+
 int all_tests() {
 	rz_cons_new(); // there is some windows-specific code in debug that accesses the cons singleton
 	mu_run_test(test_rz_debug_use);
 	mu_run_test(test_rz_debug_reg_offset);
 	mu_run_test(test_debug_sw_bp);
 	mu_run_test(test_debug_sw_bp_multibits);
+	mu_run_test(test_debug_trace_log);
+	mu_run_test(test_debug_trace_plans);
 	rz_cons_free();
 	return tests_passed != tests_run;
 }
@@ -17,6 +17,7 @@ Sdb *ref_db() {
 	Sdb *memory_sdb = sdb_ns(db, "memory", true);
 	sdb_set(memory_sdb, "0x7ffffffff000", "[{\"cnum\":0,\"data\":170},{\"cnum\":1,\"data\":187}]", 0);
 	sdb_set(memory_sdb, "0x7ffffffff001", "[{\"cnum\":0,\"data\":0},{\"cnum\":1,\"data\":1}]", 0);
+	sdb_set(memory_sdb, "ranges", "[{\"cnum\":1,\"addr\":140737488351248,\"data\":\"AQIDBA==\"}]", 0);
 
 	Sdb *checkpoints_sdb = sdb_ns(db, "checkpoints", true);
 	sdb_set(checkpoints_sdb, "0x0", "{"
@@ -58,6 +59,7 @@ RzDebugSession *ref_session() {
 	rz_debug_session_add_reg_change(s, 0, 0x100, 0xdeadbeef);
 	rz_debug_session_add_mem_change(s, 0x7ffffffff000, 0xbb);
 	rz_debug_session_add_mem_change(s, 0x7ffffffff001, 0x01);
+	rz_debug_session_add_mem_range(s, 0x7ffffffff010, (const ut8 *)"\x01\x02\x03\x04", 4);
 
 	// Checkpoints
 	RzDebugCheckpoint checkpoint = { 0 };
@@ -172,6 +174,13 @@ static bool test_session_load(void) {
 	ht_up_foreach(s->registers, compare_registers_cb, ref->registers);
 	// Memory
 	ht_up_foreach(s->memory, compare_memory_cb, ref->memory);
+	mu_assert_eq(s->memory_ranges->len, ref->memory_ranges->len, "memory ranges length");
+	RzDebugChangeMemRange *range = rz_vector_index_ptr(s->memory_ranges, 0);
+	RzDebugChangeMemRange *ref_range = rz_vector_index_ptr(ref->memory_ranges, 0);
+	mu_assert_eq(range->cnum, ref_range->cnum, "range cnum");
+	mu_assert_eq(range->addr, ref_range->addr, "range addr");
+	mu_assert_eq(range->size, ref_range->size, "range size");
+	mu_assert_memeq(range->data, ref_range->data, ref_range->size, "range data");
 	// Checkpoints
 	size_t i, chkpt_idx;
 	RzDebugCheckpoint *chkpt, *ref_chkpt;
@@ -198,9 +207,79 @@ static bool test_session_load(void) {
 	mu_end;
 }
 
+static ut8 mock_mem[4 * SNAP_PAGE_SIZE];
+static int mock_writes;
+
+static bool mock_read_at(RzIO *io, ut64 addr, ut8 *buf, int len) {
+	memcpy(buf, mock_mem + addr - 0x10000, len);
+	return true;
+}
+
+static bool mock_write_at(RzIO *io, ut64 addr, const ut8 *buf, int len) {
+	memcpy(mock_mem + addr - 0x10000, buf, len);
+	mock_writes++;
+	return true;
+}
+
+static bool test_snap_pages(void) {
+	RzDebug *dbg = RZ_NEW0(RzDebug);
+	dbg->iob.read_at = mock_read_at;
+	dbg->iob.write_at = mock_write_at;
+	RzDebugSession *s = rz_debug_session_new();
+	RzDebugMap map = { 0 };
+	map.name = "[heap]";
+	map.addr = 0x10000;
+	map.addr_end = 0x10000 + sizeof(mock_mem);
+	map.size = sizeof(mock_mem);
+	map.perm = RZ_PERM_RW;
+
+	memset(mock_mem, 0, sizeof(mock_mem));
+	memset(mock_mem + 2 * SNAP_PAGE_SIZE, 0x41, SNAP_PAGE_SIZE);
+	RzDebugSnap *a = rz_debug_snap_map_pages(dbg, &map, s->pages, NULL, NULL);
+	mu_assert_notnull(a, "snap");
+	mu_assert_eq(a->pages_count, 4, "pages count");
+	mu_assert_ptreq(a->pages[0], a->pages[1], "identical pages are shared");
+	mu_assert_ptreq(a->pages[0], a->pages[3], "identical pages are shared");
+	mu_assert("distinct pages", a->pages[0] != a->pages[2]);
+	mu_assert_eq(s->pages->count, 2, "stored pages");
+
+	// page 3 changes behind our back: being reported clean, it is taken from the base
+	mock_mem[SNAP_PAGE_SIZE] = 1;
+	mock_mem[3 * SNAP_PAGE_SIZE] = 2;
+	RzBitVector *dirty = rz_bv_new(4);
+	rz_bv_set(dirty, 1, true);
+	RzDebugSnap *b = rz_debug_snap_map_pages(dbg, &map, s->pages, a, dirty);
+	rz_bv_free(dirty);
+	mu_assert_notnull(b, "snap");
+	mu_assert_ptreq(b->pages[2], a->pages[2], "clean page shared with the base");
+	mu_assert_ptreq(b->pages[3], a->pages[3], "clean page shared with the base");
+	mu_assert_eq(b->pages[1]->data[0], 1, "dirty page read again");
+	mu_assert_eq(s->pages->count, 3, "stored pages");
+
+	ut8 *data = rz_debug_snap_dup_data(b);
+	mu_assert_notnull(data, "flat data");
+	mu_assert_eq(data[SNAP_PAGE_SIZE], 1, "flat data");
+	mu_assert_eq(data[2 * SNAP_PAGE_SIZE], 0x41, "flat data");
+	free(data);
+
+	mock_writes = 0;
+	mu_assert_true(rz_debug_snap_restore(dbg, a), "restore");
+	mu_assert_eq(mock_writes, 2, "only the changed pages are written");
+	mu_assert_eq(mock_mem[SNAP_PAGE_SIZE], 0, "restored page");
+	mu_assert_eq(mock_mem[3 * SNAP_PAGE_SIZE], 0, "restored page");
+
+	rz_debug_snap_free(a);
+	rz_debug_snap_free(b);
+	mu_assert_eq(s->pages->count, 0, "pages released");
+	rz_debug_session_free(s);
+	free(dbg);
+	mu_end;
+}
+
 int all_tests() {
 	mu_run_test(test_session_save);
 	mu_run_test(test_session_load);
+	mu_run_test(test_snap_pages);
 	return tests_passed != tests_run;
 }
 
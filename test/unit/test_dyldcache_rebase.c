@@ -0,0 +1,184 @@
+// SPDX-FileCopyrightText: 2023 RizinOrg <info@rizin.re>
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#include <rz_util.h>
+#include "../../librz/bin/format/mach0/dyldcache_rebase.c"
+#include "minunit.h"
+
+#define PAGE_SIZE        0x1000
+#define PAGES_COUNT      32
+#define START_OF_DATA    0x1000
+#define NO_REBASE_PAGE   1
+#define AUTH_VALUE_ADD   0x180000000ULL
+#define AUTH_PTR(target) (0x8000000000000000ULL | (target))
+
+/*
+ * A cache with a single v3 slide info: every page of the data starts with an
+ * authenticated pointer to its own index (the last of its chain), except
+ * NO_REBASE_PAGE which is left alone.
+ */
+typedef struct {
+	RzDyldCache cache;
+	RzDyldRebaseInfos infos;
+	RzDyldRebaseInfosEntry entry;
+	RzDyldRebaseInfo3 info;
+	ut16 page_starts[PAGES_COUNT];
+} TestCache;
+
+static TestCache *test_cache_new(bool cached) {
+	TestCache *t = RZ_NEW0(TestCache);
+	ut8 *data = calloc(1, START_OF_DATA + PAGES_COUNT * PAGE_SIZE);
+	if (!t || !data) {
+		free(t);
+		free(data);
+		return NULL;
+	}
+	for (ut32 i = 0; i < PAGES_COUNT; i++) {
+		rz_write_le64(data + START_OF_DATA + i * PAGE_SIZE, AUTH_PTR(i));
+		t->page_starts[i] = i == NO_REBASE_PAGE ? DYLD_CACHE_SLIDE_V3_PAGE_ATTR_NO_REBASE : 0;
+	}
+	t->info.version = 3;
+	t->info.page_size = PAGE_SIZE;
+	t->info.start_of_data = START_OF_DATA;
+	t->info.page_starts = t->page_starts;
+	t->info.page_starts_count = PAGES_COUNT;
+	t->info.delta_mask = 0x3ff8000000000000ULL;
+	t->info.delta_shift = 51;
+	t->info.auth_value_add = AUTH_VALUE_ADD;
+	t->entry.start = START_OF_DATA;
+	t->entry.end = START_OF_DATA + PAGES_COUNT * PAGE_SIZE;
+	t->entry.info = (RzDyldRebaseInfo *)&t->info;
+	t->infos.entries = &t->entry;
+	t->infos.length = 1;
+	t->cache.rebase_infos = &t->infos;
+	t->cache.buf = rz_buf_new_with_pointers(data, START_OF_DATA + PAGES_COUNT * PAGE_SIZE, true);
+	if (cached) {
+		t->cache.rebased_pages = rz_dyldcache_rebased_pages_new(&t->cache);
+	}
+	return t;
+}
+
+static void test_cache_free(TestCache *t) {
+	rz_dyldcache_rebased_pages_free(t->cache.rebased_pages, t->infos.length);
+	rz_buf_free(t->cache.buf);
+	free(t);
+}
+
+static ut64 rebased_ptr(RzBuffer *b, ut32 page) {
+	ut64 v = 0;
+	rz_buf_read_le64_at(b, START_OF_DATA + page * PAGE_SIZE, &v);
+	return v;
+}
+
+static size_t cached_pages(TestCache *t) {
+	return t->cache.rebased_pages->size / PAGE_SIZE;
+}
+
+bool test_rebased_pages_cache(void) {
+	TestCache *t = test_cache_new(true);
+	mu_assert_true(t && t->cache.rebased_pages, "cache");
+	RzBuffer *b = rz_dyldcache_new_rebasing_buf(&t->cache);
+	mu_assert_notnull(b, "rebasing buf");
+
+	mu_assert_eq(rebased_ptr(b, 2), 2 + AUTH_VALUE_ADD, "rebased pointer");
+	mu_assert_eq(cached_pages(t), 1, "page cached");
+	mu_assert_eq(rebased_ptr(b, 2), 2 + AUTH_VALUE_ADD, "rebased pointer from the cache");
+	mu_assert_eq(cached_pages(t), 1, "page hit");
+
+	mu_assert_eq(rebased_ptr(b, NO_REBASE_PAGE), AUTH_PTR(NO_REBASE_PAGE), "page without fixups");
+	mu_assert_eq(cached_pages(t), 1, "page without fixups not cached");
+
+	// read across the end of page 4 and the pointer of page 5
+	ut8 tmp[16];
+	mu_assert_eq(rz_buf_read_at(b, START_OF_DATA + 5 * PAGE_SIZE - 8, tmp, sizeof(tmp)), sizeof(tmp), "read across pages");
+	mu_assert_eq(rz_read_le64(tmp), 0, "end of page 4");
+	mu_assert_eq(rz_read_le64(tmp + 8), 5 + AUTH_VALUE_ADD, "start of page 5");
+	mu_assert_eq(cached_pages(t), 3, "both pages cached");
+
+	rz_buf_free(b);
+	test_cache_free(t);
+	mu_end;
+}
+
+bool test_rebased_pages_invalidate(void) {
+	TestCache *t = test_cache_new(true);
+	mu_assert_true(t && t->cache.rebased_pages, "cache");
+	RzBuffer *b = rz_dyldcache_new_rebasing_buf(&t->cache);
+	mu_assert_notnull(b, "rebasing buf");
+
+	mu_assert_eq(rebased_ptr(b, 2), 2 + AUTH_VALUE_ADD, "rebased pointer");
+	mu_assert_eq(rebased_ptr(b, 3), 3 + AUTH_VALUE_ADD, "rebased pointer");
+	mu_assert_eq(cached_pages(t), 2, "pages cached");
+
+	mu_assert_true(rz_buf_write_le64_at(b, START_OF_DATA + 2 * PAGE_SIZE, AUTH_PTR(0x42)), "write");
+	mu_assert_eq(cached_pages(t), 1, "written page dropped");
+	mu_assert_eq(rebased_ptr(b, 2), 0x42 + AUTH_VALUE_ADD, "written pointer rebased");
+	mu_assert_eq(rebased_ptr(b, 3), 3 + AUTH_VALUE_ADD, "other page untouched");
+
+	mu_assert_eq(cached_pages(t), 2, "written page cached again");
+
+	// a write ending right before a page does not drop it
+	ut8 zero = 0;
+	mu_assert_eq(rz_buf_write_at(b, START_OF_DATA + 3 * PAGE_SIZE - 1, &zero, 1), 1, "write");
+	mu_assert_eq(cached_pages(t), 1, "next page kept");
+	mu_assert_eq(rebased_ptr(b, 3), 3 + AUTH_VALUE_ADD, "next page rebased");
+	mu_assert_eq(cached_pages(t), 1, "next page hit");
+
+	mu_assert_true(rz_buf_resize(b, START_OF_DATA + 3 * PAGE_SIZE + 4), "shrink");
+	mu_assert_eq(cached_pages(t), 0, "truncated page dropped");
+	mu_assert_eq(rebased_ptr(b, 2), 0x42 + AUTH_VALUE_ADD, "page before the end");
+
+	rz_buf_free(b);
+	test_cache_free(t);
+	mu_end;
+}
+
+bool test_rebased_pages_prefetch(void) {
+	TestCache *t = test_cache_new(true);
+	mu_assert_true(t && t->cache.rebased_pages, "cache");
+
+	rz_dyldcache_prefetch_rebased(&t->cache, START_OF_DATA, 4 * PAGE_SIZE);
+	mu_assert_eq(cached_pages(t), 3, "few pages prefetched");
+	rz_dyldcache_prefetch_rebased(&t->cache, 0, START_OF_DATA + PAGES_COUNT * PAGE_SIZE);
+	mu_assert_eq(cached_pages(t), PAGES_COUNT - 1, "all pages with fixups prefetched");
+
+	RzBuffer *b = rz_dyldcache_new_rebasing_buf(&t->cache);
+	mu_assert_notnull(b, "rebasing buf");
+	for (ut32 i = 0; i < PAGES_COUNT; i++) {
+		ut64 expected = i == NO_REBASE_PAGE ? AUTH_PTR(i) : i + AUTH_VALUE_ADD;
+		mu_assert_eq(rebased_ptr(b, i), expected, "prefetched pointer");
+	}
+	mu_assert_eq(cached_pages(t), PAGES_COUNT - 1, "reads served from the cache");
+
+	rz_buf_free(b);
+	test_cache_free(t);
+	mu_end;
+}
+
+bool test_rebased_uncached(void) {
+	TestCache *t = test_cache_new(false);
+	mu_assert_notnull(t, "cache");
+	mu_assert_null(t->cache.rebased_pages, "no page cache");
+	RzBuffer *b = rz_dyldcache_new_rebasing_buf(&t->cache);
+	mu_assert_notnull(b, "rebasing buf");
+
+	mu_assert_eq(rebased_ptr(b, 2), 2 + AUTH_VALUE_ADD, "rebased pointer");
+	mu_assert_eq(rebased_ptr(b, NO_REBASE_PAGE), AUTH_PTR(NO_REBASE_PAGE), "page without fixups");
+	mu_assert_true(rz_buf_write_le64_at(b, START_OF_DATA + 2 * PAGE_SIZE, AUTH_PTR(0x42)), "write");
+	mu_assert_eq(rebased_ptr(b, 2), 0x42 + AUTH_VALUE_ADD, "written pointer rebased");
+	rz_dyldcache_prefetch_rebased(&t->cache, 0, START_OF_DATA + PAGES_COUNT * PAGE_SIZE);
+
+	rz_buf_free(b);
+	test_cache_free(t);
+	mu_end;
+}
+
+bool all_tests() {
+	mu_run_test(test_rebased_pages_cache);
+	mu_run_test(test_rebased_pages_invalidate);
+	mu_run_test(test_rebased_pages_prefetch);
+	mu_run_test(test_rebased_uncached);
+	return tests_passed != tests_run;
+}
+
+mu_main(all_tests)
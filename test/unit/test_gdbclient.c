@@ -0,0 +1,345 @@
+// SPDX-FileCopyrightText: 2023 RizinOrg <info@rizin.re>
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#include <rz_util.h>
+#include <rz_cons.h>
+#include <rz_socket.h>
+#include <libgdbr.h>
+#include <gdbclient/commands.h>
+#include <gdbclient/core.h>
+#include "minunit.h"
+
+#define STUB_MEM_BASE 0x10000
+#define STUB_MEM_SIZE 0xf800 // readable memory ends in the middle of a page
+#define STUB_REGS     3
+
+static const char *stub_reg_profile =
+	"gpr r0 .64 0 0\n"
+	"gpr r1 .64 8 0\n"
+	"gpr r2 .64 16 0\n";
+
+/*
+ * A gdb stub serving a scripted target: readable memory at STUB_MEM_BASE,
+ * STUB_REGS registers, and a stop reply expediting the registers of
+ * expedite_mask after every step. It counts the packets it got by kind.
+ */
+typedef struct {
+	RzSocket *listen;
+	ut8 mem[STUB_MEM_SIZE];
+	ut64 regs[STUB_REGS];
+	ut32 max_reply; ///< most bytes sent back per memory read, 0 for no limit
+	ut32 expedite_mask;
+	int m_packets;
+	int g_packets;
+} GdbStub;
+
+static void stub_reply(RzSocket *c, const char *data) {
+	ut8 csum = 0;
+	for (const char *p = data; *p; p++) {
+		csum += (ut8)*p;
+	}
+	char *pkt = rz_str_newf("$%s#%02x", data, csum);
+	if (pkt) {
+		rz_socket_write(c, pkt, strlen(pkt));
+		free(pkt);
+	}
+}
+
+static void stub_reply_hex(RzSocket *c, const ut8 *data, size_t len) {
+	char *hex = malloc(len * 2 + 1);
+	if (!hex) {
+		return;
+	}
+	for (size_t i = 0; i < len; i++) {
+		snprintf(hex + i * 2, 3, "%02x", data[i]);
+	}
+	stub_reply(c, hex);
+	free(hex);
+}
+
+static void stub_reply_stop(GdbStub *stub, RzSocket *c) {
+	RzStrBuf sb;
+	rz_strbuf_init(&sb);
+	rz_strbuf_append(&sb, "T05thread:1;");
+	// in reverse order and with a register out of the profile, both are allowed
+	rz_strbuf_append(&sb, "07:0102030405060708;");
+	for (int i = STUB_REGS - 1; i >= 0; i--) {
+		if (!(stub->expedite_mask & (1 << i))) {
+			continue;
+		}
+		ut8 raw[8];
+		rz_write_le64(raw, stub->regs[i]);
+		rz_strbuf_appendf(&sb, "%02x:", i);
+		for (int j = 0; j < 8; j++) {
+			rz_strbuf_appendf(&sb, "%02x", raw[j]);
+		}
+		rz_strbuf_append(&sb, ";");
+	}
+	stub_reply(c, rz_strbuf_get(&sb));
+	rz_strbuf_fini(&sb);
+}
+
+static void stub_handle(GdbStub *stub, RzSocket *c, const char *pkt) {
+	ut64 addr = 0, len = 0;
+	if (rz_str_startswith(pkt, "qSupported")) {
+		stub_reply(c, "PacketSize=1000;QStartNoAckMode+");
+	} else if (!strcmp(pkt, "QStartNoAckMode")) {
+		stub_reply(c, "OK");
+	} else if (!strcmp(pkt, "qC")) {
+		stub_reply(c, "QC1");
+	} else if (!strcmp(pkt, "vCont?")) {
+		stub_reply(c, "vCont;c;s");
+	} else if (*pkt == 'H') {
+		stub_reply(c, "OK");
+	} else if (*pkt == 'm' && sscanf(pkt + 1, "%" PFMT64x ",%" PFMT64x, &addr, &len) == 2) {
+		stub->m_packets++;
+		if (addr < STUB_MEM_BASE || addr >= STUB_MEM_BASE + STUB_MEM_SIZE) {
+			stub_reply(c, "E01");
+			return;
+		}
+		// like real stubs, send what is readable and no more than it wants to
+		len = RZ_MIN(len, STUB_MEM_BASE + STUB_MEM_SIZE - addr);
+		if (stub->max_reply) {
+			len = RZ_MIN(len, stub->max_reply);
+		}
+		stub_reply_hex(c, stub->mem + addr - STUB_MEM_BASE, len);
+	} else if (*pkt == 'M' && sscanf(pkt + 1, "%" PFMT64x ",%" PFMT64x, &addr, &len) == 2) {
+		const char *hex = strchr(pkt, ':');
+		if (!hex || addr < STUB_MEM_BASE || addr + len > STUB_MEM_BASE + STUB_MEM_SIZE) {
+			stub_reply(c, "E01");
+			return;
+		}
+		rz_hex_str2bin(hex + 1, stub->mem + addr - STUB_MEM_BASE);
+		stub_reply(c, "OK");
+	} else if (*pkt == 'g') {
+		stub->g_packets++;
+		ut8 raw[STUB_REGS * 8];
+		for (int i = 0; i < STUB_REGS; i++) {
+			rz_write_le64(raw + i * 8, stub->regs[i]);
+		}
+		stub_reply_hex(c, raw, sizeof(raw));
+	} else if (rz_str_startswith(pkt, "vCont;") || *pkt == 's' || *pkt == 'c') {
+		for (int i = 0; i < STUB_REGS; i++) {
+			stub->regs[i]++;
+		}
+		stub->mem[0]++;
+		stub_reply_stop(stub, c);
+	} else {
+		stub_reply(c, "");
+	}
+}
+
+static void *stub_th(void *user) {
+	GdbStub *stub = user;
+	RzSocket *c = rz_socket_accept(stub->listen);
+	if (!c) {
+		return NULL;
+	}
+	RzStrBuf in;
+	rz_strbuf_init(&in);
+	ut8 chunk[0x1000];
+	int r;
+	while ((r = rz_socket_read(c, chunk, sizeof(chunk))) > 0) {
+		rz_strbuf_append_n(&in, (const char *)chunk, r);
+		while (true) {
+			const char *data = rz_strbuf_get(&in);
+			const char *start = strchr(data, '$');
+			const char *end = start ? strchr(start, '#') : NULL;
+			if (!end || strlen(end) < 3) {
+				break;
+			}
+			char *pkt = rz_str_ndup(start + 1, end - start - 1);
+			char *rest = strdup(end + 3);
+			rz_strbuf_set(&in, rest);
+			free(rest);
+			if (pkt) {
+				stub_handle(stub, c, pkt);
+				free(pkt);
+			}
+		}
+	}
+	rz_strbuf_fini(&in);
+	rz_socket_close(c);
+	rz_socket_free(c);
+	return (void *)(size_t)1;
+}
+
+static GdbStub *stub_new(const char *port) {
+	GdbStub *stub = RZ_NEW0(GdbStub);
+	if (!stub) {
+		return NULL;
+	}
+	for (size_t i = 0; i < STUB_MEM_SIZE; i++) {
+		stub->mem[i] = (i * 7) & 0xff;
+	}
+	for (int i = 0; i < STUB_REGS; i++) {
+		stub->regs[i] = 0x1111 * (i + 1);
+	}
+	stub->expedite_mask = (1 << STUB_REGS) - 1;
+	stub->listen = rz_socket_new(false);
+	if (!stub->listen) {
+		free(stub);
+		return NULL;
+	}
+	stub->listen->local = true;
+	if (!rz_socket_listen(stub->listen, port, NULL)) {
+		rz_socket_free(stub->listen);
+		free(stub);
+		return NULL;
+	}
+	return stub;
+}
+
+static void stub_free(GdbStub *stub) {
+	rz_socket_close(stub->listen);
+	rz_socket_free(stub->listen);
+	free(stub);
+}
+
+static bool client_connect(libgdbr_t *g, const char *port) {
+	gdbr_init(g, false);
+	if (gdbr_connect(g, "127.0.0.1", atoi(port)) < 0) {
+		return false;
+	}
+	return gdbr_set_reg_profile(g, stub_reg_profile) >= 0;
+}
+
+bool test_gdbr_mem_cache(void) {
+	const char *port = "42601"; // arbitrary
+	GdbStub *stub = stub_new(port);
+	mu_assert_notnull(stub, "stub");
+	RzThread *th = rz_th_new(stub_th, stub);
+	mu_assert_notnull(th, "stub thread");
+	libgdbr_t g;
+	mu_assert_true(client_connect(&g, port), "connect");
+	mu_assert_true(g.mem_cache.enabled, "cache enabled");
+
+	// small reads walking forward, like disassembling, fetch each line once
+	ut8 buf[0x1000];
+	int m_packets = stub->m_packets;
+	for (int i = 0; i < 64; i++) {
+		mu_assert_eq(gdbr_read_memory(&g, 0x10080 + i * 4, buf, 16), 16, "small read");
+		mu_assert_memeq(buf, stub->mem + 0x80 + i * 4, 16, "small read data");
+	}
+	mu_assert_eq(stub->m_packets - m_packets, 2, "one packet per line");
+
+	mu_assert_eq(gdbr_read_memory(&g, 0x10080, buf, sizeof(buf)), sizeof(buf), "large read");
+	mu_assert_memeq(buf, stub->mem + 0x80, sizeof(buf), "large read data");
+
+	// writes drop the lines they touch
+	const ut8 w[4] = { 1, 2, 3, 4 };
+	mu_assert_true(gdbr_write_memory(&g, 0x10082, w, sizeof(w)) >= 0, "write");
+	m_packets = stub->m_packets;
+	mu_assert_eq(gdbr_read_memory(&g, 0x10080, buf, 8), 8, "read after write");
+	mu_assert_memeq(buf + 2, w, sizeof(w), "written data");
+	mu_assert_eq(buf[0], stub->mem[0x80], "data around the write");
+	mu_assert_eq(stub->m_packets - m_packets, 1, "written line fetched again");
+	mu_assert_eq(gdbr_read_memory(&g, 0x10180, buf, 8), 8, "read another line");
+	mu_assert_eq(stub->m_packets - m_packets, 1, "other lines kept");
+
+	gdbr_disconnect(&g);
+	gdbr_cleanup(&g);
+	rz_th_wait(th);
+	mu_assert_notnull(rz_th_get_retv(th), "stub served");
+	rz_th_free(th);
+	stub_free(stub);
+	mu_end;
+}
+
+bool test_gdbr_short_reply(void) {
+	const char *port = "42602"; // arbitrary
+	GdbStub *stub = stub_new(port);
+	mu_assert_notnull(stub, "stub");
+	stub->max_reply = 0x30;
+	RzThread *th = rz_th_new(stub_th, stub);
+	mu_assert_notnull(th, "stub thread");
+	libgdbr_t g;
+	mu_assert_true(client_connect(&g, port), "connect");
+
+	ut8 buf[0x200];
+	mu_assert_eq(gdbr_read_memory(&g, 0x12000, buf, sizeof(buf)), sizeof(buf), "read in short replies");
+	mu_assert_memeq(buf, stub->mem + 0x2000, sizeof(buf), "read data");
+
+	// the reply after the end of the memory is an error, what was read before is kept
+	ut64 end = STUB_MEM_BASE + STUB_MEM_SIZE;
+	mu_assert_eq(gdbr_read_memory(&g, end - 0x20, buf, 0x40), 0x20, "read across the end");
+	mu_assert_memeq(buf, stub->mem + STUB_MEM_SIZE - 0x20, 0x20, "read data before the end");
+	g.mem_cache.enabled = false;
+	mu_assert_eq(gdbr_read_memory(&g, end - 0x20, buf, 0x40), 0x20, "uncached read across the end");
+	mu_assert_eq(gdbr_read_memory(&g, end, buf, 0x40), -1, "read after the end");
+
+	// the line after the topmost one wraps to 0, it is read uncached
+	g.mem_cache.enabled = true;
+	int m_packets = stub->m_packets;
+	mu_assert_eq(gdbr_read_memory(&g, UT64_MAX - 0xf, buf, 0x10), -1, "read at the top of the address space");
+	mu_assert_eq(stub->m_packets - m_packets, 1, "single uncached packet");
+	// ends right before UT64_MAX, dropping the lines must not walk on from 0
+	gdbr_write_memory(&g, UT64_MAX - 0x10, buf, 0x10);
+	mu_assert_eq(gdbr_read_memory(&g, 0x12000, buf, 0x10), 0x10, "cache still usable");
+
+	gdbr_disconnect(&g);
+	gdbr_cleanup(&g);
+	rz_th_wait(th);
+	rz_th_free(th);
+	stub_free(stub);
+	mu_end;
+}
+
+bool test_gdbr_expedited_regs(void) {
+	const char *port = "42603"; // arbitrary
+	GdbStub *stub = stub_new(port);
+	mu_assert_notnull(stub, "stub");
+	RzThread *th = rz_th_new(stub_th, stub);
+	mu_assert_notnull(th, "stub thread");
+	libgdbr_t g;
+	mu_assert_true(client_connect(&g, port), "connect");
+
+	ut8 buf[1];
+	for (int i = 0; i < 4; i++) {
+		mu_assert_eq(gdbr_read_memory(&g, STUB_MEM_BASE, buf, 1), 1, "read");
+		mu_assert_eq(buf[0], stub->mem[0], "memory before the step");
+		mu_assert_true(gdbr_step(&g, -1) >= 0, "step");
+
+		// all the registers came with the stop reply
+		int g_packets = stub->g_packets;
+		mu_assert_eq(gdbr_read_registers(&g), 0, "read registers");
+		mu_assert_eq(stub->g_packets, g_packets, "registers expedited");
+		mu_assert_eq(g.data_len, STUB_REGS * 8, "registers size");
+		for (int r = 0; r < STUB_REGS; r++) {
+			mu_assert_eq(rz_read_le64(g.data + r * 8), stub->regs[r], "expedited register");
+		}
+		// the step dropped the cached memory
+		mu_assert_eq(gdbr_read_memory(&g, STUB_MEM_BASE, buf, 1), 1, "read");
+		mu_assert_eq(buf[0], stub->mem[0], "memory after the step");
+	}
+
+	// some registers missing from the stop reply, they are all read with 'g'
+	stub->expedite_mask = 1;
+	mu_assert_true(gdbr_step(&g, -1) >= 0, "step");
+	int g_packets = stub->g_packets;
+	mu_assert_eq(gdbr_read_registers(&g), 0, "read registers");
+	mu_assert_eq(stub->g_packets, g_packets + 1, "registers read");
+	for (int r = 0; r < STUB_REGS; r++) {
+		mu_assert_eq(rz_read_le64(g.data + r * 8), stub->regs[r], "register");
+	}
+	mu_assert_eq(gdbr_read_registers(&g), 0, "read registers again");
+	mu_assert_eq(stub->g_packets, g_packets + 1, "registers cached");
+
+	gdbr_disconnect(&g);
+	gdbr_cleanup(&g);
+	rz_th_wait(th);
+	rz_th_free(th);
+	stub_free(stub);
+	mu_end;
+}
+
+bool all_tests() {
+	rz_cons_new();
+	mu_run_test(test_gdbr_mem_cache);
+	mu_run_test(test_gdbr_short_reply);
+	mu_run_test(test_gdbr_expedited_regs);
+	rz_cons_free();
+	return tests_passed != tests_run;
+}
+
+mu_main(all_tests)
@@ -165,6 +165,174 @@ bool test_rz_io_pcache(void) {
 	mu_end;
 }
 
+bool test_rz_io_rcache(void) {
+	RzIO *io = rz_io_new();
+	io->rcache = true;
+	io->rcache_pagesize = 0x10;
+	io->rcache_pages = 2;
+	io->va = true;
+	ut8 buf[0x20];
+	int fd = rz_io_fd_open(io, "malloc://0x28", RZ_PERM_RW, 0);
+	rz_io_map_add(io, fd, RZ_PERM_RW, 0LL, 0LL, 0x28);
+	rz_io_write_at(io, 0, (const ut8 *)"AAAAAAAAAAAAAAAABBBBBBBBBBBBBBBBCCCCCCCC", 0x28);
+
+	mu_assert_true(rz_io_read_at(io, 0x8, buf, 0x10), "read across two pages");
+	mu_assert_memeq(buf, (const ut8 *)"AAAAAAAABBBBBBBB", 0x10, "read across two pages");
+	mu_assert_eq(io->rcache_misses, 2, "two pages read");
+	mu_assert_eq(io->rcache_hits, 0, "nothing cached yet");
+	mu_assert_true(rz_io_read_at(io, 0x0, buf, 4), "read of a cached page");
+	mu_assert_memeq(buf, (const ut8 *)"AAAA", 4, "read of a cached page");
+	mu_assert_eq(io->rcache_hits, 1, "page served from the cache");
+
+	// writes invalidate the cached pages
+	rz_io_write_at(io, 0x2, (const ut8 *)"XY", 2);
+	mu_assert_true(rz_io_read_at(io, 0x0, buf, 4), "read after write");
+	mu_assert_memeq(buf, (const ut8 *)"AAXY", 4, "no stale bytes after write");
+	mu_assert_eq(io->rcache_misses, 3, "written page read again");
+
+	// the last page is short and evicts the least recently used one
+	mu_assert_true(rz_io_read_at(io, 0x20, buf, 8), "read of the last page");
+	mu_assert_memeq(buf, (const ut8 *)"CCCCCCCC", 8, "read of the last page");
+	mu_assert_eq(io->rcache_misses, 4, "last page read");
+	mu_assert_true(rz_io_read_at(io, 0x10, buf, 1), "read of the evicted page");
+	mu_assert_eq(io->rcache_misses, 5, "evicted page read again");
+	mu_assert_true(rz_io_read_at(io, 0x20, buf, 1), "read of the recently used page");
+	mu_assert_eq(io->rcache_misses, 5, "recently used page still cached");
+
+	// only the pages of debugger descs are dropped when the target ran
+	rz_io_rcache_invalidate_dbg(io);
+	mu_assert_true(rz_io_read_at(io, 0x20, buf, 1), "read of a non-debugger desc");
+	mu_assert_eq(io->rcache_misses, 5, "non-debugger desc still cached");
+	RzIODesc *desc = rz_io_desc_get(io, fd);
+	RzIOPlugin *plugin = desc->plugin;
+	RzIOPlugin dbg_plugin = *plugin;
+	dbg_plugin.isdbg = true;
+	desc->plugin = &dbg_plugin;
+	mu_assert_true(rz_io_read_at(io, 0x20, buf, 1), "read of a debugger desc");
+	mu_assert_eq(io->rcache_misses, 5, "debugger desc is cached");
+	rz_io_rcache_invalidate_dbg(io);
+	mu_assert_true(rz_io_read_at(io, 0x20, buf, 8), "read after the target ran");
+	mu_assert_memeq(buf, (const ut8 *)"CCCCCCCC", 8, "read after the target ran");
+	mu_assert_eq(io->rcache_misses, 6, "debugger desc pages dropped");
+	desc->plugin = plugin;
+
+	rz_io_free(io);
+	mu_end;
+}
+
+typedef struct {
+	ut8 data[0x40];
+	int reads;
+	int readvs;
+} ReadvMock;
+
+static int readv_mock_read_at(RzIO *io, RzIODesc *fd, ut64 addr, ut8 *buf, int count) {
+	ReadvMock *mock = fd->data;
+	mock->reads++;
+	if (addr >= sizeof(mock->data)) {
+		return 0;
+	}
+	int n = RZ_MIN(count, sizeof(mock->data) - addr);
+	memcpy(buf, mock->data + addr, n);
+	return n;
+}
+
+static bool readv_mock_readv_at(RzIO *io, RzIODesc *fd, RzIOReadVec *vec, size_t count) {
+	ReadvMock *mock = fd->data;
+	mock->readvs++;
+	for (size_t i = 0; i < count; i++) {
+		vec[i].ret = readv_mock_read_at(io, fd, vec[i].addr, vec[i].buf, vec[i].len);
+		mock->reads--;
+	}
+	return true;
+}
+
+static ut64 readv_mock_lseek(RzIO *io, RzIODesc *fd, ut64 offset, int whence) {
+	return whence == RZ_IO_SEEK_SET ? offset : 0;
+}
+
+static RzIOPlugin readv_mock_plugin = {
+	.name = "readv_mock",
+	.read_at = readv_mock_read_at,
+	.readv_at = readv_mock_readv_at,
+	.lseek = readv_mock_lseek
+};
+
+bool test_rz_io_readv(void) {
+	ReadvMock mock = { 0 };
+	for (int i = 0; i < sizeof(mock.data); i++) {
+		mock.data[i] = i;
+	}
+	RzIO *io = rz_io_new();
+	io->va = true;
+	RzIODesc *desc = rz_io_desc_new(io, &readv_mock_plugin, "readv_mock://", RZ_PERM_R, 0, &mock);
+	rz_io_desc_add(io, desc);
+	// 0x100..0x120 maps the data backwards, 4 bytes at a time
+	for (int i = 0; i < 8; i++) {
+		rz_io_map_add(io, desc->fd, RZ_PERM_R, 0x1c - i * 4, 0x100 + i * 4, 4);
+	}
+	// the last map runs past the end of the data
+	rz_io_map_add(io, desc->fd, RZ_PERM_R, 0x3c, 0x120, 8);
+
+	ut8 buf[0x30];
+	mu_assert_true(rz_io_read_at_mapped(io, 0x100, buf, 0x20), "read of all the fragments");
+	for (int i = 0; i < 8; i++) {
+		ut8 expect[] = { 0x1c - i * 4, 0x1d - i * 4, 0x1e - i * 4, 0x1f - i * 4 };
+		mu_assert_memeq(buf + i * 4, expect, 4, "fragment read");
+	}
+	mu_assert_eq(mock.readvs, 1, "fragments read with a single call");
+	mu_assert_eq(mock.reads, 0, "no single read");
+
+	mu_assert_eq(rz_io_nread_at(io, 0x11e, buf, 0x10), 6, "prefix read up to the end of the data");
+	mu_assert_memeq(buf, (const ut8 *)"\x02\x03\x3c\x3d\x3e\x3f", 6, "prefix read");
+	mu_assert_false(rz_io_read_at_mapped(io, 0x11c, buf, 0xc), "short read of the last fragment");
+	mu_assert_eq(mock.readvs, 3, "fragments read with a single call");
+
+	mu_assert_true(rz_io_read_at_mapped(io, 0x101, buf, 2), "read inside a map");
+	mu_assert_memeq(buf, (const ut8 *)"\x1d\x1e", 2, "read inside a map");
+	mu_assert_eq(mock.readvs, 3, "single fragment not vectored");
+	mu_assert_eq(mock.reads, 1, "single fragment read at its address");
+
+	rz_io_free(io);
+	mu_end;
+}
+
+bool test_rz_io_read_at_borrow(void) {
+	RzIO *io = rz_io_new();
+	io->va = true;
+	ut8 buf[0x10];
+	RzIODesc *desc = rz_io_open_at(io, "malloc://0x20", RZ_PERM_RW, 0644, 0x100, NULL);
+	mu_assert_notnull(desc, "open");
+	rz_io_write_at(io, 0x100, (const ut8 *)"AAAAAAAABBBBBBBBCCCCCCCCDDDDDDDD", 0x20);
+	rz_io_map_add(io, desc->fd, RZ_PERM_R, 0x10, 0x200, 0x10);
+
+	const ut8 *data = rz_io_read_at_borrow(io, 0x104, buf, 8);
+	mu_assert_ptrneq(data, buf, "bytes borrowed from the desc");
+	mu_assert_memeq(data, (const ut8 *)"AAAABBBB", 8, "borrowed bytes");
+	data = rz_io_read_at_borrow(io, 0x204, buf, 8);
+	mu_assert_ptrneq(data, buf, "bytes borrowed through a map with a delta");
+	mu_assert_memeq(data, (const ut8 *)"CCCCDDDD", 8, "borrowed bytes");
+
+	data = rz_io_read_at_borrow(io, 0x11c, buf, 8);
+	mu_assert_ptreq(data, buf, "range past the end of the map is copied");
+	mu_assert_memeq(data, (const ut8 *)"DDDD", 4, "copied bytes");
+
+	io->cached = RZ_PERM_RW;
+	rz_io_write_at(io, 0x104, (const ut8 *)"XY", 2);
+	data = rz_io_read_at_borrow(io, 0x104, buf, 4);
+	mu_assert_ptreq(data, buf, "bytes copied with the io cache on");
+	mu_assert_memeq(data, (const ut8 *)"XYAA", 4, "io cache applied");
+	io->cached = 0;
+
+	io->va = false;
+	data = rz_io_read_at_borrow(io, 0x8, buf, 8);
+	mu_assert_ptrneq(data, buf, "bytes borrowed in physical mode");
+	mu_assert_memeq(data, (const ut8 *)"BBBBBBBB", 8, "borrowed bytes in physical mode");
+
+	rz_io_free(io);
+	mu_end;
+}
+
 bool test_rz_io_desc_exchange(void) {
 	RzIO *io = rz_io_new();
 	int fd = rz_io_fd_open(io, "malloc://3", RZ_PERM_R, 0),
@@ -637,6 +805,9 @@ bool all_tests(void) {
 	mu_run_test(test_rz_io_mapsplit3);
 	mu_run_test(test_rz_io_maps_vector);
 	mu_run_test(test_rz_io_pcache);
+	mu_run_test(test_rz_io_rcache);
+	mu_run_test(test_rz_io_readv);
+	mu_run_test(test_rz_io_read_at_borrow);
 	mu_run_test(test_rz_io_desc_exchange);
 	mu_run_test(test_rz_io_priority);
 	mu_run_test(test_rz_io_priority2);
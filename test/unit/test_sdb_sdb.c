@@ -549,6 +549,40 @@ bool test_sdb_text_load_file() {
 	mu_end;
 }
 
+bool test_sdb_binary_save_load() {
+	Sdb *ref_db = text_ref_db();
+	int fd = tmpfile_new(".binary_save", NULL, 0);
+	bool succ = sdb_binary_save_fd(ref_db, fd, true);
+	close(fd);
+	mu_assert_true(succ, "save success");
+
+	Sdb *db = sdb_new0();
+	succ = sdb_binary_load(db, ".binary_save");
+	unlink(".binary_save");
+	mu_assert_true(succ, "load success");
+	bool eq = sdb_diff(ref_db, db, diff_cb, NULL);
+	sdb_free(ref_db);
+	sdb_free(db);
+	mu_assert_true(eq, "load correct");
+	mu_end;
+}
+
+bool test_sdb_binary_load_broken() {
+	const ut8 no_magic[] = "SDBX\x01\x00\x00\x00\x00\x00";
+	const ut8 truncated[] = "SDBB\x01\x00\x00\x00\x01\x04key";
+	const ut8 no_nul[] = "SDBB\x01\x00\x00\x00\x01\x02kk\x02vv\x00";
+	const ut8 trailing[] = "SDBB\x01\x00\x00\x00\x00\x00garbage";
+	const ut8 empty[] = "SDBB\x01\x00\x00\x00\x00\x00";
+	Sdb *db = sdb_new0();
+	mu_assert_false(sdb_binary_load_buf(db, no_magic, sizeof(no_magic) - 1), "bad magic");
+	mu_assert_false(sdb_binary_load_buf(db, truncated, sizeof(truncated) - 1), "truncated");
+	mu_assert_false(sdb_binary_load_buf(db, no_nul, sizeof(no_nul) - 1), "string without null byte");
+	mu_assert_false(sdb_binary_load_buf(db, trailing, sizeof(trailing) - 1), "trailing garbage");
+	mu_assert_true(sdb_binary_load_buf(db, empty, sizeof(empty) - 1), "empty db");
+	sdb_free(db);
+	mu_end;
+}
+
 int all_tests() {
 	// XXX two bugs found with crash
 	mu_run_test(test_sdb_namespace);
@@ -571,6 +605,8 @@ int all_tests() {
 	mu_run_test(test_sdb_text_load_broken);
 	mu_run_test(test_sdb_text_load_path_last_line);
 	mu_run_test(test_sdb_text_load_file);
+	mu_run_test(test_sdb_binary_save_load);
+	mu_run_test(test_sdb_binary_load_broken);
 	return tests_passed != tests_run;
 }
 
@@ -0,0 +1,57 @@
+// SPDX-FileCopyrightText: 2023 RizinOrg <info@rizin.re>
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#include <rz_search.h>
+#include "minunit.h"
+
+static const ut8 search_buf[] = "\x55\x48\x89\xe5 hello \x55\x89\xe5 HeLLo \x55\x48\x89\xe5\x55\x48\x89\xe5";
+
+static int hits_cb(RzSearchKeyword *kw, void *user, ut64 addr) {
+	rz_strbuf_appendf(user, "%d:%" PFMT64x " ", kw->kwidx, addr);
+	return 1;
+}
+
+static char *search_hits(RzSearch *s, int block_size) {
+	RzStrBuf *sb = rz_strbuf_new("");
+	rz_search_begin(s);
+	rz_search_set_callback(s, hits_cb, sb);
+	int size = sizeof(search_buf) - 1;
+	for (int at = 0; at < size; at += block_size) {
+		rz_search_update(s, at, search_buf + at, RZ_MIN(block_size, size - at));
+	}
+	return rz_strbuf_drain(sb);
+}
+
+bool test_rz_search_keywords(void) {
+	RzSearch *s = rz_search_new(RZ_SEARCH_KEYWORD);
+	rz_search_kw_add(s, rz_search_keyword_new_hexmask("554889e5", NULL));
+	rz_search_kw_add(s, rz_search_keyword_new_hex("5589e5", "ffff00", NULL));
+	rz_search_kw_add(s, rz_search_keyword_new_str("hello", NULL, NULL, 1));
+	rz_search_kw_add(s, rz_search_keyword_new_hexmask("e5", NULL));
+
+	// hits are reported keyword after keyword for each block, matches across blocks included,
+	// the second match at 0x19 is right after the one at 0x15 and ignored as sequential
+	char *hits = search_hits(s, sizeof(search_buf));
+	mu_assert_streq(hits, "0:0 0:15 1:b 2:5 2:f 3:3 3:d 3:18 3:1c ", "hits in a single block");
+	free(hits);
+	hits = search_hits(s, 7);
+	mu_assert_streq(hits, "0:0 3:3 1:b 2:5 3:d 2:f 0:15 3:18 3:1c ", "hits in small blocks");
+	free(hits);
+
+	rz_search_kw_reset(s);
+	rz_search_kw_add(s, rz_search_keyword_new_hexmask("554889e555", NULL));
+	rz_search_kw_add(s, rz_search_keyword_new_hexmask("e555", NULL));
+	hits = search_hits(s, sizeof(search_buf));
+	mu_assert_streq(hits, "4:15 5:18 ", "keywords changed after reset");
+	free(hits);
+
+	rz_search_free(s);
+	mu_end;
+}
+
+bool all_tests() {
+	mu_run_test(test_rz_search_keywords);
+	return tests_passed != tests_run;
+}
+
+mu_main(all_tests)
@@ -343,6 +343,40 @@ bool test_rz_scan_strings_extended_ascii(void) {
 	mu_end;
 }
 
+bool test_rz_scan_strings_skip_padding(void) {
+	// strings surrounded by padding and control bytes, spanning several 16 bytes blocks
+	ut8 buf[0x100] = { 0 };
+	memcpy(buf + 0x31, "\x00s\x00t\x00r\x00i\x00n\x00g", 12);
+	memset(buf + 0x50, 0x01, 0x23);
+	memcpy(buf + 0x73, "I am an ASCII string", 20);
+	memcpy(buf + 0xa0, "ab\x02" "cd\x7f", 6);
+	memcpy(buf + 0xfc, "tail", 4);
+
+	RzList *str_list = rz_list_newf((RzListFree)rz_detected_string_free);
+	int n = rz_scan_strings_raw(buf, str_list, &g_opt, 0x1000, 0x1000 + sizeof(buf), RZ_STRING_ENC_GUESS);
+	mu_assert_eq(n, 3, "rz_scan_strings guess, number of strings");
+	RzDetectedString *s = rz_list_get_n(str_list, 0);
+	mu_assert_streq(s->string, "string", "rz_scan_strings guess, utf16be string");
+	mu_assert_eq(s->addr, 0x1031, "rz_scan_strings guess, utf16be address");
+	mu_assert_eq(s->type, RZ_STRING_ENC_UTF16BE, "rz_scan_strings guess, utf16be type");
+	s = rz_list_get_n(str_list, 1);
+	mu_assert_streq(s->string, "I am an ASCII string", "rz_scan_strings guess, ascii string");
+	mu_assert_eq(s->addr, 0x1073, "rz_scan_strings guess, ascii address");
+	s = rz_list_get_n(str_list, 2);
+	mu_assert_streq(s->string, "tail", "rz_scan_strings guess, string at the end");
+	rz_list_purge(str_list);
+
+	n = rz_scan_strings_raw(buf, str_list, &g_opt, 0x1000, 0x1000 + sizeof(buf), RZ_STRING_ENC_8BIT);
+	mu_assert_eq(n, 2, "rz_scan_strings 8bit, number of strings");
+	s = rz_list_get_n(str_list, 0);
+	mu_assert_eq(s->addr, 0x1073, "rz_scan_strings 8bit, ascii address");
+	s = rz_list_get_n(str_list, 1);
+	mu_assert_eq(s->addr, 0x10fc, "rz_scan_strings 8bit, address at the end");
+	rz_list_free(str_list);
+
+	mu_end;
+}
+
 bool all_tests() {
 	mu_run_test(test_rz_scan_strings_detect_ascii);
 	mu_run_test(test_rz_scan_strings_detect_ibm037);
@@ -354,6 +388,7 @@ bool all_tests() {
 	mu_run_test(test_rz_scan_strings_detect_utf32_be);
 	mu_run_test(test_rz_scan_strings_utf16_be);
 	mu_run_test(test_rz_scan_strings_extended_ascii);
+	mu_run_test(test_rz_scan_strings_skip_padding);
 
 	return tests_passed != tests_run;
 }